@@ -18,11 +18,6 @@
 // which might not be avaialable on lower end devices.
 #define ENCRYPTED false
 
-// Enables sending messages that are bigger than the predefined message size,
-// where the message will be sent byte by byte as a fallback instead.
-// Requires an additional library, see https://github.com/bblanchon/ArduinoStreamUtils for more information.
-// Simply install that library and the feature will be enabled automatically.
-
 // Enables the ThingsBoard class to be fully dynamic instead of requiring template arguments to statically allocate memory.
 // If enabled the program might be slightly slower and all the memory will be placed onto the heap instead of the stack.
 #define THINGSBOARD_ENABLE_DYNAMIC 1
@@ -136,7 +131,8 @@ ThingsBoardHttp tb(httpClient, TOKEN, THINGSBOARD_SERVER, THINGSBOARD_PORT);
 Arduino_MQTT_Client mqttClient(espClient);
 // Initialize used apis
 const std::array<IAPI_Implementation*, 0U> apis = {};
-// Initialize ThingsBoard instance with the maximum needed buffer size
+// Initialize ThingsBoard instance with the maximum needed buffer size,
+// if the StreamUtils library is still installed the previous constructor with the ignored buffering_size argument is used instead
 #if THINGSBOARD_ENABLE_DYNAMIC
 #if THINGSBOARD_ENABLE_STREAM_UTILS
 ThingsBoard tb(mqttClient, MAX_MESSAGE_RECEIVE_SIZE, MAX_MESSAGE_SEND_SIZE, DEFAULT_MAX_STACK_SIZE, DEFAULT_BUFFERING_SIZE, DEFAULT_MAX_RESPONSE_SIZE, apis.cbegin(), apis.cend());
@@ -11,6 +11,8 @@
 ///
 /// If the received data is unserialized binary data, which we should not serialize into JSON because the received data is not JSON in the first place Process_Response method will be called (OTA Firmware Update).
 /// Alterantively, if the received data needs to be serialized into JSON data the Process_JSON_Response method will be called with the data already serialized into the JSON format instead (everything else).
+/// Data encoded as protobuf, because the device profile on the ThingsBoard server uses the protobuf transport payload type, is binary data as well and is therefore also passed to the Process_Response method,
+/// where the API implementation decodes it with the @ref Protobuf_Reader (server-side RPC, shared attribute update).
 ///
 /// Additionally the actual data is never copied in both cases to safe space. Instead the underlying MQTT buffer is expected to keep the buffer unchanged and alive and we simply use a non-owning pointer for our operations.
 /// This can cause the data to become garbage if the user code resizes the underlying MQTT buffer size and therefore moves the actual data in the MQTT buffer, before the data is handled by the code itself.
@@ -18,7 +20,8 @@
 /// but instead it was handled by the same underlying Heap buffer, meaning if we sent data in the callback handling received data that data was partially overwritten and became mangled
 enum class API_Process_Type : uint8_t {
     RAW, ///< Calls Process_Response with the received unserialized binary data
-    JSON ///< Calls Process_Json_Response with the received unserialized binary data serialized into JSON
+    JSON, ///< Calls Process_Json_Response with the received unserialized binary data serialized into JSON
+    PROTOBUF ///< Calls Process_Response with the received protobuf encoded binary data
 };
 
 #endif // API_Process_Type_h
@@ -90,8 +90,6 @@ void Arduino_MQTT_Client::subscribe_connection_state_changed_callback(Callback<v
     m_connection_state_changed_callback.Set_Callback(callback);
 }
 
-#if THINGSBOARD_ENABLE_STREAM_UTILS
-
 bool Arduino_MQTT_Client::begin_publish(char const * topic, size_t const & length) {
     return m_mqtt_client.beginPublish(topic, length, false);
 }
@@ -108,7 +106,10 @@ size_t Arduino_MQTT_Client::write(uint8_t const * buffer, size_t const & size) {
     return m_mqtt_client.write(buffer, size);
 }
 
-#endif // THINGSBOARD_ENABLE_STREAM_UTILS
+size_t Arduino_MQTT_Client::get_outbox_size() {
+    // PubSubClient writes published messages directly into the network client, meaning there is never anything waiting to be sent
+    return 0U;
+}
 
 MQTT_Connection_Error Arduino_MQTT_Client::connect_mqtt_client(char const * client_id, char const * user_name, char const * password) {
     m_mqtt_client.connect(client_id, user_name, password);
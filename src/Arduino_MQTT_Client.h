@@ -67,21 +67,15 @@ class Arduino_MQTT_Client : public IMQTT_Client {
 
     void subscribe_connection_state_changed_callback(Callback<void, MQTT_Connection_State, MQTT_Connection_Error>::function callback) override;
 
-#if THINGSBOARD_ENABLE_STREAM_UTILS
-
     bool begin_publish(char const * topic, size_t const & length) override;
 
     bool end_publish() override;
 
-    //----------------------------------------------------------------------------
-    // Print interface
-    //----------------------------------------------------------------------------
-
     size_t write(uint8_t payload_byte) override;
 
     size_t write(uint8_t const * buffer, size_t const & size) override;
 
-#endif // THINGSBOARD_ENABLE_STREAM_UTILS
+    size_t get_outbox_size() override;
 
   private:
     MQTT_Connection_Error connect_mqtt_client(char const * client_id, char const * user_name, char const * password);
@@ -0,0 +1,16 @@
+#ifndef Array_Encoding_h
+#define Array_Encoding_h
+
+// Library include.
+#include <stdint.h>
+
+
+/// @brief Possible representations a buffer of numeric samples referenced by a @ref Telemetry instance is serialized as
+/// @note Base64 is roughly 3 to 5 times smaller than the json array for floating point samples and does not require formatting every single number,
+/// but the receiving side (for example a rule chain script) has to decode it again and has to know the element type as well as the byte order of the device
+enum class Array_Encoding : uint8_t {
+    JSON_ARRAY, ///< Every sample is written as a json number into a json array [1,2,3]
+    BASE64 ///< Raw bytes of the buffer, in the byte order of the device, are written as a single base64 encoded json string "AQACAAMA"
+};
+
+#endif // Array_Encoding_h
@@ -0,0 +1,153 @@
+#ifndef Attribute_Change_Tracker_h
+#define Attribute_Change_Tracker_h
+
+// Local includes.
+#include "Callback.h"
+#include "Constants.h"
+#include "Hash_Writer.h"
+#include "IReport_Filter.h"
+
+// Library include.
+#include <string.h>
+
+
+/// @brief Report filter for client-side attributes, that drops key-value pairs whose value did not change since it was last sent (report-on-change)
+/// @note Instead of copying the last sent values, only a copy of every key and a 64-bit FNV-1a hash of the key-value pair serialized as json are stored, meaning every key requires its own length plus 9 bytes,
+/// independent of whether its value is a number, a string or a buffer of samples. Keys are compared exactly, therefore two keys can never be confused with each other. Because the serialized json is hashed,
+/// a change is detected exactly if the payload that would be sent changes, for example a floating point value rounded to 2 decimal places is not sent again if only the third decimal place changed.
+/// Two different values of the same key resulting in the same 64-bit hash are practically impossible, but would cause the newer value to not be sent, which is corrected by the next full resync.
+/// Every value is only hashed once per sent message, the hash is cached until @ref Begin_Report is called for the next message. The first value of every key is always sent, as well as every value once the tracker has been reset.
+/// Is passed to @ref ThingsBoardSized::Set_Attribute_Filter, which resets the tracker once a new session with the MQTT broker has been established or a message published with QoS 1 was dropped,
+/// so that the complete set of attributes is sent again (full resync). Calling @ref Reset manually allows to periodically resync as well
+#if THINGSBOARD_ENABLE_DYNAMIC
+class Attribute_Change_Tracker : public IReport_Filter {
+#else
+/// @tparam MaxKeyAmount Maximum amount of keys whose last sent value can be tracked, values of further keys are always sent.
+/// Once the maximum amount has been reached it is not possible to increase the size, this is done because it allows to allcoate the memory on the stack instead of the heap, default = DEFAULT_TRACKED_ATTRIBUTE_AMOUNT (8)
+template<size_t MaxKeyAmount = DEFAULT_TRACKED_ATTRIBUTE_AMOUNT>
+class Attribute_Change_Tracker : public IReport_Filter {
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+    /// @brief Copy of a single key, the hash of the value that was last sent for it and the hash of the value in the message that is currently built
+    struct Key_State {
+        char            *key;              // Copy of the key, allocated when the key is first sent and freed once the tracker is reset
+        uint64_t        value_hash;        // FNV-1a hash of the key-value pair that was last sent, serialized as json
+        uint64_t        pending_hash;      // FNV-1a hash of the key-value pair in the message that is currently built, only valid if pending_report is the current report
+        Telemetry const *pending_data;     // Non owning pointer to the key-value pair pending_hash was calculated for, is only compared and never dereferenced
+        uint32_t        pending_report;    // Report the pending hash was calculated in, compared against the amount of calls to Begin_Report
+    };
+
+#if THINGSBOARD_ENABLE_DYNAMIC
+    using State_Container = Container<Key_State>;
+#else
+    using State_Container = Container<Key_State, MaxKeyAmount>;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+
+  public:
+    /// @brief Constructs a tracker without any sent values, that sends every key-value pair once
+    Attribute_Change_Tracker() = default;
+
+    /// @brief Deleted copy constructor
+    /// @note Copying the tracker would require copying the keys, simply copying the pointers to them would free them twice instead. Therefore copying is disabled alltogether
+    /// @param other Other instance we disallow copying from
+    Attribute_Change_Tracker(Attribute_Change_Tracker const & other) = delete;
+
+    /// @brief Deleted copy assignment operator
+    /// @note Copying the tracker would require copying the keys, simply copying the pointers to them would free them twice instead. Therefore copying is disabled alltogether
+    /// @param other Other instance we disallow copying from
+    void operator=(Attribute_Change_Tracker const & other) = delete;
+
+    /// @brief Destructor, frees the copies of all tracked keys
+    ~Attribute_Change_Tracker() override {
+        Reset();
+    }
+
+    /// @brief Forgets the last sent value of every key, so that the next value of every key is sent again (full resync)
+    void Reset() override {
+        for (auto & state : m_key_states) {
+            delete[] state.key;
+        }
+        m_key_states.clear();
+    }
+
+    /// @brief Returns the amount of keys whose last sent value is currently tracked
+    /// @return Amount of tracked keys
+    size_t Get_Tracked_Amount() const {
+        return m_key_states.size();
+    }
+
+    void Begin_Report() override {
+        m_current_report++;
+    }
+
+    bool Is_Reportable(Telemetry const & data, uint32_t const & current_time) override {
+        Key_State * state = Find_State(data.GetKey());
+        return state == nullptr || state->value_hash != Get_Pending_Hash(*state, data);
+    }
+
+    void Reported(Telemetry const & data, uint32_t const & current_time) override {
+        char const * key = data.GetKey();
+        Key_State * state = Find_State(key);
+        if (state != nullptr) {
+            state->value_hash = Get_Pending_Hash(*state, data);
+            // Key-value pair might be changed in place before the next message is built, therefore the pending hash is not reused even if Begin_Report is never called
+            state->pending_data = nullptr;
+            return;
+        }
+#if !THINGSBOARD_ENABLE_DYNAMIC
+        // Further keys are not tracked and therefore always sent, instead of evicting keys that are already tracked
+        if (m_key_states.size() + 1U > m_key_states.capacity()) {
+            return;
+        }
+#endif // !THINGSBOARD_ENABLE_DYNAMIC
+        size_t const key_size = key != nullptr ? strlen(key) : 0U;
+        Key_State new_state = {};
+        new_state.key = new char[key_size + 1U];
+        if (new_state.key == nullptr) {
+            return;
+        }
+        (void)memcpy(new_state.key, key != nullptr ? key : "", key_size + 1U);
+        new_state.value_hash = Hash_Value(data);
+        m_key_states.push_back(new_state);
+    }
+
+  private:
+    /// @brief Returns the state of the given key
+    /// @param key Non owning pointer to the key, nullptr is treated the same as an empty key
+    /// @return Non owning pointer to the state of the key or nullptr if no value has been sent for the key yet
+    Key_State * Find_State(char const * key) {
+        key = key != nullptr ? key : "";
+        for (auto & state : m_key_states) {
+            if (strcmp(state.key, key) == 0) {
+                return &state;
+            }
+        }
+        return nullptr;
+    }
+
+    /// @brief Returns the hash of the given key-value pair, which is only calculated the first time it is requested in the message that is currently built
+    /// @param state State of the key of the given key-value pair
+    /// @param data Key-value pair that should be hashed
+    /// @return FNV-1a hash of the serialized key-value pair
+    uint64_t const & Get_Pending_Hash(Key_State & state, Telemetry const & data) {
+        if (state.pending_report != m_current_report || state.pending_data != &data) {
+            state.pending_hash = Hash_Value(data);
+            state.pending_data = &data;
+            state.pending_report = m_current_report;
+        }
+        return state.pending_hash;
+    }
+
+    /// @brief Calculates the FNV-1a hash of the given key-value pair serialized as json, without requiring any memory for the serialized bytes
+    /// @param data Key-value pair that should be hashed
+    /// @return FNV-1a hash of the serialized key-value pair
+    static uint64_t Hash_Value(Telemetry const & data) {
+        Hash_Writer writer;
+        (void)data.SerializeJson(writer);
+        return writer.hash();
+    }
+
+    State_Container m_key_states = {};   // Copy of every key and the hash of the value that was last sent for it
+    uint32_t        m_current_report = {}; // Amount of calls to Begin_Report, pending hashes calculated with a different value are outdated
+};
+
+#endif // Attribute_Change_Tracker_h
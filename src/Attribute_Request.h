@@ -8,9 +8,15 @@
 
 
 // Attribute request API topics.
+#if THINGSBOARD_ENABLE_SHORT_TOPICS
+char constexpr ATTRIBUTE_REQUEST_TOPIC[] = "v2/a/req/%u";
+char constexpr ATTRIBUTE_RESPONSE_SUBSCRIBE_TOPIC[] = "v2/a/res/+";
+char constexpr ATTRIBUTE_RESPONSE_TOPIC[] = "v2/a/res/";
+#else
 char constexpr ATTRIBUTE_REQUEST_TOPIC[] = "v1/devices/me/attributes/request/%u";
 char constexpr ATTRIBUTE_RESPONSE_SUBSCRIBE_TOPIC[] = "v1/devices/me/attributes/response/+";
 char constexpr ATTRIBUTE_RESPONSE_TOPIC[] = "v1/devices/me/attributes/response/";
+#endif // THINGSBOARD_ENABLE_SHORT_TOPICS
 // Client side attribute request keys.
 char constexpr CLIENT_REQUEST_KEYS[] = "clientKeys";
 char constexpr CLIENT_RESPONSE_KEY[] = "client";
@@ -140,8 +146,53 @@ class Attribute_Request : public IAPI_Implementation {
         }
     }
 
-    bool Is_Response_Topic_Matching(char const * topic) const override {
-        return strncmp(ATTRIBUTE_RESPONSE_TOPIC, topic, strlen(ATTRIBUTE_RESPONSE_TOPIC)) == 0;
+    char const * Get_Response_Topic(bool & exact) const override {
+        exact = false;
+        return ATTRIBUTE_RESPONSE_TOPIC;
+    }
+
+    bool Add_Json_Filter(char const * topic, JsonDocument & filter) const override {
+        // Responses only contain the attributes requested with the same request id, therefore only the keys of that request are required
+        auto const request_id = Helper::Split_Topic_Into_Request_ID(topic, strlen(ATTRIBUTE_RESPONSE_TOPIC));
+        for (auto const & attribute_request : m_attribute_request_callbacks) {
+            if (attribute_request.Get_Request_ID() != request_id) {
+                continue;
+            }
+            char const * attribute_response_key = attribute_request.Get_Attribute_Key();
+            if (attribute_response_key == nullptr || attribute_request.Get_Attributes().empty()) {
+                return false;
+            }
+            for (auto const & att : attribute_request.Get_Attributes()) {
+                if (Helper::String_IsNull_Or_Empty(att)) {
+                    continue;
+                }
+                // Responses either contain the attributes nested inside of the attribute response key or directly, see Process_Json_Response
+                filter[attribute_response_key][att] = true;
+                filter[att] = true;
+            }
+        }
+        return true;
+    }
+
+    size_t Get_Json_Filter_Size(char const * topic) const override {
+        auto const request_id = Helper::Split_Topic_Into_Request_ID(topic, strlen(ATTRIBUTE_RESPONSE_TOPIC));
+        size_t size = 0U;
+        for (auto const & attribute_request : m_attribute_request_callbacks) {
+            if (attribute_request.Get_Request_ID() != request_id) {
+                continue;
+            }
+            else if (attribute_request.Get_Attribute_Key() == nullptr || attribute_request.Get_Attributes().empty()) {
+                return 0U;
+            }
+            // Attribute response key containing the nested attributes of the request
+            size++;
+            for (auto const & att : attribute_request.Get_Attributes()) {
+                if (!Helper::String_IsNull_Or_Empty(att)) {
+                    size += 2U;
+                }
+            }
+        }
+        return size;
     }
 
     bool Unsubscribe() override {
@@ -0,0 +1,92 @@
+#ifndef Buffered_Publish_Writer_h
+#define Buffered_Publish_Writer_h
+
+// Local includes.
+#include "IMQTT_Client.h"
+
+// Library includes.
+#include <string.h>
+
+
+/// @brief Write combining wrapper around the streaming publish methods of the IMQTT_Client interface, that can be passed directly to serializeJson as a custom writer.
+/// See https://arduinojson.org/v6/api/json/serializejson/ for more information on the requirements of a custom writer
+/// @note Serializing directly into the MQTT client would cause every single byte to be written one by one, which is very slow because most implementations directly send the written bytes over the network.
+/// Therefore the written bytes are first combined in the given buffer and only written into the MQTT client, once the buffer is full or the end of the payload has been reached, which has to be signaled by calling flush().
+/// Chunks that are bigger than the given buffer are directly written into the MQTT client instead, because combining them would not reduce the amount of calls.
+/// The buffer is not owned by this class, this allows to reuse any buffer that is currently not needed, like the internal send buffer of the ThingsBoard client, instead of allocating additional memory
+class Buffered_Publish_Writer {
+  public:
+    /// @brief Constructs the wrapper around the given MQTT client, that combines all written bytes in the given buffer
+    /// @note Expects begin_publish() to already have been called on the given client and end_publish() to be called once the complete payload has been written and flush() has been called
+    /// @param client MQTT Client implementation that the combined bytes should be written into
+    /// @param buffer Non owning pointer to the buffer the written bytes are combined in, has to be kept alive for as long as this instance is used.
+    /// If it is a nullptr then all bytes are directly written into the client instead
+    /// @param buffer_size Size of the given buffer in bytes
+    Buffered_Publish_Writer(IMQTT_Client & client, uint8_t * buffer, size_t const & buffer_size)
+      : m_client(client)
+      , m_buffer(buffer)
+      , m_buffer_size(buffer != nullptr ? buffer_size : 0U)
+      , m_buffered_size(0U)
+      , m_write_failed(false)
+    {
+        // Nothing to do
+    }
+
+    /// @brief Writes the given single byte into the internal buffer and writes the complete buffer into the MQTT client if it is full
+    /// @param payload_byte Byte containing part of the payload that should be sent
+    /// @return The amount of bytes successfully written, 0 if writing the buffered bytes into the MQTT client failed
+    size_t write(uint8_t payload_byte) {
+        return write(&payload_byte, 1U);
+    }
+
+    /// @brief Writes the given bytes into the internal buffer and writes the complete buffer into the MQTT client if it is full
+    /// @param buffer Non owning pointer to a buffer containing part of the payload that should be sent.
+    /// Does not need to kept alive as the function copies the bytes into the internal buffer or directly into the MQTT client
+    /// @param size Amount of bytes contained in the buffer that should be sent
+    /// @return The amount of bytes successfully written, 0 if writing the buffered bytes into the MQTT client failed
+    size_t write(uint8_t const * buffer, size_t const & size) {
+        if (m_write_failed) {
+            return 0U;
+        }
+        // Chunks that do not fit into the remaining space are not split, instead the buffer is written and the chunk is then either buffered or if it is bigger than the buffer itself directly written as well
+        if (m_buffered_size + size > m_buffer_size && !flush()) {
+            return 0U;
+        }
+        if (size >= m_buffer_size) {
+            return write_to_client(buffer, size) ? size : 0U;
+        }
+        (void)memcpy(m_buffer + m_buffered_size, buffer, size);
+        m_buffered_size += size;
+        return size;
+    }
+
+    /// @brief Writes all bytes that are still contained in the internal buffer into the MQTT client
+    /// @note Has to be called once the complete payload has been written, before calling end_publish() on the MQTT client
+    /// @return Whether writing the remaining bytes into the MQTT client was successful or not
+    bool flush() {
+        if (m_write_failed) {
+            return false;
+        }
+        size_t const buffered_size = m_buffered_size;
+        m_buffered_size = 0U;
+        return buffered_size == 0U || write_to_client(m_buffer, buffered_size);
+    }
+
+  private:
+    /// @brief Writes the given bytes directly into the MQTT client and remembers if that failed, to skip writing any following bytes
+    /// @param buffer Non owning pointer to a buffer containing part of the payload that should be sent
+    /// @param size Amount of bytes contained in the buffer that should be sent
+    /// @return Whether all bytes were written successfully or not
+    bool write_to_client(uint8_t const * buffer, size_t const & size) {
+        m_write_failed = m_client.write(buffer, size) != size;
+        return !m_write_failed;
+    }
+
+    IMQTT_Client & m_client;             // MQTT client instance the combined bytes are written into
+    uint8_t        *m_buffer = {};       // Non owning pointer to the buffer the written bytes are combined in
+    size_t         m_buffer_size = {};   // Size of the buffer the written bytes are combined in
+    size_t         m_buffered_size = {}; // Amount of bytes currently contained in the buffer, that still need to be written into the MQTT client
+    bool           m_write_failed = {};  // Whether writing into the MQTT client failed, if it did all following bytes are discarded, because the payload would be incomplete anyway
+};
+
+#endif // Buffered_Publish_Writer_h
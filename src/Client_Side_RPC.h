@@ -7,9 +7,15 @@
 
 
 // client-side RPC topics.
+#if THINGSBOARD_ENABLE_SHORT_TOPICS
+char constexpr RPC_RESPONSE_SUBSCRIBE_TOPIC[] = "v2/r/res/+";
+char constexpr RPC_RESPONSE_TOPIC[] = "v2/r/res/";
+char constexpr RPC_SEND_REQUEST_TOPIC[] = "v2/r/req/%u";
+#else
 char constexpr RPC_RESPONSE_SUBSCRIBE_TOPIC[] = "v1/devices/me/rpc/response/+";
 char constexpr RPC_RESPONSE_TOPIC[] = "v1/devices/me/rpc/response/";
 char constexpr RPC_SEND_REQUEST_TOPIC[] = "v1/devices/me/rpc/request/%u";
+#endif // THINGSBOARD_ENABLE_SHORT_TOPICS
 // Log messages.
 char constexpr CLIENT_RPC_METHOD_NULL[] = "Client-side RPC method name is NULL";
 #if !THINGSBOARD_ENABLE_DYNAMIC
@@ -151,8 +157,9 @@ class Client_Side_RPC : public IAPI_Implementation {
         }
     }
 
-    bool Is_Response_Topic_Matching(char const * topic) const override {
-        return strncmp(RPC_RESPONSE_TOPIC, topic, strlen(RPC_RESPONSE_TOPIC)) == 0;
+    char const * Get_Response_Topic(bool & exact) const override {
+        exact = false;
+        return RPC_RESPONSE_TOPIC;
     }
 
     bool Unsubscribe() override {
@@ -0,0 +1,170 @@
+#ifndef Concurrent_Publish_Queue_h
+#define Concurrent_Publish_Queue_h
+
+// Local includes.
+#include "Configuration.h"
+
+#if THINGSBOARD_ENABLE_CONCURRENT_PUBLISH
+
+// Library includes.
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+
+/// @brief Bounded lock-free queue of serialized telemetry and attribute payloads, that can be filled by any amount of threads at once (producers) and is emptied by a single thread (consumer)
+/// @note Based on the bounded queue by Dmitry Vyukov, where every slot contains a sequence number that tells producers and the consumer whether the slot is currently free or filled.
+/// Producers reserve a slot with a single compare and swap on the enqueue position and then serialize their payload directly into the memory of that slot, meaning producers never wait on each other while serializing or on the consumer while it is publishing.
+/// The consumer only reads its own dequeue position, meaning it never has to wait on the producers either, a slot that has been reserved but not yet completely written simply ends the current drain.
+/// All slots and their memory are allocated once with @ref Allocate and reused afterwards, meaning posting a payload does not require any heap allocation.
+/// Neither @ref Allocate nor @ref Free are thread-safe, they have to be called before any producer is started or after all producers have been stopped
+class Concurrent_Publish_Queue {
+  public:
+    /// @brief Constructs an empty queue, that can not hold any payload until @ref Allocate has been called
+    Concurrent_Publish_Queue() = default;
+
+    /// @brief Destructor, frees the slots and their memory
+    ~Concurrent_Publish_Queue() {
+        Free();
+    }
+
+    /// @brief Allocates the slots and their memory, any already posted payloads are discarded
+    /// @param slot_amount Maximum amount of payloads that can be posted at once without being consumed, is rounded up to the next power of two so the position can be wrapped with a bit mask
+    /// @param slot_size Maximum size of a single serialized payload in bytes, bigger payloads can not be posted
+    /// @return Whether allocating the slots was successful or not
+    bool Allocate(size_t const & slot_amount, size_t const & slot_size) {
+        Free();
+        if (slot_amount == 0U || slot_size == 0U) {
+            return true;
+        }
+        size_t amount = 1U;
+        while (amount < slot_amount) {
+            amount <<= 1U;
+        }
+        m_slots = new Slot[amount]();
+        m_payloads = new char[amount * (slot_size + 1U)]();
+        if (m_slots == nullptr || m_payloads == nullptr) {
+            Free();
+            return false;
+        }
+        for (size_t i = 0U; i < amount; i++) {
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        m_mask = amount - 1U;
+        m_slot_size = slot_size;
+        m_enqueue_position.store(0U, std::memory_order_relaxed);
+        m_dequeue_position = 0U;
+        return true;
+    }
+
+    /// @brief Frees the slots and their memory and therefore discards all posted payloads
+    void Free() {
+        delete[] m_slots;
+        m_slots = nullptr;
+        delete[] m_payloads;
+        m_payloads = nullptr;
+        m_mask = 0U;
+        m_slot_size = 0U;
+    }
+
+    /// @brief Whether the slots have been allocated
+    /// @return Whether payloads can be posted
+    bool Is_Allocated() const {
+        return m_slots != nullptr;
+    }
+
+    /// @brief Reserves a free slot, lets the given serializer write the payload directly into it and then hands the slot to the consumer, can be called from any thread
+    /// @note If the serializer fails or writes more bytes than fit into the slot, the slot is still handed to the consumer, because later slots might already have been reserved by other producers,
+    /// but it is marked as empty so the consumer simply skips it
+    /// @tparam Serializer Callable that writes the payload into the given buffer with the given size and returns the total amount of bytes it wanted to write, 0 if serializing failed
+    /// @param telemetry Whether the payload contains telemetry or attribute data
+    /// @param data_point_amount Amount of telemetry data points contained in the payload
+    /// @param serializer Callable writing the payload
+    /// @return Whether the payload has been posted, fails if all slots are currently used or the payload did not fit into a slot
+    template<typename Serializer>
+    bool push(bool telemetry, size_t const & data_point_amount, Serializer serializer) {
+        if (m_slots == nullptr) {
+            return false;
+        }
+        size_t position = m_enqueue_position.load(std::memory_order_relaxed);
+        Slot * slot = nullptr;
+        for (;;) {
+            slot = &m_slots[position & m_mask];
+            size_t const sequence = slot->sequence.load(std::memory_order_acquire);
+            intptr_t const difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (difference == 0) {
+                // Updates position to the current enqueue position if another producer reserved the slot first
+                if (m_enqueue_position.compare_exchange_weak(position, position + 1U, std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+            else if (difference < 0) {
+                // Slot still contains the payload of the previous round, that has not been consumed yet
+                return false;
+            }
+            else {
+                position = m_enqueue_position.load(std::memory_order_relaxed);
+            }
+        }
+
+        char * payload = Get_Payload(position);
+        size_t const payload_size = serializer(payload, m_slot_size);
+        bool const result = payload_size != 0U && payload_size <= m_slot_size;
+        payload[result ? payload_size : 0U] = '\0';
+        slot->telemetry = telemetry;
+        slot->payload_size = result ? payload_size : 0U;
+        slot->data_point_amount = data_point_amount;
+        slot->sequence.store(position + 1U, std::memory_order_release);
+        return result;
+    }
+
+    /// @brief Passes the oldest completely written payload to the given consumer and frees its slot afterwards, has to always be called from the same thread
+    /// @note Slots that have been marked as empty by their producer, are freed without calling the consumer
+    /// @tparam Consumer Callable that receives whether the payload contains telemetry data, the null terminated payload, its size and the amount of data points contained in it
+    /// @param consumer Callable handling the payload, the payload is only valid for the duration of the call
+    /// @return Whether a slot has been freed, false if the oldest slot has not been completely written yet or there are no posted payloads
+    template<typename Consumer>
+    bool pop(Consumer consumer) {
+        if (m_slots == nullptr) {
+            return false;
+        }
+        Slot & slot = m_slots[m_dequeue_position & m_mask];
+        if (slot.sequence.load(std::memory_order_acquire) != m_dequeue_position + 1U) {
+            return false;
+        }
+        if (slot.payload_size != 0U) {
+            consumer(slot.telemetry, static_cast<char const *>(Get_Payload(m_dequeue_position)), slot.payload_size, slot.data_point_amount);
+        }
+        // Marks the slot as free for the producer that reaches the same slot in the next round
+        slot.sequence.store(m_dequeue_position + m_mask + 1U, std::memory_order_release);
+        m_dequeue_position++;
+        return true;
+    }
+
+  private:
+    /// @brief Single slot of the queue, the payload itself is stored in a seperate continuous buffer, so that all slots can be allocated with a single allocation independent of the payload size
+    struct Slot {
+        std::atomic<size_t> sequence;          // Equal to the position if the slot is free for the producer at that position, or the position + 1 if the slot has been written and can be consumed
+        bool                telemetry;         // Whether the payload contains telemetry or attribute data
+        size_t              payload_size;      // Size of the payload without the null terminator, 0 if the producer failed to serialize it
+        size_t              data_point_amount; // Amount of telemetry data points contained in the payload
+    };
+
+    /// @brief Returns the memory of the slot at the given position
+    /// @param position Position the slot is used for
+    /// @return Non owning pointer to the memory the payload is written into, can hold the slot size plus the null terminator
+    char * Get_Payload(size_t const & position) const {
+        return m_payloads + (position & m_mask) * (m_slot_size + 1U);
+    }
+
+    Slot                *m_slots = {};             // Slots of the queue, the amount is always a power of two
+    char                *m_payloads = {};          // Memory all payloads are serialized into, contains the slot size plus the null terminator for every slot
+    size_t              m_mask = {};               // Amount of slots - 1, used to wrap a position into the index of its slot
+    size_t              m_slot_size = {};          // Maximum size of a single serialized payload in bytes
+    std::atomic<size_t> m_enqueue_position = {};   // Position the next producer reserves, shared between all producers
+    size_t              m_dequeue_position = {};   // Position the consumer reads next, only ever accessed by the consumer
+};
+
+#endif // THINGSBOARD_ENABLE_CONCURRENT_PUBLISH
+
+#endif // Concurrent_Publish_Queue_h
@@ -55,6 +55,34 @@
 #    endif
 #  endif
 
+// Enables the lock-free multi-producer publish queue, which allows to post telemetry and attribute data from multiple threads or FreeRTOS tasks, as long as the atomic header exists.
+// Requires the C++ STL library, because std::atomic is used to coordinate the producers without a mutex.
+#  ifndef THINGSBOARD_ENABLE_CONCURRENT_PUBLISH
+#    ifdef __has_include
+#      if THINGSBOARD_ENABLE_STL && __has_include(<atomic>)
+#        define THINGSBOARD_ENABLE_CONCURRENT_PUBLISH 1
+#      else
+#        define THINGSBOARD_ENABLE_CONCURRENT_PUBLISH 0
+#      endif
+#    else
+#      define THINGSBOARD_ENABLE_CONCURRENT_PUBLISH 0
+#    endif
+#  endif
+
+// Enables handing over state that is changed in the callbacks of the MQTT client to the task calling loop() with std::atomic, as long as the atomic header exists.
+// Required because the Espressif_MQTT_Client calls the callbacks from its own task, whereas the Arduino_MQTT_Client calls them from loop() and therefore from the same task that publishes messages.
+#  ifndef THINGSBOARD_ENABLE_ATOMIC
+#    ifdef __has_include
+#      if THINGSBOARD_ENABLE_STL && __has_include(<atomic>)
+#        define THINGSBOARD_ENABLE_ATOMIC 1
+#      else
+#        define THINGSBOARD_ENABLE_ATOMIC 0
+#      endif
+#    else
+#      define THINGSBOARD_ENABLE_ATOMIC 0
+#    endif
+#  endif
+
 // Use the esp_timer header internally for handling timeouts and callbacks, as long as the header exists, because it is more efficient than the Arduino Ticker implementation.
 // That is because we can stop the timer without having to delete it, removing the need to create a new timer to restart it, instead it can simply be stopped and started again.
 // Only exists following major version 3 minor version 0 on ESP32 (https://github.com/espressif/esp-idf/releases/tag/v3.0-rc1)and major version 3 minor version 1 on ESP8266 (https://github.com/espressif/ESP8266_RTOS_SDK/releases/tag/v3.1-rc1)
@@ -134,14 +162,19 @@
 #    define THINGSBOARD_ENABLE_DEBUG CONFIG_THINGSBOARD_ENABLE_DEBUG
 #  endif
 
-// Use the StreamUtils header internally for enabling the usage of an additonal library as a fallback, as long as the header exists,
-// to allow to directly serialize a json message that is sent to the cloud, if the size of that message would be bigger than the internal buffer size of the client.
-// Allows sending much bigger messages than would otherwise be possible, and without the need to increase stack or heap requirements, but at the cost of increased send times.
-// See https://arduinojson.org/v6/how-to/use-arduinojson-with-pubsubclient/#serializing-a-json-document-into-an-mqtt-message for the main difference in the underlying code.
-// Option can only be enabled when using Arduino, because this feature relies on Arduino as it improves the underlying data streams to directly write the data into the MQTT Client,
-// but writing each byte one by one, would be too slow, therefore the ArduinoStreamUtils (https://github.com/bblanchon/ArduinoStreamUtils) library is used to buffer those calls into bigger packets.
-// This allows sending data that is very big without requiring to allocate that much memory, because it is sent in smaller packets.
-// To support this feature, however the IMQTT_Client interface implementation, needs to additionally override the Print interface, because that is required by the wrapper class BufferingPrint.
+// Enables the ThingsBoard class to use the short (v2) form of the telemetry, attribute, attribute request and RPC topics, for example v2/t instead of v1/devices/me/telemetry.
+// Both forms are handled identically by the ThingsBoard server, but the short form reduces the size of every sent and received message, which is especially noticeable for small payloads.
+// Requires the ThingsBoard server to support the short topics. The claiming, provisioning and firmware topics do not have a short form and are therefore not affected.
+// Can also optionally be configured via the ESP-IDF menuconfig, if that is the done the value is set to the value entered in the menuconfig,
+// if the value is manually overriden tough with a #define before including ThingsBoard then the hardcoded value takes precendence.
+#  ifndef THINGSBOARD_ENABLE_SHORT_TOPICS
+#    define THINGSBOARD_ENABLE_SHORT_TOPICS CONFIG_THINGSBOARD_ENABLE_SHORT_TOPICS
+#  endif
+
+// Previously enabled the usage of the StreamUtils library as a fallback to send messages bigger than the internal buffer size of the client, which is now always supported without additional libraries.
+// Is still enabled by default if the StreamUtils header exists, but now only keeps the previous signature of the ThingsBoard constructor with the buffering_size argument between the max_stack_size and max_response_size argument.
+// The argument is ignored and the constructor is marked as deprecated, this ensures that previous constructor calls still forward every argument to the correct parameter and cause a warning,
+// instead of silently passing the buffering_size as the max_response_size or as the first API implementation. Set to 0 to use the constructor without the buffering_size argument.
 #  ifndef THINGSBOARD_ENABLE_STREAM_UTILS
 #    ifdef __has_include
 #      if __has_include(<StreamUtils.h>)
@@ -170,4 +203,21 @@
 #    endif
 #  endif
 
+// Selects how the internal json serializer formats floating point values, which is used for all key-value pairs that are serialized without a JsonDocument (Send_Telemetry, Send_Attributes, ...).
+// THINGSBOARD_REAL_FORMAT_COMPATIBLE writes up to 9 significant digits split between the integral and decimal part (123.1234568) with the same thresholds and rounding as ArduinoJson,
+// meaning the messages are identical to the ones serialized with a JsonDocument, as long as ArduinoJson stores floating point values as double (ARDUINOJSON_USE_DOUBLE, the default on all 32-bit platforms).
+// THINGSBOARD_REAL_FORMAT_SHORTEST writes the shortest representation that is still parsed back into the exact same value (Grisu2), which does not lose precision, only uses integer arithmetic and additionally writes floats with their own precision (0.1 instead of 0.100000001).
+// THINGSBOARD_REAL_FORMAT_FIXED rounds to THINGSBOARD_REAL_FIXED_DECIMAL_PLACES decimal places and removes trailing zeros, which is the fastest option and keeps messages small, if the sensor does not provide more precision anyway.
+#  define THINGSBOARD_REAL_FORMAT_COMPATIBLE 0
+#  define THINGSBOARD_REAL_FORMAT_SHORTEST 1
+#  define THINGSBOARD_REAL_FORMAT_FIXED 2
+#  ifndef THINGSBOARD_REAL_FORMAT
+#    define THINGSBOARD_REAL_FORMAT THINGSBOARD_REAL_FORMAT_COMPATIBLE
+#  endif
+
+// Amount of decimal places floating point values are rounded to if THINGSBOARD_REAL_FORMAT is set to THINGSBOARD_REAL_FORMAT_FIXED, at most 9 decimal places are supported.
+#  ifndef THINGSBOARD_REAL_FIXED_DECIMAL_PLACES
+#    define THINGSBOARD_REAL_FIXED_DECIMAL_PLACES 3
+#  endif
+
 #endif // Configuration_h
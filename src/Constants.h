@@ -15,10 +15,14 @@ uint8_t constexpr DEFAULT_ENDPOINT_AMOUNT = 7U;
 uint8_t constexpr DEFAULT_RESPONSE_AMOUNT = 8U;
 uint8_t constexpr DEFAULT_SUBSCRIPTION_AMOUNT = 1U;
 uint8_t constexpr DEFAULT_ATTRIBUTES_AMOUNT = 1U;
+uint8_t constexpr DEFAULT_DEADBAND_RULE_AMOUNT = 4U;
+uint8_t constexpr DEFAULT_TRACKED_ATTRIBUTE_AMOUNT = 8U;
 uint8_t constexpr DEFAULT_RPC_AMOUNT = 0U;
 uint8_t constexpr DEFAULT_REQUEST_RPC_AMOUNT = 2U;
+uint8_t constexpr DEFAULT_FILTER_KEY_AMOUNT = 2U * DEFAULT_SUBSCRIPTION_AMOUNT * DEFAULT_ATTRIBUTES_AMOUNT + 1U;
 uint8_t constexpr DEFAULT_PAYLOAD_SIZE = 64U;
 uint16_t constexpr DEFAULT_MAX_STACK_SIZE = 1024U;
+uint8_t constexpr DEFAULT_IN_FLIGHT_WINDOW = 4U;
 #if THINGSBOARD_ENABLE_STREAM_UTILS
 uint8_t constexpr DEFAULT_BUFFERING_SIZE = 64U;
 #endif // THINGSBOARD_ENABLE_STREAM_UTILS
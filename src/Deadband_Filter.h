@@ -0,0 +1,194 @@
+#ifndef Deadband_Filter_h
+#define Deadband_Filter_h
+
+// Local includes.
+#include "Callback.h"
+#include "Constants.h"
+#include "DefaultLogger.h"
+#include "Helper.h"
+#include "IReport_Filter.h"
+
+// Library include.
+#include <math.h>
+
+
+// Log messages.
+#if !THINGSBOARD_ENABLE_DYNAMIC
+char constexpr MAX_DEADBAND_RULES_EXCEEDED[] = "Too many deadband rules, increase (MaxRuleAmount) (%u) accordingly";
+#endif // !THINGSBOARD_ENABLE_DYNAMIC
+
+
+/// @brief Reporting rule of a single key, used by the @ref Deadband_Filter
+/// @note Is an aggregate, meaning the rules can be declared as a constexpr array at compile time ({"temperature", 0.5, 0.0, 1000U, 60000U}, ...)
+struct Deadband_Rule {
+    char const *key;             // Non owning pointer to the key the rule applies to, has to be kept alive for as long as the filter is used
+    double     absolute;         // Minimum absolute difference to the last reported value, that a numeric value has to reach to be reported again, 0 disables the absolute deadband
+    double     relative;         // Minimum difference to the last reported value relative to its magnitude (0.05 for 5%), that a numeric value has to reach to be reported again, 0 disables the relative deadband
+    uint32_t   min_interval_ms;  // Minimum amount of milliseconds between two reports of the key, even if the value changed more than the deadband inbetween, 0 disables the minimum interval
+    uint32_t   max_interval_ms;  // Maximum amount of milliseconds the key stays silent, after which the value is reported again even if it did not change (heartbeat), 0 disables the heartbeat
+};
+
+
+/// @brief Report-by-exception filter, that drops key-value pairs whose value did not change enough since it was last reported
+/// @note Every key with a rule remembers the last reported value and the time it was reported at. A numeric value is reported again once it differs from the last reported value
+/// by at least the absolute or the relative deadband, if both are disabled any change is reported. Boolean values are reported once they change,
+/// string values are always reported, because they can not be compared without copying them. Independent of the value, a key is never reported more often than the minimum interval
+/// and is always reported again once the maximum interval has passed. Keys without a rule, as well as the first value of every key, are always reported.
+/// Is passed to @ref ThingsBoardSized::Set_Telemetry_Filter or @ref ThingsBoardSized::Set_Attribute_Filter
+/// @tparam Logger Implementation that should be used to print error messages generated by internal processes and additional debugging messages if THINGSBOARD_ENABLE_DEBUG is set, default = DefaultLogger
+#if THINGSBOARD_ENABLE_DYNAMIC
+template <typename Logger = DefaultLogger>
+#else
+/// @tparam MaxRuleAmount Maximum amount of keys that can have a rule.
+/// Once the maximum amount has been reached it is not possible to increase the size, this is done because it allows to allcoate the memory on the stack instead of the heap, default = DEFAULT_DEADBAND_RULE_AMOUNT (4)
+template<size_t MaxRuleAmount = DEFAULT_DEADBAND_RULE_AMOUNT, typename Logger = DefaultLogger>
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+class Deadband_Filter : public IReport_Filter {
+    /// @brief Rule of a single key and the last value that was reported for it
+    struct Key_State {
+        Deadband_Rule rule;        // Reporting rule of the key
+        bool          reported;    // Whether the key has been reported at least once
+        uint32_t      last_time;   // Time in milliseconds the key was last reported at
+        double        last_value;  // Last reported numeric value of the key, booleans are stored as 0 and 1
+    };
+
+#if THINGSBOARD_ENABLE_DYNAMIC
+    using State_Container = Container<Key_State>;
+#else
+    using State_Container = Container<Key_State, MaxRuleAmount>;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+
+  public:
+    /// @brief Constructs a filter without any rules, that reports every key-value pair
+    Deadband_Filter() = default;
+
+    ~Deadband_Filter() override = default;
+
+    /// @brief Adds the given rules or replaces the rules for keys that already have one, the last reported values of replaced keys are kept
+    /// @tparam InputIterator Class that allows for forward incrementable access to data
+    /// of the given data container, allows for using / passing either std::vector or std::array.
+    /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
+    /// @param first Iterator pointing to the first element in the data container
+    /// @param last Iterator pointing to the end of the data container (last element + 1)
+    /// @return Whether setting all given rules was successful or not
+    template<typename InputIterator>
+    bool Set_Rules(InputIterator const & first, InputIterator const & last) {
+        for (auto it = first; it != last; ++it) {
+            if (!Set_Rule(*it)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// @brief Adds the given rule or replaces the rule for the key if it already has one, the last reported value of a replaced key is kept
+    /// @param rule Reporting rule of a single key
+    /// @return Whether setting the rule was successful or not
+    bool Set_Rule(Deadband_Rule const & rule) {
+        if (Helper::String_IsNull_Or_Empty(rule.key)) {
+            return false;
+        }
+        Key_State * state = Find_State(rule.key);
+        if (state != nullptr) {
+            state->rule = rule;
+            return true;
+        }
+#if !THINGSBOARD_ENABLE_DYNAMIC
+        if (m_key_states.size() + 1U > m_key_states.capacity()) {
+            Logger::printfln(MAX_DEADBAND_RULES_EXCEEDED, MaxRuleAmount);
+            return false;
+        }
+#endif // !THINGSBOARD_ENABLE_DYNAMIC
+        Key_State new_state = {};
+        new_state.rule = rule;
+        m_key_states.push_back(new_state);
+        return true;
+    }
+
+    /// @brief Forgets the last reported value of every key, so that the next value of every key is reported, for example to send a complete snapshot after reconnecting
+    void Reset() override {
+        for (auto & state : m_key_states) {
+            state.reported = false;
+        }
+    }
+
+    bool Is_Reportable(Telemetry const & data, uint32_t const & current_time) override {
+        Key_State const * state = Find_State(data.GetKey());
+        if (state == nullptr || !state->reported) {
+            return true;
+        }
+        // Unsigned subtraction handles the overflow of the milliseconds correctly
+        uint32_t const elapsed = current_time - state->last_time;
+        if (state->rule.min_interval_ms != 0U && elapsed < state->rule.min_interval_ms) {
+            return false;
+        }
+        else if (state->rule.max_interval_ms != 0U && elapsed >= state->rule.max_interval_ms) {
+            return true;
+        }
+
+        double value = 0.0;
+        bool boolean = false;
+        if (!Get_Numeric_Value(data, value)) {
+            return true;
+        }
+        double const difference = fabs(value - state->last_value);
+        bool const absolute_enabled = state->rule.absolute > 0.0;
+        bool const relative_enabled = state->rule.relative > 0.0;
+        // Deadbands are meaningless for booleans, therefore they are reported on every change
+        if (data.GetBoolean(boolean) || (!absolute_enabled && !relative_enabled)) {
+            return difference != 0.0;
+        }
+        return (absolute_enabled && difference >= state->rule.absolute) || (relative_enabled && difference != 0.0 && difference >= state->rule.relative * fabs(state->last_value));
+    }
+
+    void Reported(Telemetry const & data, uint32_t const & current_time) override {
+        Key_State * state = Find_State(data.GetKey());
+        if (state == nullptr) {
+            return;
+        }
+        state->reported = true;
+        state->last_time = current_time;
+        (void)Get_Numeric_Value(data, state->last_value);
+    }
+
+  private:
+    /// @brief Returns the state of the given key
+    /// @param key Non owning pointer to the key
+    /// @return Non owning pointer to the state of the key or nullptr if the key does not have a rule
+    Key_State * Find_State(char const * key) {
+        if (key == nullptr) {
+            return nullptr;
+        }
+        for (auto & state : m_key_states) {
+            if (strcmp(state.rule.key, key) == 0) {
+                return &state;
+            }
+        }
+        return nullptr;
+    }
+
+    /// @brief Converts the value of the given key-value pair into a double, so that it can be compared with the deadbands
+    /// @param data Key-value pair containing the value
+    /// @param value Set to the numeric value, booleans are converted to 0 and 1
+    /// @return Whether the key-value pair contained a numeric or boolean value, string values can not be converted
+    static bool Get_Numeric_Value(Telemetry const & data, double & value) {
+        int64_t integer = 0;
+        bool boolean = false;
+        if (data.GetReal(value)) {
+            return true;
+        }
+        else if (data.GetInteger(integer)) {
+            value = static_cast<double>(integer);
+            return true;
+        }
+        else if (data.GetBoolean(boolean)) {
+            value = boolean ? 1.0 : 0.0;
+            return true;
+        }
+        return false;
+    }
+
+    State_Container m_key_states = {}; // Rule and last reported value of every key that has a rule
+};
+
+#endif // Deadband_Filter_h
@@ -0,0 +1,151 @@
+#ifndef Delivery_Report_Queue_h
+#define Delivery_Report_Queue_h
+
+// Local includes.
+#include "Configuration.h"
+
+// Library includes.
+#if THINGSBOARD_ENABLE_ATOMIC
+#include <atomic>
+#endif // THINGSBOARD_ENABLE_ATOMIC
+#include <stddef.h>
+#include <stdint.h>
+
+
+/// @brief Bounded lock-free queue of delivery reports for messages published with QoS 1, that is filled by the task of the MQTT client (producer) and emptied by the task calling loop() (consumer)
+/// @note Every report consists of the packet id of the message and whether it has been confirmed by the broker or dropped by the client. The producer only ever writes the tail and the consumer only ever writes the head,
+/// meaning neither of them has to wait on the other and the in-flight window itself is only ever changed from the task calling loop(). One slot between the tail and the head is always kept free,
+/// to ensure they are only ever equal if the queue is empty. All slots are allocated once with @ref Allocate and reused afterwards, meaning pushing a report does not require any heap allocation.
+/// Neither @ref Allocate nor @ref Free are thread-safe, they have to be called while no message published with QoS 1 is waiting for its confirmation.
+/// If the atomic header does not exist, the positions are plain integers, which is only safe if the client calls its callbacks from loop() as well, like the @ref Arduino_MQTT_Client
+class Delivery_Report_Queue {
+  public:
+    /// @brief Constructs an empty queue, that can not hold any report until @ref Allocate has been called
+    Delivery_Report_Queue() = default;
+
+    /// @brief Deleted copy constructor
+    /// @note Copying the queue would require copying the allocated slots, simply copying the pointer to them would free them twice instead. Therefore copying is disabled alltogether
+    /// @param other Other instance we disallow copying from
+    Delivery_Report_Queue(Delivery_Report_Queue const & other) = delete;
+
+    /// @brief Deleted copy assignment operator
+    /// @note Copying the queue would require copying the allocated slots, simply copying the pointer to them would free them twice instead. Therefore copying is disabled alltogether
+    /// @param other Other instance we disallow copying from
+    void operator=(Delivery_Report_Queue const & other) = delete;
+
+    /// @brief Destructor, frees the slots holding the queued reports
+    ~Delivery_Report_Queue() {
+        Free();
+    }
+
+    /// @brief Allocates the slots holding the queued reports, any already queued reports are discarded
+    /// @param max_reports Maximum amount of reports that can be queued at once without being consumed
+    /// @return Whether allocating the slots was successful or not
+    bool Allocate(size_t const & max_reports) {
+        Free();
+        if (max_reports == 0U) {
+            return true;
+        }
+        m_reports = new Report[max_reports + 1U]();
+        if (m_reports == nullptr) {
+            return false;
+        }
+        m_slot_amount = max_reports + 1U;
+        return true;
+    }
+
+    /// @brief Frees the slots holding the queued reports and therefore discards all queued reports
+    void Free() {
+        delete[] m_reports;
+        m_reports = nullptr;
+        m_slot_amount = 0U;
+        m_head = 0U;
+        m_tail = 0U;
+    }
+
+    /// @brief Appends the given report to the end of the queue, has to always be called from the same task
+    /// @param packet_id Packet id of the message that has been confirmed or dropped
+    /// @param delivered Whether the message has been confirmed by the broker (true) or dropped by the client (false)
+    /// @return Whether the report was queued, fails if the queue has not been allocated or all slots are currently used
+    bool push(uint16_t packet_id, bool delivered) {
+        if (m_reports == nullptr) {
+            return false;
+        }
+#if THINGSBOARD_ENABLE_ATOMIC
+        size_t const tail = m_tail.load(std::memory_order_relaxed);
+        size_t const next = Get_Next_Position(tail);
+        if (next == m_head.load(std::memory_order_acquire)) {
+            return false;
+        }
+#else
+        size_t const tail = m_tail;
+        size_t const next = Get_Next_Position(tail);
+        if (next == m_head) {
+            return false;
+        }
+#endif // THINGSBOARD_ENABLE_ATOMIC
+        m_reports[tail].packet_id = packet_id;
+        m_reports[tail].delivered = delivered;
+#if THINGSBOARD_ENABLE_ATOMIC
+        m_tail.store(next, std::memory_order_release);
+#else
+        m_tail = next;
+#endif // THINGSBOARD_ENABLE_ATOMIC
+        return true;
+    }
+
+    /// @brief Removes the oldest report from the queue, has to always be called from the same task
+    /// @param packet_id Set to the packet id of the message that has been confirmed or dropped
+    /// @param delivered Set to whether the message has been confirmed by the broker (true) or dropped by the client (false)
+    /// @return Whether a report was removed, false if there are no queued reports
+    bool pop(uint16_t & packet_id, bool & delivered) {
+        if (m_reports == nullptr) {
+            return false;
+        }
+#if THINGSBOARD_ENABLE_ATOMIC
+        size_t const head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+#else
+        size_t const head = m_head;
+        if (head == m_tail) {
+            return false;
+        }
+#endif // THINGSBOARD_ENABLE_ATOMIC
+        packet_id = m_reports[head].packet_id;
+        delivered = m_reports[head].delivered;
+#if THINGSBOARD_ENABLE_ATOMIC
+        m_head.store(Get_Next_Position(head), std::memory_order_release);
+#else
+        m_head = Get_Next_Position(head);
+#endif // THINGSBOARD_ENABLE_ATOMIC
+        return true;
+    }
+
+  private:
+    /// @brief Single delivery report
+    struct Report {
+        uint16_t packet_id; // Packet id of the message that has been confirmed or dropped
+        bool     delivered; // Whether the message has been confirmed by the broker (true) or dropped by the client (false)
+    };
+
+    /// @brief Returns the position following the given position, wrapped around at the end of the slots
+    /// @param position Current position of the head or tail
+    /// @return Position of the next slot
+    size_t Get_Next_Position(size_t const & position) const {
+        return position + 1U == m_slot_amount ? 0U : position + 1U;
+    }
+
+    Report              *m_reports = {};     // Slots holding the queued reports, contains one more slot than the maximum amount of reports
+    size_t              m_slot_amount = {};  // Amount of elements in m_reports
+#if THINGSBOARD_ENABLE_ATOMIC
+    std::atomic<size_t> m_head = {};         // Position of the oldest queued report, only ever written by the consumer
+    std::atomic<size_t> m_tail = {};         // Position the next report is written to, only ever written by the producer
+#else
+    size_t              m_head = {};         // Position of the oldest queued report, only ever written by the consumer
+    size_t              m_tail = {};         // Position the next report is written to, only ever written by the producer
+#endif // THINGSBOARD_ENABLE_ATOMIC
+};
+
+#endif // Delivery_Report_Queue_h
@@ -12,6 +12,8 @@
 // Library includes.
 #include <mqtt_client.h>
 #include <esp_crt_bundle.h>
+#include <string.h>
+#include <new>
 
 // The error integer -1 means a general failure while handling the mqtt client,
 // where as -2 means that the outbox is filled and the message can therefore not be sent.
@@ -19,6 +21,11 @@
 // to ensure other errors are indentified as well
 constexpr int MQTT_FAILURE_MESSAGE_ID = -1;
 constexpr char MQTT_DATA_EXCEEDS_BUFFER[] = "Received amount of data (%u) is bigger than current buffer size (%u), increase accordingly";
+#ifdef CONFIG_MQTT_PROTOCOL_5
+// Maximum amount of topics a topic alias can be reserved for, the ThingsBoard client itself only reserves the telemetry and the attribute topic
+constexpr uint8_t MAX_TOPIC_ALIASES = 4U;
+constexpr char MQTT_5_REFUSED[] = "Broker refused MQTT 5 connection, falling back to MQTT 3.1.1";
+#endif // CONFIG_MQTT_PROTOCOL_5
 #if THINGSBOARD_ENABLE_DEBUG
 constexpr char RECEIVED_MQTT_EVENT[] = "Handling received mqtt event: (%s)";
 constexpr char UPDATING_CONFIGURATION[] = "Updated configuration after inital connection with response: (%s)";
@@ -39,6 +46,7 @@ class Espressif_MQTT_Client : public IMQTT_Client {
 
     ~Espressif_MQTT_Client() override {
         (void)esp_mqtt_client_destroy(m_mqtt_client);
+        free_stream_buffer();
     }
 
     /// @brief Deleted copy constructor
@@ -209,6 +217,25 @@ class Espressif_MQTT_Client : public IMQTT_Client {
         m_enqueue_messages = enqueue_messages;
     }
 
+    /// @brief Sets the maximum amount of topic aliases that should be used, where any value above 0 connects to the broker with MQTT 5 instead of MQTT 3.1.1. The default value is 0
+    /// @note Topic aliases replace the topic with a 2 byte alias in every message after the first one published on a topic reserved with @ref reserve_topic_alias, which saves bandwidth for small messages that are sent frequently.
+    /// Aliases are assigned in the order the topics were reserved in. If the broker accepts fewer aliases than configured, the first message that uses an alias above its limit is published again with the full topic
+    /// and every alias above that limit is not used anymore until the next connect, which resets the limit to the configured maximum again. Messages that fail for any other reason do not change the limit. If the broker does not support MQTT 5 at all and refuses the connection because of the protocol version, all following connection attempts fall back to MQTT 3.1.1.
+    /// Aliases are only used for messages published directly, because enqueued messages might only be sent after a reconnect, once the broker does not know the alias anymore.
+    /// For the same reason messages published with QoS 1 always contain the full topic together with the alias, because the ESP MQTT client keeps them in its outbox and resends them after a reconnect until the broker confirmed them.
+    /// Requires atleast Espressif IDF v5.0 with MQTT 5 support enabled in menuconfig (CONFIG_MQTT_PROTOCOL_5), otherwise only 0 is accepted
+    /// @param topic_alias_maximum Maximum amount of topic aliases, capped at MAX_TOPIC_ALIASES, 0 connects with MQTT 3.1.1 and disables topic aliases
+    /// @return Whether changing the protocol version and the amount of topic aliases was successful or not
+    bool set_topic_alias_maximum(uint16_t topic_alias_maximum) {
+#ifdef CONFIG_MQTT_PROTOCOL_5
+        m_topic_alias_maximum = topic_alias_maximum > MAX_TOPIC_ALIASES ? MAX_TOPIC_ALIASES : topic_alias_maximum;
+        m_mqtt_configuration.session.protocol_ver = m_topic_alias_maximum > 0U ? esp_mqtt_protocol_ver_t::MQTT_PROTOCOL_V_5 : esp_mqtt_protocol_ver_t::MQTT_PROTOCOL_V_3_1_1;
+        return update_configuration();
+#else
+        return topic_alias_maximum == 0U;
+#endif // CONFIG_MQTT_PROTOCOL_5
+    }
+
     void set_data_callback(Callback<void, char *, uint8_t *, unsigned int>::function callback) override {
         m_received_data_callback.Set_Callback(callback);
     }
@@ -290,18 +317,32 @@ class Espressif_MQTT_Client : public IMQTT_Client {
         int message_id = MQTT_FAILURE_MESSAGE_ID;
 
         if (m_enqueue_messages) {
-            message_id = esp_mqtt_client_enqueue(m_mqtt_client, topic, reinterpret_cast<const char*>(payload), length, 0U, 0U, true);
-            return message_id > MQTT_FAILURE_MESSAGE_ID;
+            message_id = esp_mqtt_client_enqueue(m_mqtt_client, topic, reinterpret_cast<const char*>(payload), length, static_cast<int>(m_publish_qos), 0U, true);
+            return update_last_packet_id(message_id);
         }
 
+#ifdef CONFIG_MQTT_PROTOCOL_5
+        uint16_t const topic_alias = get_topic_alias(topic);
+        if (topic_alias != 0U) {
+            message_id = publish_with_topic_alias(topic, topic_alias, payload, length);
+            if (message_id > MQTT_FAILURE_MESSAGE_ID) {
+                return update_last_packet_id(message_id);
+            }
+            // The publish property is only consumed by a successful publish, therefore it has to be reset to not send the alias with the following message as well
+            esp_mqtt5_publish_property_config_t const property = {};
+            (void)esp_mqtt5_client_set_publish_property(m_mqtt_client, &property);
+        }
+#endif // CONFIG_MQTT_PROTOCOL_5
+
         // The blocking version esp_mqtt_client_publish() is sent directly from the users task context.
         // This way to send messages to the cloud, has the advantage that no internal buffer has to be used to store the message until it should be sent,
-        // because all messages are sent with QoS level 0. If this is not wanted esp_mqtt_client_enqueue() could be used with store = true,
+        // as long as messages are sent with QoS level 0. Messages sent with QoS level 1 are additionally kept in the outbox until the broker confirmed them, so they can be resent after a reconnect.
+        // If sending from the users task context is not wanted esp_mqtt_client_enqueue() could be used with store = true,
         // to ensure the sending is done in the mqtt event context instead of the users task context.
         // Allows to use the publish method without having to worry about any CPU overhead, so it can even be used in callbacks or high priority tasks, without starving other tasks,
         // but compared to the other method esp_mqtt_client_enqueue() requires to save the message in the outbox, which increases the memory requirements for the internal buffer size
-        message_id = esp_mqtt_client_publish(m_mqtt_client, topic, reinterpret_cast<const char*>(payload), length, 0U, 0U);
-        return message_id > MQTT_FAILURE_MESSAGE_ID;
+        message_id = esp_mqtt_client_publish(m_mqtt_client, topic, reinterpret_cast<const char*>(payload), length, static_cast<int>(m_publish_qos), 0U);
+        return update_last_packet_id(message_id);
     }
 
     bool subscribe(char const * topic) override {
@@ -340,7 +381,175 @@ class Espressif_MQTT_Client : public IMQTT_Client {
         m_connection_state_changed_callback.Set_Callback(callback);
     }
 
+    /// @copydoc IMQTT_Client::begin_publish
+    /// @note The ESP MQTT client does not provide an API to write the payload of a single publish message incrementally, it instead handles fragmenting messages that are bigger than its internal buffer itself.
+    /// Therefore this implementation does not stream, instead the topic and the complete payload are copied into a temporary heap buffer of length + strlen(topic) + 1 bytes,
+    /// which is allocated for the duration of the streamed publish and is then published in end_publish() as one message.
+    /// Additionally the ESP MQTT client copies the message into its outbox as well for messages with QoS 1, meaning the peak heap usage is roughly twice the payload size.
+    /// Payloads that are bigger than the largest free contiguous heap block fail to publish with this client, even though they would fit into the internal buffer in chunks
+    bool begin_publish(char const * topic, size_t const & length) override {
+        free_stream_buffer();
+        size_t const topic_size = strlen(topic) + 1U;
+        m_stream_buffer = new (std::nothrow) uint8_t[length + topic_size];
+        if (m_stream_buffer == nullptr) {
+            return false;
+        }
+        (void)memcpy(m_stream_buffer + length, topic, topic_size);
+        m_stream_length = length;
+        return true;
+    }
+
+    bool end_publish() override {
+        bool const result = m_stream_buffer != nullptr && m_stream_written == m_stream_length && publish(reinterpret_cast<char const *>(m_stream_buffer + m_stream_length), m_stream_buffer, m_stream_length);
+        free_stream_buffer();
+        return result;
+    }
+
+    size_t write(uint8_t payload_byte) override {
+        return write(&payload_byte, 1U);
+    }
+
+    size_t write(uint8_t const * buffer, size_t const & size) override {
+        // Writing more bytes than announced in begin_publish() would overwrite the copied topic, therefore the bytes are discarded instead
+        if (m_stream_buffer == nullptr || m_stream_written + size > m_stream_length) {
+            return 0U;
+        }
+        (void)memcpy(m_stream_buffer + m_stream_written, buffer, size);
+        m_stream_written += size;
+        return size;
+    }
+
+    /// @copydoc IMQTT_Client::get_outbox_size
+    /// @note Messages are only stored in the outbox if enqueueing messages has been enabled with @ref set_enqueue_messages, because they are otherwise sent directly from the task calling publish().
+    /// The esp_mqtt_client_get_outbox_size method only exists following major version 4 minor version 4 (https://github.com/espressif/esp-idf/releases/tag/v4.4), on older versions 0 is always returned instead
+    size_t get_outbox_size() override {
+#if ESP_IDF_VERSION_MAJOR > 4 || (ESP_IDF_VERSION_MAJOR == 4 && ESP_IDF_VERSION_MINOR >= 4)
+        if (m_mqtt_client == nullptr) {
+            return 0U;
+        }
+        int const outbox_size = esp_mqtt_client_get_outbox_size(m_mqtt_client);
+        return outbox_size > 0 ? static_cast<size_t>(outbox_size) : 0U;
+#else
+        return 0U;
+#endif // ESP_IDF_VERSION_MAJOR > 4 || (ESP_IDF_VERSION_MAJOR == 4 && ESP_IDF_VERSION_MINOR >= 4)
+    }
+
+    /// @copydoc IMQTT_Client::reserve_topic_alias
+    /// @note Aliases are only used once a maximum has been configured with @ref set_topic_alias_maximum, therefore topics can be reserved before the client has been configured.
+    /// Always returns false if the esp-mqtt component was compiled without MQTT 5 support (CONFIG_MQTT_PROTOCOL_5)
+    bool reserve_topic_alias(char const * topic) override {
+#ifdef CONFIG_MQTT_PROTOCOL_5
+        if (topic == nullptr || get_reserved_topic_alias(topic) != 0U) {
+            return topic != nullptr;
+        }
+        for (auto & reserved_topic : m_topic_aliases) {
+            if (reserved_topic == nullptr) {
+                reserved_topic = topic;
+                return true;
+            }
+        }
+#endif // CONFIG_MQTT_PROTOCOL_5
+        return false;
+    }
+
+    /// @copydoc IMQTT_Client::set_publish_qos
+    /// @note Messages published with QoS 1 are kept in the outbox of the ESP MQTT client until the broker confirmed them, which increases the memory requirements of the outbox
+    /// until the confirmation has been received. See https://docs.espressif.com/projects/esp-idf/en/latest/esp32/api-reference/protocols/mqtt.html#events for more information
+    bool set_publish_qos(MQTT_QoS qos) override {
+        m_publish_qos = qos;
+        return true;
+    }
+
+    uint16_t get_last_packet_id() const override {
+        return m_last_packet_id;
+    }
+
+    /// @copydoc IMQTT_Client::set_delivery_callback
+    /// @note Confirmed messages are reported once the MQTT_EVENT_PUBLISHED event is received and dropped messages once the MQTT_EVENT_DELETED event is received,
+    /// which happens if the message could not be sent before it expired in the outbox, configurable with the outbox expiry time of the ESP MQTT client
+    void set_delivery_callback(Callback<void, uint16_t, bool>::function callback) override {
+        m_delivery_callback.Set_Callback(callback);
+    }
+
 private:
+#ifdef CONFIG_MQTT_PROTOCOL_5
+    /// @brief Gets the alias that was reserved for the given topic, independent of whether it can currently be used
+    /// @param topic Non owning pointer to the topic the message is published on
+    /// @return Alias between 1 and MAX_TOPIC_ALIASES, or 0 if no alias has been reserved for the topic
+    uint16_t get_reserved_topic_alias(char const * topic) const {
+        for (uint8_t i = 0U; i < MAX_TOPIC_ALIASES && m_topic_aliases[i] != nullptr; i++) {
+            if (m_topic_aliases[i] == topic || strcmp(m_topic_aliases[i], topic) == 0) {
+                return i + 1U;
+            }
+        }
+        return 0U;
+    }
+
+    /// @brief Gets the alias that should be used to publish on the given topic in the current connection
+    /// @param topic Non owning pointer to the topic the message is published on
+    /// @return Alias that is within the maximum of both the client and the broker, or 0 if the full topic has to be sent because we are connected with MQTT 3.1.1 or no usable alias has been reserved for the topic
+    uint16_t get_topic_alias(char const * topic) const {
+        if (m_mqtt_configuration.session.protocol_ver != esp_mqtt_protocol_ver_t::MQTT_PROTOCOL_V_5) {
+            return 0U;
+        }
+        uint16_t const topic_alias = get_reserved_topic_alias(topic);
+        return topic_alias <= m_broker_topic_alias_maximum ? topic_alias : 0U;
+    }
+
+    /// @brief Publishes the given payload with the given topic alias, where the full topic is only omitted if the alias has already been established in the current connection and the message is published with QoS 0.
+    /// Messages published with QoS 1 are resent by the ESP MQTT client after a reconnect exactly as they were first sent, but the new connection does not know the alias, which would cause the broker to close the connection with a protocol error.
+    /// Therefore they always contain the full topic, which establishes the alias again in the connection the message is resent in
+    /// @param topic Non owning pointer to the topic the message is published on
+    /// @param topic_alias Alias reserved for the topic, has to be within the maximum of both the client and the broker
+    /// @param payload Payload containg the data that should be sent
+    /// @param length Length of the payload in bytes
+    /// @return Message id returned by the ESP MQTT client, where a value smaller or equal to MQTT_FAILURE_MESSAGE_ID means publishing the payload failed
+    int publish_with_topic_alias(char const * topic, uint16_t const & topic_alias, uint8_t const * payload, size_t const & length) {
+        esp_mqtt5_publish_property_config_t property = {};
+        property.topic_alias = topic_alias;
+        if (esp_mqtt5_client_set_publish_property(m_mqtt_client, &property) != ESP_OK) {
+            // The ESP MQTT client only refuses a publish property containing nothing but the alias, if the alias exceeds the topic alias maximum the broker sent in its connect acknowledgement.
+            // Therefore every alias above is not used anymore until the next connect, whereas failures of the publish itself (full outbox, lost connection) keep the maximum unchanged
+            m_broker_topic_alias_maximum = topic_alias - 1U;
+            return MQTT_FAILURE_MESSAGE_ID;
+        }
+        bool & established = m_topic_alias_established[topic_alias - 1U];
+        bool const alias_only = established && m_publish_qos == MQTT_QoS::AT_MOST_ONCE;
+        int const message_id = esp_mqtt_client_publish(m_mqtt_client, alias_only ? "" : topic, reinterpret_cast<const char*>(payload), length, static_cast<int>(m_publish_qos), 0U);
+        if (message_id > MQTT_FAILURE_MESSAGE_ID) {
+            established = true;
+        }
+        return message_id;
+    }
+
+    /// @brief Resets the topic aliases established with the broker, because the broker forgets all aliases once the connection has been closed
+    void reset_topic_aliases() {
+        m_broker_topic_alias_maximum = m_topic_alias_maximum;
+        for (auto & established : m_topic_alias_established) {
+            established = false;
+        }
+    }
+#endif // CONFIG_MQTT_PROTOCOL_5
+
+    /// @brief Remembers the packet id of the last published message, which is only sent to the broker and confirmed by it if the message was published with QoS 1
+    /// @param message_id Message id returned by the ESP MQTT client, where a value smaller or equal to MQTT_FAILURE_MESSAGE_ID means publishing failed and 0 means the message was published with QoS 0
+    /// @return Whether publishing the message was successful or not
+    bool update_last_packet_id(int const & message_id) {
+        if (message_id <= MQTT_FAILURE_MESSAGE_ID) {
+            return false;
+        }
+        m_last_packet_id = m_publish_qos != MQTT_QoS::AT_MOST_ONCE ? static_cast<uint16_t>(message_id) : 0U;
+        return true;
+    }
+
+    /// @brief Releases the temporary buffer allocated in begin_publish() and resets the streamed publish message
+    void free_stream_buffer() {
+        delete[] m_stream_buffer;
+        m_stream_buffer = nullptr;
+        m_stream_length = 0U;
+        m_stream_written = 0U;
+    }
+
     /// @brief Is internally used to allow changes to the underlying configuration of the esp_mqtt_client_handle_t after it has connected
     /// @note Allows to increase the buffer size, timeouts or stack size, of the underlying client configuration,
     /// without the need to completly disconnect and reconnect the client
@@ -438,6 +647,10 @@ private:
 #endif // THINGSBOARD_ENABLE_DEBUG
         switch (event_id) {
             case esp_mqtt_event_id_t::MQTT_EVENT_CONNECTED:
+#ifdef CONFIG_MQTT_PROTOCOL_5
+                // Has to be reset before the connected callback, because the ThingsBoard client might already publish messages in it
+                reset_topic_aliases();
+#endif // CONFIG_MQTT_PROTOCOL_5
                 m_connected_callback.Call_Callback();
                 update_connection_state(MQTT_Connection_State::CONNECTED);
                 break;
@@ -458,12 +671,29 @@ private:
                 m_received_data_callback.Call_Callback(topic, reinterpret_cast<uint8_t*>(event->data), event->data_len);
                 break;
             }
+            case esp_mqtt_event_id_t::MQTT_EVENT_PUBLISHED:
+                m_delivery_callback.Call_Callback(static_cast<uint16_t>(event->msg_id), true);
+                break;
+            case esp_mqtt_event_id_t::MQTT_EVENT_DELETED:
+                m_delivery_callback.Call_Callback(static_cast<uint16_t>(event->msg_id), false);
+                break;
             case esp_mqtt_event_id_t::MQTT_EVENT_ERROR: {
                 esp_mqtt_error_codes_t const * error = event->error_handle;
                 if (error == nullptr) {
                     break;
                 }
                 m_last_connection_error = static_cast<MQTT_Connection_Error>(error->connect_return_code);
+#ifdef CONFIG_MQTT_PROTOCOL_5
+                // Brokers that only support MQTT 3.1.1 refuse the connection with the unacceptable protocol version return code, whereas brokers that support MQTT 5 use the unsupported protocol version reason code instead
+                if (error->error_type == esp_mqtt_error_type_t::MQTT_ERROR_TYPE_CONNECTION_REFUSED && m_mqtt_configuration.session.protocol_ver == esp_mqtt_protocol_ver_t::MQTT_PROTOCOL_V_5 &&
+                    (error->connect_return_code == esp_mqtt_connect_return_code_t::MQTT_CONNECTION_REFUSE_PROTOCOL || static_cast<int>(error->connect_return_code) == MQTT5_UNSUPPORTED_PROTOCOL_VER)) {
+                    Logger::printfln(MQTT_5_REFUSED);
+                    m_last_connection_error = MQTT_Connection_Error::REFUSE_PROTOCOL;
+                    // Automatic reconnect uses the updated configuration, meaning the next connection attempt is made with MQTT 3.1.1
+                    m_mqtt_configuration.session.protocol_ver = esp_mqtt_protocol_ver_t::MQTT_PROTOCOL_V_3_1_1;
+                    (void)update_configuration();
+                }
+#endif // CONFIG_MQTT_PROTOCOL_5
                 update_connection_state(MQTT_Connection_State::ERROR);
                 break;
             }
@@ -484,11 +714,23 @@ private:
     Callback<void, char *, uint8_t *, unsigned int>              m_received_data_callback = {};            // Callback that will be called as soon as the mqtt client receives any data
     Callback<void>                                               m_connected_callback = {};                // Callback that will be called as soon as the mqtt client has connected
     Callback<void, MQTT_Connection_State, MQTT_Connection_Error> m_connection_state_changed_callback = {}; // Callback that will be called as soon as the mqtt client connection changes
+    Callback<void, uint16_t, bool>                               m_delivery_callback = {};                 // Callback that will be called as soon as a message published with QoS 1 has been confirmed by the broker or dropped from the outbox
     MQTT_Connection_State                                        m_connection_state = {};                  // Current connection state to the MQTT broker
     MQTT_Connection_Error                                        m_last_connection_error = {};             // Last error that occured while trying to establish a connection to the MQTT broker
     bool                                                         m_enqueue_messages = {};                  // Whether we enqueue messages making nearly all ThingsBoard calls non blocking or wheter we publish instead
+    MQTT_QoS                                                     m_publish_qos = {};                       // Quality of service the following messages are published with
+    uint16_t                                                     m_last_packet_id = {};                    // Packet id of the last published message, 0 if it was published with QoS 0
     esp_mqtt_client_config_t                                     m_mqtt_configuration = {};                // Configuration of the underlying mqtt client, saved as a private variable to allow changes after inital configuration with the same options for all non changed settings
     esp_mqtt_client_handle_t                                     m_mqtt_client = {};                       // Handle to the underlying mqtt client, used to establish the communication
+    uint8_t                                                      *m_stream_buffer = {};                    // Temporary buffer containing the payload followed by the topic of the currently streamed publish message, only allocated between begin_publish() and end_publish()
+    size_t                                                       m_stream_length = {};                     // Payload size of the currently streamed publish message, announced in begin_publish()
+    size_t                                                       m_stream_written = {};                    // Amount of payload bytes already written into the temporary buffer of the currently streamed publish message
+#ifdef CONFIG_MQTT_PROTOCOL_5
+    char const                                                   *m_topic_aliases[MAX_TOPIC_ALIASES] = {}; // Non owning pointers to the topics an alias has been reserved for, where the alias is the index + 1
+    bool                                                         m_topic_alias_established[MAX_TOPIC_ALIASES] = {}; // Whether the alias has already been sent together with its full topic in the current connection
+    uint16_t                                                     m_topic_alias_maximum = {};               // Maximum amount of topic aliases configured with set_topic_alias_maximum(), 0 means MQTT 3.1.1 is used
+    uint16_t                                                     m_broker_topic_alias_maximum = {};        // Maximum amount of topic aliases that can be used in the current connection, lowered if the broker rejects an alias
+#endif // CONFIG_MQTT_PROTOCOL_5
 };
 
 #endif // THINGSBOARD_USE_ESP_MQTT
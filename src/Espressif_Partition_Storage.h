@@ -0,0 +1,94 @@
+#ifndef Espressif_Partition_Storage_h
+#define Espressif_Partition_Storage_h
+
+// Local include.
+#include "Configuration.h"
+
+#if THINGSBOARD_USE_ESP_PARTITION
+
+// Local includes.
+#include "DefaultLogger.h"
+#include "IStorage.h"
+
+// Library include.
+#include <esp_partition.h>
+
+/// @brief Smallest amount of bytes that can be erased at once, defined here instead of using SPI_FLASH_SEC_SIZE, because the header that defines it differs between major versions
+size_t constexpr FLASH_SECTOR_SIZE = 4096U;
+constexpr char MISSING_STORAGE_PARTITION[] = "Missing data partition with label (%s), ensure it has been added to the partition table";
+constexpr char INVALID_STORAGE_SEGMENT_SIZE[] = "Segment size (%u) is not a multiple of the flash sector size (%u)";
+
+
+/// @brief IStorage implementation that uses the Partitions API from Espressif (https://docs.espressif.com/projects/esp-idf/en/latest/esp32/api-reference/storage/partition.html)
+/// under the hood to store the segments directly in a raw data partition of the flash memory, without requiring a file system.
+/// @note The data partition has to be added to the partition table manually, for example with the line "tb_log, data, 0x40, , 64K" and the segment size has to be a multiple of the flash sector size (4096 bytes).
+/// Segments are written exactly like NOR flash memory expects, meaning they are erased before they are written again and already written bytes are only written again to clear bits.
+/// This is not possible if flash encryption is enabled, because encrypted bytes can not be partially cleared, therefore the partition should not be marked as encrypted in the partition table
+/// @tparam Logger Implementation that should be used to print error messages generated by internal processes and additional debugging messages if THINGSBOARD_ENABLE_DEBUG is set, default = DefaultLogger
+template <typename Logger = DefaultLogger>
+class Espressif_Partition_Storage : public IStorage {
+  public:
+    /// @brief Constructor
+    /// @param partition_label Non owning pointer to the label of the data partition, that should be used to store the segments.
+    /// Does not need to kept alive as the partition is searched once in the constructor
+    /// @param segment_size Size of a single segment in bytes, has to be a multiple of the flash sector size (4096 bytes). The amount of segments is the partition size divided by the segment size
+    Espressif_Partition_Storage(char const * partition_label, size_t const & segment_size)
+      : m_partition(esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, partition_label))
+      , m_segment_size(segment_size)
+    {
+        if (m_partition == nullptr) {
+            Logger::printfln(MISSING_STORAGE_PARTITION, partition_label);
+        }
+        else if (m_segment_size == 0U || m_segment_size % FLASH_SECTOR_SIZE != 0U) {
+            Logger::printfln(INVALID_STORAGE_SEGMENT_SIZE, m_segment_size, FLASH_SECTOR_SIZE);
+            m_partition = nullptr;
+        }
+    }
+
+    /// @brief Deleted copy constructor
+    /// @note Copying a storage writing to the same partition, makes no sense as it would overwrite the partition contents. Therefore copying is disabled alltogether
+    /// @param other Other instance we disallow copying from
+    Espressif_Partition_Storage(Espressif_Partition_Storage const & other) = delete;
+
+    /// @brief Deleted copy assignment operator
+    /// @note Copying a storage writing to the same partition, makes no sense as it would overwrite the partition contents. Therefore copying is disabled alltogether
+    /// @param other Other instance we disallow copying from
+    void operator=(Espressif_Partition_Storage const & other) = delete;
+
+    size_t get_segment_amount() override {
+        return m_partition != nullptr ? m_partition->size / m_segment_size : 0U;
+    }
+
+    size_t get_segment_size() override {
+        return m_segment_size;
+    }
+
+    bool read(size_t const & segment, size_t const & offset, uint8_t * buffer, size_t const & size) override {
+        if (segment >= get_segment_amount() || offset + size > m_segment_size) {
+            return false;
+        }
+        return esp_partition_read(m_partition, segment * m_segment_size + offset, buffer, size) == ESP_OK;
+    }
+
+    bool write(size_t const & segment, size_t const & offset, uint8_t const * buffer, size_t const & size) override {
+        if (segment >= get_segment_amount() || offset + size > m_segment_size) {
+            return false;
+        }
+        return esp_partition_write(m_partition, segment * m_segment_size + offset, buffer, size) == ESP_OK;
+    }
+
+    bool erase(size_t const & segment) override {
+        if (segment >= get_segment_amount()) {
+            return false;
+        }
+        return esp_partition_erase_range(m_partition, segment * m_segment_size, m_segment_size) == ESP_OK;
+    }
+
+  private:
+    esp_partition_t const *m_partition = {};  // Data partition the segments are stored in, nullptr if it could not be found
+    size_t                m_segment_size = {}; // Size of a single segment in bytes, multiple of the flash sector size
+};
+
+#endif // THINGSBOARD_USE_ESP_PARTITION
+
+#endif // Espressif_Partition_Storage_h
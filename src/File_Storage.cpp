@@ -0,0 +1,124 @@
+// Header include.
+#include "File_Storage.h"
+
+// Library includes.
+#include <stdio.h>
+#include <string.h>
+#ifdef __has_include
+#  if __has_include(<unistd.h>)
+#    include <unistd.h>
+#    define FILE_STORAGE_USE_FSYNC 1
+#  endif
+#endif
+#ifndef FILE_STORAGE_USE_FSYNC
+#  define FILE_STORAGE_USE_FSYNC 0
+#endif
+
+/// @brief Maximum amount of characters appended to the path prefix, consisting of the segment index with up to 20 digits, the .log extension and the null terminator
+size_t constexpr MAX_PATH_SUFFIX_LENGTH = 25U;
+/// @brief Value bytes that have not been written since the segment was erased are read as
+uint8_t constexpr ERASED_BYTE = 0xFFU;
+
+namespace {
+
+/// @brief Writes the buffered bytes of the given file into the file system and waits until the file system persisted them on the underlying medium
+/// @note fflush() only hands the buffered bytes over to the operating system or the virtual file system, which might keep them in its own cache until the file is closed or even longer.
+/// Therefore fsync() is called afterwards if it exists, to ensure the bytes survive a reset or power loss directly after returning
+/// @param file File that should be synchronized
+/// @return Whether synchronizing the file was successful or not
+bool Sync_File(FILE * file) {
+    if (fflush(file) != 0) {
+        return false;
+    }
+#if FILE_STORAGE_USE_FSYNC
+    return fsync(fileno(file)) == 0;
+#else
+    return true;
+#endif // FILE_STORAGE_USE_FSYNC
+}
+
+} // namespace
+
+File_Storage::File_Storage(char const * path_prefix, size_t const & segment_amount, size_t const & segment_size)
+  : m_path(nullptr)
+  , m_prefix_length(path_prefix != nullptr ? strlen(path_prefix) : 0U)
+  , m_segment_amount(segment_amount)
+  , m_segment_size(segment_size)
+{
+    m_path = new char[m_prefix_length + MAX_PATH_SUFFIX_LENGTH]();
+    if (m_path != nullptr && path_prefix != nullptr) {
+        (void)memcpy(m_path, path_prefix, m_prefix_length);
+    }
+}
+
+File_Storage::~File_Storage() {
+    delete[] m_path;
+    m_path = nullptr;
+}
+
+size_t File_Storage::get_segment_amount() {
+    return m_path != nullptr ? m_segment_amount : 0U;
+}
+
+size_t File_Storage::get_segment_size() {
+    return m_segment_size;
+}
+
+bool File_Storage::read(size_t const & segment, size_t const & offset, uint8_t * buffer, size_t const & size) {
+    if (segment >= m_segment_amount || offset + size > m_segment_size) {
+        return false;
+    }
+    size_t read_bytes = 0U;
+    FILE * file = fopen(Get_Path(segment), "rb");
+    // Missing files have never been written or have been erased, therefore all their bytes are read as erased
+    if (file != nullptr) {
+        if (fseek(file, static_cast<long>(offset), SEEK_SET) == 0) {
+            read_bytes = fread(buffer, 1U, size, file);
+        }
+        (void)fclose(file);
+    }
+    (void)memset(buffer + read_bytes, ERASED_BYTE, size - read_bytes);
+    return true;
+}
+
+bool File_Storage::write(size_t const & segment, size_t const & offset, uint8_t const * buffer, size_t const & size) {
+    if (segment >= m_segment_amount || offset + size > m_segment_size) {
+        return false;
+    }
+    char const * path = Get_Path(segment);
+    FILE * file = fopen(path, "r+b");
+    if (file == nullptr) {
+        file = fopen(path, "w+b");
+        if (file == nullptr) {
+            return false;
+        }
+    }
+    bool result = fseek(file, 0, SEEK_END) == 0;
+    long const file_size = ftell(file);
+    result = result && file_size >= 0;
+    // Seeking past the end of the file would fill the skipped bytes with 0x00, therefore they are filled explicitly to still be read as erased
+    for (size_t i = static_cast<size_t>(file_size); result && i < offset; i++) {
+        result = fputc(ERASED_BYTE, file) != EOF;
+    }
+    result = result && fseek(file, static_cast<long>(offset), SEEK_SET) == 0;
+    result = result && fwrite(buffer, 1U, size, file) == size;
+    result = result && Sync_File(file);
+    return fclose(file) == 0 && result;
+}
+
+bool File_Storage::erase(size_t const & segment) {
+    if (segment >= m_segment_amount) {
+        return false;
+    }
+    FILE * file = fopen(Get_Path(segment), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    bool const result = Sync_File(file);
+    return fclose(file) == 0 && result;
+}
+
+char const * File_Storage::Get_Path(size_t const & segment) {
+    (void)snprintf(m_path + m_prefix_length, MAX_PATH_SUFFIX_LENGTH, "%lu.log", static_cast<unsigned long>(segment));
+    return m_path;
+}
@@ -0,0 +1,56 @@
+#ifndef File_Storage_h
+#define File_Storage_h
+
+// Local include.
+#include "IStorage.h"
+
+
+/// @brief IStorage implementation that uses the c fopen function (https://cplusplus.com/reference/cstdio/fopen/),
+/// under the hood to store every segment in its own file. Can be used to persist data on an SD card or on the file system of a Linux host
+/// @note Every segment is stored in a file named after the given path prefix followed by the index of the segment and the .log extension ("/sdcard/tb_" results in "/sdcard/tb_0.log", "/sdcard/tb_1.log", ...).
+/// Erasing a segment truncates its file and bytes that are beyond the end of the file are read as 0xFF, which emulates the behaviour of erased flash memory.
+/// Every write opens and closes the file, so that written bytes are handed to the file system immediately instead of being kept in the buffer of an open file
+class File_Storage : public IStorage {
+  public:
+    /// @brief Constructor
+    /// @param path_prefix Non owning pointer to the prefix of the file path of every segment, the directory has to already exist.
+    /// Does not need to kept alive as the function copies the prefix
+    /// @param segment_amount Amount of segments and therefore files that are used
+    /// @param segment_size Maximum size of a single segment and therefore file in bytes
+    File_Storage(char const * path_prefix, size_t const & segment_amount, size_t const & segment_size);
+
+    /// @brief Deleted copy constructor
+    /// @note Copying a storage writing to the same files, makes no sense as it would overwrite file contents. Therefore copying is disabled alltogether
+    /// @param other Other instance we disallow copying from
+    File_Storage(File_Storage const & other) = delete;
+
+    /// @brief Deleted copy assignment operator
+    /// @note Copying a storage writing to the same files, makes no sense as it would overwrite file contents. Therefore copying is disabled alltogether
+    /// @param other Other instance we disallow copying from
+    void operator=(File_Storage const & other) = delete;
+
+    ~File_Storage() override;
+
+    size_t get_segment_amount() override;
+
+    size_t get_segment_size() override;
+
+    bool read(size_t const & segment, size_t const & offset, uint8_t * buffer, size_t const & size) override;
+
+    bool write(size_t const & segment, size_t const & offset, uint8_t const * buffer, size_t const & size) override;
+
+    bool erase(size_t const & segment) override;
+
+  private:
+    /// @brief Formats the file path of the given segment into the internal path buffer
+    /// @param segment Index of the segment
+    /// @return Non owning pointer to the internal path buffer, is only valid until this method is called again
+    char const * Get_Path(size_t const & segment);
+
+    char   *m_path = {};           // Buffer the file path of a segment is formatted into, contains the copied prefix followed by space for the segment index and extension
+    size_t m_prefix_length = {};   // Length of the copied path prefix without the null terminator
+    size_t m_segment_amount = {};  // Amount of segments and therefore files that are used
+    size_t m_segment_size = {};    // Maximum size of a single segment in bytes
+};
+
+#endif // File_Storage_h
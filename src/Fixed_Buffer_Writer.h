@@ -0,0 +1,65 @@
+#ifndef Fixed_Buffer_Writer_h
+#define Fixed_Buffer_Writer_h
+
+// Library includes.
+#include <stdint.h>
+#include <string.h>
+
+
+/// @brief Writer that copies all written bytes into a fixed size buffer, while additionally counting the total amount of bytes that have been written.
+/// @note Bytes that do not fit into the buffer anymore are discarded, but are still counted and reported as written. This allows to serialize a payload into the buffer and measure its total size in one pass,
+/// where a total size that is bigger than the buffer size means the payload has been truncated and has to be sent differently, for example by streaming it with the @ref Buffered_Publish_Writer instead.
+/// Passing a nullptr as the buffer allows to use the class to simply measure the size of a payload, without copying it anywhere
+class Fixed_Buffer_Writer {
+  public:
+    /// @brief Constructs the writer around the given buffer
+    /// @param buffer Non owning pointer to the buffer the written bytes are copied into, has to be kept alive for as long as this instance is used.
+    /// If it is a nullptr then the written bytes are only counted
+    /// @param buffer_size Size of the given buffer in bytes
+    Fixed_Buffer_Writer(char * buffer, size_t const & buffer_size)
+      : m_buffer(buffer)
+      , m_buffer_size(buffer != nullptr ? buffer_size : 0U)
+      , m_written_size(0U)
+    {
+        // Nothing to do
+    }
+
+    /// @brief Copies the given single byte into the buffer, if there is still space left
+    /// @param payload_byte Byte that should be written
+    /// @return Always 1, even if the byte did not fit into the buffer anymore
+    size_t write(uint8_t payload_byte) {
+        return write(&payload_byte, 1U);
+    }
+
+    /// @brief Copies as many of the given bytes into the buffer, as there is still space left
+    /// @param buffer Non owning pointer to the bytes that should be written
+    /// @param size Amount of bytes that should be written
+    /// @return Always the given size, even if the bytes did not fit into the buffer anymore
+    size_t write(uint8_t const * buffer, size_t const & size) {
+        if (m_written_size < m_buffer_size) {
+            size_t const remaining_size = m_buffer_size - m_written_size;
+            (void)memcpy(m_buffer + m_written_size, buffer, size < remaining_size ? size : remaining_size);
+        }
+        m_written_size += size;
+        return size;
+    }
+
+    /// @brief Returns the total amount of bytes that have been written, including the bytes that did not fit into the buffer anymore
+    /// @return Total amount of written bytes
+    size_t const & size() const {
+        return m_written_size;
+    }
+
+    /// @brief Whether more bytes have been written than fit into the buffer
+    /// @return Whether the content of the buffer has been truncated
+    bool overflowed() const {
+        return m_written_size > m_buffer_size;
+    }
+
+  private:
+    char   *m_buffer = {};       // Non owning pointer to the buffer the written bytes are copied into
+    size_t m_buffer_size = {};   // Size of the buffer the written bytes are copied into
+    size_t m_written_size = {};  // Total amount of bytes that have been written, including the bytes that did not fit into the buffer anymore
+};
+
+#endif // Fixed_Buffer_Writer_h
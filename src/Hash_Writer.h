@@ -0,0 +1,66 @@
+#ifndef Hash_Writer_h
+#define Hash_Writer_h
+
+// Library includes.
+#include <stddef.h>
+#include <stdint.h>
+
+
+// Offset basis and prime of the 64-bit FNV-1a hash, see http://www.isthe.com/chongo/tech/comp/fnv/index.html#FNV-param.
+uint64_t constexpr FNV_OFFSET_BASIS = 14695981039346656037U;
+uint64_t constexpr FNV_PRIME = 1099511628211U;
+
+
+/// @brief Writer that does not store the written bytes, but instead combines them into a 64-bit FNV-1a hash, while additionally counting the total amount of bytes that have been written.
+/// @note Has the same interface as the @ref Fixed_Buffer_Writer, meaning anything that can be serialized into a buffer can also be hashed, without requiring any memory for the serialized bytes.
+/// Writing the same bytes in multiple smaller parts results in the same hash as writing them all at once. FNV-1a is not a cryptographic hash, it is only meant to detect changes cheaply.
+/// See http://www.isthe.com/chongo/tech/comp/fnv/index.html for more information on the algorithm
+class Hash_Writer {
+  public:
+    /// @brief Constructs the writer with the hash of zero written bytes
+    Hash_Writer()
+      : m_hash(FNV_OFFSET_BASIS)
+      , m_written_size(0U)
+    {
+        // Nothing to do
+    }
+
+    /// @brief Combines the given single byte into the hash
+    /// @param payload_byte Byte that should be written
+    /// @return Always 1
+    size_t write(uint8_t payload_byte) {
+        m_hash = (m_hash ^ payload_byte) * FNV_PRIME;
+        m_written_size++;
+        return 1U;
+    }
+
+    /// @brief Combines the given bytes into the hash
+    /// @param buffer Non owning pointer to the bytes that should be written
+    /// @param size Amount of bytes that should be written
+    /// @return Always the given size
+    size_t write(uint8_t const * buffer, size_t const & size) {
+        for (size_t i = 0U; i < size; i++) {
+            m_hash = (m_hash ^ buffer[i]) * FNV_PRIME;
+        }
+        m_written_size += size;
+        return size;
+    }
+
+    /// @brief Returns the hash of all bytes that have been written
+    /// @return 64-bit FNV-1a hash
+    uint64_t const & hash() const {
+        return m_hash;
+    }
+
+    /// @brief Returns the total amount of bytes that have been written
+    /// @return Total amount of written bytes
+    size_t const & size() const {
+        return m_written_size;
+    }
+
+  private:
+    uint64_t m_hash = {};          // FNV-1a hash of all bytes that have been written
+    size_t   m_written_size = {};  // Total amount of bytes that have been written
+};
+
+#endif // Hash_Writer_h
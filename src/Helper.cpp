@@ -6,6 +6,11 @@
 #include <algorithm>
 #endif // THINGSBOARD_ENABLE_STL
 #include <string.h>
+#if THINGSBOARD_USE_ESP_TIMER
+#include <esp_timer.h>
+#else
+#include <Arduino.h>
+#endif // THINGSBOARD_USE_ESP_TIMER
 
 size_t Helper::Calculate_Symbol_Occurences(uint8_t const * bytes, char symbol, uint32_t length) {
     size_t count = 0;
@@ -24,10 +29,300 @@ size_t Helper::Calculate_Symbol_Occurences(uint8_t const * bytes, char symbol, u
     return count;
 }
 
+namespace {
+
+// Word that is compared at once using SWAR (SIMD within a register), native register size of the board
+using Symbol_Word = size_t;
+// Word with every byte set to 0x01, multiplied with a byte to repeat that byte in every byte of the word
+Symbol_Word constexpr REPEATED_ONES = ~static_cast<Symbol_Word>(0U) / 0xFFU;
+// Word with every bit besides the highest bit of each byte set
+Symbol_Word constexpr REPEATED_LOW_BITS = REPEATED_ONES * 0x7FU;
+
+/// @brief Returns a word with the highest bit set in every byte of the given word that is equal to the given symbol
+/// @note Does not cause any false positives because of borrows between bytes, see https://graphics.stanford.edu/~seander/bithacks.html#ZeroInWord for more information
+/// @param word Word that should be compared
+/// @param symbol Symbol that every byte should be compared with
+/// @return Word with the highest bit set in every matching byte and all other bits cleared
+Symbol_Word Match_Symbol(Symbol_Word const & word, char symbol) {
+    Symbol_Word const zeroed = word ^ (REPEATED_ONES * static_cast<uint8_t>(symbol));
+    return ~(((zeroed & REPEATED_LOW_BITS) + REPEATED_LOW_BITS) | zeroed | REPEATED_LOW_BITS);
+}
+
+/// @brief Returns a word with the highest bit set in every byte, that is preceded by an uneven amount of matching bytes, including the byte itself
+/// @note Calculates the prefix xor over all bytes, meaning for quotes the highest bit is set for every byte after an opening quote up to the byte before the closing quote
+/// @param matches Word returned by Match_Symbol, where only the highest bit of each byte may be set
+/// @return Word with the highest bit set in every byte preceded by an uneven amount of matching bytes and all other bits cleared
+Symbol_Word Prefix_Xor_Matches(Symbol_Word matches) {
+    for (size_t shift = 8U; shift < sizeof(Symbol_Word) * 8U; shift <<= 1U) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        // First byte in memory is the most significant byte, therefore the following bytes are the lower bytes
+        matches ^= matches >> shift;
+#else
+        // First byte in memory is the least significant byte, therefore the following bytes are the higher bytes
+        matches ^= matches << shift;
+#endif // defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    }
+    return matches & ~REPEATED_LOW_BITS;
+}
+
+/// @brief Returns whether the highest bit of the last byte in memory is set in the given word
+/// @param matches Word returned by Prefix_Xor_Matches
+/// @return Whether the last byte is preceded by an uneven amount of matching bytes
+bool Is_Last_Byte_Matching(Symbol_Word const & matches) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return (matches & 0x80U) != 0U;
+#else
+    return (matches >> ((sizeof(Symbol_Word) - 1U) * 8U)) != 0U;
+#endif // defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+}
+
+/// @brief Returns the amount of bytes with the highest bit set in the given word
+/// @param matches Word returned by Match_Symbol, where only the highest bit of each byte may be set
+/// @return Amount of matching bytes
+size_t Count_Matches(Symbol_Word const & matches) {
+    // Moves the highest bit to the lowest bit of each byte, afterwards the multiplication sums up all bytes into the highest byte
+    return static_cast<size_t>(((matches >> 7U) * REPEATED_ONES) >> ((sizeof(Symbol_Word) - 1U) * 8U));
+}
+
+/// @brief Counts the given byte if it is a structural json symbol outside of a string literal and updates whether the following bytes are part of a string literal
+/// @param byte Byte that should be checked
+/// @param in_string Whether the byte is part of a string literal, is updated if the byte starts or ends the string literal
+/// @param escaped Whether the byte is escaped by the previous backslash, is updated if the byte escapes the following byte
+/// @param count Amount of structural json symbols, is incremented if the byte is one of them
+void Count_Json_Symbol(uint8_t const & byte, bool & in_string, bool & escaped, size_t & count) {
+    if (in_string) {
+        if (escaped) {
+            escaped = false;
+        }
+        else if (byte == '\\') {
+            escaped = true;
+        }
+        else if (byte == '"') {
+            in_string = false;
+        }
+        return;
+    }
+    if (byte == '"') {
+        in_string = true;
+    }
+    else if (byte == ',' || byte == '{' || byte == '[') {
+        count++;
+    }
+}
+
+/// @brief Position inside of a json payload, that is moved forward while the payload is read
+struct Json_Cursor {
+    uint8_t const *current; // Non owning pointer to the next byte that is read
+    uint8_t const *end;     // Non owning pointer to the byte after the last byte of the payload
+};
+
+/// @brief Moves the cursor past all whitespace characters
+/// @param cursor Position inside of the payload
+void Skip_Whitespace(Json_Cursor & cursor) {
+    while (cursor.current < cursor.end && (*cursor.current == ' ' || *cursor.current == '\t' || *cursor.current == '\n' || *cursor.current == '\r')) {
+        cursor.current++;
+    }
+}
+
+/// @brief Moves the cursor past the string literal starting at the cursor
+/// @param cursor Position of the opening quote inside of the payload, moved past the closing quote
+/// @param escaped Set to whether the string literal contains any escaped characters
+/// @return Whether the string literal was terminated before the end of the payload
+bool Skip_String(Json_Cursor & cursor, bool & escaped) {
+    escaped = false;
+    for (cursor.current++; cursor.current < cursor.end; cursor.current++) {
+        if (*cursor.current == '\\') {
+            escaped = true;
+            cursor.current++;
+        }
+        else if (*cursor.current == '"') {
+            cursor.current++;
+            return true;
+        }
+    }
+    return false;
+}
+
+/// @brief Moves the cursor past the value starting at the cursor, including all nested objects and arrays
+/// @param cursor Position of the first byte of the value inside of the payload, moved past the last byte of the value
+/// @param count Amount of structural json symbols, is incremented by the ones contained in the value if it is not a nullptr
+/// @return Whether the value was complete before the end of the payload
+bool Skip_Value(Json_Cursor & cursor, size_t * count) {
+    bool escaped = false;
+    if (cursor.current >= cursor.end) {
+        return false;
+    }
+    else if (*cursor.current == '"') {
+        return Skip_String(cursor, escaped);
+    }
+    else if (*cursor.current != '{' && *cursor.current != '[') {
+        // Scalar value (number, true, false or null) ends at the first whitespace or the seperator or end of the parent object or array
+        while (cursor.current < cursor.end && strchr(" \t\n\r,}]\"", *cursor.current) == nullptr) {
+            cursor.current++;
+        }
+        return true;
+    }
+    size_t depth = 0U;
+    while (cursor.current < cursor.end) {
+        uint8_t const byte = *cursor.current;
+        if (byte == '"') {
+            if (!Skip_String(cursor, escaped)) {
+                return false;
+            }
+            continue;
+        }
+        if (byte == '{' || byte == '[') {
+            depth++;
+        }
+        else if (byte == '}' || byte == ']') {
+            depth--;
+        }
+        if (count != nullptr && (byte == ',' || byte == '{' || byte == '[')) {
+            (*count)++;
+        }
+        cursor.current++;
+        if (depth == 0U) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/// @brief Counts the structural json symbols of the values and the keys of the object starting at the cursor, that are kept by the given filter
+/// @note Only recurses into nested objects the filter contains nested keys for, therefore the depth of the recursion is limited by the depth of the filter instead of the depth of the payload
+/// @param cursor Position of the opening brace of the object inside of the payload, moved past the closing brace
+/// @param filter Filter containing the kept keys of the object
+/// @param count Amount of structural json symbols and kept keys, is incremented by the ones contained in the object
+/// @return Whether the object was valid and complete before the end of the payload
+bool Count_Filtered_Object(Json_Cursor & cursor, JsonObjectConst const & filter, size_t & count) {
+    cursor.current++;
+    Skip_Whitespace(cursor);
+    if (cursor.current < cursor.end && *cursor.current == '}') {
+        cursor.current++;
+        return true;
+    }
+    while (cursor.current < cursor.end) {
+        if (*cursor.current != '"') {
+            return false;
+        }
+        uint8_t const * const key = cursor.current + 1U;
+        bool escaped = false;
+        if (!Skip_String(cursor, escaped)) {
+            return false;
+        }
+        size_t const key_size = cursor.current - key - 1U;
+        Skip_Whitespace(cursor);
+        if (cursor.current >= cursor.end || *cursor.current != ':') {
+            return false;
+        }
+        cursor.current++;
+        Skip_Whitespace(cursor);
+
+        JsonVariantConst kept = {};
+        bool keep_everything = escaped;
+        for (JsonPairConst const pair : filter) {
+            char const * const filter_key = pair.key().c_str();
+            if (strlen(filter_key) == key_size && memcmp(filter_key, key, key_size) == 0) {
+                kept = pair.value();
+                break;
+            }
+        }
+        bool valid = false;
+        if (!keep_everything && kept.isNull()) {
+            valid = Skip_Value(cursor, nullptr);
+        }
+        else if (!keep_everything && kept.is<JsonObjectConst>() && cursor.current < cursor.end && *cursor.current == '{') {
+            count++;
+            valid = Count_Filtered_Object(cursor, kept.as<JsonObjectConst>(), count);
+        }
+        else {
+            count++;
+            valid = Skip_Value(cursor, &count);
+        }
+        if (!valid) {
+            return false;
+        }
+
+        Skip_Whitespace(cursor);
+        if (cursor.current >= cursor.end) {
+            return false;
+        }
+        else if (*cursor.current == '}') {
+            cursor.current++;
+            return true;
+        }
+        else if (*cursor.current != ',') {
+            return false;
+        }
+        cursor.current++;
+        Skip_Whitespace(cursor);
+    }
+    return false;
+}
+
+} // namespace
+
+size_t Helper::Calculate_Json_Symbol_Occurences(uint8_t const * bytes, uint32_t length) {
+    size_t count = 0;
+    if (bytes == nullptr) {
+        return count;
+    }
+    bool in_string = false;
+    bool escaped = false;
+    size_t i = 0;
+    for (; i + sizeof(Symbol_Word) <= length; i += sizeof(Symbol_Word)) {
+        Symbol_Word word = 0U;
+        // Compiled into a single load, but without requiring the payload to be aligned
+        (void)memcpy(&word, bytes + i, sizeof(Symbol_Word));
+        // Escaped characters are rare, therefore words containing a backslash or starting with an escaped character are compared byte per byte instead
+        if (!escaped && Match_Symbol(word, '\\') == 0U) {
+            // Every byte after an uneven amount of quotes, is part of a string literal if the word started outside of a string literal and the other way around.
+            // Quotes themselves are never counted, therefore it does not matter if they are marked as part of the string literal or not
+            Symbol_Word const string_bytes = Prefix_Xor_Matches(Match_Symbol(word, '"'));
+            Symbol_Word const symbols = Match_Symbol(word, ',') | Match_Symbol(word, '{') | Match_Symbol(word, '[');
+            count += Count_Matches(symbols & (in_string ? string_bytes : ~string_bytes));
+            in_string = in_string != Is_Last_Byte_Matching(string_bytes);
+            continue;
+        }
+        for (size_t j = i; j < i + sizeof(Symbol_Word); j++) {
+            Count_Json_Symbol(bytes[j], in_string, escaped, count);
+        }
+    }
+    for (; i < length; i++) {
+        Count_Json_Symbol(bytes[i], in_string, escaped, count);
+    }
+    return count;
+}
+
+size_t Helper::Calculate_Filtered_Json_Symbol_Occurences(uint8_t const * bytes, uint32_t length, JsonVariantConst const & filter) {
+    if (filter.isNull()) {
+        // Empty filter skips every key-value pair
+        return 0U;
+    }
+    else if (bytes == nullptr || !filter.is<JsonObjectConst>()) {
+        return Calculate_Json_Symbol_Occurences(bytes, length);
+    }
+    Json_Cursor cursor = {bytes, bytes + length};
+    Skip_Whitespace(cursor);
+    size_t count = 0;
+    if (cursor.current >= cursor.end || *cursor.current != '{' || !Count_Filtered_Object(cursor, filter.as<JsonObjectConst>(), count)) {
+        return Calculate_Json_Symbol_Occurences(bytes, length);
+    }
+    return count;
+}
+
 bool Helper::String_IsNull_Or_Empty(char const * str) {
     return str == nullptr || str[0] == '\0';
 }
 
+uint32_t Helper::Get_Milliseconds() {
+#if THINGSBOARD_USE_ESP_TIMER
+    return static_cast<uint32_t>(esp_timer_get_time() / 1000);
+#else
+    return static_cast<uint32_t>(millis());
+#endif // THINGSBOARD_USE_ESP_TIMER
+}
+
 size_t Helper::Split_Topic_Into_Request_ID(char const * received_topic, size_t const & end_position) {
     return atoi(received_topic + end_position);
 }
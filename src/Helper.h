@@ -44,12 +44,41 @@ class Helper {
     /// @return Amount of occurences of the given symbol
     static size_t Calculate_Symbol_Occurences(uint8_t const * bytes, char symbol, uint32_t length);
 
+    /// @brief Returns the combined amount of occurences of the structural json symbols ',', '{' and '[' in the given byte payload, that are not part of a string literal
+    /// @note Used to calculate the amount of key-value pairs that have to fit into the JsonDocument the payload is deserialized into, because every key-value pair either ends with a comma or opens an object or array.
+    /// Reads the payload only once instead of once per symbol, and compares a whole word (4 or 8 bytes) at once using SWAR (SIMD within a register) instead of every byte seperately,
+    /// which works on every board without requiring any instruction set extensions. Whether a byte is part of a string literal is calculated from the amount of quotes preceding it in the word,
+    /// only words containing a backslash, meaning an escaped character, are compared byte per byte. Symbols inside of string literals ({"key":",,,,"}) are skipped, which ensures malicious payloads can not cause a lot of memory to be allocated without actually containing the key-value pairs
+    /// @param bytes Non owning pointer to the byte payload that we want to count the symbols for.
+    /// Does not need to be kept alive, because the byte payload is only used for the scope of the method itself
+    /// @param length Length of the byte payload, ensure to never pass a length that is longer than the actualy payload, because this will cause this method to read outside of the bounds of the buffer
+    /// @return Amount of occurences of the structural json symbols outside of string literals
+    static size_t Calculate_Json_Symbol_Occurences(uint8_t const * bytes, uint32_t length);
+
+    /// @brief Returns the combined amount of occurences of the structural json symbols ',', '{' and '[', that are part of values kept by the given deserialization filter, plus one for every kept key
+    /// @note Equivalent to @ref Calculate_Json_Symbol_Occurences, but only counts the key-value pairs that are actually deserialized into the JsonDocument if the same filter is passed to deserializeJson,
+    /// which allows to allocate only the memory required for the filtered key-value pairs instead of the complete payload. Only walks the keys of the objects the filter contains nested keys for,
+    /// all other values are either counted or skipped completly. Keys containing escaped characters are always counted, because they are compared to the filter without unescaping them first
+    /// @param bytes Non owning pointer to the byte payload that we want to count the symbols for.
+    /// Does not need to be kept alive, because the byte payload is only used for the scope of the method itself
+    /// @param length Length of the byte payload, ensure to never pass a length that is longer than the actualy payload, because this will cause this method to read outside of the bounds of the buffer
+    /// @param filter Filter that will be passed to deserializeJson, where keys are either set to true or to a nested object containing the keys of the nested object that are kept
+    /// @return Amount of occurences of the structural json symbols in the kept values and the amount of kept keys, 0 if the filter is empty and therefore does not keep any key.
+    /// If the payload is not a json object, or is malformed the result of @ref Calculate_Json_Symbol_Occurences is returned instead, so that deserializeJson reports the actual error
+    static size_t Calculate_Filtered_Json_Symbol_Occurences(uint8_t const * bytes, uint32_t length, JsonVariantConst const & filter);
+
     /// @brief Returns wheter the given string is either a nullptr or is an empty string,
     /// meaning it only contains a null terminator and no other characters
     /// @param str Non owning poitner to the string that we want to check for emptiness
     /// @return Wheter the given string is a nullptr or empty
     static bool String_IsNull_Or_Empty(char const * str);
 
+    /// @brief Returns the amount of milliseconds that have passed since the device has been started
+    /// @note Uses the ESP Timer if it exists, otherwise the Arduino millis() method is used instead. In both cases the returned value overflows roughly every 50 days,
+    /// meaning differences between two returned values should always be calculated with unsigned subtraction to handle that case correctly
+    /// @return Amount of milliseconds that have passed since the device has been started
+    static uint32_t Get_Milliseconds();
+
     /// @brief Splits the topic at the given position and extracts the request id parameter from the remaining string
     /// @note Should contain the request id that the original request was sent with. Is used to know which received response is connected to which inital request,
     /// so that the correct request can be informed that a response has been received.
@@ -25,12 +25,19 @@ char constexpr REQUEST_ID_NULL[] = "Internal request id is NULL";
 // RPC data keys.
 char constexpr RPC_METHOD_KEY[] = "method";
 char constexpr RPC_PARAMS_KEY[] = "params";
-// Shared attribute update API topics.
-char constexpr ATTRIBUTE_TOPIC[] = "v1/devices/me/attributes";
 // Shared attribute request keys.
 char constexpr SHARED_RESPONSE_KEY[] = "shared";
+#if THINGSBOARD_ENABLE_SHORT_TOPICS
+// Shared attribute update API topics.
+char constexpr ATTRIBUTE_TOPIC[] = "v2/a";
+// Publish data topics.
+char constexpr TELEMETRY_TOPIC[] = "v2/t";
+#else
+// Shared attribute update API topics.
+char constexpr ATTRIBUTE_TOPIC[] = "v1/devices/me/attributes";
 // Publish data topics.
 char constexpr TELEMETRY_TOPIC[] = "v1/devices/me/telemetry";
+#endif // THINGSBOARD_ENABLE_SHORT_TOPICS
 
 
 /// @brief Base functionality required by all API implementation
@@ -63,16 +70,41 @@ class IAPI_Implementation {
     /// @param data Payload sent by the server over our given topic, that contains our key value pairs
     virtual void Process_Json_Response(char const * topic, JsonDocument const & data) = 0;
 
-    /// @brief Compares received response topic and the topic this api implementation handles responses on,
-    /// messages from all other topics are ignored and only messages from topics that match are handled
-    /// @note For the comparsion we either compare the full expected string with null termination,
-    /// if the response topic does not include additional parameters, example being shared attribute update (v1/devices/me/attributes).
-    /// Or we compare only before the null termination for topics that include additional parameters in the response.
+    /// @brief Returns the topic this api implementation handles responses on, messages from all other topics are ignored and only messages from topics that match are handled
+    /// @note Used once the api implementation is subscribed to insert it into the dispatch table of the ThingsBoard client, which finds all matching api implementations by walking the received topic only once.
+    /// The topic is either compared fully with null termination, if the response topic does not include additional parameters, example being shared attribute update (v1/devices/me/attributes).
+    /// Or only as a prefix for topics that include additional parameters in the response.
     /// Like for example the original request id in the response of the attribute request (v1/devices/me/attributes/response/1)
+    /// @param exact Set to whether the received topic has to match the returned topic fully, or whether it only has to start with it
+    /// @return Non owning pointer to the topic, has to be kept alive for as long as the api implementation is subscribed, because it is not copied
+    virtual char const * Get_Response_Topic(bool & exact) const = 0;
+
+    /// @brief Adds the keys this api implementation reads from the json response received over the given topic to the given deserialization filter,
+    /// all other keys are skipped while deserializing and therefore neither require any memory in the JsonDocument nor any time to be parsed
+    /// @note Only called if Get_Process_Type returns API_Process_Type::JSON, before the received response is deserialized and passed to Process_Json_Response.
+    /// Keys are added by setting them to true (filter[key] = true), which keeps the complete value of the key, or by adding them to a nested object (filter[key][nested_key] = true), which only keeps the given nested keys.
+    /// See https://arduinojson.org/v6/api/json/deserializejson/#filtering for more information on the filter
+    /// @param topic Non owning pointer to the previously subscribed topic, we got the response over.
+    /// Does not need to be kept alive, because the topic is only used for the scope of the method itself
+    /// @param filter Filter that should contain every key required by the subscribed callbacks, keys added as char const * are not copied and therefore have to be kept alive until the response has been processed
+    /// @return Whether the response can be filtered or whether every key of the response is required, because atleast one callback is subscribed to any key.
+    /// API implementations whose callbacks receive the complete response can keep the default implementation, which always returns false
+    virtual bool Add_Json_Filter(char const * topic, JsonDocument & filter) const {
+        (void)topic;
+        (void)filter;
+        return false;
+    }
+
+    /// @brief Returns the amount of keys @ref Add_Json_Filter adds to the deserialization filter for the json response received over the given topic, every nested key and every object containing nested keys counts as a seperate key
+    /// @note Called before the filter is allocated, so that its size only depends on the keys of the subscribed callbacks and not on the received payload. May return more keys than are actually added, for example if multiple callbacks are subscribed to the same key.
+    /// API implementations that can not filter their responses, because their callbacks receive the complete response, can keep the default implementation, which always returns 0
     /// @param topic Non owning pointer to the previously subscribed topic, we got the response over.
     /// Does not need to be kept alive, because the topic is only used for the scope of the method itself
-    /// @return Whether the received response topic matches the topic this api implementation handles responses on
-    virtual bool Is_Response_Topic_Matching(char const * topic) const = 0;
+    /// @return Maximum amount of keys added to the filter, 0 if the response can not be filtered or no key would be added, in which case the response is deserialized without a filter
+    virtual size_t Get_Json_Filter_Size(char const * topic) const {
+        (void)topic;
+        return 0U;
+    }
 
     /// @brief Unsubcribes all callbacks, to clear up any ongoing subscriptions and stop receiving information over the previously subscribed topic
     /// @return Whether unsubscribing all the previously subscribed callbacks
@@ -97,6 +129,24 @@ class IAPI_Implementation {
     /// in this method instead, because it ensures all member methods are instantiated already
     virtual void Initialize() = 0;
 
+#if THINGSBOARD_ENABLE_DYNAMIC
+    /// @brief Sets the maximum amount of bytes that are allocated for a JsonDocument created while processing a response, for example the params of a protobuf RPC request
+    /// @note Directly set by the used ThingsBoard client to the value passed to its constructor or its Set_Max_Response_Size method, so that responses that are not deserialized by the client itself are guarded the same way.
+    /// API implementations that do not allocate any JsonDocument, while processing a response, can keep the default implementation, which ignores the value
+    /// @param max_response_size Maximum amount of bytes allocated for a JsonDocument holding parts of a received response, 0 means there is no limit
+    virtual void Set_Max_Response_Size(size_t const & max_response_size) {
+        (void)max_response_size;
+    }
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+
+    /// @brief Sets the callback that sends a JsonDocument serialized as json and wrapped into a single length delimited field of a protobuf message, used to answer requests received as protobuf
+    /// @note Directly set by the used ThingsBoard client to its internal method, which encodes the message directly into its internal send buffer or streams it into the client, if the message is bigger than the send buffer size.
+    /// API implementations that never send protobuf messages can keep the default implementation, which ignores the callback
+    /// @param send_protobuf_json_callback Method which allows to send a JsonDocument wrapped into the given protobuf field number, points to Send_Control_Protobuf_Json per default
+    virtual void Set_Send_Protobuf_Json_Callback(Callback<bool, char const * const, uint32_t, JsonDocument const &>::function send_protobuf_json_callback) {
+        (void)send_protobuf_json_callback;
+    }
+
     /// @brief Sets the underlying callbacks that are required for the different API Implementation to communicate with the cloud
     /// @note Directly set by the used ThingsBoard client to its internal methods, therefore calling again and overriding as a user ist not recommended, unless you know what you are doing
     /// @param subscribe_api_callback Method which allows to subscribe additional API endpoints, points to Subscribe_API_Implementation per default
@@ -6,11 +6,7 @@
 #include "DefaultLogger.h"
 #include "MQTT_Connection_State.h"
 #include "MQTT_Connection_Error.h"
-
-// Library include.
-#if THINGSBOARD_ENABLE_STREAM_UTILS
-#include <Print.h>
-#endif // THINGSBOARD_ENABLE_STREAM_UTILS
+#include "MQTT_QoS.h"
 
 
 /// @brief MQTT Client interface that contains the method that a class that can be used to send and receive data over an MQTT connection should implement
@@ -21,20 +17,11 @@
 /// For Espressif IDF however the default MQTT Client is the esp-mqtt (https://docs.espressif.com/projects/esp-idf/en/latest/esp32/api-reference/protocols/mqtt.html) component.
 /// The aforementioned recommendations are already implemented in the library and can can simply be used and included when using the library, for Arduino the Arduino_MQTT_Client can simply be included
 /// and for Espressif IDF the Espressif_MQTT_Client can simply be included, the implementations have been tested and should be compatible when used in conjunction with the ThingsBoard client.
-/// Alternatively when using Arduino it is possible to enable support for THINGSBOARD_ENABLE_STREAM_UTILS by importing the ArduinoStreamUtils (https://github.com/bblanchon/ArduinoStreamUtils) in the project.
-/// This feature allows to improve the underlying data streams by directly writing the data into the MQTT Client instead of into an output buffer,
-/// but writing each byte one by one, would be too slow, therefore the ArduinoStreamUtils (https://github.com/bblanchon/ArduinoStreamUtils) library is used to buffer those calls into bigger packets.
-/// This allows sending data that is very big without requiring to allocate that much memory, because it is sent in smaller packets.
-/// To support this feature, however this interface needs to additionally implement the Print interface, because that is required by the wrapper class BufferingPrint, which only exists on Arduino
-/// This then allows to send arbitrary size payloads if that is done the internal buffer of the MQTT Client implementation
-/// can theoretically set the value as big as the buffering_size passed to the constructor + enough memory to hold the topic and MQTT Header ~= 20 bytes.
-/// This will mean though that all messages are sent over the StreamUtils library as long as they are bigger than the internal send buffer size,
-/// which needs more time than sending a message directly but has the advantage of requiring less memory
-#if THINGSBOARD_ENABLE_STREAM_UTILS
-class IMQTT_Client : public Print {
-#else
+/// Additionally the interface allows to stream payloads that are bigger than the internal send buffer of the MQTT client implementation, with the begin_publish(), write() and end_publish() methods.
+/// The ThingsBoard client uses this to send arbitrary size payloads, by serializing them directly into the MQTT client in smaller packets instead of into an output buffer that has to hold the complete payload.
+/// To ensure the single bytes are not written one by one, which would be too slow, they are first combined in a small buffer (see @ref Buffered_Publish_Writer) and then written in bigger packets.
+/// This allows sending data that is very big without requiring to allocate that much memory, but needs more time than sending a message directly
 class IMQTT_Client {
-#endif // THINGSBOARD_ENABLE_STREAM_UTILS
   public:
     /// @copydoc Callback::~Callback
     virtual ~IMQTT_Client() {}
@@ -61,15 +48,8 @@ class IMQTT_Client {
     /// @param send_buffer_size Maximum amount of data that can be sent via MQTT at once,
     /// expected behaviour is that, if we attempt to send data that is bigger, it will simply not be sent and a message is printed to the console instead.
     /// Should be big enough to hold the biggest request that is expected to be ever sent by the device at once.
-    /// Alternatively when using Arduino it is possible to enable support for THINGSBOARD_ENABLE_STREAM_UTILS by importing the ArduinoStreamUtils (https://github.com/bblanchon/ArduinoStreamUtils) in the project.
-    /// This feature allows to improve the underlying data streams by directly writing the data into the MQTT Client instead of into an output buffer,
-    /// but writing each byte one by one, would be too slow, therefore the ArduinoStreamUtils (https://github.com/bblanchon/ArduinoStreamUtils) library is used to buffer those calls into bigger packets.
-    /// This allows sending data that is very big without requiring to allocate that much memory, because it is sent in smaller packets.
-    /// To support this feature, however this interface needs to additionally implement the Print interface, because that is required by the wrapper class BufferingPrint, which only exists on Arduino
-    /// This then allows to send arbitrary size payloads if that is done the internal buffer of the MQTT Client implementation
-    /// can theoretically set the value as big as the buffering_size passed to the constructor + enough memory to hold the topic and MQTT Header ~= 20 bytes.
-    /// This will mean though that all messages are sent over the StreamUtils library as long as they are bigger than the internal send buffer size,
-    /// which needs more time than sending a message directly but has the advantage of requiring less memory
+    /// If the ThingsBoard client attempts to send a payload that is bigger than the send buffer size, it is instead streamed with the begin_publish(), write() and end_publish() methods,
+    /// this allows to send arbitrary size payloads while keeping the send buffer as small as the biggest message that is commonly sent
     /// @return Whether allocating the needed memory for the given buffer sizes was successful or not
     virtual bool set_buffer_size(uint16_t receive_buffer_size, uint16_t send_buffer_size) = 0;
 
@@ -165,11 +145,12 @@ class IMQTT_Client {
     /// @param callback Method that should be called on state changes to our MQTT connection 
     virtual void subscribe_connection_state_changed_callback(Callback<void, MQTT_Connection_State, MQTT_Connection_Error>::function callback) = 0;
 
-#if THINGSBOARD_ENABLE_STREAM_UTILS
-
     /// @brief Start to publish a message over a given topic, without being restricted to the internal buffer size
     /// @note Allows for arbitrarily large payloads to be sent without them having to be copied into a new buffer and held in memory.
-    /// To use this feature first call begin_publish(), followed by multiple calls to write() and then ending with a call to end_publish()
+    /// To use this feature first call begin_publish(), followed by multiple calls to write() and then ending with a call to end_publish().
+    /// The amount of bytes written in between has to be exactly the given length, because the length has to be sent in the MQTT header before the payload itself.
+    /// Whether the payload is actually streamed depends on the implementation, clients whose underlying library can not write a publish message incrementally (for example the Espressif_MQTT_Client)
+    /// instead allocate a heap buffer of the complete length plus the topic and only send the message in end_publish(), meaning payloads bigger than the free heap can not be sent with them
     /// @param topic Non owning pointer to topic that the message is sent over, where different MQTT topics expect a different kind of payload.
     /// Does not need to kept alive as the function copies the data into the outgoing MQTT buffer to begin publishing to the given topic
     /// @param length Length of the payload in bytes
@@ -180,10 +161,6 @@ class IMQTT_Client {
     /// @return Whether the complete packet was sent successfully or not
     virtual bool end_publish() = 0;
 
-    //----------------------------------------------------------------------------
-    // Print interface
-    //----------------------------------------------------------------------------
-
     /// @brief Sends a single byte of payload to be published, is meant to be used after having called begin_publish()
     /// @note Once the complete payload has been written ensure to call end_publish() to send any remaining bytes.
     /// Because payload bytes are sent one by one this method is extremly inefficient,
@@ -200,7 +177,53 @@ class IMQTT_Client {
     /// @return The amount of bytes successfully written
     virtual size_t write(uint8_t const * buffer, size_t const & size) = 0;
 
-#endif // THINGSBOARD_ENABLE_STREAM_UTILS
+    /// @brief Returns the amount of bytes of already published messages, that are still waiting in the outbox of the client to be sent to the MQTT broker
+    /// @note Only clients that send messages asynchronously from their own task have an outbox, for example the @ref Espressif_MQTT_Client if enqueueing messages has been enabled.
+    /// Clients that send messages directly in the publish() call, like the @ref Arduino_MQTT_Client, can keep the default implementation, which always returns 0.
+    /// Allows the ThingsBoard client to detect that messages are published faster than the client can send them, before the outbox grows until no heap memory is left
+    /// @return Amount of bytes currently waiting in the outbox
+    virtual size_t get_outbox_size() {
+        return 0U;
+    }
+
+    /// @brief Reserves a topic alias for the given topic, which allows to replace the topic with a 2 byte alias in every following message published on exactly that topic
+    /// @note Topic aliases are a feature of MQTT 5, the alias is sent together with the full topic in the first message after every connect and instead of the topic in all following messages published with QoS 0.
+    /// Messages published with QoS 1 always have to contain the full topic as well, because they are resent after a reconnect, once the broker does not know the alias anymore.
+    /// Meant for the fixed topics that are published to frequently, like the telemetry and attribute topic, because topics that contain a changing request id would only waste the limited amount of aliases.
+    /// Clients that only support MQTT 3.1.1, like the @ref Arduino_MQTT_Client, can keep the default implementation, which always returns false and therefore keeps sending the full topic instead
+    /// @param topic Non owning pointer to the topic the alias is reserved for, has to be kept alive for as long as the client is used, because it is not copied
+    /// @return Whether an alias could be reserved for the given topic or not
+    virtual bool reserve_topic_alias(char const * topic) {
+        (void)topic;
+        return false;
+    }
+
+    /// @brief Sets the quality of service all following messages are published with, until it is changed again. Applies to both publish() and the complete message started with begin_publish()
+    /// @note Allows the ThingsBoard client to select the quality of service per class of message, for example confirmed attributes and RPC responses but unconfirmed bulk telemetry.
+    /// Clients that can only publish with QoS 0, like the @ref Arduino_MQTT_Client, can keep the default implementation, which returns false for every other level and keeps publishing with QoS 0 instead
+    /// @param qos Quality of service the following messages are published with
+    /// @return Whether the client supports publishing with the given quality of service or not
+    virtual bool set_publish_qos(MQTT_QoS qos) {
+        return qos == MQTT_QoS::AT_MOST_ONCE;
+    }
+
+    /// @brief Returns the packet id of the last message that was successfully published with QoS 1, which is contained in the PUBACK the broker confirms that message with
+    /// @note Has to be read directly after publish() or end_publish() returned, because the id is overwritten by the next published message.
+    /// Clients that can only publish with QoS 0 can keep the default implementation, which always returns 0
+    /// @return Packet id of the last published message, or 0 if it was published with QoS 0 and therefore never confirmed
+    virtual uint16_t get_last_packet_id() const {
+        return 0U;
+    }
+
+    /// @brief Sets the callback that is called, once a message published with QoS 1 has either been confirmed by the broker or has been dropped by the client without being confirmed
+    /// @note The callback is called with the packet id of the message, as returned by @ref get_last_packet_id and whether the message was confirmed (true) or dropped (false).
+    /// Clients that send messages from their own task, like the @ref Espressif_MQTT_Client, call it from that task as well. Clients that never publish with QoS 1 never call the callback
+    /// and can therefore keep the default implementation, which ignores the callback.
+    /// Directly set by the used ThingsBoard client to its internal method, therefore calling again and overriding as a user ist not recommended, unless you know what you are doing
+    /// @param callback Method that should be called once a message published with QoS 1 has been confirmed or dropped
+    virtual void set_delivery_callback(Callback<void, uint16_t, bool>::function callback) {
+        (void)callback;
+    }
 };
 
 #endif // IMQTT_Client_h
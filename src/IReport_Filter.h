@@ -0,0 +1,39 @@
+#ifndef IReport_Filter_h
+#define IReport_Filter_h
+
+// Local include.
+#include "Telemetry.h"
+
+
+/// @brief Report filter interface that contains the methods a class that decides whether a key-value pair has to be sent (report-by-exception), has to implement
+/// @note The filter is asked for every key-value pair before any json is built, key-value pairs that are not reportable are dropped from the message.
+/// Once the message has been sent successfully, the filter is informed about every key-value pair that was contained in it, so that it can remember the last reported value
+class IReport_Filter {
+  public:
+    /// @copydoc Callback::~Callback
+    virtual ~IReport_Filter() {}
+
+    /// @brief Informs the filter that a new message is built, called once before @ref Is_Reportable is called for any of the key-value pairs contained in it
+    /// @note @ref Is_Reportable is called once for every key-value pair of the message and @ref Reported once for every reported key-value pair after the message has been sent,
+    /// therefore results that are expensive to calculate (like the hash of the serialized value) can be cached until the next call. Filters that are cheap to evaluate can keep the default implementation, which does nothing
+    virtual void Begin_Report() {
+        // Nothing to do
+    }
+
+    /// @brief Whether the given key-value pair has to be sent, has to return the same result if called multiple times with the same arguments and without calling @ref Reported inbetween
+    /// @param data Key-value pair that should be sent
+    /// @param current_time Amount of milliseconds that have passed since the device has been started, see Helper::Get_Milliseconds
+    /// @return Whether the key-value pair has to be sent
+    virtual bool Is_Reportable(Telemetry const & data, uint32_t const & current_time) = 0;
+
+    /// @brief Informs the filter that the given key-value pair has been sent successfully
+    /// @param data Key-value pair that has been sent
+    /// @param current_time Amount of milliseconds that have passed since the device has been started, is the same value that was passed to @ref Is_Reportable
+    virtual void Reported(Telemetry const & data, uint32_t const & current_time) = 0;
+
+    /// @brief Forgets the last reported value of every key, so that the next value of every key is reported again
+    /// @note Called for the attribute filter by the ThingsBoard client itself, once a new session with the MQTT broker has been established, see @ref ThingsBoardSized::Set_Attribute_Filter
+    virtual void Reset() = 0;
+};
+
+#endif // IReport_Filter_h
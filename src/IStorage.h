@@ -0,0 +1,48 @@
+#ifndef IStorage_h
+#define IStorage_h
+
+// Library include.
+#include <stddef.h>
+#include <stdint.h>
+
+
+/// @brief Storage interface that contains the methods a class that can be used to persist data across reboots, for example in a flash partition or in files on an SD card, has to implement
+/// @note The storage is split into a fixed amount of equally sized segments, that behave like the sectors of NOR flash memory.
+/// Meaning a segment has to be erased before it is written again, erased bytes read as 0xFF and already written bytes are only ever written again to clear bits (0xFF to 0x00).
+/// This allows to implement the interface directly on top of raw flash memory without any additional wear leveling or file system layer, while files simply emulate the same behaviour
+class IStorage {
+  public:
+    /// @copydoc Callback::~Callback
+    virtual ~IStorage() {}
+
+    /// @brief Returns the amount of segments the storage is split into
+    /// @return Amount of segments
+    virtual size_t get_segment_amount() = 0;
+
+    /// @brief Returns the size of a single segment, has to be the same for all segments
+    /// @return Size of a single segment in bytes
+    virtual size_t get_segment_size() = 0;
+
+    /// @brief Reads the given amount of bytes from the given segment, bytes that have not been written since the segment was erased have to be read as 0xFF
+    /// @param segment Index of the segment that should be read from
+    /// @param offset Offset into the segment the read bytes start at
+    /// @param buffer Buffer the read bytes are copied into, has to be big enough to hold the given size
+    /// @param size Amount of bytes that should be read
+    /// @return Whether reading the bytes was successful or not
+    virtual bool read(size_t const & segment, size_t const & offset, uint8_t * buffer, size_t const & size) = 0;
+
+    /// @brief Writes the given bytes into the given segment and ensures they are persisted before returning
+    /// @param segment Index of the segment that should be written to
+    /// @param offset Offset into the segment the written bytes start at
+    /// @param buffer Bytes that should be written
+    /// @param size Amount of bytes that should be written
+    /// @return Whether writing the bytes was successful or not
+    virtual bool write(size_t const & segment, size_t const & offset, uint8_t const * buffer, size_t const & size) = 0;
+
+    /// @brief Erases the complete given segment, so that all its bytes read as 0xFF afterwards
+    /// @param segment Index of the segment that should be erased
+    /// @return Whether erasing the segment was successful or not
+    virtual bool erase(size_t const & segment) = 0;
+};
+
+#endif // IStorage_h
@@ -0,0 +1,328 @@
+// Header include.
+#include "Json_Serializer.h"
+
+/// @brief Amount of bits of the significand of a double, without the implicit leading bit
+uint8_t constexpr DOUBLE_SIGNIFICAND_BITS = 52U;
+/// @brief Offset between the stored exponent of a double and the exponent of its significand interpreted as an integer
+int16_t constexpr DOUBLE_EXPONENT_BIAS = 1075;
+/// @brief Amount of bits of the significand of a float, without the implicit leading bit
+uint8_t constexpr FLOAT_SIGNIFICAND_BITS = 23U;
+/// @brief Offset between the stored exponent of a float and the exponent of its significand interpreted as an integer
+int16_t constexpr FLOAT_EXPONENT_BIAS = 150;
+/// @brief Biggest decimal exponent, that is still written in positional notation instead of scientific notation by the shortest representation, same as JavaScript
+int16_t constexpr MAX_POSITIONAL_EXPONENT = 21;
+/// @brief Smallest decimal exponent, that is still written in positional notation instead of scientific notation by the shortest representation, same as JavaScript
+int16_t constexpr MIN_POSITIONAL_EXPONENT = -5;
+/// @brief Biggest value that can be scaled into an integer with fixed decimal places, without losing precision, is 2^53
+double constexpr MAX_FIXED_SCALED_VALUE = 9007199254740992.0;
+/// @brief Powers of ten that fit into a 64-bit unsigned integer, used to split the generated digits and to scale fixed decimal places
+uint64_t constexpr POWERS_OF_TEN[] = {
+    UINT64_C(1), UINT64_C(10), UINT64_C(100), UINT64_C(1000), UINT64_C(10000), UINT64_C(100000), UINT64_C(1000000), UINT64_C(10000000), UINT64_C(100000000), UINT64_C(1000000000),
+    UINT64_C(10000000000), UINT64_C(100000000000), UINT64_C(1000000000000), UINT64_C(10000000000000), UINT64_C(100000000000000), UINT64_C(1000000000000000),
+    UINT64_C(10000000000000000), UINT64_C(100000000000000000), UINT64_C(1000000000000000000), UINT64_C(10000000000000000000)
+};
+
+namespace {
+
+/// @brief Floating point number with a 64-bit significand and a binary exponent, that is not limited to the precision of the built-in types (f * 2^e)
+struct Diy_Fp {
+    uint64_t f; // Significand
+    int16_t  e; // Binary exponent
+};
+
+/// @brief Normalized powers of ten (10^-348, 10^-340, ..., 10^340), where every power has its most significant bit set, allows to scale any double into the range the digits are generated in
+uint64_t constexpr CACHED_POWER_SIGNIFICANDS[] = {
+        UINT64_C(0xfa8fd5a0081c0288), UINT64_C(0xbaaee17fa23ebf76), UINT64_C(0x8b16fb203055ac76), UINT64_C(0xcf42894a5dce35ea),
+        UINT64_C(0x9a6bb0aa55653b2d), UINT64_C(0xe61acf033d1a45df), UINT64_C(0xab70fe17c79ac6ca), UINT64_C(0xff77b1fcbebcdc4f),
+        UINT64_C(0xbe5691ef416bd60c), UINT64_C(0x8dd01fad907ffc3c), UINT64_C(0xd3515c2831559a83), UINT64_C(0x9d71ac8fada6c9b5),
+        UINT64_C(0xea9c227723ee8bcb), UINT64_C(0xaecc49914078536d), UINT64_C(0x823c12795db6ce57), UINT64_C(0xc21094364dfb5637),
+        UINT64_C(0x9096ea6f3848984f), UINT64_C(0xd77485cb25823ac7), UINT64_C(0xa086cfcd97bf97f4), UINT64_C(0xef340a98172aace5),
+        UINT64_C(0xb23867fb2a35b28e), UINT64_C(0x84c8d4dfd2c63f3b), UINT64_C(0xc5dd44271ad3cdba), UINT64_C(0x936b9fcebb25c996),
+        UINT64_C(0xdbac6c247d62a584), UINT64_C(0xa3ab66580d5fdaf6), UINT64_C(0xf3e2f893dec3f126), UINT64_C(0xb5b5ada8aaff80b8),
+        UINT64_C(0x87625f056c7c4a8b), UINT64_C(0xc9bcff6034c13053), UINT64_C(0x964e858c91ba2655), UINT64_C(0xdff9772470297ebd),
+        UINT64_C(0xa6dfbd9fb8e5b88f), UINT64_C(0xf8a95fcf88747d94), UINT64_C(0xb94470938fa89bcf), UINT64_C(0x8a08f0f8bf0f156b),
+        UINT64_C(0xcdb02555653131b6), UINT64_C(0x993fe2c6d07b7fac), UINT64_C(0xe45c10c42a2b3b06), UINT64_C(0xaa242499697392d3),
+        UINT64_C(0xfd87b5f28300ca0e), UINT64_C(0xbce5086492111aeb), UINT64_C(0x8cbccc096f5088cc), UINT64_C(0xd1b71758e219652c),
+        UINT64_C(0x9c40000000000000), UINT64_C(0xe8d4a51000000000), UINT64_C(0xad78ebc5ac620000), UINT64_C(0x813f3978f8940984),
+        UINT64_C(0xc097ce7bc90715b3), UINT64_C(0x8f7e32ce7bea5c70), UINT64_C(0xd5d238a4abe98068), UINT64_C(0x9f4f2726179a2245),
+        UINT64_C(0xed63a231d4c4fb27), UINT64_C(0xb0de65388cc8ada8), UINT64_C(0x83c7088e1aab65db), UINT64_C(0xc45d1df942711d9a),
+        UINT64_C(0x924d692ca61be758), UINT64_C(0xda01ee641a708dea), UINT64_C(0xa26da3999aef774a), UINT64_C(0xf209787bb47d6b85),
+        UINT64_C(0xb454e4a179dd1877), UINT64_C(0x865b86925b9bc5c2), UINT64_C(0xc83553c5c8965d3d), UINT64_C(0x952ab45cfa97a0b3),
+        UINT64_C(0xde469fbd99a05fe3), UINT64_C(0xa59bc234db398c25), UINT64_C(0xf6c69a72a3989f5c), UINT64_C(0xb7dcbf5354e9bece),
+        UINT64_C(0x88fcf317f22241e2), UINT64_C(0xcc20ce9bd35c78a5), UINT64_C(0x98165af37b2153df), UINT64_C(0xe2a0b5dc971f303a),
+        UINT64_C(0xa8d9d1535ce3b396), UINT64_C(0xfb9b7cd9a4a7443c), UINT64_C(0xbb764c4ca7a44410), UINT64_C(0x8bab8eefb6409c1a),
+        UINT64_C(0xd01fef10a657842c), UINT64_C(0x9b10a4e5e9913129), UINT64_C(0xe7109bfba19c0c9d), UINT64_C(0xac2820d9623bf429),
+        UINT64_C(0x80444b5e7aa7cf85), UINT64_C(0xbf21e44003acdd2d), UINT64_C(0x8e679c2f5e44ff8f), UINT64_C(0xd433179d9c8cb841),
+        UINT64_C(0x9e19db92b4e31ba9), UINT64_C(0xeb96bf6ebadf77d9), UINT64_C(0xaf87023b9bf0ee6b)
+};
+/// @brief Binary exponents of @ref CACHED_POWER_SIGNIFICANDS
+int16_t constexpr CACHED_POWER_EXPONENTS[] = {
+        -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980,
+        -954, -927, -901, -874, -847, -821, -794, -768, -741, -715,
+        -688, -661, -635, -608, -582, -555, -529, -502, -475, -449,
+        -422, -396, -369, -343, -316, -289, -263, -236, -210, -183,
+        -157, -130, -103, -77, -50, -24, 3, 30, 56, 83,
+        109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+        375, 402, 428, 455, 481, 508, 534, 561, 588, 614,
+        641, 667, 694, 720, 747, 774, 800, 827, 853, 880,
+        907, 933, 960, 986, 1013, 1039, 1066
+};
+/// @brief Decimal exponent of the first cached power
+int16_t constexpr CACHED_POWER_MIN_DECIMAL_EXPONENT = -348;
+/// @brief Distance between the decimal exponents of two consecutive cached powers
+int16_t constexpr CACHED_POWER_DECIMAL_EXPONENT_STEP = 8;
+
+/// @brief Multiplies the given numbers, where the lower half of the 128-bit product is only used to round the upper half
+/// @param x First factor
+/// @param y Second factor
+/// @return Product of both factors
+Diy_Fp Multiply(Diy_Fp const & x, Diy_Fp const & y) {
+    uint64_t constexpr lower_mask = UINT32_MAX;
+    uint64_t const a = x.f >> 32U;
+    uint64_t const b = x.f & lower_mask;
+    uint64_t const c = y.f >> 32U;
+    uint64_t const d = y.f & lower_mask;
+    uint64_t const ac = a * c;
+    uint64_t const bc = b * c;
+    uint64_t const ad = a * d;
+    uint64_t const bd = b * d;
+    uint64_t const middle = (bd >> 32U) + (ad & lower_mask) + (bc & lower_mask) + (UINT64_C(1) << 31U);
+    return { ac + (ad >> 32U) + (bc >> 32U) + (middle >> 32U), static_cast<int16_t>(x.e + y.e + 64) };
+}
+
+/// @brief Shifts the significand of the given number to the left, until its most significant bit is set
+/// @param value Number that should be normalized, the significand may not be 0
+/// @return Normalized number
+Diy_Fp Normalize(Diy_Fp value) {
+#if defined(__GNUC__)
+    // Counting the leading zeros is a single instruction on most platforms, compared to shifting bit by bit for every bit of precision the value is missing
+    uint8_t const shift = static_cast<uint8_t>(__builtin_clzll(value.f));
+    value.f <<= shift;
+    value.e -= shift;
+#else
+    while ((value.f & (UINT64_C(1) << 63U)) == 0U) {
+        value.f <<= 1U;
+        value.e--;
+    }
+#endif // defined(__GNUC__)
+    return value;
+}
+
+/// @brief Returns the cached power of ten, that scales a number with the given binary exponent into the range the digits are generated in
+/// @param exponent Binary exponent of the normalized upper boundary
+/// @param decimal_exponent Set to the negated decimal exponent of the returned power of ten
+/// @return Cached power of ten
+Diy_Fp Get_Cached_Power(int16_t const & exponent, int16_t & decimal_exponent) {
+    // Calculates ceil((-61 - exponent) * log10(2)), which is the decimal exponent that moves the binary exponent into the range [-60, -32].
+    // Uses the fixed point approximation log10(2) ~ 78913 / 2^18 instead of floating point arithmetic, which is exact for every exponent of a double and avoids software floating point on microcontrollers without a double precision unit
+    int32_t const product = static_cast<int32_t>(-61 - exponent) * 78913;
+    int16_t const k = static_cast<int16_t>(-((-product) >> 18) + 347);
+    size_t const index = static_cast<size_t>((k >> 3) + 1);
+    decimal_exponent = -(CACHED_POWER_MIN_DECIMAL_EXPONENT + static_cast<int16_t>(index) * CACHED_POWER_DECIMAL_EXPONENT_STEP);
+    return { CACHED_POWER_SIGNIFICANDS[index], CACHED_POWER_EXPONENTS[index] };
+}
+
+/// @brief Decrements the last generated digit, as long as that moves the digits closer to the exact value while still staying inside the rounding interval
+/// @param buffer Generated digits
+/// @param length Amount of generated digits
+/// @param delta Size of the rounding interval
+/// @param rest Distance of the generated digits to the upper boundary
+/// @param ten_kappa Weight of the last generated digit
+/// @param distance Distance of the exact value to the upper boundary
+void Round_Weed(char * buffer, uint8_t const & length, uint64_t const & delta, uint64_t rest, uint64_t const & ten_kappa, uint64_t const & distance) {
+    while (rest < distance && delta - rest >= ten_kappa && (rest + ten_kappa < distance || distance - rest > rest + ten_kappa - distance)) {
+        buffer[length - 1U]--;
+        rest += ten_kappa;
+    }
+}
+
+/// @brief Generates the shortest digits, that still lie inside the rounding interval of the scaled value (Grisu2, see https://www.cs.tufts.edu/~nr/cs257/archive/florian-loitsch/printf.pdf)
+/// @param value Scaled value
+/// @param upper Scaled upper boundary of the rounding interval
+/// @param delta Size of the scaled rounding interval
+/// @param buffer Buffer the digits are written into, has to fit at least 20 digits
+/// @param decimal_exponent Decimal exponent of the scaling, is increased by the amount of digits that did not need to be generated
+/// @return Amount of generated digits
+uint8_t Generate_Digits(Diy_Fp const & value, Diy_Fp const & upper, uint64_t delta, char * buffer, int16_t & decimal_exponent) {
+    uint8_t const shift = static_cast<uint8_t>(-upper.e);
+    uint64_t const one = UINT64_C(1) << shift;
+    uint64_t const distance = upper.f - value.f;
+    uint32_t integral = static_cast<uint32_t>(upper.f >> shift);
+    uint64_t fractional = upper.f & (one - 1U);
+    int16_t kappa = 10;
+    while (kappa > 0 && POWERS_OF_TEN[kappa - 1] > integral) {
+        kappa--;
+    }
+
+    uint8_t length = 0U;
+    while (kappa > 0) {
+        uint32_t const divisor = static_cast<uint32_t>(POWERS_OF_TEN[kappa - 1]);
+        uint32_t const digit = integral / divisor;
+        integral %= divisor;
+        if (digit != 0U || length != 0U) {
+            buffer[length++] = static_cast<char>('0' + digit);
+        }
+        kappa--;
+        uint64_t const rest = (static_cast<uint64_t>(integral) << shift) + fractional;
+        if (rest <= delta) {
+            decimal_exponent += kappa;
+            Round_Weed(buffer, length, delta, rest, POWERS_OF_TEN[kappa] << shift, distance);
+            return length;
+        }
+    }
+    for (;;) {
+        fractional *= 10U;
+        delta *= 10U;
+        uint8_t const digit = static_cast<uint8_t>(fractional >> shift);
+        if (digit != 0U || length != 0U) {
+            buffer[length++] = static_cast<char>('0' + digit);
+        }
+        fractional &= one - 1U;
+        kappa--;
+        if (fractional < delta) {
+            decimal_exponent += kappa;
+            size_t const index = static_cast<size_t>(-kappa);
+            Round_Weed(buffer, length, delta, fractional, one, index < sizeof(POWERS_OF_TEN) / sizeof(POWERS_OF_TEN[0]) ? distance * POWERS_OF_TEN[index] : 0U);
+            return length;
+        }
+    }
+}
+
+/// @brief Writes the given digits with their decimal exponent as json number text, in positional notation for moderate exponents and in scientific notation otherwise
+/// @param buffer Buffer containing the digits at its start, the text is written into the same buffer, has to fit at least 32 characters
+/// @param length Amount of digits
+/// @param exponent Decimal exponent of the digits, meaning the value is the digits interpreted as an integer times 10^exponent
+/// @return Amount of written characters
+uint8_t Format_Digits(char * buffer, uint8_t const & length, int16_t const & exponent) {
+    // Position of the decimal point relative to the first digit, meaning the value lies inside [10^(point - 1), 10^point)
+    int16_t const point = length + exponent;
+    if (exponent >= 0 && point <= MAX_POSITIONAL_EXPONENT) {
+        // 1234e7 -> 12340000000
+        (void)memset(buffer + length, '0', exponent);
+        return static_cast<uint8_t>(point);
+    }
+    else if (point > 0 && point <= MAX_POSITIONAL_EXPONENT) {
+        // 1234e-2 -> 12.34
+        (void)memmove(buffer + point + 1, buffer + point, length - point);
+        buffer[point] = '.';
+        return length + 1U;
+    }
+    else if (point > MIN_POSITIONAL_EXPONENT && point <= 0) {
+        // 1234e-6 -> 0.001234
+        uint8_t const offset = static_cast<uint8_t>(2 - point);
+        (void)memmove(buffer + offset, buffer, length);
+        buffer[0U] = '0';
+        buffer[1U] = '.';
+        (void)memset(buffer + 2U, '0', offset - 2U);
+        return length + offset;
+    }
+
+    // 1234e30 -> 1.234e33 and 1e30 -> 1e30
+    uint8_t size = length;
+    if (length > 1U) {
+        (void)memmove(buffer + 2U, buffer + 1U, length - 1U);
+        buffer[1U] = '.';
+        size++;
+    }
+    buffer[size++] = 'e';
+    int16_t scientific_exponent = point - 1;
+    if (scientific_exponent < 0) {
+        buffer[size++] = '-';
+        scientific_exponent = -scientific_exponent;
+    }
+    if (scientific_exponent >= 100) {
+        buffer[size++] = static_cast<char>('0' + scientific_exponent / 100);
+        scientific_exponent %= 100;
+        buffer[size++] = static_cast<char>('0' + scientific_exponent / 10);
+    }
+    else if (scientific_exponent >= 10) {
+        buffer[size++] = static_cast<char>('0' + scientific_exponent / 10);
+    }
+    buffer[size++] = static_cast<char>('0' + scientific_exponent % 10);
+    return size;
+}
+
+} // namespace
+
+double Json_Serializer::Round_To_Decimal_Places(double const & value, uint8_t decimal_places) {
+    decimal_places = decimal_places < MAX_DECIMAL_PLACES ? decimal_places : MAX_DECIMAL_PLACES;
+    double const scale = static_cast<double>(POWERS_OF_TEN[decimal_places]);
+    double const scaled_value = fabs(value) * scale;
+    if (isnan(value) || isinf(value) || scaled_value >= MAX_FIXED_SCALED_VALUE) {
+        return value;
+    }
+    double const rounded = static_cast<double>(static_cast<uint64_t>(scaled_value + 0.5)) / scale;
+    // Numbers that are rounded to zero lose their sign, so that they are not written as -0
+    return (value < 0.0 && rounded != 0.0) ? -rounded : rounded;
+}
+
+uint8_t Json_Serializer::Format_Shortest(char * buffer, double const & value) {
+    uint64_t bits = 0U;
+    (void)memcpy(&bits, &value, sizeof(bits));
+    return Format_Shortest(buffer, bits & ~(UINT64_C(1) << 63U), DOUBLE_SIGNIFICAND_BITS, DOUBLE_EXPONENT_BIAS);
+}
+
+uint8_t Json_Serializer::Format_Shortest(char * buffer, float const & value) {
+    uint32_t bits = 0U;
+    (void)memcpy(&bits, &value, sizeof(bits));
+    return Format_Shortest(buffer, bits & ~(UINT32_C(1) << 31U), FLOAT_SIGNIFICAND_BITS, FLOAT_EXPONENT_BIAS);
+}
+
+uint8_t Json_Serializer::Format_Shortest(char * buffer, uint64_t const & bits, uint8_t const & significand_bits, int16_t const & exponent_bias) {
+    if (bits == 0U) {
+        buffer[0U] = '0';
+        return 1U;
+    }
+    uint64_t const hidden_bit = UINT64_C(1) << significand_bits;
+    int16_t const biased_exponent = static_cast<int16_t>(bits >> significand_bits);
+    Diy_Fp value = { bits & (hidden_bit - 1U), static_cast<int16_t>(1 - exponent_bias) };
+    if (biased_exponent != 0) {
+        value.f += hidden_bit;
+        value.e = biased_exponent - exponent_bias;
+    }
+
+    // Boundaries are halfway to the neighbouring values, where the lower neighbour is closer if the significand is the smallest possible one of its exponent
+    Diy_Fp const upper = Normalize({ (value.f << 1U) + 1U, static_cast<int16_t>(value.e - 1) });
+    Diy_Fp lower = (value.f == hidden_bit && biased_exponent > 1) ? Diy_Fp{ (value.f << 2U) - 1U, static_cast<int16_t>(value.e - 2) } : Diy_Fp{ (value.f << 1U) - 1U, static_cast<int16_t>(value.e - 1) };
+    lower.f <<= lower.e - upper.e;
+    lower.e = upper.e;
+
+    int16_t decimal_exponent = 0;
+    Diy_Fp const cached_power = Get_Cached_Power(upper.e, decimal_exponent);
+    Diy_Fp const scaled = Multiply(Normalize(value), cached_power);
+    Diy_Fp scaled_upper = Multiply(upper, cached_power);
+    Diy_Fp scaled_lower = Multiply(lower, cached_power);
+    // Boundaries are moved inwards by one unit, to account for the rounding error of the multiplication
+    scaled_lower.f++;
+    scaled_upper.f--;
+    uint8_t const length = Generate_Digits(scaled, scaled_upper, scaled_upper.f - scaled_lower.f, buffer, decimal_exponent);
+    return Format_Digits(buffer, length, decimal_exponent);
+}
+
+uint8_t Json_Serializer::Format_Fixed(char * buffer, double const & value, uint8_t decimal_places) {
+    decimal_places = decimal_places < MAX_DECIMAL_PLACES ? decimal_places : MAX_DECIMAL_PLACES;
+    double const scaled_value = value * static_cast<double>(POWERS_OF_TEN[decimal_places]);
+    if (scaled_value >= MAX_FIXED_SCALED_VALUE) {
+        return 0U;
+    }
+    uint64_t const scaled = static_cast<uint64_t>(scaled_value + 0.5);
+    uint64_t const integral = scaled / POWERS_OF_TEN[decimal_places];
+    uint64_t fractional = scaled % POWERS_OF_TEN[decimal_places];
+    char digits[20U] = {};
+    char const * start = Format_Unsigned_Integer(digits + sizeof(digits), integral);
+    uint8_t size = static_cast<uint8_t>(digits + sizeof(digits) - start);
+    (void)memcpy(buffer, start, size);
+    if (fractional == 0U) {
+        return size;
+    }
+    while (fractional % 10U == 0U) {
+        fractional /= 10U;
+        decimal_places--;
+    }
+    buffer[size++] = '.';
+    for (uint8_t i = decimal_places; i > 0U; i--) {
+        buffer[size + i - 1U] = static_cast<char>('0' + (fractional % 10U));
+        fractional /= 10U;
+    }
+    return size + decimal_places;
+}
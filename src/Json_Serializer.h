@@ -0,0 +1,457 @@
+#ifndef Json_Serializer_h
+#define Json_Serializer_h
+
+// Local includes.
+#include "Configuration.h"
+
+// Library includes.
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+
+// Json literals.
+char constexpr JSON_NULL[] = "null";
+char constexpr JSON_TRUE[] = "true";
+char constexpr JSON_FALSE[] = "false";
+char constexpr HEX_DIGITS[] = "0123456789abcdef";
+// Two decimal digits for every value from 0 to 99, allows to format integers with half the amount of divisions.
+char constexpr DIGIT_PAIRS[] = "00010203040506070809101112131415161718192021222324252627282930313233343536373839404142434445464748495051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+char constexpr BASE64_DIGITS[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+// Amount of base64 characters that are encoded on the stack before they are written, has to be a multiple of 4.
+uint8_t constexpr BASE64_CHUNK_SIZE = 64U;
+// Floating point formatting, uses the same thresholds and amount of decimal places as ArduinoJson.
+uint8_t constexpr MAX_DECIMAL_PLACES = 9U;
+uint32_t constexpr MAX_DECIMAL_PART = 1000000000U;
+double constexpr POSITIVE_EXPONENTIATION_THRESHOLD = 1e7;
+double constexpr NEGATIVE_EXPONENTIATION_THRESHOLD = 1e-5;
+// Size of the buffers on the stack floating point values are formatted into, fits the longest shortest representation (-1.2345678901234567e-308) as well as 16 integral and 9 decimal places.
+uint8_t constexpr REAL_BUFFER_SIZE = 32U;
+#if THINGSBOARD_REAL_FORMAT == THINGSBOARD_REAL_FORMAT_SHORTEST
+// Longest shortest representation is a negative number with 17 significant digits, either in scientific notation with a three digit exponent (-1.2345678901234567e-308)
+// or in positional notation just above the threshold for scientific notation (-0.000012345678901234567), where both are equally long.
+size_t constexpr MAX_REAL_SIZE = 24U;
+#else
+// Longest representation written with up to 9 significant digits is a negative number in scientific notation with a three digit exponent (-1.12345678e-308),
+// the bound additionally fits a negative number just below the exponentiation threshold with 9 decimal places (-9999999.123456789), as written by the fixed decimal places.
+// Fixed decimal places never exceed it either, because they are only used as long as integral and decimal places together fit into the 16 digits of precision of a double
+size_t constexpr MAX_REAL_SIZE = 2U + 7U + MAX_DECIMAL_PLACES;
+#endif // THINGSBOARD_REAL_FORMAT == THINGSBOARD_REAL_FORMAT_SHORTEST
+
+
+/// @brief Static helper class that writes single json values directly as text into a writer, without having to create a JsonDocument beforehand.
+/// @note Is used to serialize flat key-value pairs, where the types of the values are already known, directly into the outgoing buffer. This skips building the JsonDocument node by node,
+/// which would then have to be traversed a second time to serialize it. The given writer is expected to implement a size_t write(uint8_t const * buffer, size_t const & size) method,
+/// which returns the amount of bytes that have been written, like the @ref Fixed_Buffer_Writer or the @ref Buffered_Publish_Writer.
+/// All methods return the total amount of bytes written, which is smaller than the expected size of the value if the writer failed to write some of the bytes
+class Json_Serializer {
+  public:
+    /// @brief Writes the given raw characters without any escaping
+    /// @tparam TWriter Writer class the characters are written into
+    /// @param writer Writer the characters are written into
+    /// @param str Non owning pointer to the characters that should be written
+    /// @param length Amount of characters that should be written
+    /// @return Amount of bytes that have been written
+    template<typename TWriter>
+    static size_t Write_Raw(TWriter & writer, char const * str, size_t const & length) {
+        return writer.write(reinterpret_cast<uint8_t const *>(str), length);
+    }
+
+    /// @brief Writes the given single raw character
+    /// @tparam TWriter Writer class the character is written into
+    /// @param writer Writer the character is written into
+    /// @param character Character that should be written
+    /// @return Amount of bytes that have been written
+    template<typename TWriter>
+    static size_t Write_Character(TWriter & writer, char character) {
+        return Write_Raw(writer, &character, 1U);
+    }
+
+    /// @brief Writes the json null literal
+    /// @tparam TWriter Writer class the literal is written into
+    /// @param writer Writer the literal is written into
+    /// @return Amount of bytes that have been written
+    template<typename TWriter>
+    static size_t Write_Null(TWriter & writer) {
+        return Write_Raw(writer, JSON_NULL, sizeof(JSON_NULL) - 1U);
+    }
+
+    /// @brief Writes the given boolean as the json true or false literal
+    /// @tparam TWriter Writer class the literal is written into
+    /// @param writer Writer the literal is written into
+    /// @param value Boolean that should be written
+    /// @return Amount of bytes that have been written
+    template<typename TWriter>
+    static size_t Write_Boolean(TWriter & writer, bool value) {
+        return value ? Write_Raw(writer, JSON_TRUE, sizeof(JSON_TRUE) - 1U) : Write_Raw(writer, JSON_FALSE, sizeof(JSON_FALSE) - 1U);
+    }
+
+    /// @brief Writes the given string surrounded by quotes, where quotes, backslashes and control characters are escaped
+    /// @note Consecutive characters that do not need to be escaped are written with one call to the writer, to reduce the amount of calls for strings that do not contain any special characters.
+    /// Writes the json null literal instead if the given string is a nullptr
+    /// @tparam TWriter Writer class the string is written into
+    /// @param writer Writer the string is written into
+    /// @param str Non owning pointer to the null terminated string that should be written
+    /// @return Amount of bytes that have been written
+    template<typename TWriter>
+    static size_t Write_String(TWriter & writer, char const * str) {
+        if (str == nullptr) {
+            return Write_Null(writer);
+        }
+        size_t const size = Write_Character(writer, '"') + Write_Escaped(writer, str);
+        return size + Write_Character(writer, '"');
+    }
+
+    /// @brief Writes the given string without surrounding quotes, where quotes, backslashes and control characters are escaped
+    /// @note Allows to write a json string in multiple parts, for example a key followed by a constant suffix ("temperature_avg"), without having to concatenate them beforehand
+    /// @tparam TWriter Writer class the string is written into
+    /// @param writer Writer the string is written into
+    /// @param str Non owning pointer to the null terminated string that should be written, may not be a nullptr
+    /// @return Amount of bytes that have been written
+    template<typename TWriter>
+    static size_t Write_Escaped(TWriter & writer, char const * str) {
+        size_t size = 0U;
+        char const * unescaped_start = str;
+        for (; *str != '\0'; str++) {
+            char const escaped = Get_Escaped_Character(*str);
+            if (escaped == '\0') {
+                continue;
+            }
+            size += Write_Raw(writer, unescaped_start, str - unescaped_start);
+            unescaped_start = str + 1U;
+            if (escaped != 'u') {
+                char const sequence[] = { '\\', escaped };
+                size += Write_Raw(writer, sequence, sizeof(sequence));
+                continue;
+            }
+            char const sequence[] = { '\\', 'u', '0', '0', HEX_DIGITS[(*str >> 4U) & 0x0F], HEX_DIGITS[*str & 0x0F] };
+            size += Write_Raw(writer, sequence, sizeof(sequence));
+        }
+        return size + Write_Raw(writer, unescaped_start, str - unescaped_start);
+    }
+
+    /// @brief Writes the given bytes as a base64 encoded string (RFC 4648 with padding) surrounded by quotes
+    /// @note The bytes are encoded into a small buffer on the stack in multiple parts, meaning the encoded string is never held in memory as a whole
+    /// @tparam TWriter Writer class the string is written into
+    /// @param writer Writer the string is written into
+    /// @param data Non owning pointer to the bytes that should be encoded
+    /// @param size Amount of bytes that should be encoded
+    /// @return Amount of bytes that have been written
+    template<typename TWriter>
+    static size_t Write_Base64(TWriter & writer, uint8_t const * data, size_t const & size) {
+        size_t written = Write_Character(writer, '"');
+        char buffer[BASE64_CHUNK_SIZE] = {};
+        uint8_t length = 0U;
+        for (size_t i = 0U; i < size; i += 3U) {
+            size_t const remaining = size - i;
+            uint32_t const group = (static_cast<uint32_t>(data[i]) << 16U) | (remaining > 1U ? static_cast<uint32_t>(data[i + 1U]) << 8U : 0U) | (remaining > 2U ? data[i + 2U] : 0U);
+            buffer[length++] = BASE64_DIGITS[(group >> 18U) & 0x3F];
+            buffer[length++] = BASE64_DIGITS[(group >> 12U) & 0x3F];
+            buffer[length++] = remaining > 1U ? BASE64_DIGITS[(group >> 6U) & 0x3F] : '=';
+            buffer[length++] = remaining > 2U ? BASE64_DIGITS[group & 0x3F] : '=';
+            if (length == BASE64_CHUNK_SIZE) {
+                written += Write_Raw(writer, buffer, length);
+                length = 0U;
+            }
+        }
+        written += Write_Raw(writer, buffer, length);
+        return written + Write_Character(writer, '"');
+    }
+
+    /// @brief Writes the given signed integer in decimal notation
+    /// @tparam TWriter Writer class the integer is written into
+    /// @param writer Writer the integer is written into
+    /// @param value Integer that should be written
+    /// @return Amount of bytes that have been written
+    template<typename TWriter>
+    static size_t Write_Integer(TWriter & writer, int64_t const & value) {
+        if (value >= 0) {
+            return Write_Unsigned_Integer(writer, static_cast<uint64_t>(value));
+        }
+        // Negating in the unsigned type ensures the minimum value, which has no positive counterpart in the signed type, is written correctly as well
+        return Write_Character(writer, '-') + Write_Unsigned_Integer(writer, UINT64_C(0) - static_cast<uint64_t>(value));
+    }
+
+    /// @brief Writes the given unsigned integer in decimal notation
+    /// @tparam TWriter Writer class the integer is written into
+    /// @param writer Writer the integer is written into
+    /// @param value Integer that should be written
+    /// @return Amount of bytes that have been written
+    template<typename TWriter>
+    static size_t Write_Unsigned_Integer(TWriter & writer, uint64_t const & value) {
+        // Biggest 64-bit unsigned integer 18'446'744'073'709'551'615 has 20 digits
+        char buffer[20U] = {};
+        char const * start = Format_Unsigned_Integer(buffer + sizeof(buffer), value);
+        return Write_Raw(writer, start, buffer + sizeof(buffer) - start);
+    }
+
+    /// @brief Writes the given floating point number in the format selected with THINGSBOARD_REAL_FORMAT, see @ref Write_Real_Compatible, @ref Write_Real_Shortest and @ref Write_Real_Fixed
+    /// @tparam TWriter Writer class the number is written into
+    /// @param writer Writer the number is written into
+    /// @param value Floating point number that should be written
+    /// @return Amount of bytes that have been written
+    template<typename TWriter>
+    static size_t Write_Real(TWriter & writer, double const & value) {
+#if THINGSBOARD_REAL_FORMAT == THINGSBOARD_REAL_FORMAT_SHORTEST
+        return Write_Real_Shortest(writer, value);
+#elif THINGSBOARD_REAL_FORMAT == THINGSBOARD_REAL_FORMAT_FIXED
+        return Write_Real_Fixed(writer, value, THINGSBOARD_REAL_FIXED_DECIMAL_PLACES);
+#else
+        return Write_Real_Compatible(writer, value);
+#endif // THINGSBOARD_REAL_FORMAT == THINGSBOARD_REAL_FORMAT_SHORTEST
+    }
+
+    /// @brief Writes the given single precision floating point number in the format selected with THINGSBOARD_REAL_FORMAT
+    /// @note Only differs from @ref Write_Real for the shortest format, which finds the shortest representation that is parsed back into the same float instead of the same double
+    /// @tparam TWriter Writer class the number is written into
+    /// @param writer Writer the number is written into
+    /// @param value Floating point number that should be written
+    /// @return Amount of bytes that have been written
+    template<typename TWriter>
+    static size_t Write_Float(TWriter & writer, float const & value) {
+#if THINGSBOARD_REAL_FORMAT == THINGSBOARD_REAL_FORMAT_SHORTEST
+        return Write_Real_Shortest(writer, value);
+#else
+        return Write_Real(writer, value);
+#endif // THINGSBOARD_REAL_FORMAT == THINGSBOARD_REAL_FORMAT_SHORTEST
+    }
+
+    /// @brief Writes the shortest representation of the given floating point number, that is still parsed back into the exact same double (Grisu2)
+    /// @note Numbers from 1e-5 up to 1e21 are written in positional notation (0.000123, 1500), all other numbers in scientific notation (1.5e-7).
+    /// Grisu2 finds the shortest representation for more than 99.9% of all values, for the remaining values it writes one or two additional digits, that are still parsed back into the exact same double.
+    /// Not finite numbers (NaN, Infinity) can not be represented in json and are therefore written as the json null literal instead
+    /// @tparam TWriter Writer class the number is written into
+    /// @param writer Writer the number is written into
+    /// @param value Floating point number that should be written
+    /// @return Amount of bytes that have been written
+    template<typename TWriter>
+    static size_t Write_Real_Shortest(TWriter & writer, double const & value) {
+        if (isnan(value) || isinf(value)) {
+            return Write_Null(writer);
+        }
+        char buffer[REAL_BUFFER_SIZE] = {};
+        size_t const size = value < 0.0 ? Write_Character(writer, '-') : 0U;
+        return size + Write_Raw(writer, buffer, Format_Shortest(buffer, value));
+    }
+
+    /// @brief Writes the shortest representation of the given single precision floating point number, that is still parsed back into the exact same float
+    /// @copydetails Write_Real_Shortest(TWriter &, double const &)
+    template<typename TWriter>
+    static size_t Write_Real_Shortest(TWriter & writer, float const & value) {
+        if (isnan(value) || isinf(value)) {
+            return Write_Null(writer);
+        }
+        char buffer[REAL_BUFFER_SIZE] = {};
+        size_t const size = value < 0.0F ? Write_Character(writer, '-') : 0U;
+        return size + Write_Raw(writer, buffer, Format_Shortest(buffer, value));
+    }
+
+    /// @brief Writes the given floating point number rounded to the given amount of decimal places, where trailing zeros are removed
+    /// @note Numbers whose scaled magnitude does not fit into the 53 bits of precision of a double, are written with @ref Write_Real_Compatible instead.
+    /// Not finite numbers (NaN, Infinity) can not be represented in json and are therefore written as the json null literal instead
+    /// @tparam TWriter Writer class the number is written into
+    /// @param writer Writer the number is written into
+    /// @param value Floating point number that should be written
+    /// @param decimal_places Amount of decimal places the number is rounded to, at most 9
+    /// @return Amount of bytes that have been written
+    template<typename TWriter>
+    static size_t Write_Real_Fixed(TWriter & writer, double const & value, uint8_t const & decimal_places) {
+        if (isnan(value) || isinf(value)) {
+            return Write_Null(writer);
+        }
+        char buffer[REAL_BUFFER_SIZE] = {};
+        uint8_t const length = Format_Fixed(buffer, fabs(value), decimal_places);
+        if (length == 0U) {
+            return Write_Real_Compatible(writer, value);
+        }
+        // Numbers that are rounded to zero are written without their sign
+        size_t const size = (value < 0.0 && (length != 1U || buffer[0U] != '0')) ? Write_Character(writer, '-') : 0U;
+        return size + Write_Raw(writer, buffer, length);
+    }
+
+    /// @brief Rounds the given floating point number to the given amount of decimal places, with the same rounding as @ref Write_Real_Fixed
+    /// @note Allows to round values before they are written into a JsonDocument, which then writes the same digits as @ref Write_Real_Fixed would have.
+    /// Because the rounded decimal number is converted to the closest double, any format that writes at least as many decimal places as requested writes exactly the rounded digits,
+    /// for the format of ArduinoJson (@ref Write_Real_Compatible) that is the case as long as the integral digits and the requested decimal places together do not exceed 9 significant digits
+    /// @param value Floating point number that should be rounded
+    /// @param decimal_places Amount of decimal places the number is rounded to, at most 9
+    /// @return Rounded number or the unchanged number if it is not finite or the scaled magnitude does not fit into the precision of a double
+    static double Round_To_Decimal_Places(double const & value, uint8_t decimal_places);
+
+    /// @brief Writes the given floating point number with up to 9 significant digits, split between the integral and the decimal part, where trailing zeros are removed
+    /// @note Very big or very small numbers are written in scientific notation instead (1.5e-7), to keep the amount of written characters small.
+    /// Does not use printf, because it does not support floating point numbers on every supported platform (AVR), and writes the same representation as ArduinoJson does (123.123456789123 is written as 123.1234568),
+    /// because it uses the same algorithm, where every digit in the integral part removes one decimal place
+    /// Not finite numbers (NaN, Infinity) can not be represented in json and are therefore written as the json null literal instead
+    /// @tparam TWriter Writer class the number is written into
+    /// @param writer Writer the number is written into
+    /// @param value Floating point number that should be written
+    /// @return Amount of bytes that have been written
+    template<typename TWriter>
+    static size_t Write_Real_Compatible(TWriter & writer, double value) {
+        if (isnan(value) || isinf(value)) {
+            return Write_Null(writer);
+        }
+        size_t size = 0U;
+        if (value < 0.0) {
+            size += Write_Character(writer, '-');
+            value = -value;
+        }
+
+        int16_t exponent = Normalize_Real(value);
+        uint32_t integral = static_cast<uint32_t>(value);
+        // Every digit of the integral part removes one decimal place, so that at most 9 significant digits are written
+        uint32_t max_decimal_part = MAX_DECIMAL_PART;
+        uint8_t decimal_places = MAX_DECIMAL_PLACES;
+        for (uint32_t remaining = integral; remaining >= 10U; remaining /= 10U) {
+            max_decimal_part /= 10U;
+            decimal_places--;
+        }
+        double const remainder = (value - static_cast<double>(integral)) * static_cast<double>(max_decimal_part);
+        uint32_t decimal = static_cast<uint32_t>(remainder);
+        // Round to nearest, where rounding up might carry over into the integral part and potentially the exponent
+        if (remainder - static_cast<double>(decimal) >= 0.5) {
+            decimal++;
+            if (decimal >= max_decimal_part) {
+                decimal = 0U;
+                integral++;
+                if (exponent != 0 && integral >= 10U) {
+                    integral = 1U;
+                    exponent++;
+                }
+            }
+        }
+
+        size += Write_Unsigned_Integer(writer, integral);
+        if (decimal != 0U) {
+            while (decimal % 10U == 0U) {
+                decimal /= 10U;
+                decimal_places--;
+            }
+            char buffer[MAX_DECIMAL_PLACES + 1U] = {};
+            buffer[0U] = '.';
+            for (uint8_t i = decimal_places; i > 0U; i--) {
+                buffer[i] = static_cast<char>('0' + (decimal % 10U));
+                decimal /= 10U;
+            }
+            size += Write_Raw(writer, buffer, decimal_places + 1U);
+        }
+        if (exponent != 0) {
+            size += Write_Character(writer, 'e');
+            size += Write_Integer(writer, exponent);
+        }
+        return size;
+    }
+
+  private:
+    /// @brief Writes the decimal digits of the given unsigned integer in front of the given position, two digits at a time
+    /// @param end Pointer one past the last character the digits are written into, the buffer in front of it has to fit 20 digits
+    /// @param value Integer that should be written
+    /// @return Pointer to the first written digit
+    static char * Format_Unsigned_Integer(char * end, uint64_t value) {
+        // Dividing 64-bit integers is expensive on 32-bit microcontrollers, therefore the remaining digits are formatted with 32-bit divisions as soon as they fit
+        while (value > UINT32_MAX) {
+            uint32_t const pair = static_cast<uint32_t>(value % 100U);
+            value /= 100U;
+            end -= 2U;
+            (void)memcpy(end, DIGIT_PAIRS + pair * 2U, 2U);
+        }
+        uint32_t remaining = static_cast<uint32_t>(value);
+        while (remaining >= 100U) {
+            uint32_t const pair = remaining % 100U;
+            remaining /= 100U;
+            end -= 2U;
+            (void)memcpy(end, DIGIT_PAIRS + pair * 2U, 2U);
+        }
+        if (remaining >= 10U) {
+            end -= 2U;
+            (void)memcpy(end, DIGIT_PAIRS + remaining * 2U, 2U);
+            return end;
+        }
+        *--end = static_cast<char>('0' + remaining);
+        return end;
+    }
+
+    /// @brief Formats the shortest representation of the magnitude of the given double, see @ref Write_Real_Shortest
+    /// @param buffer Buffer the text is written into, has to fit REAL_BUFFER_SIZE characters
+    /// @param value Finite floating point number, whose sign is ignored
+    /// @return Amount of written characters
+    static uint8_t Format_Shortest(char * buffer, double const & value);
+
+    /// @brief Formats the shortest representation of the magnitude of the given float, see @ref Write_Real_Shortest
+    /// @param buffer Buffer the text is written into, has to fit REAL_BUFFER_SIZE characters
+    /// @param value Finite floating point number, whose sign is ignored
+    /// @return Amount of written characters
+    static uint8_t Format_Shortest(char * buffer, float const & value);
+
+    /// @brief Formats the shortest representation of the given positive IEEE 754 binary floating point number, independent of its precision
+    /// @param buffer Buffer the text is written into, has to fit REAL_BUFFER_SIZE characters
+    /// @param bits Raw bits of the floating point number, without the sign bit
+    /// @param significand_bits Amount of bits of the significand, without the implicit leading bit
+    /// @param exponent_bias Offset between the stored exponent and the exponent of the significand interpreted as an integer
+    /// @return Amount of written characters
+    static uint8_t Format_Shortest(char * buffer, uint64_t const & bits, uint8_t const & significand_bits, int16_t const & exponent_bias);
+
+    /// @brief Formats the given positive floating point number rounded to the given amount of decimal places, see @ref Write_Real_Fixed
+    /// @param buffer Buffer the text is written into, has to fit REAL_BUFFER_SIZE characters
+    /// @param value Finite positive floating point number
+    /// @param decimal_places Amount of decimal places the number is rounded to, is limited to 9
+    /// @return Amount of written characters, 0 if the scaled number does not fit into the precision of a double
+    static uint8_t Format_Fixed(char * buffer, double const & value, uint8_t decimal_places);
+
+    /// @brief Returns the character that has to follow the backslash to escape the given character
+    /// @param character Character that should be checked
+    /// @return Character following the backslash, 'u' if the character has to be escaped as a unicode sequence or '\0' if the character does not need to be escaped
+    static char Get_Escaped_Character(char character) {
+        switch (character) {
+            case '"':
+                return '"';
+            case '\\':
+                return '\\';
+            case '\b':
+                return 'b';
+            case '\f':
+                return 'f';
+            case '\n':
+                return 'n';
+            case '\r':
+                return 'r';
+            case '\t':
+                return 't';
+            default:
+                break;
+        }
+        return static_cast<uint8_t>(character) < 0x20U ? 'u' : '\0';
+    }
+
+    /// @brief Scales the given positive floating point number into the range [1, 10) if it is very big or very small, by multiplying it with binary powers of ten
+    /// @param value Positive floating point number that is scaled in place
+    /// @return Power of ten the number has been scaled by, 0 if the number has not been scaled
+    static int16_t Normalize_Real(double & value) {
+        // Powers of ten with an exponent that is a power of 2 (10^1, 10^2, 10^4, ...) allow to scale by any exponent with at most 9 multiplications
+        static double constexpr positive_binary_powers[] = { 1e1, 1e2, 1e4, 1e8, 1e16, 1e32, 1e64, 1e128, 1e256 };
+        static double constexpr negative_binary_powers[] = { 1e-1, 1e-2, 1e-4, 1e-8, 1e-16, 1e-32, 1e-64, 1e-128, 1e-256 };
+        static double constexpr negative_binary_powers_plus_one[] = { 1e0, 1e-1, 1e-3, 1e-7, 1e-15, 1e-31, 1e-63, 1e-127, 1e-255 };
+        int16_t exponent = 0;
+        if (value >= POSITIVE_EXPONENTIATION_THRESHOLD) {
+            for (int8_t i = 8; i >= 0; i--) {
+                if (value >= positive_binary_powers[i]) {
+                    // Multiplied with the negative power instead of divided by the positive one like ArduinoJson does, because the results differ in the last bit for some values
+                    value *= negative_binary_powers[i];
+                    exponent += 1 << i;
+                }
+            }
+        }
+        else if (value > 0.0 && value <= NEGATIVE_EXPONENTIATION_THRESHOLD) {
+            for (int8_t i = 8; i >= 0; i--) {
+                if (value < negative_binary_powers_plus_one[i]) {
+                    value *= positive_binary_powers[i];
+                    exponent -= 1 << i;
+                }
+            }
+        }
+        return exponent;
+    }
+};
+
+#endif // Json_Serializer_h
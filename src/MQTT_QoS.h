@@ -0,0 +1,15 @@
+#ifndef MQTT_QoS_h
+#define MQTT_QoS_h
+
+// Library include.
+#include <stdint.h>
+
+
+/// @brief Possible quality of service levels a message can be published with, decides whether the MQTT broker confirms that it received the message.
+/// See https://docs.oasis-open.org/mqtt/mqtt/v3.1.1/os/mqtt-v3.1.1-os.html#_Toc398718099 for more information
+enum class MQTT_QoS : uint8_t {
+    AT_MOST_ONCE, ///< QoS 0, the message is sent once without the broker confirming it, meaning it is lost if the connection breaks while it is sent. Does not require any memory once the message has been sent
+    AT_LEAST_ONCE ///< QoS 1, the broker confirms the message with a PUBACK containing the packet id of the message, which has to be kept by the client and resent until it has been confirmed. Might cause the broker to receive the message more than once
+};
+
+#endif // MQTT_QoS_h
@@ -13,6 +13,7 @@ uint8_t constexpr OTA_ATTRIBUTE_KEYS_AMOUNT = 5U;
 char constexpr NO_FW_REQUEST_RESPONSE[] = "Did not receive requested shared attribute firmware keys. Ensure keys exist and device is connected";
 // Firmware topics.
 char constexpr FIRMWARE_RESPONSE_TOPIC[] = "v2/fw/response/%u/chunk/";
+char constexpr FIRMWARE_RESPONSE_TOPIC_PREFIX[] = "v2/fw/response/";
 char constexpr FIRMWARE_REQUEST_TOPIC[] = "v2/fw/request/%u/chunk/%u";
 // Firmware data keys.
 char constexpr CURR_FW_TITLE_KEY[] = "current_fw_title";
@@ -58,7 +59,7 @@ class OTA_Firmware_Update : public IAPI_Implementation {
     using Request_Callback_Value = Attribute_Request_Callback<OTA_ATTRIBUTE_KEYS_AMOUNT>;
     using Request_Callback_Container = Attribute_Request<1U, OTA_ATTRIBUTE_KEYS_AMOUNT, Logger>;
     using Update_Callback_Value = Shared_Attribute_Callback<OTA_ATTRIBUTE_KEYS_AMOUNT>;
-    using Update_Callback_Container = Shared_Attribute_Update<1U, OTA_ATTRIBUTE_KEYS_AMOUNT, Logger>;
+    using Update_Callback_Container = Shared_Attribute_Update<1U, OTA_ATTRIBUTE_KEYS_AMOUNT, DEFAULT_RESPONSE_AMOUNT, Logger>;
 #endif // THINGSBOARD_ENABLE_DYNAMIC
 
   public:
@@ -163,6 +164,10 @@ class OTA_Firmware_Update : public IAPI_Implementation {
     }
 
     void Process_Response(char const * topic, uint8_t * payload, uint32_t length) override {
+        // Dispatched for every firmware response, therefore responses to previous firmware requests, that still contain their old request id are ignored
+        if (strncmp(m_response_topic, topic, strlen(m_response_topic)) != 0) {
+            return;
+        }
         auto const & request_id = m_fw_callback.Get_Request_ID();
         auto const chunk = Helper::Split_Topic_Into_Request_ID(topic, Helper::Calculate_Print_Size(FIRMWARE_RESPONSE_TOPIC, request_id));
         m_ota.Process_Firmware_Packet(chunk, payload, length);
@@ -172,8 +177,10 @@ class OTA_Firmware_Update : public IAPI_Implementation {
         // Nothing to do
     }
 
-    bool Is_Response_Topic_Matching(char const * topic) const override {
-        return strncmp(m_response_topic, topic, strlen(m_response_topic)) == 0;
+    char const * Get_Response_Topic(bool & exact) const override {
+        // The request id contained in the response topic changes with every firmware update, therefore only the constant part is returned
+        exact = false;
+        return FIRMWARE_RESPONSE_TOPIC_PREFIX;
     }
 
     bool Unsubscribe() override {
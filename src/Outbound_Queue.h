@@ -0,0 +1,230 @@
+#ifndef Outbound_Queue_h
+#define Outbound_Queue_h
+
+// Library includes.
+#include <stdint.h>
+#include <string.h>
+
+
+/// @brief Bounded first in first out queue of outgoing messages, where every message consists of its topic, its already serialized payload and the amount of data points it contains.
+/// @note Messages are copied into a single ring of bytes, that is allocated once with @ref Allocate and reused afterwards, meaning queueing a message does not require any heap allocation.
+/// Every message is stored contiguously as a header containing the topic size, payload size and data point amount, followed by the null terminated topic and the null terminated payload,
+/// this allows to pass the stored topic and payload directly to the publish() method of the MQTT client, without having to copy them out of the ring again.
+/// If a message does not fit into the remaining bytes at the end of the ring, the remaining bytes are skipped and the message is copied to the start of the ring instead.
+/// Additionally the amount of queued messages is limited to the given maximum depth, even if there would still be enough bytes left
+class Outbound_Queue {
+  public:
+    /// @brief Constructs an empty queue, that can not hold any message until @ref Allocate has been called
+    Outbound_Queue() = default;
+
+    /// @brief Deleted copy constructor
+    /// @note Copying the queue would require copying the allocated ring, simply copying the pointer to it would free it twice instead. Therefore copying is disabled alltogether
+    /// @param other Other instance we disallow copying from
+    Outbound_Queue(Outbound_Queue const & other) = delete;
+
+    /// @brief Deleted copy assignment operator
+    /// @note Copying the queue would require copying the allocated ring, simply copying the pointer to it would free it twice instead. Therefore copying is disabled alltogether
+    /// @param other Other instance we disallow copying from
+    void operator=(Outbound_Queue const & other) = delete;
+
+    /// @brief Destructor, frees the ring holding the queued messages
+    ~Outbound_Queue() {
+        Free();
+    }
+
+    /// @brief Allocates the ring holding the queued messages, any already queued messages are discarded
+    /// @param buffer_size Total amount of bytes that can be used to store the queued messages, every message requires the size of its topic and payload plus 2 null terminators and the header
+    /// @param max_depth Maximum amount of messages that can be queued at once
+    /// @return Whether allocating the ring was successful or not
+    bool Allocate(size_t const & buffer_size, size_t const & max_depth) {
+        Free();
+        if (buffer_size == 0U || max_depth == 0U) {
+            return true;
+        }
+        m_buffer = new uint8_t[buffer_size]();
+        if (m_buffer == nullptr) {
+            return false;
+        }
+        m_buffer_size = buffer_size;
+        m_max_depth = max_depth;
+        return true;
+    }
+
+    /// @brief Frees the ring holding the queued messages and therefore discards all queued messages
+    void Free() {
+        delete[] m_buffer;
+        m_buffer = nullptr;
+        m_buffer_size = 0U;
+        m_max_depth = 0U;
+        Clear();
+    }
+
+    /// @brief Discards all queued messages, without freeing the ring holding them
+    void Clear() {
+        m_head = 0U;
+        m_tail = 0U;
+        m_size = 0U;
+    }
+
+    /// @brief Whether the ring holding the queued messages has been allocated
+    /// @return Whether messages can be queued
+    bool Is_Allocated() const {
+        return m_buffer != nullptr;
+    }
+
+    /// @brief Amount of currently queued messages
+    /// @return Amount of queued messages
+    size_t const & size() const {
+        return m_size;
+    }
+
+    /// @brief Amount of bytes in the ring currently occupied by queued messages
+    /// @note Includes the headers and null terminators of the queued messages, as well as the bytes at the end of the ring that have been skipped, because the next message did not fit into them anymore
+    /// @return Amount of occupied bytes
+    size_t used_size() const {
+        if (empty()) {
+            return 0U;
+        }
+        return m_tail > m_head ? m_tail - m_head : m_buffer_size - m_head + m_tail;
+    }
+
+    /// @brief Whether there are currently no queued messages
+    /// @return Whether the queue is empty
+    bool empty() const {
+        return m_size == 0U;
+    }
+
+    /// @brief Copies the given message to the end of the queue
+    /// @param topic Non owning pointer to the null terminated topic the message should be published over.
+    /// Does not need to kept alive as the function copies the topic into the ring
+    /// @param payload Non owning pointer to the payload that should be published.
+    /// Does not need to kept alive as the function copies the payload into the ring
+    /// @param payload_size Size of the given payload in bytes
+    /// @param data_point_amount Amount of telemetry data points contained in the payload, is stored so the rate limit does not need to be calculated again once the message is published
+    /// @return Whether the message was queued, fails if the maximum depth has been reached or there are not enough bytes left in the ring
+    bool push(char const * topic, char const * payload, size_t const & payload_size, size_t const & data_point_amount) {
+        if (m_buffer == nullptr || m_size >= m_max_depth) {
+            return false;
+        }
+        Entry_Header const header = { strlen(topic), payload_size, data_point_amount };
+        size_t const entry_size = Calculate_Entry_Size(header);
+        size_t offset = m_tail;
+        // One byte between the tail and the head is always kept free, to ensure they are only ever equal if the queue is empty
+        if (m_size == 0U) {
+            Clear();
+            offset = 0U;
+            if (entry_size > m_buffer_size) {
+                return false;
+            }
+        }
+        else if (m_tail >= m_head) {
+            if (entry_size > m_buffer_size - m_tail) {
+                if (entry_size >= m_head) {
+                    return false;
+                }
+                Mark_Wrap(m_tail);
+                offset = 0U;
+            }
+        }
+        else if (entry_size >= m_head - m_tail) {
+            return false;
+        }
+
+        uint8_t * entry = m_buffer + offset;
+        (void)memcpy(entry, &header, sizeof(header));
+        entry += sizeof(header);
+        (void)memcpy(entry, topic, header.topic_size + 1U);
+        entry += header.topic_size + 1U;
+        (void)memcpy(entry, payload, payload_size);
+        entry[payload_size] = '\0';
+        m_tail = offset + entry_size;
+        m_size++;
+        return true;
+    }
+
+    /// @brief Gets the oldest queued message, without removing it from the queue
+    /// @param topic Set to the null terminated topic of the message, points into the ring and is therefore only valid until the message is removed with @ref pop
+    /// @param payload Set to the null terminated payload of the message, points into the ring and is therefore only valid until the message is removed with @ref pop
+    /// @param payload_size Set to the size of the payload in bytes, without the null terminator
+    /// @param data_point_amount Set to the amount of telemetry data points contained in the payload
+    /// @return Whether there was a queued message
+    bool front(char const * & topic, char const * & payload, size_t & payload_size, size_t & data_point_amount) {
+        if (empty()) {
+            return false;
+        }
+        Skip_Wrap();
+        Entry_Header header = {};
+        (void)memcpy(&header, m_buffer + m_head, sizeof(header));
+        topic = reinterpret_cast<char const *>(m_buffer + m_head + sizeof(header));
+        payload = topic + header.topic_size + 1U;
+        payload_size = header.payload_size;
+        data_point_amount = header.data_point_amount;
+        return true;
+    }
+
+    /// @brief Removes the oldest queued message
+    void pop() {
+        if (empty()) {
+            return;
+        }
+        Skip_Wrap();
+        Entry_Header header = {};
+        (void)memcpy(&header, m_buffer + m_head, sizeof(header));
+        m_head += Calculate_Entry_Size(header);
+        m_size--;
+        if (m_size == 0U) {
+            Clear();
+        }
+    }
+
+  private:
+    /// @brief Header written in front of every queued message
+    struct Entry_Header {
+        size_t topic_size;        // Length of the topic without the null terminator
+        size_t payload_size;      // Size of the payload without the null terminator
+        size_t data_point_amount; // Amount of telemetry data points contained in the payload
+    };
+
+    /// @brief Topic size written into the header at the end of the ring, to mark that the remaining bytes are skipped and the next message starts at the beginning of the ring
+    static size_t constexpr WRAP_MARKER = ~static_cast<size_t>(0U);
+
+    /// @brief Calculates the amount of bytes a message with the given header occupies in the ring
+    /// @param header Header of the message
+    /// @return Amount of bytes the header, the topic and the payload, including their null terminators, occupy
+    static size_t Calculate_Entry_Size(Entry_Header const & header) {
+        return sizeof(header) + header.topic_size + 1U + header.payload_size + 1U;
+    }
+
+    /// @brief Marks that the bytes from the given offset to the end of the ring are skipped
+    /// @note If not even a header fits into the remaining bytes, they are skipped implicitly instead, because no message could have been stored there
+    /// @param offset Offset into the ring the skipped bytes start at
+    void Mark_Wrap(size_t const & offset) {
+        if (m_buffer_size - offset < sizeof(Entry_Header)) {
+            return;
+        }
+        Entry_Header const header = { WRAP_MARKER, 0U, 0U };
+        (void)memcpy(m_buffer + offset, &header, sizeof(header));
+    }
+
+    /// @brief Moves the head to the start of the ring, if the bytes at the head have been skipped when the message was queued
+    void Skip_Wrap() {
+        if (m_buffer_size - m_head < sizeof(Entry_Header)) {
+            m_head = 0U;
+            return;
+        }
+        Entry_Header header = {};
+        (void)memcpy(&header, m_buffer + m_head, sizeof(header));
+        if (header.topic_size == WRAP_MARKER) {
+            m_head = 0U;
+        }
+    }
+
+    uint8_t *m_buffer = {};     // Ring all queued messages are copied into, allocated once and then reused
+    size_t  m_buffer_size = {}; // Size of the ring in bytes
+    size_t  m_max_depth = {};   // Maximum amount of messages that can be queued at once
+    size_t  m_head = {};        // Offset of the oldest queued message
+    size_t  m_tail = {};        // Offset the next queued message is written to
+    size_t  m_size = {};        // Amount of currently queued messages
+};
+
+#endif // Outbound_Queue_h
@@ -0,0 +1,351 @@
+// Header include.
+#include "Persistent_Log.h"
+
+// Library includes.
+#include <string.h>
+
+/// @brief Value written at the start of every segment used by the log, spells TBLG
+uint32_t constexpr SEGMENT_MAGIC = 0x474C4254U;
+/// @brief Value of the state byte of a message that has not been delivered yet, is the value of an erased byte so it does not need to be written
+uint8_t constexpr RECORD_PENDING = 0xFFU;
+/// @brief Value of the state byte of a message that has been delivered, only clears bits so it can be written without erasing the segment
+uint8_t constexpr RECORD_DELIVERED = 0x00U;
+/// @brief Value of the priority byte if no message has been written yet
+uint8_t constexpr RECORD_ERASED = 0xFFU;
+/// @brief Size of the buffer on the stack, that payloads are read into in parts to validate their checksum
+size_t constexpr CRC_CHUNK_SIZE = 32U;
+
+Persistent_Log::Persistent_Log()
+  : m_storage(nullptr)
+  , m_segment_amount(0U)
+  , m_segment_size(0U)
+  , m_read_segment(0U)
+  , m_read_offset(0U)
+  , m_replay_segment(0U)
+  , m_replay_offset(0U)
+  , m_replay_amount(0U)
+  , m_write_segment(0U)
+  , m_write_offset(0U)
+  , m_write_sequence(0U)
+  , m_size(0U)
+{
+    // Nothing to do
+}
+
+bool Persistent_Log::Open(IStorage * storage) {
+    m_storage = nullptr;
+    m_size = 0U;
+    m_replay_amount = 0U;
+    if (storage == nullptr) {
+        return true;
+    }
+    m_segment_amount = storage->get_segment_amount();
+    m_segment_size = storage->get_segment_size();
+    if (m_segment_amount < 2U || m_segment_size < sizeof(Segment_Header) + Calculate_Record_Size(0U)) {
+        return false;
+    }
+    m_storage = storage;
+
+    // Newest segment is the one with the biggest sequence number, the comparison is done with the difference to still work once the sequence number wraps around
+    bool found = false;
+    uint32_t newest_sequence = 0U;
+    size_t newest_segment = 0U;
+    for (size_t segment = 0U; segment < m_segment_amount; segment++) {
+        uint32_t sequence = 0U;
+        if (Read_Segment_Header(segment, sequence) && (!found || static_cast<int32_t>(sequence - newest_sequence) > 0)) {
+            found = true;
+            newest_sequence = sequence;
+            newest_segment = segment;
+        }
+    }
+    if (!found) {
+        m_read_segment = 0U;
+        m_read_offset = sizeof(Segment_Header);
+        if (!Start_Segment(0U, 1U)) {
+            m_storage = nullptr;
+            return false;
+        }
+        rewind();
+        return true;
+    }
+
+    // Oldest segment is the first one of the uninterrupted run of sequence numbers ending at the newest segment, all segments before it have already been erased
+    size_t oldest_segment = newest_segment;
+    for (size_t i = 1U; i < m_segment_amount; i++) {
+        size_t const segment = (newest_segment + m_segment_amount - i) % m_segment_amount;
+        uint32_t sequence = 0U;
+        if (!Read_Segment_Header(segment, sequence) || sequence != newest_sequence - i) {
+            break;
+        }
+        oldest_segment = segment;
+    }
+
+    m_write_segment = newest_segment;
+    m_write_sequence = newest_sequence;
+    for (size_t segment = oldest_segment; ; segment = (segment + 1U) % m_segment_amount) {
+        size_t offset = sizeof(Segment_Header);
+        while (offset + sizeof(Record_Header) <= m_segment_size) {
+            Record_Header header = {};
+            Record_State const state = Read_Record(segment, offset, header);
+            if (state == Record_State::END) {
+                break;
+            }
+            else if (state == Record_State::CORRUPT) {
+                // Bytes of the partially written message can not be written again without erasing the segment, therefore the next message is appended to a new segment instead
+                offset = m_segment_size;
+                break;
+            }
+            if (header.state == RECORD_PENDING) {
+                m_size++;
+            }
+            offset += Calculate_Record_Size(header.payload_size);
+        }
+        if (segment == newest_segment) {
+            m_write_offset = offset;
+            break;
+        }
+    }
+
+    m_read_segment = oldest_segment;
+    m_read_offset = sizeof(Segment_Header);
+    if (!Find_Front()) {
+        m_storage = nullptr;
+        return false;
+    }
+    rewind();
+    return true;
+}
+
+bool Persistent_Log::Is_Open() const {
+    return m_storage != nullptr;
+}
+
+size_t const & Persistent_Log::size() const {
+    return m_size;
+}
+
+bool Persistent_Log::empty() const {
+    return m_size == 0U;
+}
+
+bool Persistent_Log::push(Publish_Priority priority, uint64_t const & timestamp, size_t const & data_point_amount, uint8_t const * payload, size_t const & payload_size) {
+    size_t const record_size = Calculate_Record_Size(payload_size);
+    if (m_storage == nullptr || payload_size > UINT16_MAX || sizeof(Segment_Header) + record_size > m_segment_size) {
+        return false;
+    }
+    if (m_write_offset + record_size > m_segment_size) {
+        size_t const next_segment = (m_write_segment + 1U) % m_segment_amount;
+        // Segment still contains the oldest message that has not been delivered yet, therefore the log is full
+        if (next_segment == m_read_segment) {
+            return false;
+        }
+        else if (!Start_Segment(next_segment, m_write_sequence + 1U)) {
+            return false;
+        }
+    }
+    // Read position already reached the end of the log, therefore the new message directly becomes the oldest message that has not been delivered yet
+    if (empty()) {
+        m_read_segment = m_write_segment;
+        m_read_offset = m_write_offset;
+    }
+    // Same applies to the replay position, if every message has already been replayed
+    if (m_replay_amount == m_size) {
+        m_replay_segment = m_write_segment;
+        m_replay_offset = m_write_offset;
+    }
+
+    Record_Header header = {};
+    header.state = RECORD_PENDING;
+    header.priority = static_cast<uint8_t>(priority);
+    header.payload_size = static_cast<uint16_t>(payload_size);
+    header.data_point_amount = static_cast<uint16_t>(data_point_amount < UINT16_MAX ? data_point_amount : UINT16_MAX);
+    header.reserved = UINT16_MAX;
+    header.crc = 0U;
+    header.timestamp_low = static_cast<uint32_t>(timestamp);
+    header.timestamp_high = static_cast<uint32_t>(timestamp >> 32U);
+    header.crc = Calculate_Crc(Calculate_Crc(0U, reinterpret_cast<uint8_t const *>(&header), sizeof(header)), payload, payload_size);
+
+    // Header is written first, so that an interrupted write is always detected as a corrupt message instead of as free space, that would then be written again
+    if (!m_storage->write(m_write_segment, m_write_offset, reinterpret_cast<uint8_t const *>(&header), sizeof(header)) ||
+        !m_storage->write(m_write_segment, m_write_offset + sizeof(header), payload, payload_size)) {
+        // Position is still advanced, because the partially written bytes can not be written again without erasing the segment
+        m_write_offset = m_segment_size;
+        return false;
+    }
+    m_write_offset += record_size;
+    m_size++;
+    return true;
+}
+
+bool Persistent_Log::front(Persistent_Record & record) {
+    if (m_storage == nullptr || empty()) {
+        return false;
+    }
+    return Read_Metadata(m_read_segment, m_read_offset, record);
+}
+
+bool Persistent_Log::next(Persistent_Record & record) {
+    if (m_storage == nullptr || m_replay_amount >= m_size) {
+        return false;
+    }
+    return Read_Metadata(m_replay_segment, m_replay_offset, record);
+}
+
+bool Persistent_Log::read(size_t const & offset, uint8_t * buffer, size_t const & size) {
+    if (m_storage == nullptr || m_replay_amount >= m_size) {
+        return false;
+    }
+    return m_storage->read(m_replay_segment, m_replay_offset + sizeof(Record_Header) + offset, buffer, size);
+}
+
+bool Persistent_Log::advance() {
+    Persistent_Record record = {};
+    if (!next(record)) {
+        return false;
+    }
+    m_replay_amount++;
+    m_replay_offset += Calculate_Record_Size(record.payload_size);
+    return Find_Pending(m_replay_segment, m_replay_offset, false);
+}
+
+void Persistent_Log::rewind() {
+    m_replay_segment = m_read_segment;
+    m_replay_offset = m_read_offset;
+    m_replay_amount = 0U;
+}
+
+bool Persistent_Log::pop() {
+    Persistent_Record record = {};
+    if (!front(record)) {
+        return false;
+    }
+    uint8_t const state = RECORD_DELIVERED;
+    if (!m_storage->write(m_read_segment, m_read_offset, &state, sizeof(state))) {
+        return false;
+    }
+    m_size--;
+    m_read_offset += Calculate_Record_Size(record.payload_size);
+    if (m_replay_amount != 0U) {
+        m_replay_amount--;
+    }
+    bool const result = Find_Front();
+    // Replay position is never behind the read position, therefore it has to be moved as well once every replayed message has been delivered
+    if (m_replay_amount == 0U) {
+        rewind();
+    }
+    return result;
+}
+
+bool Persistent_Log::Read_Metadata(size_t const & segment, size_t const & offset, Persistent_Record & record) {
+    Record_Header header = {};
+    if (!m_storage->read(segment, offset, reinterpret_cast<uint8_t *>(&header), sizeof(header))) {
+        return false;
+    }
+    record.priority = static_cast<Publish_Priority>(header.priority);
+    record.timestamp = (static_cast<uint64_t>(header.timestamp_high) << 32U) | header.timestamp_low;
+    record.data_point_amount = header.data_point_amount;
+    record.payload_size = header.payload_size;
+    return true;
+}
+
+bool Persistent_Log::Read_Segment_Header(size_t const & segment, uint32_t & sequence) {
+    Segment_Header header = {};
+    if (!m_storage->read(segment, 0U, reinterpret_cast<uint8_t *>(&header), sizeof(header)) || header.magic != SEGMENT_MAGIC) {
+        return false;
+    }
+    else if (header.crc != Calculate_Crc(0U, reinterpret_cast<uint8_t const *>(&header), sizeof(header.magic) + sizeof(header.sequence))) {
+        return false;
+    }
+    sequence = header.sequence;
+    return true;
+}
+
+bool Persistent_Log::Start_Segment(size_t const & segment, uint32_t const & sequence) {
+    Segment_Header header = {};
+    header.magic = SEGMENT_MAGIC;
+    header.sequence = sequence;
+    header.crc = Calculate_Crc(0U, reinterpret_cast<uint8_t const *>(&header), sizeof(header.magic) + sizeof(header.sequence));
+    if (!m_storage->erase(segment) || !m_storage->write(segment, 0U, reinterpret_cast<uint8_t const *>(&header), sizeof(header))) {
+        return false;
+    }
+    m_write_segment = segment;
+    m_write_offset = sizeof(header);
+    m_write_sequence = sequence;
+    return true;
+}
+
+Persistent_Log::Record_State Persistent_Log::Read_Record(size_t const & segment, size_t const & offset, Record_Header & header) {
+    if (!m_storage->read(segment, offset, reinterpret_cast<uint8_t *>(&header), sizeof(header))) {
+        return Record_State::CORRUPT;
+    }
+    else if (header.priority == RECORD_ERASED) {
+        return Record_State::END;
+    }
+    else if (offset + Calculate_Record_Size(header.payload_size) > m_segment_size) {
+        return Record_State::CORRUPT;
+    }
+
+    Record_Header initial = header;
+    initial.state = RECORD_PENDING;
+    initial.crc = 0U;
+    uint32_t crc = Calculate_Crc(0U, reinterpret_cast<uint8_t const *>(&initial), sizeof(initial));
+    uint8_t chunk[CRC_CHUNK_SIZE] = {};
+    for (size_t read = 0U; read < header.payload_size; read += CRC_CHUNK_SIZE) {
+        size_t const chunk_size = header.payload_size - read < CRC_CHUNK_SIZE ? header.payload_size - read : CRC_CHUNK_SIZE;
+        if (!m_storage->read(segment, offset + sizeof(header) + read, chunk, chunk_size)) {
+            return Record_State::CORRUPT;
+        }
+        crc = Calculate_Crc(crc, chunk, chunk_size);
+    }
+    return crc == header.crc ? Record_State::VALID : Record_State::CORRUPT;
+}
+
+bool Persistent_Log::Find_Pending(size_t & segment, size_t & offset, bool const & erase_finished) {
+    for (;;) {
+        if (segment == m_write_segment && offset >= m_write_offset) {
+            return true;
+        }
+        Record_Header header = {};
+        Record_State state = Record_State::END;
+        if (offset + sizeof(Record_Header) <= m_segment_size) {
+            state = Read_Record(segment, offset, header);
+        }
+        if (state == Record_State::VALID) {
+            if (header.state == RECORD_PENDING) {
+                return true;
+            }
+            offset += Calculate_Record_Size(header.payload_size);
+            continue;
+        }
+        else if (segment == m_write_segment) {
+            offset = m_write_offset;
+            return true;
+        }
+        // Reached the end of an older segment, meaning all its messages have been delivered and it can be erased to be reused later on, if it is the read position that reached it
+        size_t const finished_segment = segment;
+        segment = (segment + 1U) % m_segment_amount;
+        offset = sizeof(Segment_Header);
+        if (erase_finished && !m_storage->erase(finished_segment)) {
+            return false;
+        }
+    }
+}
+
+bool Persistent_Log::Find_Front() {
+    return Find_Pending(m_read_segment, m_read_offset, true);
+}
+
+size_t Persistent_Log::Calculate_Record_Size(size_t const & payload_size) {
+    return (sizeof(Record_Header) + payload_size + 3U) & ~static_cast<size_t>(3U);
+}
+
+uint32_t Persistent_Log::Calculate_Crc(uint32_t crc, uint8_t const * data, size_t const & size) {
+    crc = ~crc;
+    for (size_t i = 0U; i < size; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0U; bit < 8U; bit++) {
+            crc = (crc >> 1U) ^ (0xEDB88320U & (0U - (crc & 1U)));
+        }
+    }
+    return ~crc;
+}
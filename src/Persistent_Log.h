@@ -0,0 +1,179 @@
+#ifndef Persistent_Log_h
+#define Persistent_Log_h
+
+// Local includes.
+#include "IStorage.h"
+#include "Publish_Priority.h"
+
+
+/// @brief Metadata of a single message stored in the @ref Persistent_Log
+struct Persistent_Record {
+    Publish_Priority priority;          // Priority class of the message, decides the topic it is published over
+    uint64_t         timestamp;         // Time in milliseconds since the unix epoch the message was stored at, 0 if no time source was available
+    size_t           data_point_amount; // Amount of telemetry data points contained in the payload
+    size_t           payload_size;      // Size of the payload in bytes
+};
+
+
+/// @brief Append-only log of outgoing messages, that is persisted in an @ref IStorage implementation and therefore survives disconnects as well as reboots
+/// @note The segments of the storage are used as a ring, where new messages are always appended to the newest segment and a new segment is started once it is full.
+/// Every segment starts with a header containing an increasing sequence number, which allows to find the oldest and newest segment again after a reboot.
+/// Every message is stored as a header containing its metadata and a CRC32 checksum, followed by the payload itself. The checksum detects messages that were only partially written,
+/// because the device lost power or crashed while writing them, such messages are ignored and the next message is appended to a new segment instead.
+/// Messages are never modified once written, except for clearing a single state byte once they have been delivered, which is possible on raw NOR flash without erasing it first.
+/// Segments that only contain delivered messages are erased, so they can be reused once the ring wraps around.
+/// Messages can be replayed ahead of the oldest message that has not been delivered yet, so that multiple messages can wait for their confirmation at once, while still only being marked as delivered in the order they were stored in.
+/// Only the current read, replay and write position are kept in memory, meaning the amount of required memory does not depend on the amount of stored messages
+class Persistent_Log {
+  public:
+    /// @brief Constructs a closed log, that can not store any messages until @ref Open has been called
+    Persistent_Log();
+
+    /// @brief Opens the log on the given storage and recovers all messages that have not been delivered yet, from the previous run of the device
+    /// @param storage Non owning pointer to the storage the log is persisted in, requires at least 2 segments.
+    /// Has to be kept alive for as long as the log is open. Passing a nullptr closes the log
+    /// @return Whether opening the log was successful or not, the log is closed if it was not
+    bool Open(IStorage * storage);
+
+    /// @brief Whether the log has been opened on a storage
+    /// @return Whether messages can be stored
+    bool Is_Open() const;
+
+    /// @brief Amount of stored messages that have not been delivered yet
+    /// @return Amount of pending messages
+    size_t const & size() const;
+
+    /// @brief Whether there are currently no stored messages that have not been delivered yet
+    /// @return Whether the log is empty
+    bool empty() const;
+
+    /// @brief Appends the given message to the end of the log
+    /// @param priority Priority class of the message, decides the topic it is published over once it is replayed
+    /// @param timestamp Time in milliseconds since the unix epoch the message was created at, 0 if no time source is available
+    /// @param data_point_amount Amount of telemetry data points contained in the payload
+    /// @param payload Non owning pointer to the payload that should be stored.
+    /// Does not need to kept alive as the function writes the payload into the storage
+    /// @param payload_size Size of the given payload in bytes
+    /// @return Whether the message was stored, fails if the message is bigger than a segment or all segments are still used by messages that have not been delivered yet
+    bool push(Publish_Priority priority, uint64_t const & timestamp, size_t const & data_point_amount, uint8_t const * payload, size_t const & payload_size);
+
+    /// @brief Gets the metadata of the oldest message that has not been delivered yet, without removing it from the log
+    /// @param record Set to the metadata of the oldest pending message
+    /// @return Whether there was a pending message
+    bool front(Persistent_Record & record);
+
+    /// @brief Gets the metadata of the oldest message that has not been replayed yet, without removing it from the log
+    /// @param record Set to the metadata of the oldest message that has not been replayed yet
+    /// @return Whether there was a pending message that has not been replayed yet
+    bool next(Persistent_Record & record);
+
+    /// @brief Reads a part of the payload of the oldest message that has not been replayed yet, allows to read big payloads in multiple smaller parts
+    /// @param offset Offset into the payload the read bytes start at
+    /// @param buffer Buffer the read bytes are copied into, has to be big enough to hold the given size
+    /// @param size Amount of bytes that should be read
+    /// @return Whether reading the bytes was successful or not
+    bool read(size_t const & offset, uint8_t * buffer, size_t const & size);
+
+    /// @brief Moves the replay position past the oldest message that has not been replayed yet, the message is kept in the log until it has been removed with @ref pop
+    /// @return Whether there was a pending message that has not been replayed yet and reading the following message was successful or not
+    bool advance();
+
+    /// @brief Moves the replay position back to the oldest message that has not been delivered yet, so that every message that has been replayed but not removed yet is replayed again
+    void rewind();
+
+    /// @brief Marks the oldest message that has not been delivered yet as delivered, which removes it from the log
+    /// @note If the message has not been replayed yet, the replay position is moved past it as well
+    /// @return Whether marking the message was successful or not
+    bool pop();
+
+  private:
+    /// @brief Header written at the start of every segment
+    struct Segment_Header {
+        uint32_t magic;    // Constant value marking the segment as used by the log
+        uint32_t sequence; // Increases by one for every started segment, allows to find the oldest and newest segment
+        uint32_t crc;      // CRC32 checksum of the magic value and the sequence number
+    };
+
+    /// @brief Header written in front of every stored message, the fields are ordered so the structure does not contain any padding
+    struct Record_Header {
+        uint8_t  state;             // Whether the message is pending or delivered, is the only byte that is ever written again and is therefore not part of the checksum
+        uint8_t  priority;          // Priority class of the message, the value of an erased byte (0xFF) marks the end of the written messages in the segment
+        uint16_t payload_size;      // Size of the payload in bytes
+        uint16_t data_point_amount; // Amount of telemetry data points contained in the payload
+        uint16_t reserved;          // Unused, always written as an erased value
+        uint32_t crc;               // CRC32 checksum of the header, with the state and checksum as their initial values, followed by the payload
+        uint32_t timestamp_low;     // Lower half of the timestamp, split to ensure the 64-bit value does not add padding on any platform
+        uint32_t timestamp_high;    // Upper half of the timestamp
+    };
+
+    /// @brief Possible results of reading a stored message
+    enum class Record_State : uint8_t {
+        VALID, ///< Message has been completely written
+        END, ///< No message has been written at the offset yet
+        CORRUPT ///< Message has only been partially written, because writing it was interrupted
+    };
+
+    /// @brief Reads the header of the given segment
+    /// @param segment Index of the segment
+    /// @param sequence Set to the sequence number of the segment
+    /// @return Whether the segment contains a valid header
+    bool Read_Segment_Header(size_t const & segment, uint32_t & sequence);
+
+    /// @brief Erases the given segment and writes a new header, so that new messages are appended to it
+    /// @param segment Index of the segment
+    /// @param sequence Sequence number of the segment
+    /// @return Whether starting the segment was successful or not
+    bool Start_Segment(size_t const & segment, uint32_t const & sequence);
+
+    /// @brief Reads the metadata of the message at the given position, without validating its checksum
+    /// @param segment Index of the segment the message is stored in
+    /// @param offset Offset into the segment the message is stored at
+    /// @param record Set to the metadata of the message
+    /// @return Whether reading the metadata was successful or not
+    bool Read_Metadata(size_t const & segment, size_t const & offset, Persistent_Record & record);
+
+    /// @brief Reads the header of the message at the given position and validates its checksum
+    /// @param segment Index of the segment the message is stored in
+    /// @param offset Offset into the segment the message is stored at
+    /// @param header Set to the header of the message
+    /// @return Whether the message is valid, not written yet or only partially written
+    Record_State Read_Record(size_t const & segment, size_t const & offset, Record_Header & header);
+
+    /// @brief Moves the given position to the next message that has not been delivered yet, skipping delivered and partially written messages
+    /// @param segment Index of the segment the position is in, moved to the segment containing the next pending message
+    /// @param offset Offset into the segment, moved to the offset of the next pending message or the write position if there is none
+    /// @param erase_finished Whether segments that have been passed are erased, only allowed for the read position because the replay position is never behind it
+    /// @return Whether erasing the segments was successful or not
+    bool Find_Pending(size_t & segment, size_t & offset, bool const & erase_finished);
+
+    /// @brief Moves the read position to the oldest message that has not been delivered yet and erases all segments that only contain delivered messages
+    /// @return Whether erasing the segments was successful or not
+    bool Find_Front();
+
+    /// @brief Amount of bytes a message with the given payload size occupies in a segment
+    /// @param payload_size Size of the payload in bytes
+    /// @return Size of the header and the payload, rounded up to the next multiple of 4 bytes, because some flash memory can only be written in words
+    static size_t Calculate_Record_Size(size_t const & payload_size);
+
+    /// @brief Continues calculating the CRC32 checksum over the given bytes
+    /// @param crc Checksum calculated over all previous bytes, has to be 0 for the first bytes
+    /// @param data Bytes the checksum should be calculated over
+    /// @param size Amount of bytes
+    /// @return Checksum calculated over all previous and the given bytes
+    static uint32_t Calculate_Crc(uint32_t crc, uint8_t const * data, size_t const & size);
+
+    IStorage *m_storage = {};        // Non owning pointer to the storage the log is persisted in, nullptr if the log is closed
+    size_t   m_segment_amount = {};  // Amount of segments in the storage
+    size_t   m_segment_size = {};    // Size of a single segment in bytes
+    size_t   m_read_segment = {};    // Index of the segment containing the oldest message that has not been delivered yet
+    size_t   m_read_offset = {};     // Offset into the read segment of the oldest message that has not been delivered yet
+    size_t   m_replay_segment = {};  // Index of the segment containing the oldest message that has not been replayed yet
+    size_t   m_replay_offset = {};   // Offset into the replay segment of the oldest message that has not been replayed yet
+    size_t   m_replay_amount = {};   // Amount of messages between the read and the replay position, that have been replayed but not delivered yet
+    size_t   m_write_segment = {};   // Index of the segment new messages are appended to
+    size_t   m_write_offset = {};    // Offset into the write segment the next message is appended at
+    uint32_t m_write_sequence = {};  // Sequence number of the write segment
+    size_t   m_size = {};            // Amount of stored messages that have not been delivered yet
+};
+
+#endif // Persistent_Log_h
@@ -0,0 +1,143 @@
+// Header include.
+#include "Protobuf_Reader.h"
+
+// Library includes.
+#include <string.h>
+
+/// @brief Biggest field number allowed by the protobuf encoding, because the tag stores it together with the wire type in 32 bits
+uint32_t constexpr MAX_FIELD_NUMBER = (1U << 29U) - 1U;
+/// @brief Maximum amount of bits a variable length integer contains, everything above would overflow the 64-bit value
+uint8_t constexpr MAX_VARINT_BITS = 64U;
+
+Protobuf_Reader::Protobuf_Reader(uint8_t const * data, size_t const & size)
+  : m_data(data)
+  , m_size(data != nullptr ? size : 0U)
+  , m_offset(0U)
+  , m_malformed(false)
+{
+    // Nothing to do
+}
+
+bool Protobuf_Reader::Next_Field(uint32_t & field_number, Protobuf_Wire_Type & wire_type) {
+    if (m_malformed || m_offset >= m_size) {
+        return false;
+    }
+    uint64_t tag = 0U;
+    if (!Read_Varint(tag)) {
+        return false;
+    }
+    uint64_t const number = tag >> 3U;
+    uint8_t const type = static_cast<uint8_t>(tag & 0x07U);
+    if (number == 0U || number > MAX_FIELD_NUMBER) {
+        return Set_Malformed();
+    }
+    else if (type != static_cast<uint8_t>(Protobuf_Wire_Type::VARINT) && type != static_cast<uint8_t>(Protobuf_Wire_Type::FIXED64) &&
+             type != static_cast<uint8_t>(Protobuf_Wire_Type::LENGTH_DELIMITED) && type != static_cast<uint8_t>(Protobuf_Wire_Type::FIXED32)) {
+        return Set_Malformed();
+    }
+    field_number = static_cast<uint32_t>(number);
+    wire_type = static_cast<Protobuf_Wire_Type>(type);
+    return true;
+}
+
+bool Protobuf_Reader::Read_Varint(uint64_t & value) {
+    if (m_malformed) {
+        return false;
+    }
+    uint64_t result = 0U;
+    for (uint8_t shift = 0U; shift < MAX_VARINT_BITS; shift += 7U) {
+        if (m_offset >= m_size) {
+            return Set_Malformed();
+        }
+        uint8_t const current = m_data[m_offset++];
+        result |= static_cast<uint64_t>(current & 0x7FU) << shift;
+        if ((current & 0x80U) == 0U) {
+            value = result;
+            return true;
+        }
+    }
+    return Set_Malformed();
+}
+
+bool Protobuf_Reader::Read_Fixed32(uint32_t & value) {
+    if (m_malformed || m_size - m_offset < sizeof(value)) {
+        return Set_Malformed();
+    }
+    value = static_cast<uint32_t>(m_data[m_offset]) | (static_cast<uint32_t>(m_data[m_offset + 1U]) << 8U) | (static_cast<uint32_t>(m_data[m_offset + 2U]) << 16U) | (static_cast<uint32_t>(m_data[m_offset + 3U]) << 24U);
+    m_offset += sizeof(value);
+    return true;
+}
+
+bool Protobuf_Reader::Read_Fixed64(uint64_t & value) {
+    uint32_t low = 0U;
+    uint32_t high = 0U;
+    if (!Read_Fixed32(low) || !Read_Fixed32(high)) {
+        return false;
+    }
+    value = (static_cast<uint64_t>(high) << 32U) | low;
+    return true;
+}
+
+bool Protobuf_Reader::Read_Double(double & value) {
+    uint64_t bits = 0U;
+    if (!Read_Fixed64(bits)) {
+        return false;
+    }
+    (void)memcpy(&value, &bits, sizeof(value));
+    return true;
+}
+
+bool Protobuf_Reader::Read_Length_Delimited(uint8_t const * & data, size_t & size) {
+    uint64_t length = 0U;
+    if (!Read_Varint(length)) {
+        return false;
+    }
+    else if (length > m_size - m_offset) {
+        return Set_Malformed();
+    }
+    data = m_data + m_offset;
+    size = static_cast<size_t>(length);
+    m_offset += size;
+    return true;
+}
+
+bool Protobuf_Reader::Skip_Field(Protobuf_Wire_Type const & wire_type) {
+    uint64_t value = 0U;
+    uint32_t fixed = 0U;
+    uint8_t const * data = nullptr;
+    size_t size = 0U;
+    switch (wire_type) {
+        case Protobuf_Wire_Type::VARINT:
+            return Read_Varint(value);
+        case Protobuf_Wire_Type::FIXED64:
+            return Read_Fixed64(value);
+        case Protobuf_Wire_Type::LENGTH_DELIMITED:
+            return Read_Length_Delimited(data, size);
+        case Protobuf_Wire_Type::FIXED32:
+            return Read_Fixed32(fixed);
+        default:
+            // Nothing to do
+            break;
+    }
+    return Set_Malformed();
+}
+
+bool Protobuf_Reader::Is_Malformed() const {
+    return m_malformed;
+}
+
+char const * Protobuf_Reader::Terminate_In_Place(uint8_t * message, uint8_t const * data, size_t const & size) {
+    if (message == nullptr || data == nullptr) {
+        return "";
+    }
+    // Writeable pointer is calculated from the offset into the message, because the reader only ever returns constant pointers
+    char * terminated = reinterpret_cast<char *>(message + (data - message)) - 1U;
+    (void)memmove(terminated, terminated + 1U, size);
+    terminated[size] = '\0';
+    return terminated;
+}
+
+bool Protobuf_Reader::Set_Malformed() {
+    m_malformed = true;
+    return false;
+}
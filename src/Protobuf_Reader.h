@@ -0,0 +1,86 @@
+#ifndef Protobuf_Reader_h
+#define Protobuf_Reader_h
+
+// Local includes.
+#include "Protobuf_Wire_Type.h"
+
+// Library includes.
+#include <stddef.h>
+#include <stdint.h>
+
+
+/// @brief Reads the fields of an encoded protobuf message one after another, directly from the received bytes without copying them or allocating any memory
+/// @note Every field is read by first calling @ref Next_Field, to get its number and encoding, followed by the read method matching the encoding or @ref Skip_Field for unknown fields.
+/// Nested messages are read by constructing another reader around the bytes returned by @ref Read_Length_Delimited.
+/// Every read is bounds checked, once any read fails because the message is truncated or malformed, all following reads fail as well and @ref Is_Malformed returns true.
+/// See https://protobuf.dev/programming-guides/encoding/ for more information on the encoding
+class Protobuf_Reader {
+  public:
+    /// @brief Constructs the reader around the given encoded message
+    /// @param data Non owning pointer to the encoded message, has to be kept alive for as long as this instance or any bytes returned by it are used
+    /// @param size Size of the encoded message in bytes
+    Protobuf_Reader(uint8_t const * data, size_t const & size);
+
+    /// @brief Reads the tag of the next field
+    /// @param field_number Set to the number of the field in the .proto message definition
+    /// @param wire_type Set to the encoding of the value following the tag
+    /// @return Whether there was another field, false once the end of the message has been reached or the message is malformed
+    bool Next_Field(uint32_t & field_number, Protobuf_Wire_Type & wire_type);
+
+    /// @brief Reads the value of the current field, if it was encoded as a variable length integer
+    /// @param value Set to the value, the 32-bit and zigzag encoded types still have to be converted by the caller
+    /// @return Whether reading the value was successful or not
+    bool Read_Varint(uint64_t & value);
+
+    /// @brief Reads the value of the current field, if it was encoded as 4 bytes in little endian byte order
+    /// @param value Set to the value
+    /// @return Whether reading the value was successful or not
+    bool Read_Fixed32(uint32_t & value);
+
+    /// @brief Reads the value of the current field, if it was encoded as 8 bytes in little endian byte order
+    /// @param value Set to the value
+    /// @return Whether reading the value was successful or not
+    bool Read_Fixed64(uint64_t & value);
+
+    /// @brief Reads the value of the current field, if it is a double field
+    /// @param value Set to the value
+    /// @return Whether reading the value was successful or not
+    bool Read_Double(double & value);
+
+    /// @brief Reads the value of the current field, if it was encoded as its size followed by its bytes (string, bytes, nested message or packed repeated field)
+    /// @param data Set to the non owning pointer to the first byte of the value inside of the encoded message, the value is not null terminated
+    /// @param size Set to the size of the value in bytes
+    /// @return Whether reading the value was successful or not
+    bool Read_Length_Delimited(uint8_t const * & data, size_t & size);
+
+    /// @brief Skips the value of the current field, used for fields that are not known or not needed
+    /// @param wire_type Encoding of the value, as returned by @ref Next_Field
+    /// @return Whether skipping the value was successful or not
+    bool Skip_Field(Protobuf_Wire_Type const & wire_type);
+
+    /// @brief Whether any read failed, because the message was truncated or contained an invalid encoding
+    /// @return Whether the message is malformed
+    bool Is_Malformed() const;
+
+    /// @brief Null terminates a value returned by @ref Read_Length_Delimited directly inside of the writeable encoded message it was read from, without copying it into another buffer
+    /// @note Every length delimited value is preceded by atleast one byte containing its size, which is not needed anymore once the value has been read.
+    /// Therefore the value is moved one byte to the front over the last byte of its size, which frees the last byte of the value for the null terminator, without touching any byte outside of the field.
+    /// Modifies the encoded message, meaning the field can not be read again afterwards
+    /// @param message Writeable encoded message the value has been read from, or the outer message containing it
+    /// @param data Non owning pointer to the first byte of the value inside of the given message, as returned by @ref Read_Length_Delimited, nullptr returns an empty string
+    /// @param size Size of the value in bytes
+    /// @return Non owning pointer to the null terminated value inside of the encoded message
+    static char const * Terminate_In_Place(uint8_t * message, uint8_t const * data, size_t const & size);
+
+  private:
+    /// @brief Marks the message as malformed, which causes all following reads to fail
+    /// @return Always false, allows to directly return the value from the read methods
+    bool Set_Malformed();
+
+    uint8_t const *m_data = {};       // Non owning pointer to the encoded message
+    size_t        m_size = {};        // Size of the encoded message in bytes
+    size_t        m_offset = {};      // Offset into the encoded message the next read starts at
+    bool          m_malformed = {};   // Whether any read failed because the message was truncated or contained an invalid encoding
+};
+
+#endif // Protobuf_Reader_h
@@ -0,0 +1,28 @@
+// Header include.
+#include "Protobuf_Schema.h"
+
+// Library includes.
+#include <string.h>
+
+Protobuf_Schema::Protobuf_Schema(Protobuf_Field const * fields, size_t const & field_amount)
+  : m_fields(fields)
+  , m_field_amount(fields != nullptr ? field_amount : 0U)
+{
+    // Nothing to do
+}
+
+Protobuf_Field const * Protobuf_Schema::Find_Field(char const * key) const {
+    if (key == nullptr) {
+        return nullptr;
+    }
+    for (size_t i = 0U; i < m_field_amount; i++) {
+        if (m_fields[i].key != nullptr && strcmp(m_fields[i].key, key) == 0) {
+            return &m_fields[i];
+        }
+    }
+    return nullptr;
+}
+
+size_t const & Protobuf_Schema::size() const {
+    return m_field_amount;
+}
@@ -0,0 +1,70 @@
+#ifndef Protobuf_Schema_h
+#define Protobuf_Schema_h
+
+// Library includes.
+#include <stddef.h>
+#include <stdint.h>
+
+
+/// @brief Possible scalar types of a field in a protobuf message, decides how the value of a key-value pair is encoded.
+/// See https://protobuf.dev/programming-guides/proto3/#scalar for more information
+enum class Protobuf_Type : uint8_t {
+    BOOL, ///< bool, written as a variable length integer with the value 0 or 1
+    INT32, ///< int32, written as a variable length integer, where negative values always take 10 bytes
+    INT64, ///< int64, written as a variable length integer, where negative values always take 10 bytes
+    UINT32, ///< uint32, written as a variable length integer
+    UINT64, ///< uint64, written as a variable length integer
+    SINT32, ///< sint32, written as a zigzag encoded variable length integer, where small negative values take as few bytes as small positive values
+    SINT64, ///< sint64, written as a zigzag encoded variable length integer, where small negative values take as few bytes as small positive values
+    FLOAT, ///< float, written as 4 bytes
+    DOUBLE, ///< double, written as 8 bytes
+    STRING ///< string, written as its size followed by its characters
+};
+
+
+/// @brief Maps a single key to a field of the protobuf message, that is configured in the device profile on the ThingsBoard server
+/// @note Is an aggregate, meaning the fields can be declared as a constexpr array at compile time ({"temperature", 1U, Protobuf_Type::DOUBLE}, ...)
+struct Protobuf_Field {
+    char const    *key;    // Non owning pointer to the key the field is used for, has to be kept alive for as long as the schema is used
+    uint32_t      number;  // Number of the field in the .proto message definition, has to be between 1 and 536870911
+    Protobuf_Type type;    // Type of the field in the .proto message definition
+};
+
+
+/// @brief User-supplied description of a flat protobuf message, which allows to encode key-value pairs without any generated code, reflection or dynamic allocation
+/// @note Has to match the telemetry or attributes proto schema configured in the protobuf transport payload type of the device profile on the ThingsBoard server,
+/// the message definition message SensorDataReading { optional double temperature = 1; optional int32 humidity = 2; } for example requires the fields {"temperature", 1U, Protobuf_Type::DOUBLE}, {"humidity", 2U, Protobuf_Type::INT32}.
+/// Only references the given fields, meaning they are not copied and have to be kept alive for as long as the schema is used.
+/// See https://thingsboard.io/docs/user-guide/device-profiles/#mqtt-device-payload for more information
+class Protobuf_Schema {
+  public:
+    /// @brief Constructs the schema referencing the given fields
+    /// @param fields Non owning pointer to the first field of the message, has to be kept alive for as long as the schema is used
+    /// @param field_amount Amount of fields in the message
+    Protobuf_Schema(Protobuf_Field const * fields, size_t const & field_amount);
+
+    /// @brief Constructs the schema referencing the given array of fields
+    /// @tparam FieldAmount Amount of fields in the message, deduced from the size of the array
+    /// @param fields Array containing all fields of the message, has to be kept alive for as long as the schema is used
+    template<size_t FieldAmount>
+    Protobuf_Schema(Protobuf_Field const (&fields)[FieldAmount])
+      : Protobuf_Schema(fields, FieldAmount)
+    {
+        // Nothing to do
+    }
+
+    /// @brief Returns the field the given key is mapped to
+    /// @param key Non owning pointer to the key
+    /// @return Non owning pointer to the field or nullptr if the key is not part of the message
+    Protobuf_Field const * Find_Field(char const * key) const;
+
+    /// @brief Amount of fields in the message
+    /// @return Amount of fields
+    size_t const & size() const;
+
+  private:
+    Protobuf_Field const *m_fields = {};       // Non owning pointer to the first field of the message
+    size_t               m_field_amount = {};  // Amount of fields in the message
+};
+
+#endif // Protobuf_Schema_h
@@ -0,0 +1,228 @@
+#ifndef Protobuf_Serializer_h
+#define Protobuf_Serializer_h
+
+// Local includes.
+#include "Protobuf_Schema.h"
+#include "Protobuf_Wire_Type.h"
+
+// Library includes.
+#include <stdint.h>
+#include <string.h>
+
+
+// Maximum amount of bytes a variable length integer occupies, 7 bits of the 64-bit value are stored in every byte.
+uint8_t constexpr MAX_VARINT_SIZE = 10U;
+
+
+/// @brief Static helper class that writes single protobuf fields directly as binary into a writer, without having to create a message object beforehand.
+/// @note Has the same requirements on the given writer as the @ref Json_Serializer, meaning the @ref Fixed_Buffer_Writer and the @ref Buffered_Publish_Writer can be used.
+/// Writing a nested message or a packed repeated field requires its size before its content, which can be measured by writing it into a @ref Fixed_Buffer_Writer without a buffer beforehand.
+/// All methods return the total amount of bytes written, where 0 means the value can not be written into a field of the given type, in which case nothing has been written either.
+/// See https://protobuf.dev/programming-guides/encoding/ for more information on the encoding
+class Protobuf_Serializer {
+  public:
+    /// @brief Writes the given value as a variable length integer
+    /// @tparam TWriter Writer class the value is written into
+    /// @param writer Writer the value is written into
+    /// @param value Value that should be written
+    /// @return Amount of bytes that have been written
+    template<typename TWriter>
+    static size_t Write_Varint(TWriter & writer, uint64_t value) {
+        uint8_t buffer[MAX_VARINT_SIZE] = {};
+        uint8_t length = 0U;
+        while (value >= 0x80U) {
+            buffer[length++] = static_cast<uint8_t>(value) | 0x80U;
+            value >>= 7U;
+        }
+        buffer[length++] = static_cast<uint8_t>(value);
+        return writer.write(buffer, length);
+    }
+
+    /// @brief Writes the tag in front of a field, containing its number and how its value is encoded
+    /// @tparam TWriter Writer class the tag is written into
+    /// @param writer Writer the tag is written into
+    /// @param field_number Number of the field in the .proto message definition
+    /// @param wire_type Encoding of the value following the tag
+    /// @return Amount of bytes that have been written
+    template<typename TWriter>
+    static size_t Write_Tag(TWriter & writer, uint32_t const & field_number, Protobuf_Wire_Type const & wire_type) {
+        return Write_Varint(writer, (static_cast<uint64_t>(field_number) << 3U) | static_cast<uint8_t>(wire_type));
+    }
+
+    /// @brief Writes the given value as 4 bytes in little endian byte order, independent of the byte order of the device
+    /// @tparam TWriter Writer class the value is written into
+    /// @param writer Writer the value is written into
+    /// @param value Value that should be written
+    /// @return Amount of bytes that have been written
+    template<typename TWriter>
+    static size_t Write_Fixed32(TWriter & writer, uint32_t const & value) {
+        uint8_t const buffer[sizeof(value)] = { static_cast<uint8_t>(value), static_cast<uint8_t>(value >> 8U), static_cast<uint8_t>(value >> 16U), static_cast<uint8_t>(value >> 24U) };
+        return writer.write(buffer, sizeof(buffer));
+    }
+
+    /// @brief Writes the given value as 8 bytes in little endian byte order, independent of the byte order of the device
+    /// @tparam TWriter Writer class the value is written into
+    /// @param writer Writer the value is written into
+    /// @param value Value that should be written
+    /// @return Amount of bytes that have been written
+    template<typename TWriter>
+    static size_t Write_Fixed64(TWriter & writer, uint64_t const & value) {
+        return Write_Fixed32(writer, static_cast<uint32_t>(value)) + Write_Fixed32(writer, static_cast<uint32_t>(value >> 32U));
+    }
+
+    /// @brief Writes the given integral value without a tag, encoded as the given type, used for the single elements of a packed repeated field
+    /// @note Floating point types are accepted as well, in which case the value is converted before it is written
+    /// @tparam TWriter Writer class the value is written into
+    /// @param writer Writer the value is written into
+    /// @param type Type of the field the value is written into
+    /// @param value Value that should be written
+    /// @return Amount of bytes that have been written, 0 for string fields
+    template<typename TWriter>
+    static size_t Write_Integer(TWriter & writer, Protobuf_Type const & type, int64_t const & value) {
+        switch (type) {
+            case Protobuf_Type::FLOAT:
+            case Protobuf_Type::DOUBLE:
+                return Write_Real(writer, type, static_cast<double>(value));
+            case Protobuf_Type::STRING:
+                return 0U;
+            default:
+                return Write_Varint(writer, Encode_Integer(type, value));
+        }
+    }
+
+    /// @brief Writes the given floating point value without a tag, encoded as the given type, used for the single elements of a packed repeated field
+    /// @tparam TWriter Writer class the value is written into
+    /// @param writer Writer the value is written into
+    /// @param type Type of the field the value is written into
+    /// @param value Value that should be written
+    /// @return Amount of bytes that have been written, 0 for every type except float and double, because the value would have to be truncated
+    template<typename TWriter>
+    static size_t Write_Real(TWriter & writer, Protobuf_Type const & type, double const & value) {
+        if (type == Protobuf_Type::FLOAT) {
+            float const single = static_cast<float>(value);
+            uint32_t bits = 0U;
+            (void)memcpy(&bits, &single, sizeof(bits));
+            return Write_Fixed32(writer, bits);
+        }
+        else if (type == Protobuf_Type::DOUBLE) {
+            uint64_t bits = 0U;
+            (void)memcpy(&bits, &value, sizeof(bits));
+            return Write_Fixed64(writer, bits);
+        }
+        return 0U;
+    }
+
+    /// @brief Writes the given integral value as a field with the given number, encoded as the given type
+    /// @tparam TWriter Writer class the field is written into
+    /// @param writer Writer the field is written into
+    /// @param field_number Number of the field in the .proto message definition
+    /// @param type Type of the field in the .proto message definition
+    /// @param value Value that should be written, converted if the field is a floating point type
+    /// @return Amount of bytes that have been written, 0 for string fields
+    template<typename TWriter>
+    static size_t Write_Integer_Field(TWriter & writer, uint32_t const & field_number, Protobuf_Type const & type, int64_t const & value) {
+        if (type == Protobuf_Type::STRING) {
+            return 0U;
+        }
+        size_t const size = Write_Tag(writer, field_number, Get_Wire_Type(type));
+        return size + Write_Integer(writer, type, value);
+    }
+
+    /// @brief Writes the given floating point value as a field with the given number, encoded as the given type
+    /// @tparam TWriter Writer class the field is written into
+    /// @param writer Writer the field is written into
+    /// @param field_number Number of the field in the .proto message definition
+    /// @param type Type of the field in the .proto message definition
+    /// @param value Value that should be written
+    /// @return Amount of bytes that have been written, 0 for every type except float and double
+    template<typename TWriter>
+    static size_t Write_Real_Field(TWriter & writer, uint32_t const & field_number, Protobuf_Type const & type, double const & value) {
+        if (type != Protobuf_Type::FLOAT && type != Protobuf_Type::DOUBLE) {
+            return 0U;
+        }
+        size_t const size = Write_Tag(writer, field_number, Get_Wire_Type(type));
+        return size + Write_Real(writer, type, value);
+    }
+
+    /// @brief Writes the given bytes as a length-delimited field with the given number, used for string and bytes fields as well as already encoded nested messages
+    /// @tparam TWriter Writer class the field is written into
+    /// @param writer Writer the field is written into
+    /// @param field_number Number of the field in the .proto message definition
+    /// @param data Non owning pointer to the bytes that should be written
+    /// @param size Amount of bytes that should be written
+    /// @return Amount of bytes that have been written
+    template<typename TWriter>
+    static size_t Write_Bytes_Field(TWriter & writer, uint32_t const & field_number, uint8_t const * data, size_t const & size) {
+        size_t written = Write_Tag(writer, field_number, Protobuf_Wire_Type::LENGTH_DELIMITED);
+        written += Write_Varint(writer, size);
+        return written + writer.write(data, size);
+    }
+
+    /// @brief Writes the given string as a string field with the given number
+    /// @tparam TWriter Writer class the field is written into
+    /// @param writer Writer the field is written into
+    /// @param field_number Number of the field in the .proto message definition
+    /// @param str Non owning pointer to the null terminated string that should be written, is written as an empty string if it is a nullptr
+    /// @return Amount of bytes that have been written
+    template<typename TWriter>
+    static size_t Write_String_Field(TWriter & writer, uint32_t const & field_number, char const * str) {
+        return Write_Bytes_Field(writer, field_number, reinterpret_cast<uint8_t const *>(str), str != nullptr ? strlen(str) : 0U);
+    }
+
+    /// @brief Amount of bytes the given value occupies once it is written as a variable length integer
+    /// @param value Value that should be written
+    /// @return Amount of bytes between 1 and MAX_VARINT_SIZE
+    static size_t Get_Varint_Size(uint64_t value) {
+        size_t size = 1U;
+        while (value >= 0x80U) {
+            value >>= 7U;
+            size++;
+        }
+        return size;
+    }
+
+    /// @brief Encoding used for the value of a field of the given type
+    /// @param type Type of the field in the .proto message definition
+    /// @return Wire type written into the tag in front of the field
+    static Protobuf_Wire_Type Get_Wire_Type(Protobuf_Type const & type) {
+        switch (type) {
+            case Protobuf_Type::FLOAT:
+                return Protobuf_Wire_Type::FIXED32;
+            case Protobuf_Type::DOUBLE:
+                return Protobuf_Wire_Type::FIXED64;
+            case Protobuf_Type::STRING:
+                return Protobuf_Wire_Type::LENGTH_DELIMITED;
+            default:
+                return Protobuf_Wire_Type::VARINT;
+        }
+    }
+
+  private:
+    /// @brief Converts the given integral value into the unsigned value that is written as a variable length integer for the given type
+    /// @note 32-bit types are truncated first, where int32 is sign extended again, because negative int32 values are written with all 64 bits the same as negative int64 values
+    /// @param type Type of the field in the .proto message definition, has to be a boolean or an integral type
+    /// @param value Value that should be written
+    /// @return Unsigned value that is written as a variable length integer
+    static uint64_t Encode_Integer(Protobuf_Type const & type, int64_t const & value) {
+        switch (type) {
+            case Protobuf_Type::BOOL:
+                return value != 0 ? 1U : 0U;
+            case Protobuf_Type::INT32:
+                return static_cast<uint64_t>(static_cast<int64_t>(static_cast<int32_t>(value)));
+            case Protobuf_Type::UINT32:
+                return static_cast<uint32_t>(value);
+            case Protobuf_Type::SINT32: {
+                uint32_t const bits = static_cast<uint32_t>(value);
+                return (bits << 1U) ^ (0U - (bits >> 31U));
+            }
+            case Protobuf_Type::SINT64: {
+                uint64_t const bits = static_cast<uint64_t>(value);
+                return (bits << 1U) ^ (0U - (bits >> 63U));
+            }
+            default:
+                return static_cast<uint64_t>(value);
+        }
+    }
+};
+
+#endif // Protobuf_Serializer_h
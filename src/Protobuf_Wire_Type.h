@@ -0,0 +1,18 @@
+#ifndef Protobuf_Wire_Type_h
+#define Protobuf_Wire_Type_h
+
+// Library include.
+#include <stdint.h>
+
+
+/// @brief Possible encodings of a single field in a protobuf message, stored in the lowest 3 bits of the tag written in front of every field
+/// @note The deprecated group encodings (3 and 4) are not supported and are treated as malformed input.
+/// See https://protobuf.dev/programming-guides/encoding/#structure for more information
+enum class Protobuf_Wire_Type : uint8_t {
+    VARINT = 0U, ///< Variable length integer, used for bool, int32, int64, uint32, uint64, sint32, sint64 and enum fields
+    FIXED64 = 1U, ///< 8 bytes in little endian byte order, used for double, fixed64 and sfixed64 fields
+    LENGTH_DELIMITED = 2U, ///< Variable length integer containing the size in bytes followed by the bytes themselves, used for string, bytes, nested messages and packed repeated fields
+    FIXED32 = 5U ///< 4 bytes in little endian byte order, used for float, fixed32 and sfixed32 fields
+};
+
+#endif // Protobuf_Wire_Type_h
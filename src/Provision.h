@@ -112,8 +112,9 @@ class Provision : public IAPI_Implementation {
         (void)Provision_Unsubscribe();
     }
 
-    bool Is_Response_Topic_Matching(char const * topic) const override {
-        return strncmp(PROV_RESPONSE_TOPIC, topic, strlen(PROV_RESPONSE_TOPIC) + 1) == 0;
+    char const * Get_Response_Topic(bool & exact) const override {
+        exact = true;
+        return PROV_RESPONSE_TOPIC;
     }
 
     bool Unsubscribe() override {
@@ -0,0 +1,22 @@
+#ifndef Publish_Priority_h
+#define Publish_Priority_h
+
+// Library include.
+#include <stddef.h>
+#include <stdint.h>
+
+
+/// @brief Possible priority classes outgoing messages are sorted into, before they are handed to the underlying MQTT client
+/// @note Only has an effect if an outbound queue has been configured for the class with ThingsBoardSized::Set_Outbound_Queue, otherwise messages of that class are published immediately in call order.
+/// Queued messages are published in the loop() method, where all pending messages of a higher priority class are published before any message of a lower priority class.
+/// Allows control-plane replies to overtake a burst of queued telemetry data, instead of waiting behind everything that has been sent before them
+enum class Publish_Priority : uint8_t {
+    CONTROL, ///< Messages sent by API implementations, for example server-side RPC responses, firmware state updates, attribute requests or provisioning requests
+    NORMAL, ///< Attribute data sent by the device
+    BULK ///< Telemetry data sent by the device
+};
+
+/// @brief Amount of possible priority classes in @ref Publish_Priority
+size_t constexpr PUBLISH_PRIORITY_AMOUNT = 3U;
+
+#endif // Publish_Priority_h
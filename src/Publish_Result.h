@@ -0,0 +1,22 @@
+#ifndef Publish_Result_h
+#define Publish_Result_h
+
+// Library include.
+#include <stdint.h>
+
+
+/// @brief Possible results of the last attempt to send data, returned by ThingsBoardSized::Get_Last_Publish_Result
+/// @note The send methods themselves keep returning a bool, where true means SUCCESS and false means any of the other results.
+/// Allows to differentiate failures that are worth retrying later (WOULD_BLOCK, QUEUE_FULL, RATE_LIMITED, NOT_CONNECTED) from failures that will never succeed with the same data (INVALID_PAYLOAD)
+enum class Publish_Result : uint8_t {
+    SUCCESS, ///< Message has been handed to the MQTT client, queued in an outbound queue or merged with the coalesced telemetry key-value pairs
+    INVALID_PAYLOAD, ///< Message could not be serialized, because it contains invalid data or the JsonDocument it was created from is too small
+    OUT_OF_MEMORY, ///< Allocating the memory required to serialize the message failed
+    NOT_CONNECTED, ///< MQTT client refused the message, because it is currently not connected to the MQTT broker
+    CLIENT_ERROR, ///< MQTT client refused the message, even though it is connected to the MQTT broker, for example because the message is bigger than its buffer
+    QUEUE_FULL, ///< Outbound queue of the priority class of the message does not have enough space left
+    RATE_LIMITED, ///< Publishing the message would exceed the configured client-side rate limits and the priority class of the message has no outbound queue to defer it
+    WOULD_BLOCK ///< Outbound backlog reached the configured high-water mark, the message was discarded to give the client time to publish the already pending messages
+};
+
+#endif // Publish_Result_h
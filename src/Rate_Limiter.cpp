@@ -0,0 +1,98 @@
+// Header include.
+#include "Rate_Limiter.h"
+
+// Library includes.
+#include <stdlib.h>
+
+Rate_Limiter::Rate_Limiter()
+  : m_buckets()
+  , m_bucket_amount(0U)
+  , m_last_refill(0U)
+{
+    // Nothing to do
+}
+
+bool Rate_Limiter::Set_Limits(char const * limits) {
+    m_bucket_amount = 0U;
+    m_last_refill = Helper::Get_Milliseconds();
+    if (Helper::String_IsNull_Or_Empty(limits)) {
+        return true;
+    }
+
+    size_t amount = 0U;
+    char * end = nullptr;
+    while (*limits != '\0') {
+        if (amount >= MAX_RATE_LIMIT_BUCKETS) {
+            return false;
+        }
+        unsigned long const capacity = strtoul(limits, &end, 10);
+        if (end == limits || *end != ':' || capacity == 0U) {
+            return false;
+        }
+        limits = end + 1U;
+        unsigned long const period_s = strtoul(limits, &end, 10);
+        if (end == limits || (*end != ',' && *end != '\0') || period_s == 0U) {
+            return false;
+        }
+        limits = *end == ',' ? end + 1U : end;
+
+        Token_Bucket & bucket = m_buckets[amount];
+        bucket.capacity = static_cast<uint32_t>(capacity);
+        bucket.period_ms = static_cast<uint32_t>(period_s * 1000U);
+        bucket.tokens = static_cast<uint64_t>(bucket.capacity) * bucket.period_ms;
+        amount++;
+    }
+    m_bucket_amount = amount;
+    return true;
+}
+
+bool Rate_Limiter::Is_Enabled() const {
+    return m_bucket_amount != 0U;
+}
+
+bool Rate_Limiter::Can_Consume(size_t const & amount) {
+    Refill();
+    for (size_t i = 0U; i < m_bucket_amount; i++) {
+        if (m_buckets[i].tokens < Calculate_Cost(m_buckets[i], amount)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Rate_Limiter::Consume(size_t const & amount) {
+    for (size_t i = 0U; i < m_bucket_amount; i++) {
+        uint64_t const cost = Calculate_Cost(m_buckets[i], amount);
+        m_buckets[i].tokens = m_buckets[i].tokens > cost ? m_buckets[i].tokens - cost : 0U;
+    }
+}
+
+size_t Rate_Limiter::Get_Budget() {
+    if (!Is_Enabled()) {
+        return SIZE_MAX;
+    }
+    Refill();
+    uint64_t budget = UINT64_MAX;
+    for (size_t i = 0U; i < m_bucket_amount; i++) {
+        uint64_t const tokens = m_buckets[i].tokens / m_buckets[i].period_ms;
+        budget = tokens < budget ? tokens : budget;
+    }
+    return static_cast<size_t>(budget);
+}
+
+void Rate_Limiter::Refill() {
+    uint32_t const now = Helper::Get_Milliseconds();
+    uint32_t const elapsed = now - m_last_refill;
+    m_last_refill = now;
+    for (size_t i = 0U; i < m_bucket_amount; i++) {
+        Token_Bucket & bucket = m_buckets[i];
+        uint64_t const maximum = static_cast<uint64_t>(bucket.capacity) * bucket.period_ms;
+        uint64_t const refilled = static_cast<uint64_t>(elapsed) * bucket.capacity;
+        bucket.tokens = maximum - bucket.tokens > refilled ? bucket.tokens + refilled : maximum;
+    }
+}
+
+uint64_t Rate_Limiter::Calculate_Cost(Token_Bucket const & bucket, size_t const & amount) {
+    uint64_t const limited_amount = amount < bucket.capacity ? amount : bucket.capacity;
+    return limited_amount * bucket.period_ms;
+}
@@ -0,0 +1,69 @@
+#ifndef Rate_Limiter_h
+#define Rate_Limiter_h
+
+// Local includes.
+#include "Helper.h"
+
+
+/// @brief Maximum amount of token buckets a single rate limit configuration string can contain ("10:1,300:60" contains 2)
+size_t constexpr MAX_RATE_LIMIT_BUCKETS = 4U;
+
+
+/// @brief Client-side rate limiter, consisting of multiple token buckets that all have to contain enough tokens to allow consuming
+/// @note Is configured with the same format ThingsBoard uses for the rate limits in the tenant and device profiles, meaning a comma seperated list of capacity:period_in_seconds pairs ("10:1,300:60").
+/// Where each pair allows to consume up to the capacity in the given period, for example 10 messages per second and additionally 300 messages per minute.
+/// Tokens are refilled continuously over the period instead of all at once at the end of the period, meaning a full bucket allows a burst of up to the capacity, followed by an evenly distributed rate afterwards.
+/// The buckets are stored inside of the class itself, meaning configuring the rate limiter does not require any heap allocation
+class Rate_Limiter {
+  public:
+    /// @brief Constructs a disabled rate limiter, that always allows consuming
+    Rate_Limiter();
+
+    /// @brief Parses the given rate limit configuration string and replaces the current token buckets with it, where all new buckets start completely filled
+    /// @param limits Non owning pointer to the comma seperated list of capacity:period_in_seconds pairs ("10:1,300:60"), containing at most MAX_RATE_LIMIT_BUCKETS pairs.
+    /// Does not need to be kept alive, because the string is parsed once in this method. Passing a nullptr or empty string disables the rate limiter
+    /// @return Whether parsing the given configuration string was successful or not, the rate limiter is disabled if it was not
+    bool Set_Limits(char const * limits);
+
+    /// @brief Whether any token bucket has been configured
+    /// @return Whether the rate limiter is enabled
+    bool Is_Enabled() const;
+
+    /// @brief Whether the given amount of tokens can currently be consumed from all token buckets
+    /// @note Amounts that are bigger than the capacity of a bucket are limited to its capacity, because they could otherwise never be consumed at all
+    /// @param amount Amount of tokens that should be consumed
+    /// @return Whether all buckets contain enough tokens, always true if the rate limiter is disabled
+    bool Can_Consume(size_t const & amount);
+
+    /// @brief Removes the given amount of tokens from all token buckets, should only be called if @ref Can_Consume returned true for the same amount
+    /// @param amount Amount of tokens that should be consumed
+    void Consume(size_t const & amount);
+
+    /// @brief Amount of whole tokens that can currently be consumed from all token buckets
+    /// @return Amount of tokens in the bucket containing the fewest tokens, SIZE_MAX if the rate limiter is disabled
+    size_t Get_Budget();
+
+  private:
+    /// @brief Single token bucket, where the tokens are scaled by the period in milliseconds,
+    /// this allows to refill the bucket by exactly the elapsed amount of milliseconds multiplied by the capacity without losing fractional tokens
+    struct Token_Bucket {
+        uint32_t capacity;    // Maximum amount of tokens in the bucket, is the amount of tokens that can be consumed in the period
+        uint32_t period_ms;   // Period in milliseconds it takes to completely refill an empty bucket
+        uint64_t tokens;      // Current amount of tokens in the bucket multiplied by the period in milliseconds
+    };
+
+    /// @brief Adds the tokens that have been refilled since the last call to all token buckets
+    void Refill();
+
+    /// @brief Amount of tokens the given amount costs in the given bucket, multiplied by its period in milliseconds
+    /// @param bucket Token bucket the amount should be consumed from
+    /// @param amount Amount of tokens that should be consumed
+    /// @return Scaled amount of tokens, limited to the capacity of the bucket
+    static uint64_t Calculate_Cost(Token_Bucket const & bucket, size_t const & amount);
+
+    Token_Bucket m_buckets[MAX_RATE_LIMIT_BUCKETS] = {}; // Configured token buckets, only the first m_bucket_amount elements are used
+    size_t       m_bucket_amount = {};                   // Amount of configured token buckets, 0 means the rate limiter is disabled
+    uint32_t     m_last_refill = {};                     // Time in milliseconds the token buckets have been refilled at last
+};
+
+#endif // Rate_Limiter_h
@@ -4,17 +4,34 @@
 // Local includes.
 #include "RPC_Callback.h"
 #include "IAPI_Implementation.h"
+#include "Protobuf_Reader.h"
 
 
 // server-side RPC topics.
+#if THINGSBOARD_ENABLE_SHORT_TOPICS
+char constexpr RPC_SUBSCRIBE_TOPIC[] = "v2/r/req/+";
+char constexpr RPC_REQUEST_TOPIC[] = "v2/r/req/";
+char constexpr RPC_SEND_RESPONSE_TOPIC[] = "v2/r/res/%u";
+#else
 char constexpr RPC_SUBSCRIBE_TOPIC[] = "v1/devices/me/rpc/request/+";
 char constexpr RPC_REQUEST_TOPIC[] = "v1/devices/me/rpc/request/";
 char constexpr RPC_SEND_RESPONSE_TOPIC[] = "v1/devices/me/rpc/response/%u";
+#endif // THINGSBOARD_ENABLE_SHORT_TOPICS
+// Field numbers of the default RPC request (method = 1, requestId = 2, params = 3) and RPC response (payload = 1) proto schema of a device profile with the protobuf transport payload type.
+uint32_t constexpr RPC_PROTOBUF_METHOD_FIELD = 1U;
+uint32_t constexpr RPC_PROTOBUF_PARAMS_FIELD = 3U;
+uint32_t constexpr RPC_PROTOBUF_PAYLOAD_FIELD = 1U;
 // Log messages.
 char constexpr RPC_RESPONSE_OVERFLOWED[] = "Server-side RPC response overflowed, increase MaxRPC (%u)";
-#if !THINGSBOARD_ENABLE_DYNAMIC
+char constexpr UNABLE_TO_DECODE_RPC_PROTOBUF[] = "Unable to decode received protobuf server-side RPC request with size (%u)";
+char constexpr UNABLE_TO_DE_SERIALIZE_RPC_PARAMS[] = "Unable to de-serialize params of received protobuf server-side RPC request with error (DeserializationError::%s)";
+#if THINGSBOARD_ENABLE_DYNAMIC
+char constexpr RPC_PARAMS_ALLOCATION_FAILED[] = "Failed allocating required size (%u) for the params of received protobuf server-side RPC request";
+char constexpr RPC_PARAMS_MAXIMUM_RESPONSE_EXCEEDED[] = "Prevented allocation on the heap (%u) for the params of received protobuf server-side RPC request, that are bigger than maximum response size (%u)";
+#else
 char constexpr SERVER_SIDE_RPC_SUBSCRIPTIONS[] = "server-side RPC";
-#endif // !THINGSBOARD_ENABLE_DYNAMIC
+char constexpr MAX_RPC_TEMPLATE_NAME[] = "MaxRPC";
+#endif // THINGSBOARD_ENABLE_DYNAMIC
 #if THINGSBOARD_ENABLE_DEBUG
 char constexpr SERVER_RPC_METHOD_NULL[] = "Server-side RPC method name is NULL";
 char constexpr RPC_RESPONSE_NULL[] = "Response JsonDocument is NULL, skipping sending";
@@ -33,7 +50,8 @@ template <typename Logger = DefaultLogger>
 /// Once the maximum amount has been reached it is not possible to increase the size, this is done because it allows to allcoate the memory on the stack instead of the heap, default = DEFAULT_SUBSCRIPTION_AMOUNT (1)
 /// @tparam MaxRPC Maximum amount of key-value pairs that will ever be sent in the subscribed callback method of an @ref RPC_Callback, allows to use a StaticJsonDocument on the stack in the background.
 /// If we simply use .to<JsonVariant>(); on the received document and use .set() to change the internal value then the size requirements are 0.
-/// However if we attempt to send multiple key-value pairs, we have to adjust the size accordingly. See https://arduinojson.org/v6/assistant/ for more information on how to estimate the required size and divide the result by 16 to receive the required MaxRPC value, default = DEFAULT_RPC_AMOUNT (0)
+/// However if we attempt to send multiple key-value pairs, we have to adjust the size accordingly. See https://arduinojson.org/v6/assistant/ for more information on how to estimate the required size and divide the result by 16 to receive the required MaxRPC value.
+/// Additionally limits the amount of key-value pairs the params of requests received as protobuf may contain, because they are deserialized into a StaticJsonDocument of the same size, default = DEFAULT_RPC_AMOUNT (0)
 template<size_t MaxSubscriptions = DEFAULT_SUBSCRIPTION_AMOUNT, size_t MaxRPC = DEFAULT_RPC_AMOUNT, typename Logger = DefaultLogger>
 #endif // THINGSBOARD_ENABLE_DYNAMIC
 class Server_Side_RPC : public IAPI_Implementation {
@@ -101,12 +119,84 @@ class Server_Side_RPC : public IAPI_Implementation {
         return m_unsubscribe_topic_callback.Call_Callback(RPC_SUBSCRIBE_TOPIC);
     }
 
+    /// @brief Sets the format received server-side RPC requests are expected in and responses are sent in, has to match the transport payload type of the device profile on the ThingsBoard server
+    /// @note Protobuf requests are decoded with the default RPC request proto schema of the device profile, where the params string is deserialized as json and passed to the subscribed callback the same way as the params of json requests.
+    /// The json response of the callback is sent serialized into the payload string of the default RPC response proto schema.
+    /// See https://thingsboard.io/docs/user-guide/device-profiles/#mqtt-device-payload for more information
+    /// @param process_type Format of requests and responses, either JSON (default) or PROTOBUF
+    /// @return Whether the given format is supported, RAW is not
+    bool Set_Process_Type(API_Process_Type process_type) {
+        if (process_type == API_Process_Type::RAW) {
+            return false;
+        }
+        m_process_type = process_type;
+        return true;
+    }
+
     API_Process_Type Get_Process_Type() const override {
-        return API_Process_Type::JSON;
+        return m_process_type;
     }
 
     void Process_Response(char const * topic, uint8_t * payload, uint32_t length) override {
-        // Nothing to do
+        Protobuf_Reader reader(payload, length);
+        uint8_t const * method = nullptr;
+        size_t method_size = 0U;
+        uint8_t const * params = nullptr;
+        size_t params_size = 0U;
+        uint32_t field_number = 0U;
+        Protobuf_Wire_Type wire_type = {};
+        while (reader.Next_Field(field_number, wire_type)) {
+            if (wire_type == Protobuf_Wire_Type::LENGTH_DELIMITED && field_number == RPC_PROTOBUF_METHOD_FIELD) {
+                (void)reader.Read_Length_Delimited(method, method_size);
+            }
+            else if (wire_type == Protobuf_Wire_Type::LENGTH_DELIMITED && field_number == RPC_PROTOBUF_PARAMS_FIELD) {
+                (void)reader.Read_Length_Delimited(params, params_size);
+            }
+            else {
+                (void)reader.Skip_Field(wire_type);
+            }
+        }
+        if (reader.Is_Malformed()) {
+            Logger::printfln(UNABLE_TO_DECODE_RPC_PROTOBUF, length);
+            return;
+        }
+        else if (method == nullptr) {
+#if THINGSBOARD_ENABLE_DEBUG
+            Logger::printfln(SERVER_RPC_METHOD_NULL);
+#endif // THINGSBOARD_ENABLE_DEBUG
+            return;
+        }
+
+        // Calculated the same way as the size of received json requests, see ThingsBoardSized::On_MQTT_Message for more information
+        size_t const size = params != nullptr ? Helper::Calculate_Json_Symbol_Occurences(params, params_size) : 0U;
+#if THINGSBOARD_ENABLE_DYNAMIC
+        if (m_max_response_size != 0U && JSON_OBJECT_SIZE(size) > m_max_response_size) {
+            Logger::printfln(RPC_PARAMS_MAXIMUM_RESPONSE_EXCEEDED, JSON_OBJECT_SIZE(size), m_max_response_size);
+            return;
+        }
+        TBJsonDocument params_buffer(JSON_OBJECT_SIZE(size));
+        if (params_buffer.capacity() != JSON_OBJECT_SIZE(size)) {
+            Logger::printfln(RPC_PARAMS_ALLOCATION_FAILED, JSON_OBJECT_SIZE(size));
+            return;
+        }
+#else
+        if (size > MaxRPC) {
+            Logger::printfln(TOO_MANY_JSON_FIELDS, size, MAX_RPC_TEMPLATE_NAME, MaxRPC);
+            return;
+        }
+        StaticJsonDocument<JSON_OBJECT_SIZE(MaxRPC)> params_buffer;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+        if (params != nullptr) {
+            // Payload is the writeable incoming buffer of the MQTT client, therefore the params can be deserialized with the zero copy mode, the same way as received json requests
+            DeserializationError const error = deserializeJson(params_buffer, reinterpret_cast<char *>(payload + (params - payload)), params_size);
+            if (error) {
+                Logger::printfln(UNABLE_TO_DE_SERIALIZE_RPC_PARAMS, error.c_str());
+                return;
+            }
+        }
+        // Method name is null terminated in place inside of the writeable incoming buffer of the MQTT client, which only moves the bytes of its own field and therefore keeps the deserialized params intact
+        char const * method_name = Protobuf_Reader::Terminate_In_Place(payload, method, method_size);
+        Handle_Request(topic, method_name, params_buffer.template as<JsonVariantConst>());
     }
 
     void Process_Json_Response(char const * topic, JsonDocument const & data) override {
@@ -117,7 +207,70 @@ class Server_Side_RPC : public IAPI_Implementation {
             return;
         }
         char const * method_name = data[RPC_METHOD_KEY];
+        Handle_Request(topic, method_name, data[RPC_PARAMS_KEY]);
+    }
+
+    char const * Get_Response_Topic(bool & exact) const override {
+        exact = false;
+        return RPC_REQUEST_TOPIC;
+    }
+
+    bool Add_Json_Filter(char const * topic, JsonDocument & filter) const override {
+        (void)topic;
+        filter[RPC_METHOD_KEY] = true;
+        filter[RPC_PARAMS_KEY] = true;
+        return true;
+    }
+
+    size_t Get_Json_Filter_Size(char const * topic) const override {
+        (void)topic;
+        return 2U;
+    }
+
+    bool Unsubscribe() override {
+        return RPC_Unsubscribe();
+    }
+
+    bool Resubscribe_Permanent_Subscriptions() override {
+        if (!m_rpc_callbacks.empty() && !m_subscribe_topic_callback.Call_Callback(RPC_SUBSCRIBE_TOPIC)) {
+            Logger::printfln(SUBSCRIBE_TOPIC_FAILED, RPC_SUBSCRIBE_TOPIC);
+            return false;
+        }
+        return true;
+    }
+
+#if !THINGSBOARD_USE_ESP_TIMER
+    void loop() override {
+        // Nothing to do
+    }
+#endif // !THINGSBOARD_USE_ESP_TIMER
+
+    void Initialize() override {
+        // Nothing to do
+    }
+
+#if THINGSBOARD_ENABLE_DYNAMIC
+    void Set_Max_Response_Size(size_t const & max_response_size) override {
+        m_max_response_size = max_response_size;
+    }
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+
+    void Set_Send_Protobuf_Json_Callback(Callback<bool, char const * const, uint32_t, JsonDocument const &>::function send_protobuf_json_callback) override {
+        m_send_protobuf_json_callback.Set_Callback(send_protobuf_json_callback);
+    }
+
+    void Set_Client_Callbacks(Callback<void, IAPI_Implementation &>::function subscribe_api_callback, Callback<bool, char const * const, JsonDocument const &>::function send_json_callback, Callback<bool, char const * const, char const * const>::function send_json_string_callback, Callback<bool, char const * const>::function subscribe_topic_callback, Callback<bool, char const * const>::function unsubscribe_topic_callback, Callback<uint16_t>::function get_receive_size_callback, Callback<uint16_t>::function get_send_size_callback, Callback<bool, uint16_t, uint16_t>::function set_buffer_size_callback, Callback<size_t *>::function get_request_id_callback) override {
+        m_send_json_callback.Set_Callback(send_json_callback);
+        m_subscribe_topic_callback.Set_Callback(subscribe_topic_callback);
+        m_unsubscribe_topic_callback.Set_Callback(unsubscribe_topic_callback);
+    }
 
+  private:
+    /// @brief Calls the callback subscribed to the given method and sends its response back to the server
+    /// @param topic Non owning pointer to the topic the request was received over, contains the id of the request
+    /// @param method_name Non owning pointer to the name of the requested method
+    /// @param param Parameters passed with the request, null if none were passed
+    void Handle_Request(char const * topic, char const * method_name, JsonVariantConst const & param) {
 #if THINGSBOARD_ENABLE_STL
         auto it = std::find_if(m_rpc_callbacks.begin(), m_rpc_callbacks.end(), [&method_name](RPC_Callback const & rpc) {
             char const * subscribedMethodName = rpc.Get_Name();
@@ -133,7 +286,7 @@ class Server_Side_RPC : public IAPI_Implementation {
             }
 #endif // THINGSBOARD_ENABLE_STL
 #if THINGSBOARD_ENABLE_DEBUG
-            if (!data.containsKey(RPC_PARAMS_KEY)) {
+            if (param.isNull()) {
                 Logger::printfln(NO_RPC_PARAMS_PASSED);
             }
 #endif // THINGSBOARD_ENABLE_DEBUG
@@ -142,7 +295,6 @@ class Server_Side_RPC : public IAPI_Implementation {
             Logger::printfln(CALLING_RPC_CB, method_name);
 #endif // THINGSBOARD_ENABLE_DEBUG
 
-            JsonVariantConst const param = data[RPC_PARAMS_KEY];
 #if THINGSBOARD_ENABLE_DYNAMIC
             auto const & rpc_response_size = rpc.Get_Response_Size();
             TBJsonDocument json_buffer(rpc_response_size);
@@ -163,47 +315,25 @@ class Server_Side_RPC : public IAPI_Implementation {
                 return;
             }
 
-            auto const request_id = Helper::Split_Topic_Into_Request_ID(topic, strlen(RPC_REQUEST_TOPIC));
-            char responseTopic[Helper::Calculate_Print_Size(RPC_SEND_RESPONSE_TOPIC, request_id)] = {};
-            (void)snprintf(responseTopic, sizeof(responseTopic), RPC_SEND_RESPONSE_TOPIC, request_id);
-            (void)m_send_json_callback.Call_Callback(responseTopic, json_buffer);
+            Send_Response(topic, json_buffer);
             return;
         }
     }
 
-    bool Is_Response_Topic_Matching(char const * topic) const override {
-        return strncmp(RPC_REQUEST_TOPIC, topic, strlen(RPC_REQUEST_TOPIC)) == 0;
-    }
-
-    bool Unsubscribe() override {
-        return RPC_Unsubscribe();
-    }
-
-    bool Resubscribe_Permanent_Subscriptions() override {
-        if (!m_rpc_callbacks.empty() && !m_subscribe_topic_callback.Call_Callback(RPC_SUBSCRIBE_TOPIC)) {
-            Logger::printfln(SUBSCRIBE_TOPIC_FAILED, RPC_SUBSCRIBE_TOPIC);
-            return false;
+    /// @brief Sends the given response to the request received over the given topic, in the format configured with @ref Set_Process_Type
+    /// @param topic Non owning pointer to the topic the request was received over, contains the id of the request
+    /// @param response Response of the subscribed callback
+    void Send_Response(char const * topic, JsonDocument const & response) {
+        auto const request_id = Helper::Split_Topic_Into_Request_ID(topic, strlen(RPC_REQUEST_TOPIC));
+        char responseTopic[Helper::Calculate_Print_Size(RPC_SEND_RESPONSE_TOPIC, request_id)] = {};
+        (void)snprintf(responseTopic, sizeof(responseTopic), RPC_SEND_RESPONSE_TOPIC, request_id);
+        if (m_process_type != API_Process_Type::PROTOBUF) {
+            (void)m_send_json_callback.Call_Callback(responseTopic, response);
+            return;
         }
-        return true;
+        (void)m_send_protobuf_json_callback.Call_Callback(responseTopic, RPC_PROTOBUF_PAYLOAD_FIELD, response);
     }
 
-#if !THINGSBOARD_USE_ESP_TIMER
-    void loop() override {
-        // Nothing to do
-    }
-#endif // !THINGSBOARD_USE_ESP_TIMER
-
-    void Initialize() override {
-        // Nothing to do
-    }
-
-    void Set_Client_Callbacks(Callback<void, IAPI_Implementation &>::function subscribe_api_callback, Callback<bool, char const * const, JsonDocument const &>::function send_json_callback, Callback<bool, char const * const, char const * const>::function send_json_string_callback, Callback<bool, char const * const>::function subscribe_topic_callback, Callback<bool, char const * const>::function unsubscribe_topic_callback, Callback<uint16_t>::function get_receive_size_callback, Callback<uint16_t>::function get_send_size_callback, Callback<bool, uint16_t, uint16_t>::function set_buffer_size_callback, Callback<size_t *>::function get_request_id_callback) override {
-        m_send_json_callback.Set_Callback(send_json_callback);
-        m_subscribe_topic_callback.Set_Callback(subscribe_topic_callback);
-        m_unsubscribe_topic_callback.Set_Callback(unsubscribe_topic_callback);
-    }
-
-  private:
 #if THINGSBOARD_ENABLE_DYNAMIC
     using Callback_Container = Container<RPC_Callback>;
 #else
@@ -211,9 +341,14 @@ class Server_Side_RPC : public IAPI_Implementation {
 #endif // THINGSBOARD_ENABLE_DYNAMIC
 
     Callback<bool, char const * const, JsonDocument const &> m_send_json_callback = {};         // Send json document callback
+    Callback<bool, char const * const, uint32_t, JsonDocument const &> m_send_protobuf_json_callback = {}; // Send json document wrapped into a protobuf field callback, used for responses encoded as protobuf
     Callback<bool, char const * const>                       m_subscribe_topic_callback = {};   // Subscribe mqtt topic client callback
     Callback<bool, char const * const>                       m_unsubscribe_topic_callback = {}; // Unubscribe mqtt topic client callback
     Callback_Container                                       m_rpc_callbacks = {};              // server-side RPC callbacks array
+    API_Process_Type                                         m_process_type = API_Process_Type::JSON; // Format received requests are expected in and responses are sent in
+#if THINGSBOARD_ENABLE_DYNAMIC
+    size_t                                                   m_max_response_size = {};          // Maximum amount of bytes allocated for the params of received protobuf requests, set by the ThingsBoard client, 0 means there is no limit
+#endif // THINGSBOARD_ENABLE_DYNAMIC
 };
 
 #endif // Server_Side_RPC_h
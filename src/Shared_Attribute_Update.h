@@ -4,12 +4,27 @@
 // Local includes.
 #include "Shared_Attribute_Callback.h"
 #include "IAPI_Implementation.h"
+#include "Protobuf_Reader.h"
 
 
+// Field numbers of the attribute update notification sent to devices with the protobuf transport payload type (AttributeUpdateNotificationMsg, TsKvProto and KeyValueProto of the ThingsBoard transport.proto).
+uint32_t constexpr ATTRIBUTE_UPDATE_PROTOBUF_UPDATED_FIELD = 1U;
+uint32_t constexpr ATTRIBUTE_UPDATE_PROTOBUF_KEY_VALUE_FIELD = 2U;
+uint32_t constexpr KEY_VALUE_PROTOBUF_KEY_FIELD = 1U;
+uint32_t constexpr KEY_VALUE_PROTOBUF_TYPE_FIELD = 2U;
+uint32_t constexpr KEY_VALUE_PROTOBUF_BOOL_FIELD = 3U;
+uint32_t constexpr KEY_VALUE_PROTOBUF_LONG_FIELD = 4U;
+uint32_t constexpr KEY_VALUE_PROTOBUF_DOUBLE_FIELD = 5U;
+uint32_t constexpr KEY_VALUE_PROTOBUF_STRING_FIELD = 6U;
+uint32_t constexpr KEY_VALUE_PROTOBUF_JSON_FIELD = 7U;
 // Log messages.
-#if !THINGSBOARD_ENABLE_DYNAMIC
+char constexpr UNABLE_TO_DECODE_ATTRIBUTE_PROTOBUF[] = "Unable to decode received protobuf shared attribute update with size (%u)";
+#if THINGSBOARD_ENABLE_DYNAMIC
+char constexpr ATTRIBUTE_UPDATE_ALLOCATION_FAILED[] = "Failed allocating required size (%u) for received protobuf shared attribute update";
+#else
 char constexpr SHARED_ATTRIBUTE_UPDATE_SUBSCRIPTIONS[] = "shared attribute update";
-#endif // !THINGSBOARD_ENABLE_DYNAMIC
+char constexpr MAX_UPDATE_ATTRIBUTES_TEMPLATE_NAME[] = "MaxUpdateAttributes";
+#endif // THINGSBOARD_ENABLE_DYNAMIC
 
 
 /// @brief Handles the internal implementation of the ThingsBoard shared Attribute Update API.
@@ -21,7 +36,9 @@ template <typename Logger = DefaultLogger>
 /// @tparam MaxSubscriptions Maximum amount of simultaneous shared attribute update subscriptions.
 /// Once the maximum amount has been reached it is not possible to increase the size, this is done because it allows to allcoate the memory on the stack instead of the heap, default = DEFAULT_SUBSCRIPTION_AMOUNT (1)
 /// @tparam MaxAttributes Maximum amount of attributes that will ever be subscribed with one @ref Shared_Attribute_Callback, allows to use an array on the stack in the background, default = DEFAULT_ATTRIBUTES_AMOUNT (1)
-template<size_t MaxSubscriptions = DEFAULT_SUBSCRIPTION_AMOUNT, size_t MaxAttributes = DEFAULT_ATTRIBUTES_AMOUNT, typename Logger = DefaultLogger>
+/// @tparam MaxUpdateAttributes Maximum amount of attributes a single update received as protobuf may contain, because they are decoded into a StaticJsonDocument of the same size.
+/// Should be the same as the MaxResponse of the used ThingsBoard client, which limits updates received as json the same way, default = DEFAULT_RESPONSE_AMOUNT (8)
+template<size_t MaxSubscriptions = DEFAULT_SUBSCRIPTION_AMOUNT, size_t MaxAttributes = DEFAULT_ATTRIBUTES_AMOUNT, size_t MaxUpdateAttributes = DEFAULT_RESPONSE_AMOUNT, typename Logger = DefaultLogger>
 #endif // THINGSBOARD_ENABLE_DYNAMIC
 class Shared_Attribute_Update : public IAPI_Implementation {
 #if THINGSBOARD_ENABLE_DYNAMIC
@@ -96,12 +113,74 @@ class Shared_Attribute_Update : public IAPI_Implementation {
         return m_unsubscribe_topic_callback.Call_Callback(ATTRIBUTE_TOPIC);
     }
 
+    /// @brief Sets the format received shared attribute updates are expected in, has to match the transport payload type of the device profile on the ThingsBoard server
+    /// @note Protobuf updates are decoded into a JsonDocument containing the updated attributes as key-value pairs, which is passed to the subscribed callbacks the same way as json updates.
+    /// Deleted attributes are not passed to the callbacks, because they are sent as a seperate list of keys without any value
+    /// See https://thingsboard.io/docs/user-guide/device-profiles/#mqtt-device-payload for more information
+    /// @param process_type Format of updates, either JSON (default) or PROTOBUF
+    /// @return Whether the given format is supported, RAW is not
+    bool Set_Process_Type(API_Process_Type process_type) {
+        if (process_type == API_Process_Type::RAW) {
+            return false;
+        }
+        m_process_type = process_type;
+        return true;
+    }
+
     API_Process_Type Get_Process_Type() const override {
-        return API_Process_Type::JSON;
+        return m_process_type;
     }
 
     void Process_Response(char const * topic, uint8_t * payload, uint32_t length) override {
-        // Nothing to do
+        size_t attribute_amount = 0U;
+        Protobuf_Attribute attribute = {};
+        bool malformed = false;
+        Protobuf_Reader reader(payload, length);
+        while (Next_Attribute(reader, attribute, malformed)) {
+            attribute_amount++;
+        }
+        if (malformed) {
+            Logger::printfln(UNABLE_TO_DECODE_ATTRIBUTE_PROTOBUF, length);
+            return;
+        }
+        else if (attribute_amount == 0U) {
+            return;
+        }
+
+#if THINGSBOARD_ENABLE_DYNAMIC
+        TBJsonDocument json_buffer(JSON_OBJECT_SIZE(attribute_amount));
+        if (json_buffer.capacity() != JSON_OBJECT_SIZE(attribute_amount)) {
+            Logger::printfln(ATTRIBUTE_UPDATE_ALLOCATION_FAILED, JSON_OBJECT_SIZE(attribute_amount));
+            return;
+        }
+#else
+        if (attribute_amount > MaxUpdateAttributes) {
+            Logger::printfln(TOO_MANY_JSON_FIELDS, attribute_amount, MAX_UPDATE_ATTRIBUTES_TEMPLATE_NAME, MaxUpdateAttributes);
+            return;
+        }
+        StaticJsonDocument<JSON_OBJECT_SIZE(MaxUpdateAttributes)> json_buffer;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+        // Keys and string values are not null terminated inside of the payload, therefore they are null terminated in place inside of the writeable incoming buffer of the MQTT client
+        // and only referenced by the JsonDocument, the same way received json updates are deserialized with the zero copy mode. Is done while reading the payload the second time, because it can not be read again afterwards
+        reader = Protobuf_Reader(payload, length);
+        while (Next_Attribute(reader, attribute, malformed)) {
+            char const * key = Protobuf_Reader::Terminate_In_Place(payload, attribute.key, attribute.key_size);
+            switch (attribute.type) {
+                case Key_Value_Type::BOOLEAN_V:
+                    json_buffer[key] = attribute.boolean;
+                    break;
+                case Key_Value_Type::LONG_V:
+                    json_buffer[key] = attribute.integer;
+                    break;
+                case Key_Value_Type::DOUBLE_V:
+                    json_buffer[key] = attribute.real;
+                    break;
+                default:
+                    json_buffer[key] = Protobuf_Reader::Terminate_In_Place(payload, attribute.str, attribute.str_size);
+                    break;
+            }
+        }
+        Handle_Update(json_buffer.template as<JsonObjectConst>());
     }
 
     void Process_Json_Response(char const * topic, JsonDocument const & data) override {
@@ -109,7 +188,102 @@ class Shared_Attribute_Update : public IAPI_Implementation {
         if (object.containsKey(SHARED_RESPONSE_KEY)) {
             object = object[SHARED_RESPONSE_KEY];
         }
+        Handle_Update(object);
+    }
+
+    char const * Get_Response_Topic(bool & exact) const override {
+        exact = true;
+        return ATTRIBUTE_TOPIC;
+    }
+
+    bool Add_Json_Filter(char const * topic, JsonDocument & filter) const override {
+        (void)topic;
+        for (auto const & shared_attribute : m_shared_attribute_update_callbacks) {
+            if (shared_attribute.Get_Attributes().empty()) {
+                // No specifc keys were subscribed so the callback requires every shared attribute
+                return false;
+            }
+            for (auto const & att : shared_attribute.Get_Attributes()) {
+                if (Helper::String_IsNull_Or_Empty(att)) {
+                    continue;
+                }
+                // Updates either contain the shared attributes directly or nested inside of the shared response key, see Process_Json_Response
+                filter[att] = true;
+                filter[SHARED_RESPONSE_KEY][att] = true;
+            }
+        }
+        return true;
+    }
+
+    size_t Get_Json_Filter_Size(char const * topic) const override {
+        (void)topic;
+        size_t size = 0U;
+        for (auto const & shared_attribute : m_shared_attribute_update_callbacks) {
+            if (shared_attribute.Get_Attributes().empty()) {
+                return 0U;
+            }
+            for (auto const & att : shared_attribute.Get_Attributes()) {
+                if (!Helper::String_IsNull_Or_Empty(att)) {
+                    size += 2U;
+                }
+            }
+        }
+        // Shared response key containing the nested attributes is only added once
+        return size != 0U ? size + 1U : 0U;
+    }
+
+    bool Unsubscribe() override {
+        return Shared_Attributes_Unsubscribe();
+    }
+
+    bool Resubscribe_Permanent_Subscriptions() override {
+        if (!m_shared_attribute_update_callbacks.empty() && !m_subscribe_topic_callback.Call_Callback(ATTRIBUTE_TOPIC)) {
+            Logger::printfln(SUBSCRIBE_TOPIC_FAILED, ATTRIBUTE_TOPIC);
+            return false;
+        }
+        return true;
+    }
+
+#if !THINGSBOARD_USE_ESP_TIMER
+    void loop() override {
+        // Nothing to do
+    }
+#endif // !THINGSBOARD_USE_ESP_TIMER
+
+    void Initialize() override {
+        // Nothing to do
+    }
+
+    void Set_Client_Callbacks(Callback<void, IAPI_Implementation &>::function subscribe_api_callback, Callback<bool, char const * const, JsonDocument const &>::function send_json_callback, Callback<bool, char const * const, char const * const>::function send_json_string_callback, Callback<bool, char const * const>::function subscribe_topic_callback, Callback<bool, char const * const>::function unsubscribe_topic_callback, Callback<uint16_t>::function get_receive_size_callback, Callback<uint16_t>::function get_send_size_callback, Callback<bool, uint16_t, uint16_t>::function set_buffer_size_callback, Callback<size_t *>::function get_request_id_callback) override {
+        m_subscribe_topic_callback.Set_Callback(subscribe_topic_callback);
+        m_unsubscribe_topic_callback.Set_Callback(unsubscribe_topic_callback);
+    }
+
+  private:
+    /// @brief Possible types of the value of a single attribute in a protobuf attribute update (KeyValueType of the ThingsBoard transport.proto)
+    enum class Key_Value_Type : uint8_t {
+        BOOLEAN_V, ///< Value is a boolean
+        LONG_V, ///< Value is a 64-bit integer
+        DOUBLE_V, ///< Value is a double precision floating point number
+        STRING_V, ///< Value is a string
+        JSON_V ///< Value is a json object serialized as a string, passed to the callbacks as a string as well
+    };
 
+    /// @brief Single attribute of a protobuf attribute update, the key and string value are referenced inside of the received payload and are not null terminated
+    struct Protobuf_Attribute {
+        uint8_t const  *key;      // Non owning pointer to the key inside of the received payload
+        size_t         key_size;  // Size of the key in bytes
+        Key_Value_Type type;      // Type of the value, decides which of the following values was sent
+        bool           boolean;   // Value if the type is BOOLEAN_V
+        int64_t        integer;   // Value if the type is LONG_V
+        double         real;      // Value if the type is DOUBLE_V
+        uint8_t const  *str;      // Non owning pointer to the value inside of the received payload if the type is STRING_V or JSON_V
+        size_t         str_size;  // Size of the string value in bytes
+    };
+
+    /// @brief Calls all subscribed callbacks, that are either subscribed to every shared attribute or to atleast one of the updated shared attributes
+    /// @param object Updated shared attributes as key-value pairs
+    void Handle_Update(JsonObjectConst const & object) {
 #if THINGSBOARD_ENABLE_STL
 #if THINGSBOARD_ENABLE_CXX20
         auto filtered_shared_attribute_update_callbacks = m_shared_attribute_update_callbacks | std::views::filter([&object](Callback_Value const & shared_attribute) {
@@ -155,41 +329,87 @@ class Shared_Attribute_Update : public IAPI_Implementation {
         }
     }
 
-    bool Is_Response_Topic_Matching(char const * topic) const override {
-        return strncmp(ATTRIBUTE_TOPIC, topic, strlen(ATTRIBUTE_TOPIC) + 1) == 0;
-    }
-
-    bool Unsubscribe() override {
-        return Shared_Attributes_Unsubscribe();
-    }
-
-    bool Resubscribe_Permanent_Subscriptions() override {
-        if (!m_shared_attribute_update_callbacks.empty() && !m_subscribe_topic_callback.Call_Callback(ATTRIBUTE_TOPIC)) {
-            Logger::printfln(SUBSCRIBE_TOPIC_FAILED, ATTRIBUTE_TOPIC);
-            return false;
+    /// @brief Reads the next updated attribute of a protobuf attribute update, skipping all deleted attributes
+    /// @param reader Reader of the received attribute update
+    /// @param attribute Set to the next updated attribute
+    /// @param malformed Set to true if the update or any of its attributes is malformed, in which case the complete update should be discarded instead of silently dropping single attributes
+    /// @return Whether there was another updated attribute, false once the end of the update has been reached or the update is malformed
+    static bool Next_Attribute(Protobuf_Reader & reader, Protobuf_Attribute & attribute, bool & malformed) {
+        uint32_t field_number = 0U;
+        Protobuf_Wire_Type wire_type = {};
+        while (reader.Next_Field(field_number, wire_type)) {
+            uint8_t const * data = nullptr;
+            size_t size = 0U;
+            if (wire_type != Protobuf_Wire_Type::LENGTH_DELIMITED || field_number != ATTRIBUTE_UPDATE_PROTOBUF_UPDATED_FIELD) {
+                (void)reader.Skip_Field(wire_type);
+                continue;
+            }
+            else if (!reader.Read_Length_Delimited(data, size)) {
+                break;
+            }
+            // Updated attribute additionally contains the timestamp of the update, which is skipped because only the key-value pair is passed to the callbacks
+            uint8_t const * key_value = nullptr;
+            size_t key_value_size = 0U;
+            Protobuf_Reader timestamped_reader(data, size);
+            while (timestamped_reader.Next_Field(field_number, wire_type)) {
+                if (wire_type == Protobuf_Wire_Type::LENGTH_DELIMITED && field_number == ATTRIBUTE_UPDATE_PROTOBUF_KEY_VALUE_FIELD) {
+                    (void)timestamped_reader.Read_Length_Delimited(key_value, key_value_size);
+                }
+                else {
+                    (void)timestamped_reader.Skip_Field(wire_type);
+                }
+            }
+            if (timestamped_reader.Is_Malformed() || key_value == nullptr || !Decode_Key_Value(key_value, key_value_size, attribute)) {
+                malformed = true;
+                return false;
+            }
+            return true;
         }
-        return true;
-    }
-
-#if !THINGSBOARD_USE_ESP_TIMER
-    void loop() override {
-        // Nothing to do
-    }
-#endif // !THINGSBOARD_USE_ESP_TIMER
-
-    void Initialize() override {
-        // Nothing to do
+        malformed = reader.Is_Malformed();
+        return false;
     }
 
-    void Set_Client_Callbacks(Callback<void, IAPI_Implementation &>::function subscribe_api_callback, Callback<bool, char const * const, JsonDocument const &>::function send_json_callback, Callback<bool, char const * const, char const * const>::function send_json_string_callback, Callback<bool, char const * const>::function subscribe_topic_callback, Callback<bool, char const * const>::function unsubscribe_topic_callback, Callback<uint16_t>::function get_receive_size_callback, Callback<uint16_t>::function get_send_size_callback, Callback<bool, uint16_t, uint16_t>::function set_buffer_size_callback, Callback<size_t *>::function get_request_id_callback) override {
-        m_subscribe_topic_callback.Set_Callback(subscribe_topic_callback);
-        m_unsubscribe_topic_callback.Set_Callback(unsubscribe_topic_callback);
+    /// @brief Decodes a single key-value pair of a protobuf attribute update
+    /// @param data Non owning pointer to the encoded key-value pair
+    /// @param size Size of the encoded key-value pair in bytes
+    /// @param attribute Set to the decoded key-value pair
+    /// @return Whether the key-value pair was valid and contained a key
+    static bool Decode_Key_Value(uint8_t const * data, size_t const & size, Protobuf_Attribute & attribute) {
+        attribute = {};
+        Protobuf_Reader reader(data, size);
+        uint32_t field_number = 0U;
+        Protobuf_Wire_Type wire_type = {};
+        uint64_t value = 0U;
+        while (reader.Next_Field(field_number, wire_type)) {
+            if (wire_type == Protobuf_Wire_Type::LENGTH_DELIMITED && field_number == KEY_VALUE_PROTOBUF_KEY_FIELD) {
+                (void)reader.Read_Length_Delimited(attribute.key, attribute.key_size);
+            }
+            else if (wire_type == Protobuf_Wire_Type::VARINT && field_number == KEY_VALUE_PROTOBUF_TYPE_FIELD && reader.Read_Varint(value)) {
+                attribute.type = static_cast<Key_Value_Type>(value);
+            }
+            else if (wire_type == Protobuf_Wire_Type::VARINT && field_number == KEY_VALUE_PROTOBUF_BOOL_FIELD && reader.Read_Varint(value)) {
+                attribute.boolean = value != 0U;
+            }
+            else if (wire_type == Protobuf_Wire_Type::VARINT && field_number == KEY_VALUE_PROTOBUF_LONG_FIELD && reader.Read_Varint(value)) {
+                attribute.integer = static_cast<int64_t>(value);
+            }
+            else if (wire_type == Protobuf_Wire_Type::FIXED64 && field_number == KEY_VALUE_PROTOBUF_DOUBLE_FIELD) {
+                (void)reader.Read_Double(attribute.real);
+            }
+            else if (wire_type == Protobuf_Wire_Type::LENGTH_DELIMITED && (field_number == KEY_VALUE_PROTOBUF_STRING_FIELD || field_number == KEY_VALUE_PROTOBUF_JSON_FIELD)) {
+                (void)reader.Read_Length_Delimited(attribute.str, attribute.str_size);
+            }
+            else {
+                (void)reader.Skip_Field(wire_type);
+            }
+        }
+        return !reader.Is_Malformed() && attribute.key != nullptr && attribute.type <= Key_Value_Type::JSON_V;
     }
 
-  private:
     Callback<bool, char const * const>                                       m_subscribe_topic_callback = {};          // Subscribe mqtt topic client callback
     Callback<bool, char const * const>                                       m_unsubscribe_topic_callback = {};        // Unubscribe mqtt topic client callback
     Callback_Container                                                       m_shared_attribute_update_callbacks = {}; // Shared attribute update callbacks array
+    API_Process_Type                                                         m_process_type = API_Process_Type::JSON;  // Format received updates are expected in
 };
 
 #endif // Shared_Attribute_Update_h
@@ -25,6 +25,128 @@ Telemetry::Telemetry(char const * key, char const * value)
     m_value.str = value;
 }
 
+Telemetry::Telemetry(char const * key, int16_t const * values, size_t const & size, Array_Encoding encoding)
+  : m_type(DataType::TYPE_INT16_ARRAY)
+  , m_encoding(encoding)
+  , m_key(key)
+  , m_value()
+{
+    m_value.array.data = values;
+    m_value.array.size = size;
+}
+
+Telemetry::Telemetry(char const * key, int32_t const * values, size_t const & size, Array_Encoding encoding)
+  : m_type(DataType::TYPE_INT32_ARRAY)
+  , m_encoding(encoding)
+  , m_key(key)
+  , m_value()
+{
+    m_value.array.data = values;
+    m_value.array.size = size;
+}
+
+Telemetry::Telemetry(char const * key, float const * values, size_t const & size, Array_Encoding encoding)
+  : m_type(DataType::TYPE_FLOAT_ARRAY)
+  , m_encoding(encoding)
+  , m_key(key)
+  , m_value()
+{
+    m_value.array.data = values;
+    m_value.array.size = size;
+}
+
+Telemetry::Telemetry(char const * key, double const * values, size_t const & size, Array_Encoding encoding)
+  : m_type(DataType::TYPE_DOUBLE_ARRAY)
+  , m_encoding(encoding)
+  , m_key(key)
+  , m_value()
+{
+    m_value.array.data = values;
+    m_value.array.size = size;
+}
+
 bool Telemetry::IsEmpty() const {
     return (m_key == nullptr) && m_type == DataType::TYPE_NONE;
 }
+
+char const * Telemetry::GetKey() const {
+    return m_key;
+}
+
+bool Telemetry::GetInteger(int64_t & value) const {
+    if (m_type != DataType::TYPE_INT) {
+        return false;
+    }
+    value = m_value.integer;
+    return true;
+}
+
+bool Telemetry::GetReal(double & value) const {
+    if (m_type != DataType::TYPE_REAL) {
+        return false;
+    }
+    value = m_value.real;
+    return true;
+}
+
+void Telemetry::SetDecimalPlaces(uint8_t const & decimal_places) {
+    m_decimal_places = decimal_places;
+}
+
+uint8_t Telemetry::GetDecimalPlaces() const {
+    return m_decimal_places;
+}
+
+bool Telemetry::GetBoolean(bool & value) const {
+    if (m_type != DataType::TYPE_BOOL) {
+        return false;
+    }
+    value = m_value.boolean;
+    return true;
+}
+
+bool Telemetry::GetString(char const * & value) const {
+    if (m_type != DataType::TYPE_STR) {
+        return false;
+    }
+    value = m_value.str;
+    return true;
+}
+
+double Telemetry::Round_Real(double const & value) const {
+    if (m_decimal_places == UNLIMITED_DECIMAL_PLACES) {
+        return value;
+    }
+    return Json_Serializer::Round_To_Decimal_Places(value, m_decimal_places);
+}
+
+int64_t Telemetry::Get_Array_Integer(size_t const & index) const {
+    if (m_type == DataType::TYPE_INT16_ARRAY) {
+        return static_cast<int16_t const *>(m_value.array.data)[index];
+    }
+    return static_cast<int32_t const *>(m_value.array.data)[index];
+}
+
+double Telemetry::Get_Array_Real(size_t const & index) const {
+    if (m_type == DataType::TYPE_FLOAT_ARRAY) {
+        return static_cast<float const *>(m_value.array.data)[index];
+    }
+    return static_cast<double const *>(m_value.array.data)[index];
+}
+
+size_t Telemetry::Get_Array_Element_Size() const {
+    switch (m_type) {
+        case DataType::TYPE_INT16_ARRAY:
+            return sizeof(int16_t);
+        case DataType::TYPE_INT32_ARRAY:
+            return sizeof(int32_t);
+        case DataType::TYPE_FLOAT_ARRAY:
+            return sizeof(float);
+        case DataType::TYPE_DOUBLE_ARRAY:
+            return sizeof(double);
+        default:
+            // Nothing to do
+            break;
+    }
+    return 0U;
+}
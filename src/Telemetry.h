@@ -2,7 +2,12 @@
 #define Telemetry_h
 
 // Local includes.
+#include "Array_Encoding.h"
 #include "Configuration.h"
+#include "Fixed_Buffer_Writer.h"
+#include "Json_Serializer.h"
+#include "Protobuf_Schema.h"
+#include "Protobuf_Serializer.h"
 
 // Library includes.
 #include <ArduinoJson.h>
@@ -11,6 +16,10 @@
 #endif // THINGSBOARD_ENABLE_STL
 
 
+/// @brief Marks that floating point values of a @ref Telemetry record are not rounded, but written in the format selected with THINGSBOARD_REAL_FORMAT instead
+uint8_t constexpr UNLIMITED_DECIMAL_PLACES = UINT8_MAX;
+
+
 /// @brief Telemetry record class, allows to store different data using a common interface
 /// @note Is used to allow to easily create a key-value pair of multiple different types that can then be deserialized into a json message
 class Telemetry {
@@ -60,6 +69,31 @@ class Telemetry {
         m_value.real = value;
     }
 
+    /// @brief Constructs a telemetry record from floating point value, that is rounded to the given amount of decimal places once it is serialized
+    /// @note Allows to only send the digits the sensor actually provides (21.46 instead of 21.456000328063965), which reduces the size of the payload considerably for many keys.
+    /// Rounding is done half away from zero on the value scaled by the power of ten, meaning the same value is always sent with the same digits, independent of THINGSBOARD_REAL_FORMAT
+    /// @tparam T Type of the passed value, is required to be a floating point,
+    /// to ensure this constructor isn't used instead of the boolean one by mistake
+    /// @param key Key of the key-value pair we want to create
+    /// @param value Value of the key-value pair we want to create
+    /// @param decimal_places Amount of decimal places the value is rounded to, at most 9, see @ref SetDecimalPlaces
+    template <typename T,
+#if THINGSBOARD_ENABLE_STL
+              // Standard library is_floating_point, includes float and double
+              typename std::enable_if<std::is_floating_point<T>::value>::type* = nullptr>
+#else
+              // Workaround for ArduinoJson version after 6.21.0, to still be able to access internal enable_if and is_floating_point declarations, previously accessible with ARDUINOJSON_NAMESPACE
+              typename ArduinoJson::ARDUINOJSON_VERSION_NAMESPACE::detail::enable_if<ArduinoJson::ARDUINOJSON_VERSION_NAMESPACE::detail::is_floating_point<T>::value>::type* = nullptr>
+#endif // THINGSBOARD_ENABLE_STL
+    Telemetry(char const * key, T const & value, uint8_t const & decimal_places)
+      : m_type(DataType::TYPE_REAL)
+      , m_decimal_places(decimal_places)
+      , m_key(key)
+      , m_value()
+    {
+        m_value.real = value;
+    }
+
     /// @brief Constructs a telemetry record from boolean value	
     /// @param key Key of the key-value pair we want to create
     /// @param value Value of the key-value pair we want to create
@@ -70,10 +104,64 @@ class Telemetry {
     /// @param value Value of the key-value pair we want to create
     Telemetry(char const * key, char const * value);
 
+    /// @brief Constructs a telemetry record referencing a buffer of 16-bit integral samples, for example the raw output of an ADC
+    /// @note The samples are not copied, but instead directly serialized from the given buffer once the record is sent, meaning no intermediate copy or JsonDocument is required.
+    /// Serializing into a JsonDocument with @ref SerializeKeyValue only supports the json array encoding, because the base64 string would have to be copied into the document
+    /// @param key Key of the key-value pair we want to create
+    /// @param values Non owning pointer to the first sample, has to be kept alive until the record has been sent
+    /// @param size Amount of samples in the buffer
+    /// @param encoding Representation the samples are serialized as, default = Array_Encoding::JSON_ARRAY
+    Telemetry(char const * key, int16_t const * values, size_t const & size, Array_Encoding encoding = Array_Encoding::JSON_ARRAY);
+
+    /// @copydoc Telemetry::Telemetry(char const *, int16_t const *, size_t const &, Array_Encoding)
+    Telemetry(char const * key, int32_t const * values, size_t const & size, Array_Encoding encoding = Array_Encoding::JSON_ARRAY);
+
+    /// @brief Constructs a telemetry record referencing a buffer of single precision floating point samples
+    /// @copydetails Telemetry::Telemetry(char const *, int16_t const *, size_t const &, Array_Encoding)
+    Telemetry(char const * key, float const * values, size_t const & size, Array_Encoding encoding = Array_Encoding::JSON_ARRAY);
+
+    /// @brief Constructs a telemetry record referencing a buffer of double precision floating point samples
+    /// @copydetails Telemetry::Telemetry(char const *, int16_t const *, size_t const &, Array_Encoding)
+    Telemetry(char const * key, double const * values, size_t const & size, Array_Encoding encoding = Array_Encoding::JSON_ARRAY);
+
     /// @brief Whether this record is empty or not
     /// @return Whether there is any data in this record or not
     bool IsEmpty() const;
 
+    /// @brief Returns the key of the key-value pair contained in this record
+    /// @return Non owning pointer to the key of the key-value pair, or nullptr if this record only contains a value
+    char const * GetKey() const;
+
+    /// @brief Returns the value contained in this record, if it is an integral value
+    /// @param value Set to the contained integral value
+    /// @return Whether this record contains an integral value
+    bool GetInteger(int64_t & value) const;
+
+    /// @brief Returns the value contained in this record, if it is a floating point value
+    /// @param value Set to the contained floating point value
+    /// @return Whether this record contains a floating point value
+    bool GetReal(double & value) const;
+
+    /// @brief Sets the amount of decimal places floating point values are rounded to once they are serialized, applies to a single value as well as to every sample of a referenced float or double buffer
+    /// @note Has no effect on integral, boolean or string values. Values are rounded before they are written into a JsonDocument as well, meaning the same digits are sent independent of the used send method,
+    /// as long as the integral digits and the decimal places together do not exceed the 9 significant digits ArduinoJson writes
+    /// @param decimal_places Amount of decimal places, at most 9. Passing UNLIMITED_DECIMAL_PLACES writes the value in the format selected with THINGSBOARD_REAL_FORMAT again
+    void SetDecimalPlaces(uint8_t const & decimal_places);
+
+    /// @brief Returns the amount of decimal places floating point values are rounded to once they are serialized
+    /// @return Amount of decimal places, or UNLIMITED_DECIMAL_PLACES if the value is written in the format selected with THINGSBOARD_REAL_FORMAT
+    uint8_t GetDecimalPlaces() const;
+
+    /// @brief Returns the value contained in this record, if it is a boolean value
+    /// @param value Set to the contained boolean value
+    /// @return Whether this record contains a boolean value
+    bool GetBoolean(bool & value) const;
+
+    /// @brief Returns the value contained in this record, if it is a string value
+    /// @param value Set to the non owning pointer to the contained string value
+    /// @return Whether this record contains a string value
+    bool GetString(char const * & value) const;
+
     /// @brief Serializes a key-value pair or only a value, depending on the constructor used
     /// @tparam TSource Source class that the given key-value pair or only a value, should be copied into
     /// @param source Data source that should contain the key-value pair or a value
@@ -95,16 +183,31 @@ class Telemetry {
                 return source.set(m_value.integer);
             case DataType::TYPE_REAL:
                 if (m_key) {
-                    source[m_key] = m_value.real;
+                    source[m_key] = Round_Real(m_value.real);
                     return source.containsKey(m_key);
                 }
-                return source.set(m_value.real);
+                return source.set(Round_Real(m_value.real));
             case DataType::TYPE_STR:
                 if (m_key) {
                     source[m_key] = m_value.str;
                     return source.containsKey(m_key);
                 }
                 return source.set(m_value.str);
+            case DataType::TYPE_INT16_ARRAY:
+            case DataType::TYPE_INT32_ARRAY:
+            case DataType::TYPE_FLOAT_ARRAY:
+            case DataType::TYPE_DOUBLE_ARRAY: {
+                if (m_encoding != Array_Encoding::JSON_ARRAY) {
+                    return false;
+                }
+                JsonArray array = m_key ? source.createNestedArray(m_key) : source.createNestedArray();
+                for (size_t i = 0U; i < m_value.array.size; i++) {
+                    if (!(m_type == DataType::TYPE_INT16_ARRAY || m_type == DataType::TYPE_INT32_ARRAY ? array.add(Get_Array_Integer(i)) : array.add(Round_Real(Get_Array_Real(i))))) {
+                        return false;
+                    }
+                }
+                return !array.isNull();
+            }
             default:
                 // Nothing to do
                 break;
@@ -112,13 +215,189 @@ class Telemetry {
         return false;
     }
 
+    /// @brief Writes the key-value pair ("key":value) or only the value, depending on the constructor used, directly as json text into the given writer
+    /// @note Skips creating a JsonDocument alltogether, which allows to serialize multiple key-value pairs into a json object, without having to allocate memory for all of them at once.
+    /// See @ref Json_Serializer for more information on the requirements of the writer
+    /// @tparam TWriter Writer class the key-value pair is written into
+    /// @param writer Writer the key-value pair is written into
+    /// @return Amount of bytes that have been written, 0 if this record is empty
+    template <typename TWriter>
+    size_t SerializeJson(TWriter & writer) const {
+        if (IsEmpty()) {
+            return 0U;
+        }
+        size_t size = 0U;
+        if (m_key) {
+            size += Json_Serializer::Write_String(writer, m_key);
+            size += Json_Serializer::Write_Character(writer, ':');
+        }
+        switch (m_type) {
+            case DataType::TYPE_BOOL:
+                return size + Json_Serializer::Write_Boolean(writer, m_value.boolean);
+            case DataType::TYPE_INT:
+                return size + Json_Serializer::Write_Integer(writer, m_value.integer);
+            case DataType::TYPE_REAL:
+                return size + Serialize_Real(writer, m_value.real);
+            case DataType::TYPE_STR:
+                return size + Json_Serializer::Write_String(writer, m_value.str);
+            case DataType::TYPE_INT16_ARRAY:
+            case DataType::TYPE_INT32_ARRAY:
+            case DataType::TYPE_FLOAT_ARRAY:
+            case DataType::TYPE_DOUBLE_ARRAY:
+                return size + Serialize_Array(writer);
+            default:
+                // Nothing to do
+                break;
+        }
+        return size + Json_Serializer::Write_Null(writer);
+    }
+
+    /// @brief Writes the value of the key-value pair directly as a protobuf field into the given writer, where the number and type of the field are looked up with the key in the given schema
+    /// @note Boolean and integral values can be written into any boolean, integral or floating point field, floating point values only into floating point fields and string values only into string fields.
+    /// A referenced buffer of samples is written as a packed repeated field of the type of the field, independent of the encoding passed to the constructor.
+    /// See @ref Protobuf_Serializer for more information on the requirements of the writer
+    /// @tparam TWriter Writer class the field is written into
+    /// @param writer Writer the field is written into
+    /// @param schema Description of the protobuf message the field is part of
+    /// @return Amount of bytes that have been written, 0 if this record is empty, the key is not part of the schema or the value can not be written into a field of its type
+    template <typename TWriter>
+    size_t SerializeProtobuf(TWriter & writer, Protobuf_Schema const & schema) const {
+        Protobuf_Field const * field = schema.Find_Field(m_key);
+        if (IsEmpty() || field == nullptr) {
+            return 0U;
+        }
+        switch (m_type) {
+            case DataType::TYPE_BOOL:
+                return Protobuf_Serializer::Write_Integer_Field(writer, field->number, field->type, m_value.boolean ? 1 : 0);
+            case DataType::TYPE_INT:
+                return Protobuf_Serializer::Write_Integer_Field(writer, field->number, field->type, m_value.integer);
+            case DataType::TYPE_REAL:
+                return Protobuf_Serializer::Write_Real_Field(writer, field->number, field->type, Round_Real(m_value.real));
+            case DataType::TYPE_STR:
+                return field->type == Protobuf_Type::STRING ? Protobuf_Serializer::Write_String_Field(writer, field->number, m_value.str) : 0U;
+            case DataType::TYPE_INT16_ARRAY:
+            case DataType::TYPE_INT32_ARRAY:
+            case DataType::TYPE_FLOAT_ARRAY:
+            case DataType::TYPE_DOUBLE_ARRAY:
+                return Serialize_Packed_Array(writer, *field);
+            default:
+                // Nothing to do
+                break;
+        }
+        return 0U;
+    }
+
   private:
+    /// @brief Writes the referenced buffer of samples as a packed repeated protobuf field, meaning the samples are written one after another without a tag in front of every sample
+    /// @tparam TWriter Writer class the field is written into
+    /// @param writer Writer the field is written into
+    /// @param field Field the samples are written into
+    /// @return Amount of bytes that have been written, 0 if the samples can not be written into a field of its type
+    template <typename TWriter>
+    size_t Serialize_Packed_Array(TWriter & writer, Protobuf_Field const & field) const {
+        bool const integral = m_type == DataType::TYPE_INT16_ARRAY || m_type == DataType::TYPE_INT32_ARRAY;
+        if (field.type == Protobuf_Type::STRING || (!integral && field.type != Protobuf_Type::FLOAT && field.type != Protobuf_Type::DOUBLE)) {
+            return 0U;
+        }
+        // Size of the samples has to be written in front of them, therefore they are measured first without copying them anywhere
+        Fixed_Buffer_Writer measure(nullptr, 0U);
+        size_t const packed_size = Serialize_Packed_Samples(measure, field.type);
+        size_t size = Protobuf_Serializer::Write_Tag(writer, field.number, Protobuf_Wire_Type::LENGTH_DELIMITED);
+        size += Protobuf_Serializer::Write_Varint(writer, packed_size);
+        return size + Serialize_Packed_Samples(writer, field.type);
+    }
+
+    /// @brief Writes every sample of the referenced buffer without a tag, encoded as the given type
+    /// @tparam TWriter Writer class the samples are written into
+    /// @param writer Writer the samples are written into
+    /// @param type Type of the field the samples are written into
+    /// @return Amount of bytes that have been written
+    template <typename TWriter>
+    size_t Serialize_Packed_Samples(TWriter & writer, Protobuf_Type const & type) const {
+        size_t size = 0U;
+        for (size_t i = 0U; i < m_value.array.size; i++) {
+            if (m_type == DataType::TYPE_INT16_ARRAY || m_type == DataType::TYPE_INT32_ARRAY) {
+                size += Protobuf_Serializer::Write_Integer(writer, type, Get_Array_Integer(i));
+            }
+            else {
+                size += Protobuf_Serializer::Write_Real(writer, type, Round_Real(Get_Array_Real(i)));
+            }
+        }
+        return size;
+    }
+
+    /// @brief Writes the referenced buffer of samples as a json array or as a base64 encoded json string, depending on the encoding passed to the constructor
+    /// @tparam TWriter Writer class the samples are written into
+    /// @param writer Writer the samples are written into
+    /// @return Amount of bytes that have been written
+    template <typename TWriter>
+    size_t Serialize_Array(TWriter & writer) const {
+        if (m_encoding == Array_Encoding::BASE64) {
+            return Json_Serializer::Write_Base64(writer, static_cast<uint8_t const *>(m_value.array.data), m_value.array.size * Get_Array_Element_Size());
+        }
+        size_t size = Json_Serializer::Write_Character(writer, '[');
+        for (size_t i = 0U; i < m_value.array.size; i++) {
+            if (i != 0U) {
+                size += Json_Serializer::Write_Character(writer, ',');
+            }
+            if (m_type == DataType::TYPE_INT16_ARRAY || m_type == DataType::TYPE_INT32_ARRAY) {
+                size += Json_Serializer::Write_Integer(writer, Get_Array_Integer(i));
+            }
+            else if (m_type == DataType::TYPE_FLOAT_ARRAY && m_decimal_places == UNLIMITED_DECIMAL_PLACES) {
+                size += Json_Serializer::Write_Float(writer, static_cast<float const *>(m_value.array.data)[i]);
+            }
+            else {
+                size += Serialize_Real(writer, Get_Array_Real(i));
+            }
+        }
+        return size + Json_Serializer::Write_Character(writer, ']');
+    }
+
+    /// @brief Writes the given floating point value rounded to the configured amount of decimal places, or in the format selected with THINGSBOARD_REAL_FORMAT if none were configured
+    /// @tparam TWriter Writer class the value is written into
+    /// @param writer Writer the value is written into
+    /// @param value Floating point value that should be written
+    /// @return Amount of bytes that have been written
+    template <typename TWriter>
+    size_t Serialize_Real(TWriter & writer, double const & value) const {
+        if (m_decimal_places == UNLIMITED_DECIMAL_PLACES) {
+            return Json_Serializer::Write_Real(writer, value);
+        }
+        return Json_Serializer::Write_Real_Fixed(writer, value, m_decimal_places);
+    }
+
+    /// @brief Rounds the given floating point value to the configured amount of decimal places, used before the value is written into a JsonDocument
+    /// @param value Floating point value that should be rounded
+    /// @return Rounded value or the unchanged value if no decimal places were configured
+    double Round_Real(double const & value) const;
+
+    /// @brief Returns the sample at the given index of a referenced buffer of integral samples
+    /// @param index Index of the sample, has to be smaller than the amount of samples
+    /// @return Sample widened to a 64-bit integer
+    int64_t Get_Array_Integer(size_t const & index) const;
+
+    /// @brief Returns the sample at the given index of a referenced buffer of floating point samples
+    /// @param index Index of the sample, has to be smaller than the amount of samples
+    /// @return Sample widened to double precision
+    double Get_Array_Real(size_t const & index) const;
+
+    /// @brief Size of a single sample of the referenced buffer
+    /// @return Size of a single sample in bytes, 0 if this record does not reference a buffer
+    size_t Get_Array_Element_Size() const;
+
+    /// @brief Non owning reference to an external buffer of samples
+    struct Array {
+        void const *data;  // Non owning pointer to the first sample
+        size_t     size;   // Amount of samples in the buffer
+    };
+
     /// @brief Data container, which contains one of the possibly passed values
     union Data {
         const char  *str;
         bool        boolean;
         int64_t     integer;
         double      real;
+        Array       array;
     };
 
     /// @brief Data type that the data container currently holds
@@ -127,10 +406,16 @@ class Telemetry {
         TYPE_BOOL, ///< Telemetry instance is a key value-pair with a boolean value
         TYPE_INT, ///< Telemetry instance is a key value-pair with an integral value
         TYPE_REAL, ///< Telemetry instance is a key value-pair with a real (float, double) value
-        TYPE_STR ///< Telemetry isntance is a key value-pair with a string value
+        TYPE_STR, ///< Telemetry isntance is a key value-pair with a string value
+        TYPE_INT16_ARRAY, ///< Telemetry instance is a key value-pair referencing a buffer of int16_t values
+        TYPE_INT32_ARRAY, ///< Telemetry instance is a key value-pair referencing a buffer of int32_t values
+        TYPE_FLOAT_ARRAY, ///< Telemetry instance is a key value-pair referencing a buffer of float values
+        TYPE_DOUBLE_ARRAY ///< Telemetry instance is a key value-pair referencing a buffer of double values
     };
 
-    DataType     m_type = {};  // Data type flag, showing which value is saved in the class instance
+    DataType       m_type = {};      // Data type flag, showing which value is saved in the class instance
+    Array_Encoding m_encoding = {};  // Representation a referenced buffer of samples is serialized as, unused for all other data types
+    uint8_t        m_decimal_places = UNLIMITED_DECIMAL_PLACES; // Amount of decimal places floating point values are rounded to, unused for all other data types
     const char   *m_key = {};  // Data key of the key-value pair
     Data         m_value = {}; // Data value of the key-value pair
 };
@@ -0,0 +1,154 @@
+// Header include.
+#include "Telemetry_Aggregator.h"
+
+// Local includes.
+#include "Helper.h"
+
+// Library includes.
+#include <math.h>
+
+char const * const Telemetry_Aggregator::STATISTIC_SUFFIXES[STATISTIC_AMOUNT] = { "_min", "_max", "_avg", "_count", "_last", "_sum" };
+
+Telemetry_Aggregator::Telemetry_Aggregator()
+  : m_key_states(nullptr)
+  , m_max_key_amount(0U)
+  , m_key_amount(0U)
+  , m_default_statistics(0U)
+  , m_window(0U)
+  , m_window_start(0U)
+  , m_value_amount(0U)
+{
+    // Nothing to do
+}
+
+Telemetry_Aggregator::~Telemetry_Aggregator() {
+    Free();
+}
+
+bool Telemetry_Aggregator::Allocate(size_t const & max_key_amount, uint32_t const & window_ms, uint8_t const & statistics) {
+    Free();
+    if (max_key_amount == 0U) {
+        return false;
+    }
+    m_key_states = new Key_State[max_key_amount]();
+    if (m_key_states == nullptr) {
+        return false;
+    }
+    m_max_key_amount = max_key_amount;
+    m_default_statistics = statistics;
+    m_window = window_ms;
+    return true;
+}
+
+void Telemetry_Aggregator::Free() {
+    delete[] m_key_states;
+    m_key_states = nullptr;
+    m_max_key_amount = 0U;
+    m_key_amount = 0U;
+    m_value_amount = 0U;
+}
+
+bool Telemetry_Aggregator::Is_Allocated() const {
+    return m_key_states != nullptr;
+}
+
+bool Telemetry_Aggregator::Set_Statistics(char const * key, uint8_t const & statistics) {
+    Key_State * state = Find_Or_Create_State(key);
+    if (state == nullptr) {
+        return false;
+    }
+    state->statistics = statistics;
+    return true;
+}
+
+bool Telemetry_Aggregator::Add(char const * key, double const & value) {
+    Key_State * state = Find_Or_Create_State(key);
+    if (state == nullptr) {
+        return false;
+    }
+    else if (isnan(value)) {
+        return true;
+    }
+    if (m_value_amount == 0U) {
+        m_window_start = Helper::Get_Milliseconds();
+    }
+    m_value_amount++;
+    if (state->count == 0U) {
+        state->min = value;
+        state->max = value;
+        state->sum = 0.0;
+    }
+    state->min = value < state->min ? value : state->min;
+    state->max = value > state->max ? value : state->max;
+    state->sum += value;
+    state->last = value;
+    state->count++;
+    return true;
+}
+
+bool Telemetry_Aggregator::Add(Telemetry const & data) {
+    double real = 0.0;
+    int64_t integer = 0;
+    bool boolean = false;
+    if (data.GetReal(real)) {
+        return Add(data.GetKey(), real);
+    }
+    else if (data.GetInteger(integer)) {
+        return Add(data.GetKey(), static_cast<double>(integer));
+    }
+    else if (data.GetBoolean(boolean)) {
+        return Add(data.GetKey(), boolean ? 1.0 : 0.0);
+    }
+    return false;
+}
+
+bool Telemetry_Aggregator::Is_Window_Finished() const {
+    // Unsigned subtraction handles the overflow of the milliseconds correctly
+    return m_value_amount != 0U && Helper::Get_Milliseconds() - m_window_start >= m_window;
+}
+
+bool Telemetry_Aggregator::empty() const {
+    return m_value_amount == 0U;
+}
+
+void Telemetry_Aggregator::Clear() {
+    for (size_t i = 0U; i < m_key_amount; i++) {
+        m_key_states[i].count = 0U;
+    }
+    m_value_amount = 0U;
+}
+
+Telemetry_Aggregator::Key_State * Telemetry_Aggregator::Find_Or_Create_State(char const * key) {
+    if (m_key_states == nullptr || Helper::String_IsNull_Or_Empty(key)) {
+        return nullptr;
+    }
+    for (size_t i = 0U; i < m_key_amount; i++) {
+        if (strcmp(m_key_states[i].key, key) == 0) {
+            return &m_key_states[i];
+        }
+    }
+    if (m_key_amount >= m_max_key_amount) {
+        return nullptr;
+    }
+    Key_State & state = m_key_states[m_key_amount++];
+    state = {};
+    state.key = key;
+    state.statistics = m_default_statistics;
+    return &state;
+}
+
+double Telemetry_Aggregator::Get_Statistic(Key_State const & state, uint8_t const & statistic) {
+    switch (statistic) {
+        case AGGREGATE_MIN:
+            return state.min;
+        case AGGREGATE_MAX:
+            return state.max;
+        case AGGREGATE_AVG:
+            return state.sum / state.count;
+        case AGGREGATE_LAST:
+            return state.last;
+        default:
+            break;
+    }
+    return state.sum;
+}
@@ -0,0 +1,167 @@
+#ifndef Telemetry_Aggregator_h
+#define Telemetry_Aggregator_h
+
+// Local includes.
+#include "Json_Serializer.h"
+#include "Telemetry.h"
+
+// Library includes.
+#include <string.h>
+
+
+/// @brief Smallest value of a key in the current window, sent as "<key>_min"
+uint8_t constexpr AGGREGATE_MIN = 1U << 0U;
+/// @brief Biggest value of a key in the current window, sent as "<key>_max"
+uint8_t constexpr AGGREGATE_MAX = 1U << 1U;
+/// @brief Arithmetic mean of all values of a key in the current window, sent as "<key>_avg"
+uint8_t constexpr AGGREGATE_AVG = 1U << 2U;
+/// @brief Amount of values of a key in the current window, sent as "<key>_count"
+uint8_t constexpr AGGREGATE_COUNT = 1U << 3U;
+/// @brief Most recent value of a key in the current window, sent as "<key>_last"
+uint8_t constexpr AGGREGATE_LAST = 1U << 4U;
+/// @brief Sum of all values of a key in the current window, sent as "<key>_sum"
+uint8_t constexpr AGGREGATE_SUM = 1U << 5U;
+
+
+/// @brief Reduces high rate telemetry into a few statistics per key, that are sent once at the end of every tumbling time window instead of every single value
+/// @note Every key keeps a constant amount of memory (minimum, maximum, sum, count and last value), independent of the amount of values added in the window,
+/// the memory for all keys is allocated once in @ref Allocate, meaning adding a value never allocates. A window starts with the first value added after the previous window has been sent
+/// and ends once its duration has passed, at which point all keys that received at least one value are sent in one message, the result for a key "temperature" with the default statistics
+/// being {"temperature_min":20.5,"temperature_max":22,"temperature_avg":21.25,"temperature_count":4}. Boolean values are aggregated as 0 and 1, meaning their average is the fraction of time they were true,
+/// string values can not be aggregated and are rejected. Is passed to @ref ThingsBoardSized::Set_Telemetry_Aggregator, which sends the window automatically as part of loop()
+class Telemetry_Aggregator {
+  public:
+    /// @brief Constructs an aggregator without any memory for keys, that can not aggregate any value until @ref Allocate has been called
+    Telemetry_Aggregator();
+
+    /// @brief Deleted copy constructor
+    /// @note Copying the aggregator would require copying the state of every key. Therefore copying is disabled alltogether
+    /// @param other Other instance we disallow copying from
+    Telemetry_Aggregator(Telemetry_Aggregator const & other) = delete;
+
+    /// @brief Deleted copy assignment operator
+    /// @note Copying the aggregator would require copying the state of every key. Therefore copying is disabled alltogether
+    /// @param other Other instance we disallow copying from
+    void operator=(Telemetry_Aggregator const & other) = delete;
+
+    /// @brief Destructor, frees the memory holding the state of every key
+    ~Telemetry_Aggregator();
+
+    /// @brief Allocates the memory holding the state of every key, any already known keys and aggregated values are discarded
+    /// @param max_key_amount Maximum amount of different keys that can be aggregated
+    /// @param window_ms Duration of a single window in milliseconds
+    /// @param statistics Bitmask of the statistics (AGGREGATE_MIN, AGGREGATE_MAX, ...) that are sent for keys, that were not configured with @ref Set_Statistics, default = AGGREGATE_MIN | AGGREGATE_MAX | AGGREGATE_AVG | AGGREGATE_COUNT
+    /// @return Whether allocating the memory was successful or not
+    bool Allocate(size_t const & max_key_amount, uint32_t const & window_ms, uint8_t const & statistics = AGGREGATE_MIN | AGGREGATE_MAX | AGGREGATE_AVG | AGGREGATE_COUNT);
+
+    /// @brief Frees the memory holding the state of every key and therefore discards all known keys and aggregated values
+    void Free();
+
+    /// @brief Whether the memory holding the state of every key has been allocated
+    /// @return Whether values can be aggregated
+    bool Is_Allocated() const;
+
+    /// @brief Sets the statistics that are sent for the given key, overriding the statistics passed to @ref Allocate
+    /// @param key Non owning pointer to the key, has to be kept alive for as long as the aggregator is used
+    /// @param statistics Bitmask of the statistics (AGGREGATE_MIN, AGGREGATE_MAX, ...) that are sent for the key, 0 disables sending the key alltogether
+    /// @return Whether setting the statistics was successful or not, fails if the maximum amount of keys has already been reached
+    bool Set_Statistics(char const * key, uint8_t const & statistics);
+
+    /// @brief Adds the given value to the current window of the given key, starts a new window if none has been started yet
+    /// @param key Non owning pointer to the key, has to be kept alive for as long as the aggregator is used
+    /// @param value Value that should be aggregated, NaN values are ignored
+    /// @return Whether adding the value was successful or not, fails if the key is not known yet and the maximum amount of keys has already been reached
+    bool Add(char const * key, double const & value);
+
+    /// @brief Adds the value of the given key-value pair to the current window of its key, starts a new window if none has been started yet
+    /// @param data Key-value pair containing an integral, floating point or boolean value, the key has to be kept alive for as long as the aggregator is used
+    /// @return Whether adding the value was successful or not, fails for string values as well
+    bool Add(Telemetry const & data);
+
+    /// @brief Whether a window has been started and its duration has passed, meaning the window should be sent
+    /// @return Whether the current window has finished
+    bool Is_Window_Finished() const;
+
+    /// @brief Whether no value has been added to the current window yet
+    /// @return Whether there is nothing to send
+    bool empty() const;
+
+    /// @brief Discards all values aggregated in the current window, without forgetting the known keys or their statistics, the next added value starts a new window
+    void Clear();
+
+    /// @brief Serializes the statistics of every key, that received at least one value in the current window, into a single json object
+    /// @note Does not clear the window, so that it can first be serialized to measure its size and then be serialized again into a buffer of that size
+    /// @tparam TWriter Class the serialized json is written into, see @ref Json_Serializer for more information on the requirements of the writer
+    /// @param writer Writer the serialized json is written into
+    /// @param data_point_amount Set to the amount of key-value pairs contained in the serialized json
+    /// @return Amount of bytes that have been written
+    template<typename TWriter>
+    size_t Serialize(TWriter & writer, size_t & data_point_amount) const {
+        data_point_amount = 0U;
+        size_t size = Json_Serializer::Write_Character(writer, '{');
+        for (size_t i = 0U; i < m_key_amount; i++) {
+            Key_State const & state = m_key_states[i];
+            if (state.count == 0U) {
+                continue;
+            }
+            for (uint8_t statistic = 0U; statistic < STATISTIC_AMOUNT; statistic++) {
+                if ((state.statistics & (1U << statistic)) == 0U) {
+                    continue;
+                }
+                else if (data_point_amount != 0U) {
+                    size += Json_Serializer::Write_Character(writer, ',');
+                }
+                size += Json_Serializer::Write_Character(writer, '"');
+                size += Json_Serializer::Write_Escaped(writer, state.key);
+                size += Json_Serializer::Write_Raw(writer, STATISTIC_SUFFIXES[statistic], strlen(STATISTIC_SUFFIXES[statistic]));
+                size += Json_Serializer::Write_Raw(writer, "\":", 2U);
+                if ((1U << statistic) == AGGREGATE_COUNT) {
+                    size += Json_Serializer::Write_Unsigned_Integer(writer, state.count);
+                }
+                else {
+                    size += Json_Serializer::Write_Real(writer, Get_Statistic(state, 1U << statistic));
+                }
+                data_point_amount++;
+            }
+        }
+        return size + Json_Serializer::Write_Character(writer, '}');
+    }
+
+  private:
+    /// @brief Amount of different statistics, that can be sent for a key
+    static uint8_t constexpr STATISTIC_AMOUNT = 6U;
+    /// @brief Suffix appended to the key for every statistic, in the order of their bit in the statistics bitmask
+    static char const * const STATISTIC_SUFFIXES[STATISTIC_AMOUNT];
+
+    /// @brief Statistics of a single key over the current window
+    struct Key_State {
+        char const *key;         // Non owning pointer to the key, has to be kept alive for as long as the aggregator is used
+        uint8_t    statistics;   // Bitmask of the statistics that are sent for the key
+        uint32_t   count;        // Amount of values added in the current window, 0 if the key is not sent
+        double     min;          // Smallest value added in the current window
+        double     max;          // Biggest value added in the current window
+        double     sum;          // Sum of all values added in the current window
+        double     last;         // Most recently added value in the current window
+    };
+
+    /// @brief Returns the state of the given key and creates it if the key is not known yet
+    /// @param key Non owning pointer to the key
+    /// @return Non owning pointer to the state of the key or nullptr if the key is not known and the maximum amount of keys has already been reached
+    Key_State * Find_Or_Create_State(char const * key);
+
+    /// @brief Calculates the given floating point statistic of the given key
+    /// @param state State of the key, has to contain at least one value
+    /// @param statistic Single statistic bit (AGGREGATE_MIN, AGGREGATE_MAX, ...)
+    /// @return Value of the statistic
+    static double Get_Statistic(Key_State const & state, uint8_t const & statistic);
+
+    Key_State *m_key_states = {};         // State of every known key, allocated once in Allocate
+    size_t    m_max_key_amount = {};      // Maximum amount of different keys that can be aggregated
+    size_t    m_key_amount = {};          // Amount of currently known keys
+    uint8_t   m_default_statistics = {};  // Bitmask of the statistics sent for keys that were not configured explicitly
+    uint32_t  m_window = {};              // Duration of a single window in milliseconds
+    uint32_t  m_window_start = {};        // Time in milliseconds the current window was started at
+    size_t    m_value_amount = {};        // Amount of values added in the current window, 0 if no window has been started yet
+};
+
+#endif // Telemetry_Aggregator_h
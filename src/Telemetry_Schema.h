@@ -0,0 +1,269 @@
+#ifndef Telemetry_Schema_h
+#define Telemetry_Schema_h
+
+// Local includes.
+#include "Json_Serializer.h"
+
+// Library includes.
+#include <stddef.h>
+#include <stdint.h>
+
+
+/// @brief Compile time sequence of indices, used to expand the characters of a key into a character array
+/// @note Own implementation of std::index_sequence, because it is only available since C++14 and not on every supported platform
+/// @tparam ...Indices Indices contained in the sequence
+template<size_t... Indices>
+struct Index_Sequence {};
+
+/// @brief Creates an @ref Index_Sequence from 0 to Size - 1
+/// @tparam Size Amount of indices in the created sequence
+/// @tparam ...Indices Already created indices, used internally for the recursion
+template<size_t Size, size_t... Indices>
+struct Make_Index_Sequence : Make_Index_Sequence<Size - 1U, Size - 1U, Indices...> {};
+
+template<size_t... Indices>
+struct Make_Index_Sequence<0U, Indices...> {
+    using type = Index_Sequence<Indices...>;
+};
+
+
+/// @brief Returns the amount of characters in the given string without the null terminator, evaluated at compile time
+/// @param str Non owning pointer to the null terminated string
+/// @param length Amount of characters already counted, used internally for the recursion
+/// @return Amount of characters in the given string
+constexpr size_t Constexpr_String_Length(char const * str, size_t length = 0U) {
+    return *str == '\0' ? length : Constexpr_String_Length(str + 1U, length + 1U);
+}
+
+/// @brief Returns whether the given string contains any character that would have to be escaped in json, evaluated at compile time
+/// @param str Non owning pointer to the null terminated string
+/// @return Whether any character of the given string has to be escaped
+constexpr bool Constexpr_Requires_Escaping(char const * str) {
+    return *str != '\0' && (*str == '"' || *str == '\\' || static_cast<uint8_t>(*str) < 0x20U || Constexpr_Requires_Escaping(str + 1U));
+}
+
+/// @brief Returns the maximum amount of characters an integer of the given size requires in decimal notation, including the sign
+/// @param size Size of the integer type in bytes
+/// @param is_signed Whether the integer type is signed
+/// @return Maximum amount of characters required to write any value of the integer type
+constexpr size_t Max_Integer_Digits(size_t size, bool is_signed) {
+    return size == 1U ? (is_signed ? 4U : 3U) : size == 2U ? (is_signed ? 6U : 5U) : size == 4U ? (is_signed ? 11U : 10U) : 20U;
+}
+
+
+/// @brief Describes how a value type of a @ref Telemetry_Field is written and how many characters it requires at most
+/// @note Specialized for every supported value type (bool, integral, floating point and strings), using any other type results in a compile error
+/// @tparam T Type of the value
+/// @tparam MaxLength Maximum amount of characters in a string value, only used for strings
+template<typename T, size_t MaxLength>
+struct Telemetry_Field_Traits;
+
+template<size_t MaxLength>
+struct Telemetry_Field_Traits<bool, MaxLength> {
+    static size_t constexpr MAX_VALUE_SIZE = sizeof(JSON_FALSE) - 1U;
+
+    template<typename TWriter>
+    static size_t Serialize(TWriter & writer, bool value) {
+        return Json_Serializer::Write_Boolean(writer, value);
+    }
+};
+
+/// @brief Traits shared by all signed integral types
+/// @tparam T Signed integral type of the value
+template<typename T>
+struct Telemetry_Signed_Field_Traits {
+    static size_t constexpr MAX_VALUE_SIZE = Max_Integer_Digits(sizeof(T), true);
+
+    template<typename TWriter>
+    static size_t Serialize(TWriter & writer, T value) {
+        return Json_Serializer::Write_Integer(writer, static_cast<int64_t>(value));
+    }
+};
+
+/// @brief Traits shared by all unsigned integral types
+/// @tparam T Unsigned integral type of the value
+template<typename T>
+struct Telemetry_Unsigned_Field_Traits {
+    static size_t constexpr MAX_VALUE_SIZE = Max_Integer_Digits(sizeof(T), false);
+
+    template<typename TWriter>
+    static size_t Serialize(TWriter & writer, T value) {
+        return Json_Serializer::Write_Unsigned_Integer(writer, static_cast<uint64_t>(value));
+    }
+};
+
+template<size_t MaxLength> struct Telemetry_Field_Traits<signed char, MaxLength> : Telemetry_Signed_Field_Traits<signed char> {};
+template<size_t MaxLength> struct Telemetry_Field_Traits<short, MaxLength> : Telemetry_Signed_Field_Traits<short> {};
+template<size_t MaxLength> struct Telemetry_Field_Traits<int, MaxLength> : Telemetry_Signed_Field_Traits<int> {};
+template<size_t MaxLength> struct Telemetry_Field_Traits<long, MaxLength> : Telemetry_Signed_Field_Traits<long> {};
+template<size_t MaxLength> struct Telemetry_Field_Traits<long long, MaxLength> : Telemetry_Signed_Field_Traits<long long> {};
+template<size_t MaxLength> struct Telemetry_Field_Traits<unsigned char, MaxLength> : Telemetry_Unsigned_Field_Traits<unsigned char> {};
+template<size_t MaxLength> struct Telemetry_Field_Traits<unsigned short, MaxLength> : Telemetry_Unsigned_Field_Traits<unsigned short> {};
+template<size_t MaxLength> struct Telemetry_Field_Traits<unsigned int, MaxLength> : Telemetry_Unsigned_Field_Traits<unsigned int> {};
+template<size_t MaxLength> struct Telemetry_Field_Traits<unsigned long, MaxLength> : Telemetry_Unsigned_Field_Traits<unsigned long> {};
+template<size_t MaxLength> struct Telemetry_Field_Traits<unsigned long long, MaxLength> : Telemetry_Unsigned_Field_Traits<unsigned long long> {};
+
+/// @brief Traits shared by all floating point types
+/// @tparam T Floating point type of the value
+template<typename T>
+struct Telemetry_Real_Field_Traits {
+    // Longest representation depends on the floating point format selected with THINGSBOARD_REAL_FORMAT
+    static size_t constexpr MAX_VALUE_SIZE = MAX_REAL_SIZE;
+
+    template<typename TWriter>
+    static size_t Serialize(TWriter & writer, T value) {
+        return Json_Serializer::Write_Real(writer, static_cast<double>(value));
+    }
+};
+
+template<size_t MaxLength>
+struct Telemetry_Field_Traits<float, MaxLength> : Telemetry_Real_Field_Traits<float> {
+    template<typename TWriter>
+    static size_t Serialize(TWriter & writer, float value) {
+        return Json_Serializer::Write_Float(writer, value);
+    }
+};
+
+template<size_t MaxLength> struct Telemetry_Field_Traits<double, MaxLength> : Telemetry_Real_Field_Traits<double> {};
+
+/// @brief Traits of floating point values, that are rounded to a fixed amount of decimal places before they are written, used by @ref Telemetry_Fixed_Field
+/// @tparam T Floating point type of the value
+/// @tparam DecimalPlaces Amount of decimal places the value is rounded to
+template<typename T, uint8_t DecimalPlaces>
+struct Telemetry_Fixed_Real_Field_Traits {
+    static_assert(DecimalPlaces <= MAX_DECIMAL_PLACES, "Floating point values can be rounded to at most 9 decimal places");
+    // Rounded values only contain as many digits as fit into the precision of a double, bigger values are written with up to 9 decimal places instead
+    static size_t constexpr MAX_VALUE_SIZE = 2U + 7U + MAX_DECIMAL_PLACES;
+
+    template<typename TWriter>
+    static size_t Serialize(TWriter & writer, T value) {
+        return Json_Serializer::Write_Real_Fixed(writer, static_cast<double>(value), DecimalPlaces);
+    }
+};
+
+template<size_t MaxLength>
+struct Telemetry_Field_Traits<char const *, MaxLength> {
+    static_assert(MaxLength > 0U, "String fields require the maximum amount of characters as the third template argument");
+    // Every character could be a control character, which is escaped as a six character unicode sequence (\u0001), additionally the string is surrounded by quotes
+    static size_t constexpr MAX_VALUE_SIZE = 2U + 6U * MaxLength;
+
+    template<typename TWriter>
+    static size_t Serialize(TWriter & writer, char const * value) {
+        return Json_Serializer::Write_String(writer, value);
+    }
+};
+
+
+/// @brief Single key of a @ref Telemetry_Schema, consisting of the key itself and the type of the value that is sent with it
+/// @tparam Key Non owning pointer to the null terminated key, has to be a constexpr character array with static storage duration (char constexpr TEMPERATURE_KEY[] = "temperature";),
+/// so that its characters can be copied into the json skeleton at compile time. Keys that would have to be escaped in json are not supported
+/// @tparam T Type of the value, supported are bool, all integral types, float, double and char const *
+/// @tparam MaxLength Maximum amount of characters in a string value, only required for and used by char const * values, default = 0.
+/// Longer strings are still sent, but might exceed the worst case payload size of the schema
+template<char const * Key, typename T, size_t MaxLength = 0U>
+struct Telemetry_Field {
+    static_assert(!Constexpr_Requires_Escaping(Key), "Keys of telemetry fields can not contain characters that have to be escaped in json");
+
+    using value_type = T;
+    using traits = Telemetry_Field_Traits<T, MaxLength>;
+    static constexpr char const * KEY = Key;
+    static size_t constexpr KEY_LENGTH = Constexpr_String_Length(Key);
+};
+
+/// @brief Single floating point key of a @ref Telemetry_Schema, whose value is rounded to a fixed amount of decimal places, so that only the digits the sensor actually provides are sent
+/// @note Rounding is done half away from zero on the value scaled by the power of ten, see @ref Json_Serializer::Write_Real_Fixed
+/// @tparam Key Non owning pointer to the null terminated key, see @ref Telemetry_Field
+/// @tparam T Type of the value, supported are float and double
+/// @tparam DecimalPlaces Amount of decimal places the value is rounded to, at most 9
+template<char const * Key, typename T, uint8_t DecimalPlaces>
+struct Telemetry_Fixed_Field : Telemetry_Field<Key, T> {
+    using traits = Telemetry_Fixed_Real_Field_Traits<T, DecimalPlaces>;
+};
+
+
+/// @brief Constant part of the json payload written in front of a single @ref Telemetry_Field value, being the opening brace or seperating comma followed by the quoted key and the colon ({"key": or ,"key":)
+/// @note Generated at compile time from the characters of the key, so that the key does not need to be escaped or measured again when sending the values
+/// @tparam Separator Opening brace for the first field or comma for every following field
+/// @tparam Field @ref Telemetry_Field containing the key
+/// @tparam Sequence @ref Index_Sequence with one index per character of the key
+template<char Separator, typename Field, typename Sequence>
+struct Telemetry_Field_Prefix;
+
+template<char Separator, typename Field, size_t... Indices>
+struct Telemetry_Field_Prefix<Separator, Field, Index_Sequence<Indices...>> {
+    static char constexpr value[] = { Separator, '"', Field::KEY[Indices]..., '"', ':' };
+};
+
+template<char Separator, typename Field, size_t... Indices>
+char constexpr Telemetry_Field_Prefix<Separator, Field, Index_Sequence<Indices...>>::value[];
+
+
+/// @brief Writes the given fields and their values one after another, used internally by @ref Telemetry_Schema to recurse over all fields
+/// @tparam IsFirst Whether the first of the given fields is the first field of the schema and therefore has to open the json object
+/// @tparam ...Fields Remaining fields that should be written
+template<bool IsFirst, typename... Fields>
+struct Telemetry_Schema_Fields {
+    static size_t constexpr MAX_PAYLOAD_SIZE = 0U;
+
+    template<typename TWriter>
+    static size_t Serialize(TWriter &) {
+        return 0U;
+    }
+};
+
+template<bool IsFirst, typename Field, typename... Fields>
+struct Telemetry_Schema_Fields<IsFirst, Field, Fields...> {
+    using prefix = Telemetry_Field_Prefix<IsFirst ? '{' : ',', Field, typename Make_Index_Sequence<Field::KEY_LENGTH>::type>;
+    using remaining = Telemetry_Schema_Fields<false, Fields...>;
+
+    static size_t constexpr MAX_PAYLOAD_SIZE = sizeof(prefix::value) + Field::traits::MAX_VALUE_SIZE + remaining::MAX_PAYLOAD_SIZE;
+
+    template<typename TWriter>
+    static size_t Serialize(TWriter & writer, typename Field::value_type const & value, typename Fields::value_type const &... values) {
+        size_t const size = Json_Serializer::Write_Raw(writer, prefix::value, sizeof(prefix::value)) + Field::traits::Serialize(writer, value);
+        return size + remaining::Serialize(writer, values...);
+    }
+};
+
+
+/// @brief Fixed set of telemetry keys and their value types known at compile time, for devices that send the same keys every time
+/// @note The constant parts of the json payload, meaning the braces, commas and quoted keys, are generated at compile time. When sending only the values have to be formatted into the slots between them,
+/// which skips escaping, measuring and copying the keys every time. Additionally the worst case size of the payload is known at compile time as @ref MAX_PAYLOAD_SIZE,
+/// which can be used as the send buffer size of the ThingsBoard instance, to ensure the payload always fits and is never streamed.
+///
+/// Example usage:
+/// char constexpr TEMPERATURE_KEY[] = "temperature";
+/// char constexpr STATUS_KEY[] = "status";
+/// using Device_Schema = Telemetry_Schema<Telemetry_Fixed_Field<TEMPERATURE_KEY, float, 1U>, Telemetry_Field<STATUS_KEY, char const *, 16U>>;
+/// ThingsBoard tb(mqttClient, MAX_MESSAGE_RECEIVE_SIZE, Device_Schema::MAX_PAYLOAD_SIZE);
+/// tb.Send_Telemetry_Schema<Device_Schema>(21.5f, "ok");
+/// @tparam ...Fields @ref Telemetry_Field or @ref Telemetry_Fixed_Field describing the keys and value types, in the order the values are passed when sending
+template<typename... Fields>
+class Telemetry_Schema {
+  public:
+    static_assert(sizeof...(Fields) > 0U, "Telemetry schema requires at least one field");
+
+    /// @brief Worst case size of the serialized json payload without null terminator, if all values require the maximum amount of characters
+    static size_t constexpr MAX_PAYLOAD_SIZE = Telemetry_Schema_Fields<true, Fields...>::MAX_PAYLOAD_SIZE + 1U;
+
+    /// @brief Amount of fields in this schema
+    static size_t constexpr FIELD_AMOUNT = sizeof...(Fields);
+
+    /// @brief Writes the given values into the slots of the precomputed json skeleton
+    /// @tparam TWriter Writer class the json object is written into, see @ref Json_Serializer for more information on the requirements of the writer
+    /// @param writer Writer the json object is written into
+    /// @param ...values One value per field, in the same order as the fields of the schema
+    /// @return Amount of bytes that have been written
+    template<typename TWriter>
+    static size_t Serialize(TWriter & writer, typename Fields::value_type const &... values) {
+        return Telemetry_Schema_Fields<true, Fields...>::Serialize(writer, values...) + Json_Serializer::Write_Character(writer, '}');
+    }
+};
+
+template<typename... Fields>
+size_t constexpr Telemetry_Schema<Fields...>::MAX_PAYLOAD_SIZE;
+
+template<typename... Fields>
+size_t constexpr Telemetry_Schema<Fields...>::FIELD_AMOUNT;
+
+#endif // Telemetry_Schema_h
@@ -3,24 +3,62 @@
 
 // Local includes.
 #include "Constants.h"
+#include "Buffered_Publish_Writer.h"
+#include "Concurrent_Publish_Queue.h"
+#include "Delivery_Report_Queue.h"
+#include "Fixed_Buffer_Writer.h"
 #include "IAPI_Implementation.h"
 #include "IMQTT_Client.h"
+#include "IReport_Filter.h"
+#include "MQTT_QoS.h"
 #include "DefaultLogger.h"
+#include "Outbound_Queue.h"
+#include "Persistent_Log.h"
+#include "Publish_Priority.h"
+#include "Publish_Result.h"
+#include "Rate_Limiter.h"
 #include "Telemetry.h"
+#include "Telemetry_Aggregator.h"
+#include "Telemetry_Schema.h"
+#include "Time_Series_Buffer.h"
+#include "Timestamped_Telemetry.h"
+#include "Topic_Dispatch_Table.h"
 
 // Library includes.
-#if THINGSBOARD_ENABLE_STREAM_UTILS
-#include <StreamUtils.h>
-#endif // THINGSBOARD_ENABLE_STREAM_UTILS
-
+#if THINGSBOARD_ENABLE_ATOMIC
+#include <atomic>
+#endif // THINGSBOARD_ENABLE_ATOMIC
 
 uint16_t constexpr DEFAULT_MQTT_PORT = 1883U;
 char constexpr PROV_ACCESS_TOKEN[] = "provision";
+// Returned by the protobuf serialization instead of the payload size if encoding failed, because an empty protobuf message is encoded as 0 bytes and is still valid.
+size_t constexpr PROTOBUF_SERIALIZATION_FAILED = SIZE_MAX;
 // Log messages.
 char constexpr UNABLE_TO_DE_SERIALIZE_JSON[] = "Unable to de-serialize received json data with error (DeserializationError::%s)";
-char constexpr INVALID_BUFFER_SIZE[] = "Send buffer size (%u) to small for the given payloads size (%u), increase with Set_Buffer_Size accordingly or install the StreamUtils library";
+char constexpr UNABLE_TO_STREAM_PAYLOAD[] = "Streaming payload with size (%u) bigger than the send buffer size (%u) into the client failed";
 char constexpr UNABLE_TO_ALLOCATE_BUFFER[] = "Allocating memory for the internal MQTT buffer failed";
+char constexpr UNABLE_TO_ALLOCATE_COALESCING_BUFFER[] = "Allocating memory for (%u) coalesced telemetry key-value pairs failed";
+char constexpr UNABLE_TO_ALLOCATE_OUTBOUND_QUEUE[] = "Allocating (%u) bytes for the outbound queue with priority (%u) failed";
+char constexpr OUTBOUND_QUEUE_FULL[] = "Outbound queue with priority (%u) is full, discarding message with size (%u)";
+char constexpr UNABLE_TO_PUBLISH_QUEUED[] = "Publishing queued message over topic (%s) failed, discarding message";
+char constexpr UNABLE_TO_PARSE_RATE_LIMITS[] = "Parsing rate limits (%s) failed, expected comma seperated capacity:period_in_seconds pairs (10:1,300:60)";
+char constexpr OUTBOUND_BACKLOG_FULL[] = "Outbound backlog with size (%u) reached the high-water mark (%u), discarding message with size (%u)";
+char constexpr UNABLE_TO_OPEN_PERSISTENT_LOG[] = "Opening the persistent log failed, ensure the storage contains at least 2 segments and can be read and written";
+char constexpr PERSISTENT_LOG_FULL[] = "Persistent log is full, discarding message with size (%u)";
+char constexpr UNABLE_TO_REPLAY_PERSISTED[] = "Replaying persisted message with size (%u) failed, discarding message";
+char constexpr UNABLE_TO_SERIALIZE_PROTOBUF[] = "Key (%s) is not part of the protobuf schema or its value can not be written into a field of its type";
+char constexpr UNABLE_TO_ALLOCATE_REPORT_DECISIONS[] = "Allocating memory for the report filter decisions of (%u) key-value pairs failed";
+char constexpr UNABLE_TO_ALLOCATE_IN_FLIGHT_WINDOW[] = "Allocating memory for an in-flight window of (%u) messages failed";
+char constexpr IN_FLIGHT_WINDOW_BUSY[] = "In-flight window can not be resized while (%u) messages are waiting for their confirmation";
+char constexpr DELIVERY_REPORT_QUEUE_FULL[] = "Delivery report queue is full, discarding report for packet id (%u)";
+char constexpr QOS_NOT_SUPPORTED[] = "Client does not support publishing with QoS (%u)";
+char constexpr IN_FLIGHT_WINDOW_FULL[] = "In-flight window with (%u) unconfirmed messages is full, discarding message with size (%u)";
+char constexpr RATE_LIMIT_EXCEEDED[] = "Rate limit reached, discarding message with (%u) data points. Configure an outbound queue with Set_Outbound_Queue to defer it instead";
+#if THINGSBOARD_ENABLE_CONCURRENT_PUBLISH
+char constexpr UNABLE_TO_ALLOCATE_CONCURRENT_QUEUE[] = "Allocating (%u) slots with size (%u) for the concurrent publish queue failed";
+#endif // THINGSBOARD_ENABLE_CONCURRENT_PUBLISH
 char constexpr MAX_ENDPOINTS_AMOUNT_TEMPLATE_NAME[] = "MaxEndpointsAmount";
+char constexpr UNABLE_TO_INSERT_API_DISPATCH[] = "Inserting response topic (%s) of an API implementation into the dispatch table failed, messages received over it are not forwarded";
 #if THINGSBOARD_ENABLE_DYNAMIC
 char constexpr MAXIMUM_RESPONSE_EXCEEDED[] = "Prevented allocation on the heap (%u) for JsonDocument. Discarding message that is bigger than maximum response size (%u)";
 char constexpr HEAP_ALLOCATION_FAILED[] = "Failed allocating required size (%u) for JsonDocument. Ensure there is enough heap memory left";
@@ -28,11 +66,18 @@ char constexpr HEAP_ALLOCATION_FAILED[] = "Failed allocating required size (%u)
 char constexpr API_SUBSCRIPTIONS[] = "API implementation";
 #endif // THINGSBOARD_ENABLE_DYNAMIC
 #if THINGSBOARD_ENABLE_DEBUG
+char constexpr FLUSH_COALESCED_TELEMETRY[] = "Flushing (%u) coalesced telemetry key-value pairs with size (%u)";
 char constexpr RECEIVE_MESSAGE[] = "Received (%u) bytes of data from server over topic (%s)";
 char constexpr ALLOCATING_JSON[] = "Allocated internal JsonDocument for MQTT server response with size (%u)";
 char constexpr SEND_MESSAGE[] = "Sending data to server over topic (%s) with data (%s)";
+char constexpr SEND_BINARY_MESSAGE[] = "Sending (%u) bytes of binary data to server over topic (%s)";
 char constexpr SEND_SERIALIZED[] = "Hidden, because json data is bigger than buffer, therefore showing in console is skipped";
 #endif // THINGSBOARD_ENABLE_DEBUG
+// Timestamped form {"ts":<timestamp>,"values":<payload>} persisted telemetry data is wrapped into when it is replayed,
+// the prefix size fits both keys together with the biggest 20 digit timestamp.
+char constexpr PERSISTENT_TIMESTAMP_KEY[] = "{\"ts\":";
+char constexpr PERSISTENT_VALUES_KEY[] = ",\"values\":";
+size_t constexpr PERSISTENT_TIMESTAMP_PREFIX_SIZE = 40U;
 // Claim topics.
 char constexpr CLAIM_TOPIC[] = "v1/devices/me/claim";
 // Claim data keys.
@@ -60,8 +105,11 @@ template <typename Logger = DefaultLogger>
 /// simply set THINGSBOARD_ENABLE_DYNAMIC to 1, before including ThingsBoard.h
 /// @tparam MaxResponse Maximum amount of key-value pairs that will ever be received by ThingsBoard in one call, default = DEFAULT_RESPONSE_AMOUNT (8)
 /// @tparam MaxEndpointsAmount Maximum amount of subscribed API endpoints, DEFAULT_ENDPOINT_AMOUNT is used as the default value because it is big enough to hold one instance of every possible API Implementation, default = DEFAULT_ENDPOINT_AMOUNT (7)
+/// @tparam MaxFilterKeys Maximum amount of keys in the deserialization filter built from the keys the subscribed API implementations read from a received response, see Get_Json_Filter_Size of the API implementations.
+/// Every attribute subscribed with a Shared_Attribute_Callback or requested with an Attribute_Request_Callback adds 2 keys and the object containing the nested attributes adds 1 more key,
+/// meaning 2 * MaxSubscriptions * MaxAttributes + 1 of the used API implementation is always big enough. Responses whose filter would contain more keys are deserialized without a filter instead, default = DEFAULT_FILTER_KEY_AMOUNT (3)
 /// @tparam Logger Implementation that should be used to print error messages generated by internal processes and additional debugging messages if THINGSBOARD_ENABLE_DEBUG is set, default = DefaultLogger
-template<size_t MaxResponse = DEFAULT_RESPONSE_AMOUNT, size_t MaxEndpointsAmount = DEFAULT_ENDPOINT_AMOUNT, typename Logger = DefaultLogger>
+template<size_t MaxResponse = DEFAULT_RESPONSE_AMOUNT, size_t MaxEndpointsAmount = DEFAULT_ENDPOINT_AMOUNT, size_t MaxFilterKeys = DEFAULT_FILTER_KEY_AMOUNT, typename Logger = DefaultLogger>
 #endif // THINGSBOARD_ENABLE_DYNAMIC
 class ThingsBoardSized {
   public:
@@ -81,82 +129,106 @@ class ThingsBoardSized {
     /// Should be big enough to hold the biggest response that is expected to be ever received by the device at once, default = DEFAULT_PAYLOAD_SIZE (64)
     /// @param send_buffer_size Maximum amount of data that can be sent via MQTT at once,
     /// expected behaviour is that, if we attempt to send data that is bigger, it will simply not be sent and a message is printed to the console instead.
-    /// Should be big enough to hold the biggest request that is expected to be ever sent by the device at once.
-    /// Alternatively when using Arduino it is possible to enable support for THINGSBOARD_ENABLE_STREAM_UTILS by importing the ArduinoStreamUtils (https://github.com/bblanchon/ArduinoStreamUtils) in the project.
-    /// This feature allows to improve the underlying data streams by directly writing the data into the MQTT Client instead of into an output buffer,
-    /// but writing each byte one by one, would be too slow, therefore the ArduinoStreamUtils (https://github.com/bblanchon/ArduinoStreamUtils) library is used to buffer those calls into bigger packets.
-    /// This allows sending data that is very big without requiring to allocate that much memory, because it is sent in smaller packets.
-    /// To support this feature, however this interface needs to additionally implement the Print interface, because that is required by the wrapper class BufferingPrint, which only exists on Arduino
-    /// This then allows to send arbitrary size payloads if that is done the internal buffer of the MQTT Client implementation
-    /// can theoretically set the value as big as the buffering_size passed to the constructor + enough memory to hold the topic and MQTT Header ~= 20 bytes.
-    /// This will mean though that all messages are sent over the StreamUtils library as long as they are bigger than the internal send buffer size,
-    /// which needs more time than sending a message directly but has the advantage of requiring less memory, default = DEFAULT_PAYLOAD_SIZE (64)
+    /// Should be big enough to hold the biggest request that is commonly sent by the device at once.
+    /// Payloads that are bigger are streamed directly into the MQTT client in smaller packets with the begin_publish(), write() and end_publish() methods of the IMQTT_Client interface instead,
+    /// where the internal send buffer is reused to combine the written bytes into bigger packets. This allows to send arbitrary size payloads without requiring to allocate that much memory,
+    /// but needs more time than sending a message directly, because the payload has to be measured beforehand and is then sent in smaller packets, default = DEFAULT_PAYLOAD_SIZE (64)
     /// @param max_stack_size Maximum amount of bytes we want to allocate on the stack.
-    /// Is used when sending a lot of data at once over MQTT, because to actually send the JsonDocument data it first has to be serialized into a json string payload.
-    /// To achieve this the data contained in the JsonDocument is copied for the scope of the @ref Send_Json method and is then copied into the outgoing MQTT buffer.
-    /// This variable therefore decides the threshold where the JsonDocument is copied into the heap instead of a object on the stack.
-    /// This is created to ensure no StackOverflow occurs because most supported boards run the actual sending code in a seperate FreeRTOS Task with limited stack space where even a stack allocation of 4 KiB might already cause a crash
-    /// To circumvent this copy the alternative mentioned in the send_buffer_size argument can also be used because it skips the internal copy alltogether, because the JsonDocument is instead directly copied into the outgoing MQTT buffer, default = DEFAULT_MAX_STACK_SIZE (1024)
+    /// Was previously used to decide if the serialized JsonDocument is copied into a temporary buffer on the stack or on the heap in the @ref Send_Json method.
+    /// Is not used anymore, because the JsonDocument is now serialized once into the internal send buffer, which is allocated once in the @ref Set_Buffer_Size method and reused for every message afterwards.
+    /// Therefore no stack or heap allocation is needed anymore when sending messages. The argument is only kept to not break the signature of the constructor, default = DEFAULT_MAX_STACK_SIZE (1024)
+    /// @param buffering_size Previously the amount of bytes allocated to speed up serialization with the StreamUtils library, is not used anymore because payloads bigger than the send buffer are now always streamed through the internal send buffer.
+    /// Only exists while THINGSBOARD_ENABLE_STREAM_UTILS is enabled, so that previous constructor calls still forward the following arguments to the correct parameter, set THINGSBOARD_ENABLE_STREAM_UTILS to 0 and remove the argument to use the current constructor instead
     /// @param max_response_size Maximum amount of bytes allocated for the interal JsonDocument structure that holds the received payload.
     /// Size is calculated automatically from certain characters in the received payload (',', '{', '[') but if we receive a malicious payload that contains these symbols in a string {"example":",,,,,,..."}.
     /// It is possible to cause huge allocations, but because the memory only lives for as long as the subscribed callback methods it should not be a problem,
     /// especially because attempting to allocate too much memory, will cause the allocation to fail, which is checked. But if the failure of that heap allocation is subscribed for example with the heap_caps_register_failed_alloc_callback method on the ESP32,
     /// then that subscribed callback will be called and could theoretically restart the device. To circumvent that we can simply set the size of this variable to a value that should never be exceeded by a non malicious json payload.
     /// If this safety feature is not required, because the heap allocation failure callback is not subscribed, then the value of the variable can simply be kept as 0, which means we will not check the received payload for its size before the allocation happens, default = DEFAULT_MAX_RESPONSE_SIZE (0)
-    /// @param buffering_size Amount of bytes allocated to speed up serialization.
-    /// Used when THINGSBOARD_ENABLE_STREAM_UTILS is enabled by importing the ArduinoStreamUtils (https://github.com/bblanchon/ArduinoStreamUtils) in the project.
-    /// This feature allows to improve the underlying data streams by directly writing the data into the MQTT Client instead of into an output buffer,
-    /// but writing each byte one by one, would be too slow, therefore the ArduinoStreamUtils (https://github.com/bblanchon/ArduinoStreamUtils) library is used to buffer those calls into bigger packets.
-    /// The variable therefore decides the exact buffering size for these packets, where bigger packets cause faster serialization but in exchange require more memory, default = DEFAULT_BUFFERING_SIZE (64)
     /// @param ...args APIs that should be connected to ThingsBoard and therefore be able to send and receive data over MQTT, that will be forwarded into the overloaded Container constructor see https://en.cppreference.com/w/cpp/container/vector/vector for more information.
     /// Ensure the actual API implementations are kept alive as long as the instance of this class. Because the values are not copied, but a non owning pointers to the values are inserted into the local container member variable instead
     template<typename... Args>
-#if THINGSBOARD_ENABLE_DYNAMIC
 #if THINGSBOARD_ENABLE_STREAM_UTILS
+#if THINGSBOARD_ENABLE_DYNAMIC
+    [[deprecated("buffering_size is ignored, remove the argument and set THINGSBOARD_ENABLE_STREAM_UTILS to 0")]]
     ThingsBoardSized(IMQTT_Client & client, uint16_t receive_buffer_size = DEFAULT_PAYLOAD_SIZE, uint16_t send_buffer_size = DEFAULT_PAYLOAD_SIZE, size_t const & max_stack_size = DEFAULT_MAX_STACK_SIZE, size_t const & buffering_size = DEFAULT_BUFFERING_SIZE, size_t const & max_response_size = DEFAULT_MAX_RESPONSE_SIZE, Args const &... args)
 #else
-    ThingsBoardSized(IMQTT_Client & client, uint16_t receive_buffer_size = DEFAULT_PAYLOAD_SIZE, uint16_t send_buffer_size = DEFAULT_PAYLOAD_SIZE, size_t const & max_stack_size = DEFAULT_MAX_STACK_SIZE, size_t const & max_response_size = DEFAULT_MAX_RESPONSE_SIZE, Args const &... args)
-#endif // THINGSBOARD_ENABLE_STREAM_UTILS
-#else
-#if THINGSBOARD_ENABLE_STREAM_UTILS
+    [[deprecated("buffering_size is ignored, remove the argument and set THINGSBOARD_ENABLE_STREAM_UTILS to 0")]]
     ThingsBoardSized(IMQTT_Client & client, uint16_t receive_buffer_size = DEFAULT_PAYLOAD_SIZE, uint16_t send_buffer_size = DEFAULT_PAYLOAD_SIZE, size_t const & max_stack_size = DEFAULT_MAX_STACK_SIZE, size_t const & buffering_size = DEFAULT_BUFFERING_SIZE, Args const &... args)
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+#else
+#if THINGSBOARD_ENABLE_DYNAMIC
+    ThingsBoardSized(IMQTT_Client & client, uint16_t receive_buffer_size = DEFAULT_PAYLOAD_SIZE, uint16_t send_buffer_size = DEFAULT_PAYLOAD_SIZE, size_t const & max_stack_size = DEFAULT_MAX_STACK_SIZE, size_t const & max_response_size = DEFAULT_MAX_RESPONSE_SIZE, Args const &... args)
 #else
     ThingsBoardSized(IMQTT_Client & client, uint16_t receive_buffer_size = DEFAULT_PAYLOAD_SIZE, uint16_t send_buffer_size = DEFAULT_PAYLOAD_SIZE, size_t const & max_stack_size = DEFAULT_MAX_STACK_SIZE, Args const &... args)
-#endif // THINGSBOARD_ENABLE_STREAM_UTILS
 #endif // THINGSBOARD_ENABLE_DYNAMIC
+#endif // THINGSBOARD_ENABLE_STREAM_UTILS
       : m_client(client)
       , m_max_stack(max_stack_size)
-#if THINGSBOARD_ENABLE_STREAM_UTILS
-      , m_buffering_size(buffering_size)
-#endif // THINGSBOARD_ENABLE_STREAM_UTILS
 #if THINGSBOARD_ENABLE_DYNAMIC
        , m_max_response_size(max_response_size)
 #endif // THINGSBOARD_ENABLE_DYNAMIC
       , m_api_implementations(args...)
     {
+#if THINGSBOARD_ENABLE_STREAM_UTILS
+        (void)buffering_size;
+#endif // THINGSBOARD_ENABLE_STREAM_UTILS
         for (auto & api : m_api_implementations) {
             if (api == nullptr) {
                 continue;
             }
 #if THINGSBOARD_ENABLE_STL
-            api->Set_Client_Callbacks(std::bind(&ThingsBoardSized::Subscribe_API_Implementation, this, std::placeholders::_1), std::bind(&ThingsBoardSized::Send_Json, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoardSized::Send_Json_String, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoardSized::Subscribe_Topic, this, std::placeholders::_1), std::bind(&ThingsBoardSized::Unsubscribe_Topic, this, std::placeholders::_1), std::bind(&ThingsBoardSized::Get_Receive_Buffer_Size, this), std::bind(&ThingsBoardSized::Get_Send_Buffer_Size, this), std::bind(&ThingsBoardSized::Set_Buffer_Size, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoardSized::Get_Last_Request_ID, this));
+            api->Set_Client_Callbacks(std::bind(&ThingsBoardSized::Subscribe_API_Implementation, this, std::placeholders::_1), std::bind(&ThingsBoardSized::Send_Control_Json, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoardSized::Send_Control_Json_String, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoardSized::Subscribe_Topic, this, std::placeholders::_1), std::bind(&ThingsBoardSized::Unsubscribe_Topic, this, std::placeholders::_1), std::bind(&ThingsBoardSized::Get_Receive_Buffer_Size, this), std::bind(&ThingsBoardSized::Get_Send_Buffer_Size, this), std::bind(&ThingsBoardSized::Set_Buffer_Size, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoardSized::Get_Last_Request_ID, this));
 #else
             api->Set_Client_Callbacks(ThingsBoardSized::Static_Subscribe_Implementation, ThingsBoardSized::Static_Send_Json, ThingsBoardSized::Static_Send_Json_String, ThingsBoardSized::Static_Subscribe_Topic, ThingsBoardSized::Static_Unsubscribe_Topic, ThingsBoardSized::Static_Get_Receive_Buffer_Size, ThingsBoardSized::Static_Get_Send_Buffer_Size, ThingsBoardSized::Static_Set_Buffer_Size, ThingsBoardSized::Static_Get_Last_Request_ID);
+#endif // THINGSBOARD_ENABLE_STL
+#if THINGSBOARD_ENABLE_DYNAMIC
+            api->Set_Max_Response_Size(m_max_response_size);
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+#if THINGSBOARD_ENABLE_STL
+            api->Set_Send_Protobuf_Json_Callback(std::bind(&ThingsBoardSized::Send_Control_Protobuf_Json, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+#else
+            api->Set_Send_Protobuf_Json_Callback(ThingsBoardSized::Static_Send_Protobuf_Json);
 #endif // THINGSBOARD_ENABLE_STL
             api->Initialize();
+            (void)Insert_API_Dispatch(*api);
         }
         (void)Set_Buffer_Size(receive_buffer_size, send_buffer_size);
+        // Telemetry and attributes are the only fixed topics that are published to frequently, therefore they are the only ones worth a topic alias if the client supports MQTT 5
+        (void)m_client.reserve_topic_alias(TELEMETRY_TOPIC);
+        (void)m_client.reserve_topic_alias(ATTRIBUTE_TOPIC);
         // Initialize callback.
 #if THINGSBOARD_ENABLE_STL
         m_client.set_data_callback(std::bind(&ThingsBoardSized::On_MQTT_Message, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
         m_client.set_connect_callback(std::bind(&ThingsBoardSized::Resubscribe_Permanent_Subscriptionss, this));
+        m_client.set_delivery_callback(std::bind(&ThingsBoardSized::On_MQTT_Delivery, this, std::placeholders::_1, std::placeholders::_2));
 #else
         m_client.set_data_callback(ThingsBoardSized::On_Static_MQTT_Message);
         m_client.set_connect_callback(ThingsBoardSized::Static_MQTT_Connect);
+        m_client.set_delivery_callback(ThingsBoardSized::On_Static_MQTT_Delivery);
         m_subscribedInstance = this;
 #endif // THINGSBOARD_ENABLE_STL
     }
 
+    /// @brief Deleted copy constructor
+    /// @note Copying the client would require copying the internal buffers and subscriptions, while both instances would still share the same underlying MQTT connection. Therefore copying is disabled alltogether
+    /// @param other Other instance we disallow copying from
+    ThingsBoardSized(ThingsBoardSized const & other) = delete;
+
+    /// @brief Deleted copy assignment operator
+    /// @note Copying the client would require copying the internal buffers and subscriptions, while both instances would still share the same underlying MQTT connection. Therefore copying is disabled alltogether
+    /// @param other Other instance we disallow copying from
+    void operator=(ThingsBoardSized const & other) = delete;
+
+    /// @brief Destructor, frees the internal send buffer that all messages are serialized into before they are published
+    ~ThingsBoardSized() {
+        Free_Send_Buffer();
+        Free_Coalescing_Buffer();
+        delete[] m_in_flight_packet_ids;
+        delete[] m_persistent_packet_ids;
+        delete[] m_report_decisions;
+    }
+
     /// @brief Gets the registered underlying MQTT Client implementation
     /// @note Allows for calling method directly on the client itself, not advised in normal use cases,
     /// as it might cause problems if the library expects the client to be sending / receiving data
@@ -167,11 +239,8 @@ class ThingsBoardSized {
     }
 
     /// @brief Sets the maximum amount of bytes that we want to allocate on the stack, before the memory is allocated on the heap instead
-    /// @note Is used when sending a lot of data at once over MQTT, because to actually send the JsonDocument data it first has to be serialized into a json string payload.
-    /// To achieve this the data contained in the JsonDocument is copied for the scope of the @ref Send_Json method and is then copied into the outgoing MQTT buffer.
-    /// This variable therefore decides the threshold where the JsonDocument is copied into the heap instead of a object on the stack.
-    /// This is created to ensure no StackOverflow occurs because most supported boards run the actual sending code in a seperate FreeRTOS Task with limited stack space where even a stack allocation of 4 KiB might already cause a crash
-    /// To circumvent this copy the alternative mentioned in the send_buffer_size argument of the constructor can also be used because it skips the internal copy alltogether, because the JsonDocument is instead directly copied into the outgoing MQTT buffer
+    /// @note Not used anymore by the @ref Send_Json method, because the JsonDocument is now serialized once into the internal send buffer, which is allocated once in the @ref Set_Buffer_Size method.
+    /// The method is only kept to not break existing code that calls it
     /// @param max_stack_size Maximum amount of bytes we want to allocate on the stack
     void Set_Maximum_Stack_Size(size_t const & max_stack_size) {
         m_max_stack = max_stack_size;
@@ -183,25 +252,6 @@ class ThingsBoardSized {
         return m_max_stack;
     }
 
-#if THINGSBOARD_ENABLE_STREAM_UTILS
-    /// @brief Returns the amount of bytes that can be allocated to speed up fall back serialization with the StreamUtils class
-    /// See https://github.com/bblanchon/ArduinoStreamUtils for more information on the underlying class used
-    /// @return Amount of bytes allocated to speed up serialization
-    size_t const & Get_Buffering_Size() const {
-      return m_buffering_size;
-    }
-
-    /// @brief Sets the amount of bytes allocated to speed up serialization
-    /// @note Used when THINGSBOARD_ENABLE_STREAM_UTILS is enabled by importing the ArduinoStreamUtils (https://github.com/bblanchon/ArduinoStreamUtils) in the project.
-    /// This feature allows to improve the underlying data streams by directly writing the data into the MQTT Client instead of into an output buffer,
-    /// but writing each byte one by one, would be too slow, therefore the ArduinoStreamUtils (https://github.com/bblanchon/ArduinoStreamUtils) library is used to buffer those calls into bigger packets.
-    /// The variable therefore decides the exact buffering size for these packets, where bigger packets cause faster serialization but in exchange require more memory
-    /// @param buffering_size Amount of bytes allocated to speed up serialization
-    void Set_Buffering_Size(size_t const & buffering_size) {
-        m_buffering_size = buffering_size;
-    }
-#endif // THINGSBOARD_ENABLE_STREAM_UTILS
-
 #if THINGSBOARD_ENABLE_DYNAMIC
     /// @brief Sets the Maximum amount of bytes allocated for the interal JsonDocument structure that holds the received payload
     /// @note Size is calculated automatically from certain characters in the received payload (',', '{', '[') but if we receive a malicious payload that contains these symbols in a string {"example":",,,,,,..."}.
@@ -209,9 +259,16 @@ class ThingsBoardSized {
     /// especially because attempting to allocate too much memory, will cause the allocation to fail, which is checked. But if the failure of that heap allocation is subscribed for example with the heap_caps_register_failed_alloc_callback method on the ESP32,
     /// then that subscribed callback will be called and could theoretically restart the device. To circumvent that we can simply set the size of this variable to a value that should never be exceeded by a non malicious json payload.
     /// If this safety feature is not required, because the heap allocation failure callback is not subscribed, then the value of the variable can simply be kept as 0, which means we will not check the received payload for its size before the allocation happens, default = DEFAULT_MAX_RESPONSE_SIZE (0)
+    /// Additionally forwarded to all API implementations, so that JsonDocuments they create while processing a response that is not deserialized by this class, like the params of protobuf RPC requests, are guarded the same way
     /// @param max_response_size Maximum amount of bytes allocated for the interal JsonDocument structure that holds the received payload
     void Set_Max_Response_Size(size_t const & max_response_size) {
         m_max_response_size = max_response_size;
+        for (auto & api : m_api_implementations) {
+            if (api == nullptr) {
+                continue;
+            }
+            api->Set_Max_Response_Size(m_max_response_size);
+        }
     }
 
     /// @brief Gets the Maximum amount of bytes allocated for the interal JsonDocument structure that holds the received payload
@@ -227,8 +284,12 @@ class ThingsBoardSized {
 #endif // THINGSBOARD_ENABLE_DYNAMIC
 
     /// @copydoc IMQTT_Client::set_buffer_size
+    /// @note Additionally allocates the internal send buffer once with the given send buffer size, all messages are serialized into it before they are published.
+    /// Is done once here instead of every time a message is sent, to ensure sending data does not need any stack or heap allocation and therefore does not fragment the heap over time
     bool Set_Buffer_Size(uint16_t receive_buffer_size, uint16_t send_buffer_size) {
-        bool const result = m_client.set_buffer_size(receive_buffer_size, send_buffer_size);
+        // Coalesced key-value pairs were limited to the previous send buffer size, therefore they have to be sent before the size is changed
+        (void)Flush_Telemetry();
+        bool const result = m_client.set_buffer_size(receive_buffer_size, send_buffer_size) && Allocate_Send_Buffer(send_buffer_size);
         if (!result) {
             Logger::printfln(UNABLE_TO_ALLOCATE_BUFFER);
         }
@@ -318,7 +379,21 @@ class ThingsBoardSized {
     }
 
     /// @copydoc IMQTT_Client::loop
+    /// @note Additionally sends all coalesced telemetry key-value pairs, if telemetry coalescing has been enabled with @ref Set_Telemetry_Coalescing and the configured time window has passed,
+    /// as well as the aggregated statistics of the aggregator configured with @ref Set_Telemetry_Aggregator, once its current window has finished.
+    /// Afterwards moves the messages posted from other threads with the Post methods into the outbound queues, if enabled with @ref Set_Concurrent_Queue,
+    /// replays the messages stored in the persistent log configured with @ref Set_Persistent_Store
+    /// and then publishes the messages queued in the outbound queues configured with @ref Set_Outbound_Queue, in the order of their priority.
+    /// Is done after the client handled received messages, so that replies created while handling them (server-side RPC responses) are published in the same call
     bool loop() {
+        // Messages published internally (coalesced telemetry, queued messages, replies of the API implementations) should not overwrite the result of the last send method called by the user
+        Publish_Result const last_publish_result = m_last_publish_result;
+        if (m_coalesced_amount != 0U && Helper::Get_Milliseconds() - m_coalescing_start >= m_coalescing_window) {
+            (void)Flush_Telemetry();
+        }
+        if (m_telemetry_aggregator != nullptr && m_telemetry_aggregator->Is_Window_Finished()) {
+            (void)Flush_Aggregated_Telemetry();
+        }
 #if !THINGSBOARD_USE_ESP_TIMER
         for (auto & api : m_api_implementations) {
             if (api == nullptr) {
@@ -327,68 +402,368 @@ class ThingsBoardSized {
             api->loop();
         }
 #endif // !THINGSBOARD_USE_ESP_TIMER
-        return m_client.loop();
+        bool const result = m_client.loop();
+        Handle_Delivery_Reports();
+#if THINGSBOARD_ENABLE_CONCURRENT_PUBLISH
+        if (m_process_posted_in_loop) {
+            (void)Process_Posted_Messages();
+        }
+#endif // THINGSBOARD_ENABLE_CONCURRENT_PUBLISH
+        Handle_Established_Session();
+        (void)Replay_Persistent_Log(m_persistent_drain_limit);
+        (void)Drain_Outbound_Queues(m_outbound_drain_limit);
+        m_last_publish_result = last_publish_result;
+        return result;
     }
 
-    /// @brief Sends key-value pairs from the given JsonDocument over the given topic
-    /// @note The passed JsonDocument data first has to be serialized into a json string payload to be then copied into the outgoing MQTT buffer.
-    /// To circumvent this copy the alternative mentioned in the send_buffer_size argument of the constructor can also be used because it skips the internal copy alltogether,
-    /// because the JsonDocument is instead directly copied into the outgoing MQTT buffer
-    /// @param topic Non owning pointer to topic that the message is sent over, where different MQTT topics expect a different kind of payload.
-    /// Does not need to kept alive as the function copies the data into the outgoing MQTT buffer to publish the given payload
-    /// @param source JsonDocument containing our json key-value pairs,
-    /// is checked before usage for any possible occuring internal errors. See https://arduinojson.org/v6/api/jsondocument/ for more information
-    /// @return Whether copying the payload contained in the source into the outgoing MQTT buffer, was successful or not
-    bool Send_Json(char const * topic, JsonDocument const & source) {
-        // Check if allocating needed memory failed when trying to create the JsonDocument,
-        // if it did the isNull() method will return true. See https://arduinojson.org/v6/api/jsonvariant/isnull/ for more information
-        if (source.isNull()) {
-            Logger::printfln(UNABLE_TO_ALLOCATE_JSON);
+    /// @brief Configures the outbound queue of the given priority class, all messages of that class are then queued instead of being published immediately
+    /// @note Queued messages are published in the @ref loop method, where all pending messages of a higher priority class (CONTROL > NORMAL > BULK) are published before any message of a lower priority class.
+    /// This allows control-plane replies to overtake a burst of telemetry data, instead of waiting behind everything that was sent before them. Classes without a configured queue are published immediately in call order,
+    /// meaning configuring only the BULK and NORMAL queue keeps replies of the API implementations (server-side RPC responses, firmware state updates, ...) immediate, while telemetry and attributes are deferred to the @ref loop method.
+    /// Messages are copied into a ring of bytes that is allocated once in this method, messages bigger than the send buffer size of the client are not queued and instead streamed immediately.
+    /// If the queue is full the message is discarded and the send method returns false, already queued messages of the class are published before the queue is reallocated
+    /// @param priority Priority class the queue is configured for
+    /// @param buffer_size Amount of bytes that can be used to hold the queued messages, every message requires the size of its topic and payload plus a small header.
+    /// A value of 0 removes the queue and publishes messages of that class immediately again
+    /// @param max_depth Maximum amount of messages that can be queued in the class at once, even if there would still be enough bytes left
+    /// @return Whether allocating the memory required for the queue was successful or not
+    bool Set_Outbound_Queue(Publish_Priority priority, size_t const & buffer_size, size_t const & max_depth) {
+        Outbound_Queue & queue = m_outbound_queues[static_cast<size_t>(priority)];
+        (void)Drain_Outbound_Queue(priority, 0U);
+        if (!queue.Allocate(buffer_size, max_depth)) {
+            Logger::printfln(UNABLE_TO_ALLOCATE_OUTBOUND_QUEUE, buffer_size, static_cast<uint8_t>(priority));
             return false;
         }
-        // Check if inserting any of the internal values failed because the JsonDocument was too small,
-        // if it did the overflowed() method will return true. See https://arduinojson.org/v6/api/jsondocument/overflowed/ for more information
-        if (source.overflowed()) {
-            Logger::printfln(JSON_SIZE_TO_SMALL);
+        return true;
+    }
+
+    /// @brief Sets the maximum amount of queued messages that are published in a single call to the @ref loop method
+    /// @note Limits how many messages are handed to the client at once, so that the client or its outbox is not filled with a burst of telemetry data that later control-plane replies would have to wait behind.
+    /// Messages of higher priority classes still count towards the limit first, meaning they are always published before any message of a lower priority class
+    /// @param max_messages_per_loop Maximum amount of queued messages published per call to loop(), a value of 0 publishes all queued messages, default = 0
+    void Set_Outbound_Drain_Limit(size_t const & max_messages_per_loop) {
+        m_outbound_drain_limit = max_messages_per_loop;
+    }
+
+    /// @brief Returns the amount of messages currently waiting in the outbound queue of the given priority class
+    /// @param priority Priority class the amount of queued messages should be returned for
+    /// @return Amount of queued messages, always 0 if no queue has been configured for the class
+    size_t const & Get_Outbound_Queue_Depth(Publish_Priority priority) const {
+        return m_outbound_queues[static_cast<size_t>(priority)].size();
+    }
+
+    /// @brief Immediately publishes all messages waiting in the outbound queues, in the order of their priority
+    /// @note Messages that can not be published because the client is not connected are kept in the queue and retried on the next call
+    /// @return Whether all queued messages could be published or not
+    bool Flush_Outbound_Queues() {
+        return Drain_Outbound_Queues(0U);
+    }
+
+    /// @brief Sets the maximum size of the outbound backlog, before telemetry and attribute data is refused with @ref Publish_Result::WOULD_BLOCK instead of being queued or published
+    /// @note The backlog consists of the messages waiting in the outbound queues configured with @ref Set_Outbound_Queue and the messages waiting in the outbox of the client, see @ref IMQTT_Client::get_outbox_size.
+    /// Especially the outbox of the @ref Espressif_MQTT_Client with enqueueing enabled is allocated on the heap and grows without any limit while the connection is slow or lost, until no heap memory is left.
+    /// Once the mark is reached the send methods return false, which allows producers to slow down or drop samples before memory runs out. Queued messages are additionally kept in their queue,
+    /// while the outbox of the client alone already reached the mark. Messages of the CONTROL priority class are never refused, so that replies of the API implementations are still published
+    /// @param max_backlog_size Maximum amount of bytes that can be waiting in the outbound backlog, a value of 0 disables the high-water mark, default = 0
+    void Set_Outbound_High_Water_Mark(size_t const & max_backlog_size) {
+        m_outbound_high_water_mark = max_backlog_size;
+    }
+
+    /// @brief Returns the amount of bytes currently waiting to be sent to the MQTT broker
+    /// @note Sum of the bytes occupied in the outbound queues and the bytes waiting in the outbox of the client, see @ref Set_Outbound_High_Water_Mark for more information
+    /// @return Amount of bytes in the outbound backlog
+    size_t Get_Outbound_Backlog_Size() {
+        size_t backlog_size = m_client.get_outbox_size();
+        for (auto const & queue : m_outbound_queues) {
+            backlog_size += queue.used_size();
+        }
+        return backlog_size;
+    }
+
+    /// @brief Returns the amount of messages currently waiting in all outbound queues combined
+    /// @note Messages already handed to the client are not included, because the outbox of the client only reports its size in bytes, see @ref Get_Outbound_Backlog_Size
+    /// @return Amount of queued messages
+    size_t Get_Outbound_Backlog_Messages() const {
+        size_t backlog_messages = 0U;
+        for (auto const & queue : m_outbound_queues) {
+            backlog_messages += queue.size();
+        }
+        return backlog_messages;
+    }
+
+    /// @brief Configures the persistent log, that telemetry and attribute data is stored in while the client is disconnected, instead of being discarded
+    /// @note The log is append-only and written into the segments of the given storage, for example the @ref File_Storage for an SD card or the file system of a Linux host
+    /// or the @ref Espressif_Partition_Storage for a raw data partition in the flash memory of an ESP. Because the log is persisted it survives disconnects as well as reboots of the device.
+    /// Stored messages are replayed in the order they were stored in, once the client has reconnected and the permanent subscriptions of the API implementations have been restored,
+    /// at most the amount configured with @ref Set_Persistent_Drain_Limit per call to @ref loop and additionally limited by the rate limits configured with @ref Set_Rate_Limits.
+    /// While the log still contains messages, newly sent telemetry and attribute data is appended to it as well, to ensure it is not published before the older stored messages.
+    /// Messages of priority classes published with QoS 1, see @ref Set_Publish_QoS, are kept in the log until the broker confirmed them and every older stored message, where at most the in-flight window configured with @ref Set_In_Flight_Window is replayed without being confirmed.
+    /// A message dropped by the client without being confirmed is replayed again, together with every newer replayed message that has not been removed yet. Therefore QoS 1 has to be configured for the NORMAL and BULK class, to ensure no stored message is lost.
+    /// Messages published with QoS 0 are instead marked as delivered once the client accepted them, even if the connection is lost before they reached the broker.
+    /// Either way a message is published again if the device reboots between publishing it and marking it (at least once delivery).
+    /// Telemetry data is stored with the current time of the given time source and replayed in the timestamped form {"ts":1451649600512,"values":{...}}, so the server uses the time it was created at.
+    /// Payloads bigger than the send buffer size of the client can not be stored, because they are streamed directly into the client instead.
+    /// Replaying only needs the internal send buffer, meaning the amount of required memory does not depend on the amount of stored messages
+    /// @param storage Non owning pointer to the storage the log is persisted in, requires at least 2 segments, where the biggest message has to fit into a single segment.
+    /// Has to be kept alive for as long as the log is used. Passing a nullptr disables the persistent log, but keeps the stored messages in the storage
+    /// @param get_time_ms Time source returning the current time in milliseconds since the unix epoch, for example from SNTP. If it is not set or returns 0, telemetry data is replayed without a timestamp instead, default = nullptr
+    /// @return Whether opening the log and recovering the messages stored in the previous run of the device was successful or not
+    bool Set_Persistent_Store(IStorage * storage, Callback<uint64_t>::function get_time_ms = nullptr) {
+        m_persistent_time_callback.Set_Callback(get_time_ms);
+        // Replay is started immediately if already connected, because the connect callback that would start it otherwise has already been called
+        m_persistent_replay = m_client.connected();
+        m_persistent_in_flight = 0U;
+        if (!m_persistent_log.Open(storage)) {
+            Logger::printfln(UNABLE_TO_OPEN_PERSISTENT_LOG);
             return false;
         }
-        bool result = false;
+        return true;
+    }
 
-        size_t const json_size = Helper::Measure_Json(source);
-#if THINGSBOARD_ENABLE_STREAM_UTILS
-        // Check if the size of the given message would be too big for the actual client,
-        // if it is utilize the serialize json work around, so that the internal client buffer can be circumvented
-        if (json_size > m_client.get_send_buffer_size())  {
-#if THINGSBOARD_ENABLE_DEBUG
-            Logger::printfln(SEND_MESSAGE, topic, SEND_SERIALIZED);
-#endif // THINGSBOARD_ENABLE_DEBUG
-            result = Serialize_Json(topic, source, json_size - 1);
+    /// @brief Sets the maximum amount of persisted messages that are replayed in a single call to the @ref loop method
+    /// @note Limits how fast the messages stored while the client was disconnected are published after reconnecting, so that the client is not flooded and newer messages are not delayed too long
+    /// @param max_messages_per_loop Maximum amount of persisted messages replayed per call to loop(), a value of 0 replays all persisted messages, default = 0
+    void Set_Persistent_Drain_Limit(size_t const & max_messages_per_loop) {
+        m_persistent_drain_limit = max_messages_per_loop;
+    }
+
+    /// @brief Returns the amount of messages stored in the persistent log, that have not been delivered yet
+    /// @return Amount of persisted messages, always 0 if no persistent log has been configured with @ref Set_Persistent_Store
+    size_t const & Get_Persistent_Backlog() const {
+        return m_persistent_log.size();
+    }
+
+    /// @brief Sets the quality of service messages of the given priority class are published with, for example QoS 1 for attributes and replies of the API implementations but QoS 0 for bulk telemetry data
+    /// @note Messages published with QoS 1 are confirmed by the broker with a PUBACK containing their packet id and are resent by the client until then, which allows to detect that a message has actually been delivered.
+    /// The amount of unconfirmed messages is bounded by the in-flight window configured with @ref Set_In_Flight_Window, which is allocated with DEFAULT_IN_FLIGHT_WINDOW (4) messages if it has not been configured yet.
+    /// Once the window is full, further messages of classes with QoS 1 are refused with @ref Publish_Result::WOULD_BLOCK or kept in their outbound queue, until the broker confirmed older messages.
+    /// Confirmed and dropped messages are reported to the callback configured with @ref Set_Delivery_Callback
+    /// @param priority Priority class the quality of service is configured for
+    /// @param qos Quality of service messages of the class are published with, default = MQTT_QoS::AT_MOST_ONCE
+    /// @return Whether the client supports the given quality of service and allocating the in-flight window was successful or not.
+    /// Returns false for QoS 1 if the @ref Arduino_MQTT_Client is used, because the underlying PubSubClient can only publish with QoS 0
+    bool Set_Publish_QoS(Publish_Priority priority, MQTT_QoS qos) {
+        if (!m_client.set_publish_qos(qos)) {
+            Logger::printfln(QOS_NOT_SUPPORTED, static_cast<uint8_t>(qos));
+            (void)m_client.set_publish_qos(m_client_qos);
+            return false;
         }
-        else
-#endif // THINGSBOARD_ENABLE_STREAM_UTILS
-        if (json_size > Get_Maximum_Stack_Size()) {
-            char* json = new char[json_size]();
-            if (serializeJson(source, json, json_size) < json_size - 1) {
-                Logger::printfln(UNABLE_TO_SERIALIZE_JSON);
-            }
-            else {
-                result = Send_Json_String(topic, json);
-            }
-            delete[] json;
-            json = nullptr;
+        m_client_qos = qos;
+        if (qos != MQTT_QoS::AT_MOST_ONCE && m_in_flight_window == 0U && !Set_In_Flight_Window(DEFAULT_IN_FLIGHT_WINDOW)) {
+            return false;
         }
-        else {
-            char json[json_size] = {};
-            if (serializeJson(source, json, json_size) < json_size - 1) {
-                Logger::printfln(UNABLE_TO_SERIALIZE_JSON);
-                return result;
-            }
-            result = Send_Json_String(topic, json);
+        m_publish_qos[static_cast<size_t>(priority)] = qos;
+        return true;
+    }
+
+    /// @brief Sets the maximum amount of messages published with QoS 1, that can be waiting for their confirmation by the broker at once
+    /// @note Allows to trade throughput against memory, because every unconfirmed message is kept in the outbox of the client until it has been confirmed.
+    /// A window of 1 publishes the next message only once the previous one has been confirmed (stop-and-wait), whereas a bigger window allows to publish further messages while older ones are still being confirmed.
+    /// The packet ids of the unconfirmed messages and the queue their delivery reports are handed over to the task calling loop() with, are allocated once in this method.
+    /// Additionally bounds the amount of messages replayed from the persistent log configured with @ref Set_Persistent_Store, that are kept in the log until they have been confirmed.
+    /// Because the client might still report the delivery of an unconfirmed message from its own task while the queue is reallocated, the window can only be resized once all messages have been confirmed or dropped
+    /// @param window_size Maximum amount of unconfirmed messages, has to be at least 1, default = DEFAULT_IN_FLIGHT_WINDOW (4)
+    /// @return Whether allocating the memory required for the window was successful or not, fails as well if messages are still waiting for their confirmation
+    bool Set_In_Flight_Window(size_t const & window_size) {
+        Handle_Delivery_Reports();
+        if (m_in_flight_amount != 0U) {
+            Logger::printfln(IN_FLIGHT_WINDOW_BUSY, m_in_flight_amount);
+            return false;
+        }
+        uint16_t * packet_ids = window_size != 0U ? new uint16_t[window_size] : nullptr;
+        uint16_t * persistent_packet_ids = window_size != 0U ? new uint16_t[window_size] : nullptr;
+        if (packet_ids == nullptr || persistent_packet_ids == nullptr || !m_delivery_reports.Allocate(window_size)) {
+            Logger::printfln(UNABLE_TO_ALLOCATE_IN_FLIGHT_WINDOW, window_size);
+            delete[] packet_ids;
+            delete[] persistent_packet_ids;
+            return false;
         }
+        delete[] m_in_flight_packet_ids;
+        delete[] m_persistent_packet_ids;
+        m_in_flight_packet_ids = packet_ids;
+        m_persistent_packet_ids = persistent_packet_ids;
+        m_in_flight_window = window_size;
+        // Every message has been confirmed, but persisted messages might still be kept if removing them failed, which are replayed again instead
+        m_persistent_log.rewind();
+        m_persistent_in_flight = 0U;
+        return true;
+    }
+
+    /// @brief Returns the amount of messages published with QoS 1, that have not been confirmed by the broker yet
+    /// @return Amount of unconfirmed messages, always 0 if no priority class is published with QoS 1
+    size_t const & Get_In_Flight_Amount() const {
+        return m_in_flight_amount;
+    }
+
+    /// @brief Returns the packet id of the last message of a priority class with QoS 1 that was handed to the client, which is passed to the delivery callback once the message has been confirmed or dropped
+    /// @note Only changes if the message was actually published, messages that are copied into an outbound queue or the persistent log receive their packet id once they are published in the @ref loop method
+    /// @return Packet id of the last published message with QoS 1, or 0 if no such message has been published yet
+    uint16_t Get_Last_Packet_ID() const {
+        return m_last_packet_id;
+    }
+
+    /// @brief Sets the callback that is called, once a message published with QoS 1 has been confirmed by the broker or has been dropped by the client without being confirmed
+    /// @note The callback is called with the packet id of the message, see @ref Get_Last_Packet_ID and whether the message was confirmed (true) or dropped (false).
+    /// The callback is always called from the @ref loop method, even if the @ref Espressif_MQTT_Client is used, because the reports of the client are handed over to the task calling loop() first
+    /// @param callback Method that should be called once a message published with QoS 1 has been confirmed or dropped
+    void Set_Delivery_Callback(Callback<void, uint16_t, bool>::function callback) {
+        m_delivery_callback.Set_Callback(callback);
+    }
+
+    /// @brief Returns the result of the last call to any method sending data, allows to find out why the method returned false
+    /// @note Messages published internally in the @ref loop method do not change the result
+    /// @return Result of the last attempt to send data
+    Publish_Result Get_Last_Publish_Result() const {
+        return m_last_publish_result;
+    }
 
+    /// @brief Configures the client-side rate limits, which should match the rate limits configured for the device in ThingsBoard,
+    /// because ThingsBoard silently discards messages or even disconnects devices that exceed them
+    /// @note Uses the same format as ThingsBoard, meaning a comma seperated list of capacity:period_in_seconds pairs ("10:1,300:60"), where all pairs have to allow the publish.
+    /// Every published message consumes one token of the message limits, telemetry messages additionally consume one token of the data point limits per contained key-value pair.
+    /// Messages of priority classes with an outbound queue configured with @ref Set_Outbound_Queue are deferred while the limits are reached, meaning they stay queued and are published in a later call to @ref loop once enough tokens have been refilled.
+    /// Messages of priority classes without an outbound queue can not be deferred and are discarded instead, therefore it is recommended to configure at least the BULK queue when using rate limits.
+    /// Tokens are refilled continuously, meaning buffered messages are published at the configured rate after a reconnect, instead of flooding the server
+    /// @param message_limits Non owning pointer to the message rate limits, nullptr or an empty string disables the message rate limit.
+    /// Does not need to be kept alive, because the string is parsed once in this method
+    /// @param data_point_limits Non owning pointer to the telemetry data point rate limits, nullptr or an empty string disables the data point rate limit.
+    /// Does not need to be kept alive, because the string is parsed once in this method, default = nullptr
+    /// @return Whether parsing both rate limits was successful or not, rate limits that could not be parsed are disabled
+    bool Set_Rate_Limits(char const * message_limits, char const * data_point_limits = nullptr) {
+        bool result = true;
+        if (!m_message_rate_limiter.Set_Limits(message_limits)) {
+            Logger::printfln(UNABLE_TO_PARSE_RATE_LIMITS, message_limits);
+            result = false;
+        }
+        if (!m_data_point_rate_limiter.Set_Limits(data_point_limits)) {
+            Logger::printfln(UNABLE_TO_PARSE_RATE_LIMITS, data_point_limits);
+            result = false;
+        }
         return result;
     }
 
+    /// @brief Returns the amount of messages that can currently be published without exceeding the message rate limits configured with @ref Set_Rate_Limits
+    /// @note Allows the application to adapt its sampling rate, instead of filling the outbound queues faster than they can be published
+    /// @return Amount of messages that can currently be published, SIZE_MAX if no message rate limit has been configured
+    size_t Get_Message_Budget() {
+        return m_message_rate_limiter.Get_Budget();
+    }
+
+    /// @brief Returns the amount of telemetry data points that can currently be published without exceeding the data point rate limits configured with @ref Set_Rate_Limits
+    /// @note Allows the application to adapt its sampling rate, instead of filling the outbound queues faster than they can be published
+    /// @return Amount of telemetry data points that can currently be published, SIZE_MAX if no data point rate limit has been configured
+    size_t Get_Data_Point_Budget() {
+        return m_data_point_rate_limiter.Get_Budget();
+    }
+
+#if THINGSBOARD_ENABLE_CONCURRENT_PUBLISH
+    /// @brief Configures the concurrent publish queue, which allows to post telemetry and attribute data from any thread or FreeRTOS task with the Post methods, for example @ref Post_Telemetry_Data
+    /// @note The Send methods of this class are not thread-safe, because they share the internal send buffer, the outbound queues and the MQTT client itself.
+    /// The Post methods instead serialize the key-value pairs directly into a slot of a lock-free queue, that can be written by any amount of threads at once without a mutex.
+    /// A single consumer then hands the serialized payloads to the outbound queues or publishes them, either automatically in every call to @ref loop or by calling @ref Process_Posted_Messages from a dedicated task.
+    /// Has to be called before any thread starts posting and must not be called again while other threads might still be posting, because the slots are reallocated
+    /// @param slot_amount Maximum amount of posted messages that can wait for the consumer at once, is rounded up to the next power of two.
+    /// A value of 0 removes the queue, which causes all Post methods to fail
+    /// @param slot_size Maximum size of a single serialized posted message in bytes, messages bigger than that can not be posted.
+    /// Posted messages bigger than the send buffer size of the client are streamed once they are processed
+    /// @param process_in_loop Whether posted messages are processed automatically in the @ref loop method, if disabled @ref Process_Posted_Messages has to be called by a single dedicated thread instead, default = true
+    /// @return Whether allocating the memory required for the queue was successful or not
+    bool Set_Concurrent_Queue(size_t const & slot_amount, size_t const & slot_size, bool process_in_loop = true) {
+        m_process_posted_in_loop = process_in_loop;
+        if (!m_posted_messages.Allocate(slot_amount, slot_size)) {
+            Logger::printfln(UNABLE_TO_ALLOCATE_CONCURRENT_QUEUE, slot_amount, slot_size);
+            return false;
+        }
+        return true;
+    }
+
+    /// @brief Moves the messages posted with the Post methods to the outbound queue of their priority class, or publishes them immediately if no queue has been configured for the class
+    /// @note Is the only consumer of the concurrent publish queue, meaning it must always be called from the same thread and never concurrently with any other method of this class except for the Post methods.
+    /// Is called automatically in the @ref loop method, unless disabled in @ref Set_Concurrent_Queue
+    /// @param max_messages Maximum amount of posted messages that should be processed, a value of 0 processes all completely written messages, default = 0
+    /// @return Amount of posted messages that have been processed
+    size_t Process_Posted_Messages(size_t const & max_messages = 0U) {
+        size_t processed = 0U;
+        auto const consumer = [this](bool telemetry, char const * payload, size_t const & payload_size, size_t const & data_point_amount) {
+            (void)Enqueue_Json_String(telemetry ? TELEMETRY_TOPIC : ATTRIBUTE_TOPIC, payload, payload_size, telemetry ? Publish_Priority::BULK : Publish_Priority::NORMAL, data_point_amount);
+        };
+        while ((max_messages == 0U || processed < max_messages) && m_posted_messages.pop(consumer)) {
+            processed++;
+        }
+        return processed;
+    }
+
+    /// @brief Posts the given key-value pair as telemetry data, can be called from any thread
+    /// @note The key-value pair is serialized immediately into a slot of the concurrent publish queue configured with @ref Set_Concurrent_Queue and published once the slot is processed by the consumer.
+    /// See https://thingsboard.io/docs/user-guide/telemetry/ for more information
+    /// @tparam T Type of the passed value
+    /// @param key Non owning pointer to the key of the key-value pair.
+    /// Does not need to kept alive as the function copies the data into the concurrent publish queue
+    /// @param value Value of the key-value pair
+    /// @return Whether copying the key-value pair into the concurrent publish queue was successful or not, fails if all slots are used or the serialized key-value pair is bigger than a slot
+    template<typename T>
+    bool Post_Telemetry_Data(char const * key, T const & value) {
+        Telemetry const t(key, value);
+        return Post_Data_Array(&t, &t + 1U, true);
+    }
+
+    /// @brief Posts aggregated key-value pairs as telemetry data, can be called from any thread
+    /// @note Expects iterators to a container containing Telemetry class instances, which are serialized immediately into a single slot of the concurrent publish queue configured with @ref Set_Concurrent_Queue.
+    /// See https://thingsboard.io/docs/user-guide/telemetry/ for more information
+    /// @tparam InputIterator Class that allows for forward incrementable access to data
+    /// of the given data container, allows for using / passing either std::vector or std::array.
+    /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
+    /// @param first Iterator pointing to the first element in the data container
+    /// @param last Iterator pointing to the end of the data container (last element + 1)
+    /// @return Whether copying the key-value pairs into the concurrent publish queue was successful or not, fails if all slots are used or the serialized key-value pairs are bigger than a slot
+    template<typename InputIterator>
+    bool Post_Telemetry(InputIterator const & first, InputIterator const & last) {
+        return Post_Data_Array(first, last, true);
+    }
+
+    /// @brief Posts the given key-value pair as attribute data, can be called from any thread
+    /// @note The key-value pair is serialized immediately into a slot of the concurrent publish queue configured with @ref Set_Concurrent_Queue and published once the slot is processed by the consumer.
+    /// See https://thingsboard.io/docs/user-guide/attributes/ for more information
+    /// @tparam T Type of the passed value
+    /// @param key Non owning pointer to the key of the key-value pair.
+    /// Does not need to kept alive as the function copies the data into the concurrent publish queue
+    /// @param value Value of the key-value pair
+    /// @return Whether copying the key-value pair into the concurrent publish queue was successful or not, fails if all slots are used or the serialized key-value pair is bigger than a slot
+    template<typename T>
+    bool Post_Attribute_Data(char const * key, T const & value) {
+        Telemetry const t(key, value);
+        return Post_Data_Array(&t, &t + 1U, false);
+    }
+
+    /// @brief Posts aggregated key-value pairs as attribute data, can be called from any thread
+    /// @note Expects iterators to a container containing Telemetry class instances, which are serialized immediately into a single slot of the concurrent publish queue configured with @ref Set_Concurrent_Queue.
+    /// See https://thingsboard.io/docs/user-guide/attributes/ for more information
+    /// @tparam InputIterator Class that allows for forward incrementable access to data
+    /// of the given data container, allows for using / passing either std::vector or std::array.
+    /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
+    /// @param first Iterator pointing to the first element in the data container
+    /// @param last Iterator pointing to the end of the data container (last element + 1)
+    /// @return Whether copying the key-value pairs into the concurrent publish queue was successful or not, fails if all slots are used or the serialized key-value pairs are bigger than a slot
+    template<typename InputIterator>
+    bool Post_Attributes(InputIterator const & first, InputIterator const & last) {
+        return Post_Data_Array(first, last, false);
+    }
+#endif // THINGSBOARD_ENABLE_CONCURRENT_PUBLISH
+
+    /// @brief Sends key-value pairs from the given JsonDocument over the given topic
+    /// @note The passed JsonDocument data is serialized once into the internal send buffer, which is allocated once in the @ref Set_Buffer_Size method and reused for every message,
+    /// the serialized json string payload is then directly copied into the outgoing MQTT buffer. Meaning sending data does neither measure the JsonDocument beforehand nor require any stack or heap allocation.
+    /// If the serialized payload is bigger than the send buffer size, the JsonDocument is instead measured and then streamed directly into the MQTT client in smaller packets,
+    /// see the send_buffer_size argument of the constructor for more information
+    /// @param topic Non owning pointer to topic that the message is sent over, where different MQTT topics expect a different kind of payload.
+    /// Does not need to kept alive as the function copies the data into the outgoing MQTT buffer to publish the given payload
+    /// @param source JsonDocument containing our json key-value pairs,
+    /// is checked before usage for any possible occuring internal errors. See https://arduinojson.org/v6/api/jsondocument/ for more information
+    /// @return Whether copying the payload contained in the source into the outgoing MQTT buffer, was successful or not
+    bool Send_Json(char const * topic, JsonDocument const & source) {
+        return Send_Prioritized_Json(topic, source, Get_Topic_Priority(topic));
+    }
+
     /// @brief Sends key-value pairs from the given json string over the given topic
     /// @param topic Non owning pointer to topic that the message is sent over, where different MQTT topics expect a different kind of payload.
     /// Does not need to kept alive as the function copies the data into the outgoing MQTT buffer to publish the given payload
@@ -396,42 +771,40 @@ class ThingsBoardSized {
     /// Does not need to kept alive as the function copies the data into the outgoing MQTT buffer to publish the given payload
     /// @return Whether copying the payload contained in the json string into the outgoing MQTT buffer, was successful or not
     bool Send_Json_String(char const * topic, char const * json) {
-        if (json == nullptr) {
-            return false;
-        }
-
-        uint16_t current_send_buffer_size = m_client.get_send_buffer_size();
-        auto const json_size = strlen(json);
-
-        if (current_send_buffer_size < json_size) {
-            Logger::printfln(INVALID_BUFFER_SIZE, current_send_buffer_size, json_size);
-            return false;
-        }
-
-#if THINGSBOARD_ENABLE_DEBUG
-        Logger::printfln(SEND_MESSAGE, topic, json);
-#endif // THINGSBOARD_ENABLE_DEBUG
-        return m_client.publish(topic, reinterpret_cast<uint8_t const *>(json), json_size);
+        return Send_Prioritized_Json_String(topic, json, Get_Topic_Priority(topic));
     }
 
     /// @brief Subscribes the given API implementation
     /// @note Ensure the actual API implementation is kept alive as long as the instance of this class. Because the value is not copied,
     /// but a non owning pointer to the value is inserted into the local container member variable instead
     /// @param api Additional API that should be connected to ThingsBoard and therefore be able to send and receive data over MQTT
-    void Subscribe_API_Implementation(IAPI_Implementation & api) {
+    /// @return Whether subscribing the API implementation was successful or not, fails if the maximum amount of API implementations has been reached or its response topic could not be inserted into the dispatch table
+    bool Subscribe_API_Implementation(IAPI_Implementation & api) {
 #if !THINGSBOARD_ENABLE_DYNAMIC
         if (m_api_implementations.size() + 1 > m_api_implementations.capacity()) {
             Logger::printfln(MAX_SUBSCRIPTIONS_EXCEEDED, API_SUBSCRIPTIONS, MAX_ENDPOINTS_AMOUNT_TEMPLATE_NAME);
-            return;
+            return false;
         }
 #endif // !THINGSBOARD_ENABLE_DYNAMIC
 #if THINGSBOARD_ENABLE_STL
-        api.Set_Client_Callbacks(std::bind(&ThingsBoardSized::Subscribe_API_Implementation, this, std::placeholders::_1), std::bind(&ThingsBoardSized::Send_Json, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoardSized::Send_Json_String, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoardSized::Subscribe_Topic, this, std::placeholders::_1), std::bind(&ThingsBoardSized::Unsubscribe_Topic, this, std::placeholders::_1), std::bind(&ThingsBoardSized::Get_Receive_Buffer_Size, this), std::bind(&ThingsBoardSized::Get_Send_Buffer_Size, this), std::bind(&ThingsBoardSized::Set_Buffer_Size, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoardSized::Get_Last_Request_ID, this));
+        api.Set_Client_Callbacks(std::bind(&ThingsBoardSized::Subscribe_API_Implementation, this, std::placeholders::_1), std::bind(&ThingsBoardSized::Send_Control_Json, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoardSized::Send_Control_Json_String, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoardSized::Subscribe_Topic, this, std::placeholders::_1), std::bind(&ThingsBoardSized::Unsubscribe_Topic, this, std::placeholders::_1), std::bind(&ThingsBoardSized::Get_Receive_Buffer_Size, this), std::bind(&ThingsBoardSized::Get_Send_Buffer_Size, this), std::bind(&ThingsBoardSized::Set_Buffer_Size, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoardSized::Get_Last_Request_ID, this));
 #else
         api.Set_Client_Callbacks(ThingsBoardSized::Static_Subscribe_Implementation, ThingsBoardSized::Static_Send_Json, ThingsBoardSized::Static_Send_Json_String, ThingsBoardSized::Static_Subscribe_Topic, ThingsBoardSized::Static_Unsubscribe_Topic, ThingsBoardSized::Static_Get_Receive_Buffer_Size, ThingsBoardSized::Static_Get_Send_Buffer_Size, ThingsBoardSized::Static_Set_Buffer_Size, ThingsBoardSized::Static_Get_Last_Request_ID);
+#endif // THINGSBOARD_ENABLE_STL
+#if THINGSBOARD_ENABLE_DYNAMIC
+        api.Set_Max_Response_Size(m_max_response_size);
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+#if THINGSBOARD_ENABLE_STL
+        api.Set_Send_Protobuf_Json_Callback(std::bind(&ThingsBoardSized::Send_Control_Protobuf_Json, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+#else
+        api.Set_Send_Protobuf_Json_Callback(ThingsBoardSized::Static_Send_Protobuf_Json);
 #endif // THINGSBOARD_ENABLE_STL
         api.Initialize();
+        if (!Insert_API_Dispatch(api)) {
+            return false;
+        }
         m_api_implementations.push_back(&api);
+        return true;
     }
 
     /// @brief Subscribes the given API implementation
@@ -443,28 +816,40 @@ class ThingsBoardSized {
     /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
     /// @param first Iterator pointing to the first element in the data container
     /// @param last Iterator pointing to the end of the data container (last element + 1)
+    /// @return Whether subscribing all API implementations was successful or not, fails if the maximum amount of API implementations would be exceeded or any response topic could not be inserted into the dispatch table
     template <typename InputIterator>
-    void Subscribe_API_Implementations(InputIterator const & first, InputIterator const & last) {
+    bool Subscribe_API_Implementations(InputIterator const & first, InputIterator const & last) {
 #if !THINGSBOARD_ENABLE_DYNAMIC
         size_t const size = Helper::distance(first, last);
         if (m_api_implementations.size() + size > m_api_implementations.capacity()) {
             Logger::printfln(MAX_SUBSCRIPTIONS_EXCEEDED, API_SUBSCRIPTIONS, MAX_ENDPOINTS_AMOUNT_TEMPLATE_NAME);
-            return;
+            return false;
         }
 #endif // !THINGSBOARD_ENABLE_DYNAMIC
+        bool result = true;
         for (auto it = first; it != last; ++it) {
             auto & api = *it;
             if (api == nullptr) {
                 continue;
             }
 #if THINGSBOARD_ENABLE_STL
-            api->Set_Client_Callbacks(std::bind(&ThingsBoardSized::Subscribe_API_Implementation, this, std::placeholders::_1), std::bind(&ThingsBoardSized::Send_Json, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoardSized::Send_Json_String, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoardSized::Subscribe_Topic, this, std::placeholders::_1), std::bind(&ThingsBoardSized::Unsubscribe_Topic, this, std::placeholders::_1), std::bind(&ThingsBoardSized::Get_Receive_Buffer_Size, this), std::bind(&ThingsBoardSized::Get_Send_Buffer_Size, this), std::bind(&ThingsBoardSized::Set_Buffer_Size, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoardSized::Get_Last_Request_ID, this));
+            api->Set_Client_Callbacks(std::bind(&ThingsBoardSized::Subscribe_API_Implementation, this, std::placeholders::_1), std::bind(&ThingsBoardSized::Send_Control_Json, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoardSized::Send_Control_Json_String, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoardSized::Subscribe_Topic, this, std::placeholders::_1), std::bind(&ThingsBoardSized::Unsubscribe_Topic, this, std::placeholders::_1), std::bind(&ThingsBoardSized::Get_Receive_Buffer_Size, this), std::bind(&ThingsBoardSized::Get_Send_Buffer_Size, this), std::bind(&ThingsBoardSized::Set_Buffer_Size, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoardSized::Get_Last_Request_ID, this));
 #else
             api->Set_Client_Callbacks(ThingsBoardSized::Static_Subscribe_Implementation, ThingsBoardSized::Static_Send_Json, ThingsBoardSized::Static_Send_Json_String, ThingsBoardSized::Static_Subscribe_Topic, ThingsBoardSized::Static_Unsubscribe_Topic, ThingsBoardSized::Static_Get_Receive_Buffer_Size, ThingsBoardSized::Static_Get_Send_Buffer_Size, ThingsBoardSized::Static_Set_Buffer_Size, ThingsBoardSized::Static_Get_Last_Request_ID);
+#endif // THINGSBOARD_ENABLE_STL
+#if THINGSBOARD_ENABLE_DYNAMIC
+            api->Set_Max_Response_Size(m_max_response_size);
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+#if THINGSBOARD_ENABLE_STL
+            api->Set_Send_Protobuf_Json_Callback(std::bind(&ThingsBoardSized::Send_Control_Protobuf_Json, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+#else
+            api->Set_Send_Protobuf_Json_Callback(ThingsBoardSized::Static_Send_Protobuf_Json);
 #endif // THINGSBOARD_ENABLE_STL
             api->Initialize();
+            result = Insert_API_Dispatch(*api) && result;
         }
         m_api_implementations.insert(m_api_implementations.end(), first, last);
+        return result;
     }
 
     //----------------------------------------------------------------------------
@@ -495,16 +880,138 @@ class ThingsBoardSized {
     //----------------------------------------------------------------------------
     // Telemetry API
 
+    /// @brief Enables or disables coalescing of telemetry data sent with @ref Send_Telemetry_Data
+    /// @note If enabled, key-value pairs are not sent immediately, but instead merged into a single telemetry json object, which is only sent once the given time window has passed since the first merged key-value pair,
+    /// or once no further key-value pair can be merged because the maximum amount of key-value pairs or the send buffer size would be exceeded. Sending is done in the @ref loop method or by calling @ref Flush_Telemetry,
+    /// if a key-value pair with a key that has already been merged is sent, then the later value replaces the earlier one. This reduces the amount of published messages drastically,
+    /// if many independent parts of the firmware send single key-value pairs in short succession, but delays the sending by up to the given time window.
+    /// The memory required to hold the merged key-value pairs, as well as copies of their keys and string values, is allocated once in this method and reused afterwards, currently merged key-value pairs are sent before it is reallocated.
+    /// The copies of the keys and string values are limited to the send buffer size of the client at the time this method is called, if they do not fit the merged key-value pairs are sent early
+    /// @param window_ms Amount of time in milliseconds after the first merged key-value pair, that further key-value pairs are merged before they are sent. Ensure to call loop() at least that often.
+    /// A value of 0 means that the merged key-value pairs are sent on the next call to loop()
+    /// @param max_key_value_pair_amount Maximum amount of key-value pairs that can be merged into a single telemetry json object. A value of 0 disables telemetry coalescing and sends every key-value pair immediately again, default = 0
+    /// @return Whether allocating the memory required to merge the given amount of key-value pairs was successful or not
+    bool Set_Telemetry_Coalescing(uint32_t window_ms, size_t const & max_key_value_pair_amount = 0U) {
+        (void)Flush_Telemetry();
+        m_coalescing_window = window_ms;
+        uint16_t const current_send_buffer_size = m_client.get_send_buffer_size();
+        if (m_coalesced_telemetry != nullptr && m_coalescing_max_amount == max_key_value_pair_amount && m_coalescing_arena_size == current_send_buffer_size) {
+            return true;
+        }
+        Free_Coalescing_Buffer();
+        if (max_key_value_pair_amount == 0U) {
+            return true;
+        }
+        m_coalesced_telemetry = new Telemetry[max_key_value_pair_amount]();
+        m_coalescing_arena = new char[current_send_buffer_size];
+        if (m_coalesced_telemetry == nullptr || m_coalescing_arena == nullptr) {
+            Free_Coalescing_Buffer();
+            Logger::printfln(UNABLE_TO_ALLOCATE_COALESCING_BUFFER, max_key_value_pair_amount);
+            return false;
+        }
+        m_coalescing_max_amount = max_key_value_pair_amount;
+        m_coalescing_arena_size = current_send_buffer_size;
+        return true;
+    }
+
+    /// @brief Sets the filter, that decides which key-value pairs sent as telemetry data are dropped before any json is built (report-by-exception), for example a @ref Deadband_Filter
+    /// @note Applies to all key-value pairs sent with @ref Send_Telemetry_Data and @ref Send_Telemetry, as well as coalesced key-value pairs once they are flushed.
+    /// If all key-value pairs of a message are dropped, then nothing is published and the send method still returns true. The filter is only informed about reported key-value pairs, once the message has been sent successfully
+    /// @param filter Non owning pointer to the filter, has to be kept alive for as long as it is used. Passing a nullptr sends every key-value pair again
+    void Set_Telemetry_Filter(IReport_Filter * filter) {
+        m_telemetry_filter = filter;
+    }
+
+    /// @brief Sets the filter, that decides which key-value pairs sent as attribute data are dropped before any json is built (report-by-exception), for example a @ref Deadband_Filter or an @ref Attribute_Change_Tracker
+    /// @note Applies to all key-value pairs sent with @ref Send_Attribute_Data and @ref Send_Attributes.
+    /// If all key-value pairs of a message are dropped, then nothing is published and the send method still returns true. The filter is only informed about reported key-value pairs, once the message has been sent successfully.
+    /// The filter is reset before the next attributes are sent, once a new session with the MQTT broker has been established or a message published with QoS 1 has been dropped by the client,
+    /// so that the first message afterwards contains the complete set of attributes again (full resync)
+    /// @param filter Non owning pointer to the filter, has to be kept alive for as long as it is used. Passing a nullptr sends every key-value pair again
+    void Set_Attribute_Filter(IReport_Filter * filter) {
+        m_attribute_filter = filter;
+    }
+
+    /// @brief Immediately sends all currently coalesced telemetry key-value pairs as a single telemetry json object
+    /// @note Is called automatically in the @ref loop method once the time window configured with @ref Set_Telemetry_Coalescing has passed.
+    /// The merged key-value pairs are discarded afterwards, even if sending them failed
+    /// @return Whether copying the merged key-value pairs into the outgoing MQTT buffer, was successful or not. Returns true if there were no merged key-value pairs
+    bool Flush_Telemetry() {
+        if (m_coalesced_amount == 0U) {
+            return true;
+        }
+#if THINGSBOARD_ENABLE_DEBUG
+        Logger::printfln(FLUSH_COALESCED_TELEMETRY, m_coalesced_amount, m_coalesced_size);
+#endif // THINGSBOARD_ENABLE_DEBUG
+        size_t const amount = m_coalesced_amount;
+        m_coalesced_amount = 0U;
+        m_coalesced_size = 0U;
+        bool const result = Send_Data_Array(m_coalesced_telemetry, m_coalesced_telemetry + amount, true);
+        // Keys and string values of the merged key-value pairs are only released once they have been serialized
+        m_coalescing_arena_used = 0U;
+        return result;
+    }
+
+    /// @brief Sets the aggregator, whose statistics (min, max, avg, ...) are sent as a single telemetry json object once its time window has finished, see @ref Telemetry_Aggregator for more information
+    /// @note Values are added directly to the aggregator with @ref Telemetry_Aggregator::Add, instead of being sent with the Send methods. Sending is done in the @ref loop method or by calling @ref Flush_Aggregated_Telemetry
+    /// @param aggregator Non owning pointer to the aggregator, has to be kept alive for as long as it is used. Passing a nullptr stops sending the statistics automatically
+    void Set_Telemetry_Aggregator(Telemetry_Aggregator * aggregator) {
+        m_telemetry_aggregator = aggregator;
+    }
+
+    /// @brief Immediately sends the statistics of the current window of the aggregator configured with @ref Set_Telemetry_Aggregator as a single telemetry json object, and starts a new window
+    /// @note Is called automatically in the @ref loop method once the window of the aggregator has finished.
+    /// The aggregated values are discarded afterwards, even if sending them failed
+    /// @return Whether copying the statistics into the outgoing MQTT buffer, was successful or not. Returns true if there were no aggregated values
+    bool Flush_Aggregated_Telemetry() {
+        if (m_telemetry_aggregator == nullptr || m_telemetry_aggregator->empty()) {
+            return true;
+        }
+        uint16_t const current_send_buffer_size = m_client.get_send_buffer_size();
+        if (m_send_buffer_size != Calculate_Send_Buffer_Size(current_send_buffer_size) && !Allocate_Send_Buffer(current_send_buffer_size)) {
+            m_telemetry_aggregator->Clear();
+            Logger::printfln(UNABLE_TO_ALLOCATE_BUFFER);
+            return Set_Publish_Result(Publish_Result::OUT_OF_MEMORY);
+        }
+
+        Fixed_Buffer_Writer writer(m_send_buffer, m_send_buffer_size);
+        size_t data_point_amount = 0U;
+        size_t const json_size = m_telemetry_aggregator->Serialize(writer, data_point_amount);
+        bool result = true;
+        if (data_point_amount == 0U) {
+            // Every key that received a value has been configured to not send any statistic
+            result = Set_Publish_Result(Publish_Result::SUCCESS);
+        }
+        else if (json_size <= current_send_buffer_size) {
+            m_send_buffer[json_size] = '\0';
+            result = Enqueue_Json_String(TELEMETRY_TOPIC, m_send_buffer, json_size, Publish_Priority::BULK, data_point_amount);
+        }
+        else {
+            Telemetry_Aggregator const & aggregator = *m_telemetry_aggregator;
+            result = Stream_Payload(TELEMETRY_TOPIC, Publish_Priority::BULK, json_size, data_point_amount, [&](Buffered_Publish_Writer & writer) {
+                size_t streamed_data_point_amount = 0U;
+                return aggregator.Serialize(writer, streamed_data_point_amount);
+            });
+        }
+        m_telemetry_aggregator->Clear();
+        return result;
+    }
+
     /// @brief Sends the given key-value pair as telemetry data.
     /// See https://thingsboard.io/docs/user-guide/telemetry/ for more information
+    /// @note If telemetry coalescing has been enabled with @ref Set_Telemetry_Coalescing the key-value pair is not sent immediately, but instead merged with other key-value pairs and sent later.
+    /// In that case the key and string values are copied into memory owned by the client, meaning they do not need to be kept alive until the merged key-value pairs have been sent
     /// @tparam T Type of the passed value
     /// @param key Non owning pointer to the key of the key-value pair.
-    /// Does not need to kept alive as the function copies the data into the outgoing MQTT buffer to publish the key-value pair
+    /// Does not need to kept alive as the function copies the data into the outgoing MQTT buffer to publish the key-value pair, or into the memory holding the merged key-value pairs if telemetry coalescing is enabled
     /// @param value Value of the key-value pair
-    /// @return Whether copying the key-value pair into the outgoing MQTT buffer, was successful or not
+    /// @return Whether copying the key-value pair into the outgoing MQTT buffer or merging it with the other coalesced key-value pairs, was successful or not
     template<typename T>
     bool Send_Telemetry_Data(char const * key, T const & value) {
-        return Send_Key_Value_Pair(key, value);
+        if (m_coalesced_telemetry == nullptr || Helper::String_IsNull_Or_Empty(key)) {
+            return Send_Key_Value_Pair(key, value);
+        }
+        return Coalesce_Telemetry(Telemetry(key, value));
     }
 
     /// @brief Send aggregated key-value pair as telemetry data
@@ -514,7 +1021,8 @@ class ThingsBoardSized {
     /// of the given data container, allows for using / passing either std::vector or std::array.
     /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
     /// @tparam MaxKeyValuePairAmount Maximum amount of key-value pairs, which will ever be sent with this method.
-    /// Should simply be the biggest distance between first and last iterator this method is ever called with
+    /// Was previously used to size the StaticJsonDocument the key-value pairs were copied into. Is not used anymore, because the key-value pairs are now directly serialized into the internal send buffer.
+    /// The argument is only kept to not break existing code that calls this method
     /// @param first Iterator pointing to the first element in the data container
     /// @param last Iterator pointing to the end of the data container (last element + 1)
     /// @return Whether copying the key-value pairs into the outgoing MQTT buffer, was successful or not
@@ -524,68 +1032,204 @@ class ThingsBoardSized {
     template<size_t MaxKeyValuePairAmount, typename InputIterator>
 #endif // THINGSBOARD_ENABLE_DYNAMIC
     bool Send_Telemetry(InputIterator const & first, InputIterator const & last) {
-#if THINGSBOARD_ENABLE_DYNAMIC
         return Send_Data_Array(first, last, true);
-#else
-        return Send_Data_Array<MaxKeyValuePairAmount>(first, last, true);
-#endif // THINGSBOARD_ENABLE_DYNAMIC
-    }
-
-    /// @brief Send string containing json as telemetry data.
-    /// See https://thingsboard.io/docs/user-guide/telemetry/ for more information
-    /// @param json Non owning pointer to the string containing our json key-value pairs
-    /// Does not need to kept alive as the function copies the data into the outgoing MQTT buffer to publish the key-value pairs
-    /// @return Whether copying the key-value pairs into the outgoing MQTT buffer, was successful or not
-    bool Send_Telemetry_String(char const * json) {
-        return Send_Json_String(TELEMETRY_TOPIC, json);
     }
 
-    /// @brief Send key-value pairs as telemetry data.
+    /// @brief Send multiple groups of key-value pairs, each with their own timestamp, as telemetry data in one message
+    /// @note Expects iterators to a container containing Timestamped_Telemetry class instances. Serializes them into the array form expected by ThingsBoard [{"ts":1451649600512,"values":{"key1":"value1"}}, ...],
+    /// which allows to sample data more often than it is sent, while still keeping the exact time each sample was taken at, instead of the time the message was received by the server.
     /// See https://thingsboard.io/docs/user-guide/telemetry/ for more information
-    /// @param source JsonDocument containing our json key-value pairs,
-    /// is checked before usage for any possible occuring internal errors. See https://arduinojson.org/v6/api/jsondocument/ for more information
-    /// @return Whether copying the key-value pairs into the outgoing MQTT buffer, was successful or not
-    bool Send_Telemetry_Json(JsonDocument const & source) {
-        return Send_Json(TELEMETRY_TOPIC, source);
-    }
-
-    //----------------------------------------------------------------------------
-    // Attribute API
-
-    /// @brief Sends the given key-value pair as attribute data.
-    /// See https://thingsboard.io/docs/user-guide/attributes/ for more information
-    /// @tparam T Type of the passed value
-    /// @param key Non owning pointer to the key of the key-value pair.
-    /// Does not need to kept alive as the function copies the data into the outgoing MQTT buffer to publish the key-value pair
-    /// @param value Value of the key-value pair
-    /// @return Whether copying the key-value pair into the outgoing MQTT buffer, was successful or not
-    template<typename T>
-    bool Send_Attribute_Data(char const * key, T const & value) {
-        return Send_Key_Value_Pair(key, value, false);
-    }
-
-    /// @brief Send aggregated key-value pair as attribute data
-    /// @note Expects iterators to a container containing Attribute class instances.
-    /// See https://thingsboard.io/docs/user-guide/attribute/ for more information
     /// @tparam InputIterator Class that allows for forward incrementable access to data
     /// of the given data container, allows for using / passing either std::vector or std::array.
     /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
-    /// @tparam MaxKeyValuePairAmount Maximum amount of key-value pairs, which will ever be sent with this method.
+    /// @tparam MaxTimestampAmount Maximum amount of timestamped groups, which will ever be sent with this method.
     /// Should simply be the biggest distance between first and last iterator this method is ever called with
+    /// @tparam MaxKeyValuePairAmount Maximum amount of key-value pairs over all timestamped groups combined, which will ever be sent with this method
     /// @param first Iterator pointing to the first element in the data container
     /// @param last Iterator pointing to the end of the data container (last element + 1)
-    /// @return Whether copying the key-value pairs into the outgoing MQTT buffer, was successful or not
+    /// @return Whether copying the timestamped key-value pairs into the outgoing MQTT buffer, was successful or not
 #if THINGSBOARD_ENABLE_DYNAMIC
     template<typename InputIterator>
 #else
-    template<size_t MaxKeyValuePairAmount, typename InputIterator>
+    template<size_t MaxTimestampAmount, size_t MaxKeyValuePairAmount, typename InputIterator>
 #endif // THINGSBOARD_ENABLE_DYNAMIC
-    bool Send_Attributes(InputIterator const & first, InputIterator const & last) {
+    bool Send_Timestamped_Telemetry(InputIterator const & first, InputIterator const & last) {
+        size_t const timestamp_amount = Helper::distance(first, last);
+        size_t key_value_pair_amount = 0U;
+        for (auto it = first; it != last; ++it) {
+            Timestamped_Telemetry const & data = *it;
+            key_value_pair_amount += data.GetSize();
+        }
 #if THINGSBOARD_ENABLE_DYNAMIC
-        return Send_Data_Array(first, last, false);
+        // char const * are stored as only a pointer inside the JsonDocument --> zero copy, meaning the size for the strings is 0 bytes.
+        // Data structure size, therefore only depends on the amount of timestamped groups, each containing an object with the timestamp and the values object, and the amount of key value pairs passed.
+        // See https://arduinojson.org/v6/assistant/ for more information on the needed size for the JsonDocument
+        TBJsonDocument json_buffer(JSON_ARRAY_SIZE(timestamp_amount) + timestamp_amount * JSON_OBJECT_SIZE(2U) + JSON_OBJECT_SIZE(key_value_pair_amount));
+#else
+        if (timestamp_amount > MaxTimestampAmount) {
+            Logger::printfln(TOO_MANY_JSON_FIELDS, timestamp_amount, "MaxTimestampAmount", MaxTimestampAmount);
+            return Set_Publish_Result(Publish_Result::INVALID_PAYLOAD);
+        }
+        else if (key_value_pair_amount > MaxKeyValuePairAmount) {
+            Logger::printfln(TOO_MANY_JSON_FIELDS, key_value_pair_amount, "MaxKeyValuePairAmount", MaxKeyValuePairAmount);
+            return Set_Publish_Result(Publish_Result::INVALID_PAYLOAD);
+        }
+        StaticJsonDocument<JSON_ARRAY_SIZE(MaxTimestampAmount) + MaxTimestampAmount * JSON_OBJECT_SIZE(2U) + JSON_OBJECT_SIZE(MaxKeyValuePairAmount)> json_buffer;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+
+#if THINGSBOARD_ENABLE_STL
+        if (std::any_of(first, last, [&json_buffer](Timestamped_Telemetry const & data) { return !data.SerializeTimestampedValues(json_buffer); })) {
+            Logger::printfln(UNABLE_TO_SERIALIZE);
+            return Set_Publish_Result(Publish_Result::INVALID_PAYLOAD);
+        }
+#else
+        for (auto it = first; it != last; ++it) {
+            auto const & data = *it;
+            if (!data.SerializeTimestampedValues(json_buffer)) {
+                Logger::printfln(UNABLE_TO_SERIALIZE);
+                return Set_Publish_Result(Publish_Result::INVALID_PAYLOAD);
+            }
+        }
+#endif // THINGSBOARD_ENABLE_STL
+        return Send_Telemetry_Json(json_buffer);
+    }
+
+    /// @brief Send the values of a compile time telemetry schema as telemetry data
+    /// @note Only the values are formatted at runtime, into the slots between the braces, commas and quoted keys of the json skeleton precomputed by the @ref Telemetry_Schema.
+    /// If the send buffer size of the client is at least the @ref Telemetry_Schema::MAX_PAYLOAD_SIZE, the payload is guaranteed to fit and is never streamed.
+    /// See https://thingsboard.io/docs/user-guide/telemetry/ for more information
+    /// @tparam Schema @ref Telemetry_Schema describing the keys and value types that are sent
+    /// @tparam ...Values Types of the passed values, have to be convertible to the value types of the fields of the schema
+    /// @param ...values One value per field, in the same order as the fields of the schema
+    /// @return Whether copying the values into the outgoing MQTT buffer, was successful or not
+    template<typename Schema, typename... Values>
+    bool Send_Telemetry_Schema(Values const &... values) {
+        static_assert(sizeof...(Values) == Schema::FIELD_AMOUNT, "Amount of passed values has to match the amount of fields in the telemetry schema");
+        uint16_t const current_send_buffer_size = m_client.get_send_buffer_size();
+        if (m_send_buffer_size != Calculate_Send_Buffer_Size(current_send_buffer_size) && !Allocate_Send_Buffer(current_send_buffer_size)) {
+            Logger::printfln(UNABLE_TO_ALLOCATE_BUFFER);
+            return Set_Publish_Result(Publish_Result::OUT_OF_MEMORY);
+        }
+
+        Fixed_Buffer_Writer writer(m_send_buffer, m_send_buffer_size);
+        size_t const json_size = Schema::Serialize(writer, values...);
+        if (json_size <= current_send_buffer_size) {
+            m_send_buffer[json_size] = '\0';
+            return Enqueue_Json_String(TELEMETRY_TOPIC, m_send_buffer, json_size, Publish_Priority::BULK, Schema::FIELD_AMOUNT);
+        }
+        return Stream_Payload(TELEMETRY_TOPIC, Publish_Priority::BULK, json_size, Schema::FIELD_AMOUNT, [&](Buffered_Publish_Writer & writer) {
+            return Schema::Serialize(writer, values...);
+        });
+    }
+
+    /// @brief Send the oldest samples stored in the given compressed time-series buffer as telemetry data in one message and remove them from the buffer once they have been sent
+    /// @note The samples are only decompressed while they are serialized into the array form expected by ThingsBoard [{"ts":1451649600512,"values":{"key1":1}}, ...],
+    /// directly into the internal send buffer, or if they do not fit, streamed into the client. Allows to keep a long history of samples while the device is offline and upload it once it reconnected.
+    /// See https://thingsboard.io/docs/user-guide/telemetry/ for more information
+    /// @param buffer Buffer containing the compressed samples, see @ref Time_Series_Buffer for more information
+    /// @param max_samples Maximum amount of oldest samples that should be sent in this message, a value of 0 sends all stored samples. Limiting the amount ensures the message does not exceed the maximum message size of the server
+    /// @return Whether copying the samples into the outgoing MQTT buffer, was successful or not. The samples are kept in the buffer if it was not
+    bool Send_Time_Series(Time_Series_Buffer & buffer, size_t const & max_samples = 0U) {
+        size_t const sample_amount = (max_samples == 0U || max_samples > buffer.size()) ? buffer.size() : max_samples;
+        if (sample_amount == 0U) {
+            return Set_Publish_Result(Publish_Result::SUCCESS);
+        }
+        uint16_t const current_send_buffer_size = m_client.get_send_buffer_size();
+        if (m_send_buffer_size != Calculate_Send_Buffer_Size(current_send_buffer_size) && !Allocate_Send_Buffer(current_send_buffer_size)) {
+            Logger::printfln(UNABLE_TO_ALLOCATE_BUFFER);
+            return Set_Publish_Result(Publish_Result::OUT_OF_MEMORY);
+        }
+
+        Fixed_Buffer_Writer writer(m_send_buffer, m_send_buffer_size);
+        size_t data_point_amount = 0U;
+        size_t const json_size = buffer.Serialize(writer, sample_amount, data_point_amount);
+        bool result = false;
+        if (json_size <= current_send_buffer_size) {
+            m_send_buffer[json_size] = '\0';
+            result = Enqueue_Json_String(TELEMETRY_TOPIC, m_send_buffer, json_size, Publish_Priority::BULK, data_point_amount);
+        }
+        else {
+            result = Stream_Payload(TELEMETRY_TOPIC, Publish_Priority::BULK, json_size, data_point_amount, [&](Buffered_Publish_Writer & writer) {
+                size_t streamed_data_point_amount = 0U;
+                return buffer.Serialize(writer, sample_amount, streamed_data_point_amount);
+            });
+        }
+        if (result) {
+            buffer.pop(sample_amount);
+        }
+        return result;
+    }
+
+    /// @brief Send string containing json as telemetry data.
+    /// See https://thingsboard.io/docs/user-guide/telemetry/ for more information
+    /// @param json Non owning pointer to the string containing our json key-value pairs
+    /// Does not need to kept alive as the function copies the data into the outgoing MQTT buffer to publish the key-value pairs
+    /// @return Whether copying the key-value pairs into the outgoing MQTT buffer, was successful or not
+    bool Send_Telemetry_String(char const * json) {
+        return Send_Json_String(TELEMETRY_TOPIC, json);
+    }
+
+    /// @brief Send key-value pairs as telemetry data.
+    /// See https://thingsboard.io/docs/user-guide/telemetry/ for more information
+    /// @param source JsonDocument containing our json key-value pairs,
+    /// is checked before usage for any possible occuring internal errors. See https://arduinojson.org/v6/api/jsondocument/ for more information
+    /// @return Whether copying the key-value pairs into the outgoing MQTT buffer, was successful or not
+    bool Send_Telemetry_Json(JsonDocument const & source) {
+        return Send_Json(TELEMETRY_TOPIC, source);
+    }
+
+    /// @brief Send aggregated key-value pairs as telemetry data encoded as a protobuf message, instead of a json object.
+    /// Requires the transport payload type of the device profile on the ThingsBoard server to be set to protobuf, where the telemetry proto schema has to match the given schema.
+    /// See https://thingsboard.io/docs/user-guide/device-profiles/#mqtt-device-payload for more information
+    /// @note Expects iterators to a container containing Telemetry class instances. The key-value pairs are directly encoded into the internal send buffer, the same way as they are serialized as json text by @ref Send_Telemetry,
+    /// meaning the filter configured with @ref Set_Telemetry_Filter, the rate limits, outbound queues and the persistent store apply as well. Protobuf messages can simply be appended to each other,
+    /// therefore every key-value pair is written as one field of the message without any surrounding brackets or delimiters
+    /// @tparam InputIterator Class that allows for forward incrementable access to data
+    /// of the given data container, allows for using / passing either std::vector or std::array.
+    /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
+    /// @param schema Description of the telemetry proto schema, mapping every key to the number and type of its field
+    /// @param first Iterator pointing to the first element in the data container
+    /// @param last Iterator pointing to the end of the data container (last element + 1)
+    /// @return Whether copying the encoded key-value pairs into the outgoing MQTT buffer was successful or not, fails if any key is not part of the schema
+    template<typename InputIterator>
+    bool Send_Telemetry_Protobuf(Protobuf_Schema const & schema, InputIterator const & first, InputIterator const & last) {
+        return Send_Data_Array(first, last, true, &schema);
+    }
+
+    //----------------------------------------------------------------------------
+    // Attribute API
+
+    /// @brief Sends the given key-value pair as attribute data.
+    /// See https://thingsboard.io/docs/user-guide/attributes/ for more information
+    /// @tparam T Type of the passed value
+    /// @param key Non owning pointer to the key of the key-value pair.
+    /// Does not need to kept alive as the function copies the data into the outgoing MQTT buffer to publish the key-value pair
+    /// @param value Value of the key-value pair
+    /// @return Whether copying the key-value pair into the outgoing MQTT buffer, was successful or not
+    template<typename T>
+    bool Send_Attribute_Data(char const * key, T const & value) {
+        return Send_Key_Value_Pair(key, value, false);
+    }
+
+    /// @brief Send aggregated key-value pair as attribute data
+    /// @note Expects iterators to a container containing Attribute class instances.
+    /// See https://thingsboard.io/docs/user-guide/attribute/ for more information
+    /// @tparam InputIterator Class that allows for forward incrementable access to data
+    /// of the given data container, allows for using / passing either std::vector or std::array.
+    /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
+    /// @tparam MaxKeyValuePairAmount Maximum amount of key-value pairs, which will ever be sent with this method.
+    /// Was previously used to size the StaticJsonDocument the key-value pairs were copied into. Is not used anymore, because the key-value pairs are now directly serialized into the internal send buffer.
+    /// The argument is only kept to not break existing code that calls this method
+    /// @param first Iterator pointing to the first element in the data container
+    /// @param last Iterator pointing to the end of the data container (last element + 1)
+    /// @return Whether copying the key-value pairs into the outgoing MQTT buffer, was successful or not
+#if THINGSBOARD_ENABLE_DYNAMIC
+    template<typename InputIterator>
 #else
-        return Send_Data_Array<MaxKeyValuePairAmount>(first, last, false);
+    template<size_t MaxKeyValuePairAmount, typename InputIterator>
 #endif // THINGSBOARD_ENABLE_DYNAMIC
+    bool Send_Attributes(InputIterator const & first, InputIterator const & last) {
+        return Send_Data_Array(first, last, false);
     }
 
     /// @brief Send string containing json as attribute data.
@@ -606,38 +1250,910 @@ class ThingsBoardSized {
         return Send_Json(ATTRIBUTE_TOPIC, source);
     }
 
+    /// @brief Send aggregated key-value pairs as attribute data encoded as a protobuf message, instead of a json object.
+    /// Requires the transport payload type of the device profile on the ThingsBoard server to be set to protobuf, where the attributes proto schema has to match the given schema.
+    /// See https://thingsboard.io/docs/user-guide/device-profiles/#mqtt-device-payload for more information
+    /// @note Expects iterators to a container containing Attribute class instances, see @ref Send_Telemetry_Protobuf for more information on the encoding
+    /// @tparam InputIterator Class that allows for forward incrementable access to data
+    /// of the given data container, allows for using / passing either std::vector or std::array.
+    /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
+    /// @param schema Description of the attributes proto schema, mapping every key to the number and type of its field
+    /// @param first Iterator pointing to the first element in the data container
+    /// @param last Iterator pointing to the end of the data container (last element + 1)
+    /// @return Whether copying the encoded key-value pairs into the outgoing MQTT buffer was successful or not, fails if any key is not part of the schema
+    template<typename InputIterator>
+    bool Send_Attributes_Protobuf(Protobuf_Schema const & schema, InputIterator const & first, InputIterator const & last) {
+        return Send_Data_Array(first, last, false, &schema);
+    }
+
   private:
 #if THINGSBOARD_ENABLE_DYNAMIC
     using IAPI_Container = Container<IAPI_Implementation *>;
+    using IAPI_Dispatch_Table = Topic_Dispatch_Table<IAPI_Implementation>;
 #else
     using IAPI_Container = Container<IAPI_Implementation *, MaxEndpointsAmount>;
+    using IAPI_Dispatch_Table = Topic_Dispatch_Table<IAPI_Implementation, MaxEndpointsAmount>;
 #endif // THINGSBOARD_ENABLE_DYNAMIC
 
-#if THINGSBOARD_ENABLE_STREAM_UTILS
+    /// @brief Inserts the response topic of the given API implementation into the dispatch table, so that received messages are forwarded to it
+    /// @note Only called once the API implementation has been initialized and the amount of subscribed API implementations has been checked,
+    /// which ensures the dispatch table never contains more API implementations than the container holding them
+    /// @param api API implementation whose response topic should be inserted
+    /// @return Whether inserting the response topic was successful or not, fails if the API implementation does not have a response topic or the dispatch table is full
+    bool Insert_API_Dispatch(IAPI_Implementation & api) {
+        bool exact = false;
+        char const * response_topic = api.Get_Response_Topic(exact);
+        if (!m_api_dispatch_table.Insert(response_topic, exact, &api)) {
+            Logger::printfln(UNABLE_TO_INSERT_API_DISPATCH, response_topic != nullptr ? response_topic : "");
+            return false;
+        }
+        return true;
+    }
+
     /// @brief Serializes key-value pairs from the given JsonDocument over the given topic directly into the underlying client
     /// @note The passed JsonDocument data circumvents the copy usually required and instead directly serializes the data into the outgoing MQTT buffer.
-    /// This reduces the memory footprint of sending data over MQTT but in exchange increases send times, because the data is sent in smaller packets and not as one big packet.
-    /// To increase the serialization speed the buffering_size argument in the constructor can be increased or with the @ref Set_Buffering_Size method
+    /// This reduces the memory footprint of sending data over MQTT but in exchange increases send times, because the data has to be measured beforehand and is then sent in smaller packets and not as one big packet.
+    /// To reduce the amount of packets the serialized bytes are combined in the internal send buffer, which is not needed for anything else while streaming, before they are written into the client
     /// @param topic Non owning pointer to topic that the message is sent over, where different MQTT topics expect a different kind of payload.
     /// Does not need to kept alive as the function copies the data into the outgoing MQTT buffer to publish the given payload
     /// @param source JsonDocument containing our json key-value pairs. See https://arduinojson.org/v6/api/jsondocument/ for more information
+    /// @param priority Priority class of the message, used to decide whether it is refused once the outbound high-water mark has been reached
+    /// @param data_point_amount Amount of telemetry data points contained in the source, consumed from the data point rate limits
     /// @return Whether seriaizing the payload contained in the source directly into the outgoing MQTT buffer, was successful or not
-    bool Serialize_Json(char const * topic, JsonDocument const & source) {
-        size_t const json_size = Helper::Measure_Json(source);
-        if (!m_client.begin_publish(topic, json_size - 1)) {
-            Logger::printfln(UNABLE_TO_SERIALIZE_JSON);
+    bool Serialize_Json(char const * topic, JsonDocument const & source, Publish_Priority priority, size_t const & data_point_amount) {
+        size_t const json_size = Helper::Measure_Json(source) - 1U;
+        return Stream_Payload(topic, priority, json_size, data_point_amount, [&source](Buffered_Publish_Writer & writer) {
+            return serializeJson(source, writer);
+        });
+    }
+
+    /// @brief Sends key-value pairs from the given JsonDocument over the given topic, in the given priority class
+    /// @note See @ref Send_Json for more information on how the JsonDocument is serialized and sent
+    /// @param topic Non owning pointer to topic that the message is sent over, where different MQTT topics expect a different kind of payload.
+    /// Does not need to kept alive as the function copies the data into the outgoing MQTT buffer to publish the given payload
+    /// @param source JsonDocument containing our json key-value pairs,
+    /// is checked before usage for any possible occuring internal errors. See https://arduinojson.org/v6/api/jsondocument/ for more information
+    /// @param priority Priority class the message is queued in, if an outbound queue has been configured for it
+    /// @return Whether copying the payload contained in the source into the outgoing MQTT buffer, was successful or not
+    bool Send_Prioritized_Json(char const * topic, JsonDocument const & source, Publish_Priority priority) {
+        // Check if allocating needed memory failed when trying to create the JsonDocument,
+        // if it did the isNull() method will return true. See https://arduinojson.org/v6/api/jsonvariant/isnull/ for more information
+        if (source.isNull()) {
+            Logger::printfln(UNABLE_TO_ALLOCATE_JSON);
+            return Set_Publish_Result(Publish_Result::OUT_OF_MEMORY);
+        }
+        // Check if inserting any of the internal values failed because the JsonDocument was too small,
+        // if it did the overflowed() method will return true. See https://arduinojson.org/v6/api/jsondocument/overflowed/ for more information
+        if (source.overflowed()) {
+            Logger::printfln(JSON_SIZE_TO_SMALL);
+            return Set_Publish_Result(Publish_Result::INVALID_PAYLOAD);
+        }
+
+        uint16_t const current_send_buffer_size = m_client.get_send_buffer_size();
+        // Send buffer size might have been changed directly on the client, without calling Set_Buffer_Size, therefore we ensure our internal buffer matches before we use it
+        if (m_send_buffer_size != Calculate_Send_Buffer_Size(current_send_buffer_size) && !Allocate_Send_Buffer(current_send_buffer_size)) {
+            Logger::printfln(UNABLE_TO_ALLOCATE_BUFFER);
+            return Set_Publish_Result(Publish_Result::OUT_OF_MEMORY);
+        }
+
+        // Internal buffer is one byte bigger than the send buffer size plus the null terminator, therefore if the written bytes are bigger than the send buffer size,
+        // we know the serialized payload has been truncated and would not have fit into the outgoing MQTT buffer, without the need to measure the JsonDocument beforehand
+        size_t const json_size = serializeJson(source, m_send_buffer, m_send_buffer_size);
+        size_t const data_point_amount = Calculate_Data_Point_Amount(topic, source);
+        if (json_size <= current_send_buffer_size) {
+            return Enqueue_Json_String(topic, m_send_buffer, json_size, priority, data_point_amount);
+        }
+        // Size of the given message would be too big for the actual client,
+        // therefore stream the serialized json directly into the client, so that the internal client buffer can be circumvented
+        return Serialize_Json(topic, source, priority, data_point_amount);
+    }
+
+    /// @brief Sends key-value pairs from the given json string over the given topic, in the given priority class
+    /// @param topic Non owning pointer to topic that the message is sent over, where different MQTT topics expect a different kind of payload.
+    /// Does not need to kept alive as the function copies the data into the outgoing MQTT buffer to publish the given payload
+    /// @param json Non owning pointer to the string containing serialized json key-value pairs that should be copied into the outgoing MQTT buffer.
+    /// Does not need to kept alive as the function copies the data into the outgoing MQTT buffer to publish the given payload
+    /// @param priority Priority class the message is queued in, if an outbound queue has been configured for it
+    /// @return Whether copying the payload contained in the json string into the outgoing MQTT buffer, was successful or not
+    bool Send_Prioritized_Json_String(char const * topic, char const * json, Publish_Priority priority) {
+        if (json == nullptr) {
+            return Set_Publish_Result(Publish_Result::INVALID_PAYLOAD);
+        }
+        return Enqueue_Json_String(topic, json, strlen(json), priority, Calculate_Data_Point_Amount(topic, json));
+    }
+
+    /// @brief Sends key-value pairs from the given JsonDocument over the given topic, in the control-plane priority class
+    /// @note Is passed to the API implementations, so that all their messages (server-side RPC responses, firmware state updates, ...) are published before queued telemetry and attribute data
+    /// @param topic Non owning pointer to topic that the message is sent over, where different MQTT topics expect a different kind of payload
+    /// @param source JsonDocument containing our json key-value pairs
+    /// @return Whether copying the payload contained in the source into the outgoing MQTT buffer, was successful or not
+    bool Send_Control_Json(char const * topic, JsonDocument const & source) {
+        return Send_Prioritized_Json(topic, source, Publish_Priority::CONTROL);
+    }
+
+    /// @brief Sends key-value pairs from the given json string over the given topic, in the control-plane priority class
+    /// @note Is passed to the API implementations, so that all their messages (server-side RPC responses, firmware state updates, ...) are published before queued telemetry and attribute data
+    /// @param topic Non owning pointer to topic that the message is sent over, where different MQTT topics expect a different kind of payload
+    /// @param json Non owning pointer to the string containing serialized json key-value pairs that should be copied into the outgoing MQTT buffer
+    /// @return Whether copying the payload contained in the json string into the outgoing MQTT buffer, was successful or not
+    bool Send_Control_Json_String(char const * topic, char const * json) {
+        return Send_Prioritized_Json_String(topic, json, Publish_Priority::CONTROL);
+    }
+
+    /// @brief Sends the given JsonDocument serialized as json and wrapped into the given length delimited field of an otherwise empty protobuf message over the given topic, in the control-plane priority class
+    /// @note Is passed to the API implementations, so that they can answer requests received as protobuf (server-side RPC responses, ...) without allocating a buffer for the encoded message themselves.
+    /// The tag, the size of the field and the serialized json are written directly into the internal send buffer, or streamed into the client if the encoded message is bigger than the send buffer size
+    /// @param topic Non owning pointer to topic that the message is sent over, where different MQTT topics expect a different kind of payload
+    /// @param field_number Number of the length delimited field the serialized json is written into
+    /// @param source JsonDocument containing our json key-value pairs
+    /// @return Whether copying the encoded message into the outgoing MQTT buffer, was successful or not
+    bool Send_Control_Protobuf_Json(char const * topic, uint32_t field_number, JsonDocument const & source) {
+        if (source.isNull()) {
+            Logger::printfln(UNABLE_TO_ALLOCATE_JSON);
+            return Set_Publish_Result(Publish_Result::OUT_OF_MEMORY);
+        }
+        if (source.overflowed()) {
+            Logger::printfln(JSON_SIZE_TO_SMALL);
+            return Set_Publish_Result(Publish_Result::INVALID_PAYLOAD);
+        }
+
+        uint16_t const current_send_buffer_size = m_client.get_send_buffer_size();
+        // Send buffer size might have been changed directly on the client, without calling Set_Buffer_Size, therefore we ensure our internal buffer matches before we use it
+        if (m_send_buffer_size != Calculate_Send_Buffer_Size(current_send_buffer_size) && !Allocate_Send_Buffer(current_send_buffer_size)) {
+            Logger::printfln(UNABLE_TO_ALLOCATE_BUFFER);
+            return Set_Publish_Result(Publish_Result::OUT_OF_MEMORY);
+        }
+
+        // Size of the serialized json is part of the encoded message in front of the json itself, therefore it has to be measured beforehand
+        size_t const json_size = Helper::Measure_Json(source) - 1U;
+        size_t const payload_size = Protobuf_Serializer::Get_Varint_Size(static_cast<uint64_t>(field_number) << 3U) + Protobuf_Serializer::Get_Varint_Size(json_size) + json_size;
+        size_t const data_point_amount = Calculate_Data_Point_Amount(topic, source);
+        if (payload_size <= current_send_buffer_size) {
+            Fixed_Buffer_Writer writer(m_send_buffer, m_send_buffer_size);
+            (void)Serialize_Protobuf_Json(writer, field_number, json_size, source);
+            return Enqueue_Json_String(topic, m_send_buffer, payload_size, Publish_Priority::CONTROL, data_point_amount);
+        }
+        return Stream_Payload(topic, Publish_Priority::CONTROL, payload_size, data_point_amount, [field_number, json_size, &source](Buffered_Publish_Writer & writer) {
+            return Serialize_Protobuf_Json(writer, field_number, json_size, source);
+        });
+    }
+
+    /// @brief Writes the given JsonDocument serialized as json into the given length delimited protobuf field
+    /// @tparam TWriter Writer class the field is written into
+    /// @param writer Writer the field is written into
+    /// @param field_number Number of the length delimited field the serialized json is written into
+    /// @param json_size Size of the serialized json, as measured beforehand
+    /// @param source JsonDocument containing our json key-value pairs
+    /// @return Amount of bytes that have been written
+    template<typename TWriter>
+    static size_t Serialize_Protobuf_Json(TWriter & writer, uint32_t const & field_number, size_t const & json_size, JsonDocument const & source) {
+        size_t const header_size = Protobuf_Serializer::Write_Tag(writer, field_number, Protobuf_Wire_Type::LENGTH_DELIMITED) + Protobuf_Serializer::Write_Varint(writer, json_size);
+        return header_size + serializeJson(source, writer);
+    }
+
+    /// @brief Streams a payload with the given size directly into the underlying client, where the given serializer writes the actual payload
+    /// @note The written bytes are combined in the internal send buffer, which is not needed for anything else while streaming, before they are written into the client to reduce the amount of packets.
+    /// Streamed payloads are never queued, therefore they are discarded instead of deferred if the rate limits configured with @ref Set_Rate_Limits have been reached
+    /// @tparam Serializer Callable that writes the payload into the given @ref Buffered_Publish_Writer and returns the amount of bytes written
+    /// @param topic Non owning pointer to topic that the message is sent over, where different MQTT topics expect a different kind of payload.
+    /// Does not need to kept alive as the function copies the data into the outgoing MQTT buffer to publish the given payload
+    /// @param priority Priority class of the message, used to decide whether it is refused once the outbound high-water mark has been reached and which quality of service it is published with
+    /// @param payload_size Exact amount of bytes the serializer is going to write, has to be known beforehand because it is part of the MQTT header, that is sent before the payload itself
+    /// @param data_point_amount Amount of telemetry data points contained in the payload, consumed from the data point rate limits
+    /// @param serializer Callable writing the payload
+    /// @return Whether streaming the complete payload into the outgoing MQTT buffer, was successful or not
+    template<typename Serializer>
+    bool Stream_Payload(char const * topic, Publish_Priority priority, size_t const & payload_size, size_t const & data_point_amount, Serializer serializer) {
+#if THINGSBOARD_ENABLE_DEBUG
+        Logger::printfln(SEND_MESSAGE, topic, SEND_SERIALIZED);
+#endif // THINGSBOARD_ENABLE_DEBUG
+        if (Would_Block(priority, payload_size) || Would_Exceed_In_Flight_Window(priority, payload_size)) {
+            return Set_Publish_Result(Publish_Result::WOULD_BLOCK);
+        }
+        else if (!Consume_Rate_Limits(data_point_amount)) {
+            Logger::printfln(RATE_LIMIT_EXCEEDED, data_point_amount);
+            return Set_Publish_Result(Publish_Result::RATE_LIMITED);
+        }
+        Select_Publish_QoS(priority);
+        if (!m_client.begin_publish(topic, payload_size)) {
+            Logger::printfln(UNABLE_TO_STREAM_PAYLOAD, payload_size, m_client.get_send_buffer_size());
+            return Set_Publish_Result(Get_Client_Failure());
+        }
+        Buffered_Publish_Writer writer(m_client, reinterpret_cast<uint8_t *>(m_send_buffer), m_send_buffer_size);
+        bool const result = serializer(writer) == payload_size && writer.flush();
+        // End publish is called even if writing failed, to ensure the client releases any resources it acquired in the begin_publish() call
+        if (!m_client.end_publish() || !result) {
+            Logger::printfln(UNABLE_TO_STREAM_PAYLOAD, payload_size, m_client.get_send_buffer_size());
+            return Set_Publish_Result(Get_Client_Failure());
+        }
+        Track_Delivery(priority);
+        return Set_Publish_Result(Publish_Result::SUCCESS);
+    }
+
+    /// @brief Calculates the size of the internal send buffer for the given send buffer size of the client
+    /// @note Contains one additional byte to the send buffer size and the null terminator, which allows to detect if the serialized payload is bigger than the send buffer size,
+    /// because serializeJson truncates the payload to the given buffer size. Meaning if the written amount of bytes is bigger than the send buffer size, the payload was too big
+    /// @param send_buffer_size Maximum amount of data that can be sent via MQTT at once
+    /// @return Size in bytes of the internal send buffer
+    static size_t Calculate_Send_Buffer_Size(uint16_t send_buffer_size) {
+        return send_buffer_size + 2U;
+    }
+
+    /// @brief Allocates the internal send buffer that all messages are serialized into before they are published
+    /// @note If the internal send buffer has already been allocated with the same size it is simply reused instead
+    /// @param send_buffer_size Maximum amount of data that can be sent via MQTT at once
+    /// @return Whether allocating the internal send buffer was successful or not
+    bool Allocate_Send_Buffer(uint16_t send_buffer_size) {
+        size_t const buffer_size = Calculate_Send_Buffer_Size(send_buffer_size);
+        if (m_send_buffer != nullptr && m_send_buffer_size == buffer_size) {
+            return true;
+        }
+        Free_Send_Buffer();
+        m_send_buffer = new char[buffer_size]();
+        if (m_send_buffer == nullptr) {
             return false;
         }
-        BufferingPrint buffered_print(m_client, Get_Buffering_Size());
-        auto const bytes_serialized = serializeJson(source, buffered_print);
-        if (bytes_serialized < json_size - 1) {
-            Logger::printfln(UNABLE_TO_SERIALIZE_JSON);
+        m_send_buffer_size = buffer_size;
+        return true;
+    }
+
+    /// @brief Allocates the memory the decisions of the report filter are stored in, so that the filter only has to be asked once per key-value pair when it is counted, serialized and reported
+    /// @note If the memory has already been allocated for atleast the given amount of key-value pairs it is simply reused instead, meaning it only grows if more key-value pairs than ever before are sent at once
+    /// @param amount Amount of key-value pairs that are sent at once
+    /// @return Whether allocating the memory was successful or not
+    bool Allocate_Report_Decisions(size_t const & amount) {
+        if (amount <= m_report_decisions_size) {
+            return true;
+        }
+        bool * decisions = new bool[amount];
+        if (decisions == nullptr) {
             return false;
         }
-        buffered_print.flush();
-        return m_client.end_publish();
+        delete[] m_report_decisions;
+        m_report_decisions = decisions;
+        m_report_decisions_size = amount;
+        return true;
+    }
+
+    /// @brief Frees the internal send buffer that all messages are serialized into before they are published
+    void Free_Send_Buffer() {
+        delete[] m_send_buffer;
+        m_send_buffer = nullptr;
+        m_send_buffer_size = 0U;
+    }
+
+    /// @brief Frees the memory holding the coalesced telemetry key-value pairs and therefore disables telemetry coalescing
+    void Free_Coalescing_Buffer() {
+        delete[] m_coalesced_telemetry;
+        m_coalesced_telemetry = nullptr;
+        delete[] m_coalescing_arena;
+        m_coalescing_arena = nullptr;
+        m_coalescing_arena_size = 0U;
+        m_coalescing_arena_used = 0U;
+        m_coalescing_max_amount = 0U;
+        m_coalesced_amount = 0U;
+        m_coalesced_size = 0U;
+    }
+
+    /// @brief Calculates the amount of bytes the given key-value pair adds to the coalesced telemetry json object
+    /// @note Is the size of the serialized key-value pair plus 1 byte for either the comma seperating it from the other key-value pairs or one of the braces.
+    /// Meaning the size of the complete json object is the sum of all key-value pairs plus 1 byte for the remaining brace
+    /// @param data Key-value pair that should be measured
+    /// @return Amount of bytes the key-value pair adds to the coalesced telemetry json object or 0 if the key-value pair could not be serialized
+    static size_t Calculate_Coalesced_Size(Telemetry const & data) {
+        Fixed_Buffer_Writer writer(nullptr, 0U);
+        size_t const size = data.SerializeJson(writer);
+        return size != 0U ? size + 1U : 0U;
+    }
+
+    /// @brief Copies the key and the string value of the given key-value pair into the memory owned by the client, that holds them until the merged key-value pairs have been sent
+    /// @note Memory of replaced string values is only released once the merged key-value pairs have been sent, therefore copying fails if the remaining memory has been used up by replaced values
+    /// @param data Key-value pair that should be copied
+    /// @param key Non owning pointer to an already copied key that should be reused, nullptr if the key should be copied as well
+    /// @param owned Set to the key-value pair referencing the copied key and string value
+    /// @return Whether copying was successful or not, fails as well for key-value pairs referencing a buffer of samples, because those are never copied
+    bool Copy_Into_Coalescing_Arena(Telemetry const & data, char const * key, Telemetry & owned) {
+        if (!Is_Coalescable(data)) {
+            return false;
+        }
+        char const * string = nullptr;
+        bool const is_string = data.GetString(string);
+        size_t const key_size = key == nullptr ? strlen(data.GetKey()) + 1U : 0U;
+        size_t const string_size = is_string && string != nullptr ? strlen(string) + 1U : 0U;
+        if (key_size + string_size > m_coalescing_arena_size - m_coalescing_arena_used) {
+            return false;
+        }
+        if (key == nullptr) {
+            char * const copied_key = m_coalescing_arena + m_coalescing_arena_used;
+            (void)memcpy(copied_key, data.GetKey(), key_size);
+            m_coalescing_arena_used += key_size;
+            key = copied_key;
+        }
+        if (string_size != 0U) {
+            char * const copied_string = m_coalescing_arena + m_coalescing_arena_used;
+            (void)memcpy(copied_string, string, string_size);
+            m_coalescing_arena_used += string_size;
+            string = copied_string;
+        }
+
+        int64_t integer = {};
+        double real = {};
+        bool boolean = {};
+        if (is_string) {
+            owned = Telemetry(key, string);
+        }
+        else if (data.GetInteger(integer)) {
+            owned = Telemetry(key, integer);
+        }
+        else if (data.GetReal(real)) {
+            owned = Telemetry(key, real, data.GetDecimalPlaces());
+        }
+        else if (data.GetBoolean(boolean)) {
+            owned = Telemetry(key, boolean);
+        }
+        return true;
+    }
+
+    /// @brief Whether the given key-value pair can be merged with the other coalesced telemetry key-value pairs
+    /// @param data Key-value pair that should be checked
+    /// @return Whether the key-value pair contains a single integral, floating point, boolean or string value, key-value pairs referencing a buffer of samples can not be merged, because the samples are never copied
+    static bool Is_Coalescable(Telemetry const & data) {
+        int64_t integer = {};
+        double real = {};
+        bool boolean = {};
+        char const * string = nullptr;
+        return data.GetInteger(integer) || data.GetReal(real) || data.GetBoolean(boolean) || data.GetString(string);
+    }
+
+    /// @brief Merges the given key-value pair with the other coalesced telemetry key-value pairs, replacing the value of an already merged key-value pair with the same key
+    /// @note If the key-value pair can not be merged, because the maximum amount of key-value pairs, the send buffer size or the memory holding the copied keys and string values would be exceeded, the currently merged key-value pairs are sent first.
+    /// Key-value pairs that are too big to ever be merged, as well as key-value pairs referencing a buffer of samples, are sent immediately instead
+    /// @param data Key-value pair that should be merged, the key and string values are copied and do not need to be kept alive
+    /// @return Whether merging or sending the key-value pair was successful or not
+    bool Coalesce_Telemetry(Telemetry const & data) {
+        size_t const size = Calculate_Coalesced_Size(data);
+        if (size == 0U) {
+            Logger::printfln(UNABLE_TO_SERIALIZE);
+            return Set_Publish_Result(Publish_Result::INVALID_PAYLOAD);
+        }
+        uint16_t const current_send_buffer_size = m_client.get_send_buffer_size();
+        if (!Is_Coalescable(data) || size + 1U > current_send_buffer_size) {
+            // Flushed beforehand to ensure the key-value pair is not overwritten by an earlier value with the same key, that would otherwise be sent afterwards
+            bool const result = Flush_Telemetry();
+            return Send_Data_Array(&data, &data + 1U, true) && result;
+        }
+
+        size_t index = 0U;
+        for (; index < m_coalesced_amount; index++) {
+            if (strcmp(m_coalesced_telemetry[index].GetKey(), data.GetKey()) == 0) {
+                break;
+            }
+        }
+        bool const replace = index < m_coalesced_amount;
+        size_t const replaced_size = replace ? Calculate_Coalesced_Size(m_coalesced_telemetry[index]) : 0U;
+        size_t const coalesced_size = (m_coalesced_size == 0U ? 1U : m_coalesced_size) - replaced_size + size;
+        bool result = true;
+        if ((!replace && m_coalesced_amount >= m_coalescing_max_amount) || coalesced_size > current_send_buffer_size) {
+            result = Flush_Telemetry();
+            index = 0U;
+        }
+        Telemetry owned;
+        if (!Copy_Into_Coalescing_Arena(data, index < m_coalesced_amount ? m_coalesced_telemetry[index].GetKey() : nullptr, owned)) {
+            // Memory is used up by replaced string values or the send buffer size has been increased since it was allocated, sending the merged key-value pairs releases it again
+            result = Flush_Telemetry() && result;
+            index = 0U;
+            if (!Copy_Into_Coalescing_Arena(data, nullptr, owned)) {
+                return Send_Data_Array(&data, &data + 1U, true) && result;
+            }
+        }
+
+        if (m_coalesced_amount == 0U) {
+            m_coalescing_start = Helper::Get_Milliseconds();
+            m_coalesced_size = 1U + size;
+            m_coalesced_amount = 1U;
+        }
+        else if (index < m_coalesced_amount) {
+            m_coalesced_size = coalesced_size;
+        }
+        else {
+            m_coalesced_size = coalesced_size;
+            m_coalesced_amount++;
+        }
+        m_coalesced_telemetry[index] = owned;
+        if (!result) {
+            return false;
+        }
+        return Set_Publish_Result(Publish_Result::SUCCESS);
+    }
+
+    /// @brief Publishes the given already serialized json string payload over the given topic
+    /// @param topic Non owning pointer to topic that the message is sent over, where different MQTT topics expect a different kind of payload.
+    /// Does not need to kept alive as the function copies the data into the outgoing MQTT buffer to publish the given payload
+    /// @param json Non owning pointer to the null terminated string containing serialized json key-value pairs that should be copied into the outgoing MQTT buffer.
+    /// Does not need to kept alive as the function copies the data into the outgoing MQTT buffer to publish the given payload
+    /// @param json_size Length of the given json string without the null terminator, is passed so the length does not need to be measured again with strlen
+    /// @param priority Priority class of the message, decides the quality of service it is published with
+    /// @return Whether copying the payload contained in the json string into the outgoing MQTT buffer, was successful or not, fails without publishing if the in-flight window is full
+    bool Publish_Json_String(char const * topic, char const * json, size_t const & json_size, Publish_Priority priority) {
+#if THINGSBOARD_ENABLE_DEBUG
+        // Protobuf messages are binary and not null terminated inside the payload, therefore only their size is shown.
+        // Json payloads always start with an opening brace or bracket, which is never the first byte of a protobuf message, because it would be the deprecated group wire type
+        if (json_size != 0U && (json[0] == '{' || json[0] == '[')) {
+            Logger::printfln(SEND_MESSAGE, topic, json);
+        }
+        else {
+            Logger::printfln(SEND_BINARY_MESSAGE, json_size, topic);
+        }
+#endif // THINGSBOARD_ENABLE_DEBUG
+        if (Would_Exceed_In_Flight_Window(priority, json_size)) {
+            return Set_Publish_Result(Publish_Result::WOULD_BLOCK);
+        }
+        uint8_t const * payload = reinterpret_cast<uint8_t const *>(json);
+        uint16_t const current_send_buffer_size = m_client.get_send_buffer_size();
+        Select_Publish_QoS(priority);
+        if (json_size <= current_send_buffer_size) {
+            if (!m_client.publish(topic, payload, json_size)) {
+                return Set_Publish_Result(Get_Client_Failure());
+            }
+            Track_Delivery(priority);
+            return Set_Publish_Result(Publish_Result::SUCCESS);
+        }
+
+        // Payload is already serialized, therefore there is no need to combine the written bytes and it can instead be directly written into the client as one chunk
+        if (!m_client.begin_publish(topic, json_size)) {
+            Logger::printfln(UNABLE_TO_STREAM_PAYLOAD, json_size, current_send_buffer_size);
+            return Set_Publish_Result(Get_Client_Failure());
+        }
+        bool const result = m_client.write(payload, json_size) == json_size;
+        // End publish is called even if writing failed, to ensure the client releases any resources it acquired in the begin_publish() call
+        if (!m_client.end_publish() || !result) {
+            Logger::printfln(UNABLE_TO_STREAM_PAYLOAD, json_size, current_send_buffer_size);
+            return Set_Publish_Result(Get_Client_Failure());
+        }
+        Track_Delivery(priority);
+        return Set_Publish_Result(Publish_Result::SUCCESS);
+    }
+
+    /// @brief Stores the given result as the result of the last attempt to send data, see @ref Get_Last_Publish_Result
+    /// @param result Result of the current attempt to send data
+    /// @return Whether the result is a success, allows to directly return the value from the send methods
+    bool Set_Publish_Result(Publish_Result result) {
+        m_last_publish_result = result;
+        return result == Publish_Result::SUCCESS;
+    }
+
+    /// @brief Deduces why the client refused a message
+    /// @return NOT_CONNECTED if the client is currently not connected, CLIENT_ERROR otherwise
+    Publish_Result Get_Client_Failure() {
+        return m_client.connected() ? Publish_Result::CLIENT_ERROR : Publish_Result::NOT_CONNECTED;
+    }
+
+    /// @brief Whether a new message of the given priority class has to be refused, because the outbound backlog reached the high-water mark configured with @ref Set_Outbound_High_Water_Mark
+    /// @param priority Priority class of the message, messages of the CONTROL class are never refused
+    /// @param payload_size Size of the message in bytes, only used to inform the user about the discarded message
+    /// @return Whether the message has to be refused
+    bool Would_Block(Publish_Priority priority, size_t const & payload_size) {
+        if (m_outbound_high_water_mark == 0U || priority == Publish_Priority::CONTROL) {
+            return false;
+        }
+        size_t const backlog_size = Get_Outbound_Backlog_Size();
+        if (backlog_size < m_outbound_high_water_mark) {
+            return false;
+        }
+        Logger::printfln(OUTBOUND_BACKLOG_FULL, backlog_size, m_outbound_high_water_mark, payload_size);
+        return true;
+    }
+
+    /// @brief Whether queued messages of the given priority class have to be kept in their queue, because the outbox of the client alone reached the high-water mark configured with @ref Set_Outbound_High_Water_Mark
+    /// @param priority Priority class of the queued messages, messages of the CONTROL class are never kept
+    /// @return Whether the queued messages have to be kept
+    bool Is_Outbox_Full(Publish_Priority priority) {
+        return m_outbound_high_water_mark != 0U && priority != Publish_Priority::CONTROL && m_client.get_outbox_size() >= m_outbound_high_water_mark;
+    }
+
+    /// @brief Whether a new message of the given priority class has to be refused, because it is published with QoS 1 and the in-flight window configured with @ref Set_In_Flight_Window is full
+    /// @param priority Priority class of the message, messages of classes published with QoS 0 are never refused
+    /// @param payload_size Size of the message in bytes, only used to inform the user about the discarded message
+    /// @return Whether the message has to be refused
+    bool Would_Exceed_In_Flight_Window(Publish_Priority priority, size_t const & payload_size) {
+        if (!Is_In_Flight_Window_Full(priority)) {
+            return false;
+        }
+        Logger::printfln(IN_FLIGHT_WINDOW_FULL, m_in_flight_amount, payload_size);
+        return true;
+    }
+
+    /// @brief Whether queued messages of the given priority class have to be kept in their queue, because they are published with QoS 1 and the in-flight window configured with @ref Set_In_Flight_Window is full
+    /// @param priority Priority class of the queued messages
+    /// @return Whether the queued messages have to be kept
+    bool Is_In_Flight_Window_Full(Publish_Priority priority) const {
+        return m_publish_qos[static_cast<size_t>(priority)] != MQTT_QoS::AT_MOST_ONCE && m_in_flight_amount >= m_in_flight_window;
+    }
+
+    /// @brief Changes the quality of service of the client to the one configured for the given priority class with @ref Set_Publish_QoS, has to be called before every publish() or begin_publish() call
+    /// @note The client is only informed if the quality of service actually changed, because most of the time all messages are published with the same quality of service
+    /// @param priority Priority class of the message that is published next
+    void Select_Publish_QoS(Publish_Priority priority) {
+        MQTT_QoS const qos = m_publish_qos[static_cast<size_t>(priority)];
+        if (qos == m_client_qos) {
+            return;
+        }
+        (void)m_client.set_publish_qos(qos);
+        m_client_qos = qos;
+    }
+
+    /// @brief Adds the packet id of the message that has just been published successfully to the in-flight window, if it was published with QoS 1
+    /// @note Every method publishing a message with QoS 1 ensures the window is not full beforehand and the window is only ever changed from the task publishing messages and calling loop(),
+    /// therefore the packet id always fits. The confirmation of the broker might already have been received from the task of the client, but it is only handed over in the next call to loop(),
+    /// meaning the packet id is always added to the window before it is removed again
+    /// @param priority Priority class of the message that has just been published
+    void Track_Delivery(Publish_Priority priority) {
+        if (m_publish_qos[static_cast<size_t>(priority)] == MQTT_QoS::AT_MOST_ONCE) {
+            return;
+        }
+        uint16_t const packet_id = m_client.get_last_packet_id();
+        if (packet_id == 0U) {
+            return;
+        }
+        m_last_packet_id = packet_id;
+        m_in_flight_packet_ids[m_in_flight_amount++] = packet_id;
+    }
+
+    /// @brief Removes the given packet id from the in-flight window, by replacing it with the last packet id in the window, because the order of the packet ids is not relevant
+    /// @param packet_id Packet id of the message that has been confirmed or dropped
+    /// @return Whether the packet id was contained in the window or not
+    bool Remove_In_Flight_Packet_ID(uint16_t packet_id) {
+        for (size_t i = 0U; i < m_in_flight_amount; i++) {
+            if (m_in_flight_packet_ids[i] == packet_id) {
+                m_in_flight_packet_ids[i] = m_in_flight_packet_ids[--m_in_flight_amount];
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// @brief Callback that will be called upon the client confirming or dropping a message published with QoS 1, might be called from the task of the client
+    /// @note Only queues the report, which is handed over to the task calling loop() in @ref Handle_Delivery_Reports, to ensure the in-flight window is never changed from two tasks at once
+    /// @param packet_id Packet id of the message that has been confirmed or dropped
+    /// @param delivered Whether the message has been confirmed by the broker (true) or dropped by the client (false)
+    void On_MQTT_Delivery(uint16_t packet_id, bool delivered) {
+        if (!m_delivery_reports.push(packet_id, delivered)) {
+            Logger::printfln(DELIVERY_REPORT_QUEUE_FULL, packet_id);
+        }
+    }
+
+    /// @brief Takes over the delivery reports queued by @ref On_MQTT_Delivery since the last call, frees the place of every confirmed or dropped message in the in-flight window and informs the user
+    void Handle_Delivery_Reports() {
+        uint16_t packet_id = 0U;
+        bool delivered = false;
+        while (m_delivery_reports.pop(packet_id, delivered)) {
+            (void)Remove_In_Flight_Packet_ID(packet_id);
+            Handle_Persistent_Delivery(packet_id, delivered);
+            // Packet id does not tell which attributes were contained in the dropped message, therefore all of them are sent again
+            m_attribute_resync = m_attribute_resync || !delivered;
+            m_delivery_callback.Call_Callback(packet_id, delivered);
+        }
+    }
+
+    /// @brief Removes the replayed persisted messages from the persistent log configured with @ref Set_Persistent_Store, once the broker confirmed them and every older replayed message
+    /// @note The log can only be read in the order the messages were stored in, therefore a dropped message is replayed again by replaying every message that has not been removed yet again
+    /// @param packet_id Packet id of the message that has been confirmed or dropped, messages that have not been replayed from the log are ignored
+    /// @param delivered Whether the message has been confirmed by the broker (true) or dropped by the client (false)
+    void Handle_Persistent_Delivery(uint16_t packet_id, bool delivered) {
+        size_t index = 0U;
+        while (index < m_persistent_in_flight && m_persistent_packet_ids[index] != packet_id) {
+            index++;
+        }
+        if (index == m_persistent_in_flight) {
+            return;
+        }
+        else if (!delivered) {
+            m_persistent_log.rewind();
+            m_persistent_in_flight = 0U;
+            return;
+        }
+        m_persistent_packet_ids[index] = 0U;
+        size_t removed = 0U;
+        while (removed < m_persistent_in_flight && m_persistent_packet_ids[removed] == 0U && m_persistent_log.pop()) {
+            removed++;
+        }
+        m_persistent_in_flight -= removed;
+        (void)memmove(m_persistent_packet_ids, m_persistent_packet_ids + removed, m_persistent_in_flight * sizeof(uint16_t));
+    }
+
+    /// @brief Returns the priority class messages sent over the given topic by the user are sorted into
+    /// @note Messages sent by the API implementations are always sorted into the CONTROL class instead, even if they are sent over the telemetry topic (firmware state updates)
+    /// @param topic Non owning pointer to topic that the message is sent over
+    /// @return BULK for telemetry data, NORMAL for attribute data and CONTROL for every other topic (claiming requests)
+    static Publish_Priority Get_Topic_Priority(char const * topic) {
+        if (topic != nullptr && strcmp(topic, TELEMETRY_TOPIC) == 0) {
+            return Publish_Priority::BULK;
+        }
+        else if (topic != nullptr && strcmp(topic, ATTRIBUTE_TOPIC) == 0) {
+            return Publish_Priority::NORMAL;
+        }
+        return Publish_Priority::CONTROL;
+    }
+
+    /// @brief Copies the given already serialized json string payload into the outbound queue of the given priority class, or publishes it immediately if no queue has been configured for the class
+    /// @param topic Non owning pointer to topic that the message is sent over, where different MQTT topics expect a different kind of payload.
+    /// Does not need to kept alive as the function copies the topic into the outbound queue or the outgoing MQTT buffer
+    /// @param json Non owning pointer to the string containing serialized json key-value pairs.
+    /// Does not need to kept alive as the function copies the payload into the outbound queue or the outgoing MQTT buffer
+    /// @param json_size Length of the given json string without the null terminator
+    /// @param priority Priority class the message is queued in
+    /// @param data_point_amount Amount of telemetry data points contained in the payload, consumed from the data point rate limits once the message is published
+    /// @return Whether copying the payload into the outbound queue or the outgoing MQTT buffer, was successful or not
+    bool Enqueue_Json_String(char const * topic, char const * json, size_t const & json_size, Publish_Priority priority, size_t const & data_point_amount) {
+        Outbound_Queue & queue = m_outbound_queues[static_cast<size_t>(priority)];
+        // Payloads that are bigger than the send buffer size have to be streamed, therefore queueing them would only delay them without being able to publish them any faster
+        if (Would_Block(priority, json_size)) {
+            return Set_Publish_Result(Publish_Result::WOULD_BLOCK);
+        }
+        else if (Should_Persist(priority)) {
+            if (!m_persistent_log.push(priority, m_persistent_time_callback.Call_Callback(), data_point_amount, reinterpret_cast<uint8_t const *>(json), json_size)) {
+                Logger::printfln(PERSISTENT_LOG_FULL, json_size);
+                return Set_Publish_Result(Publish_Result::QUEUE_FULL);
+            }
+            return Set_Publish_Result(Publish_Result::SUCCESS);
+        }
+        else if (!queue.Is_Allocated() || json_size > m_client.get_send_buffer_size()) {
+            if (Would_Exceed_In_Flight_Window(priority, json_size)) {
+                return Set_Publish_Result(Publish_Result::WOULD_BLOCK);
+            }
+            else if (!Consume_Rate_Limits(data_point_amount)) {
+                Logger::printfln(RATE_LIMIT_EXCEEDED, data_point_amount);
+                return Set_Publish_Result(Publish_Result::RATE_LIMITED);
+            }
+            return Publish_Json_String(topic, json, json_size, priority);
+        }
+        else if (!queue.push(topic, json, json_size, data_point_amount)) {
+            Logger::printfln(OUTBOUND_QUEUE_FULL, static_cast<uint8_t>(priority), json_size);
+            return Set_Publish_Result(Publish_Result::QUEUE_FULL);
+        }
+        return Set_Publish_Result(Publish_Result::SUCCESS);
+    }
+
+    /// @brief Publishes the oldest messages waiting in the outbound queue of the given priority class
+    /// @note Messages are kept in the queue while the client is disconnected, the rate limits configured with @ref Set_Rate_Limits have been reached
+    /// the outbox of the client reached the high-water mark configured with @ref Set_Outbound_High_Water_Mark or the in-flight window configured with @ref Set_In_Flight_Window is full, so that they are published later on instead.
+    /// Messages that could not be published even though the client is connected are discarded instead, to ensure a single broken message does not block the queue forever.
+    /// Whereas messages that could not be published, because the connection was lost while publishing them, are kept in the queue
+    /// @param priority Priority class of the outbound queue the messages should be published from
+    /// @param max_messages Maximum amount of messages that should be published, a value of 0 publishes all queued messages
+    /// @return Amount of messages that have been removed from the queue
+    size_t Drain_Outbound_Queue(Publish_Priority priority, size_t const & max_messages) {
+        Outbound_Queue & queue = m_outbound_queues[static_cast<size_t>(priority)];
+        size_t drained = 0U;
+        char const * topic = nullptr;
+        char const * payload = nullptr;
+        size_t payload_size = 0U;
+        size_t data_point_amount = 0U;
+        while ((max_messages == 0U || drained < max_messages) && queue.front(topic, payload, payload_size, data_point_amount)) {
+            if (!m_client.connected() || Is_Outbox_Full(priority) || Is_In_Flight_Window_Full(priority) || !Consume_Rate_Limits(data_point_amount)) {
+                break;
+            }
+            else if (!Publish_Json_String(topic, payload, payload_size, priority)) {
+                if (!m_client.connected()) {
+                    // Connection was lost while publishing, therefore the message is kept in the queue and published once the client has reconnected
+                    break;
+                }
+                Logger::printfln(UNABLE_TO_PUBLISH_QUEUED, topic);
+            }
+            queue.pop();
+            drained++;
+        }
+        return drained;
+    }
+
+    /// @brief Publishes the messages waiting in all outbound queues, where all messages of a higher priority class are published before any message of a lower priority class
+    /// @param max_messages Maximum amount of messages that should be published over all queues combined, a value of 0 publishes all queued messages
+    /// @return Whether all outbound queues are empty afterwards
+    bool Drain_Outbound_Queues(size_t const & max_messages) {
+        size_t drained = 0U;
+        bool result = true;
+        for (size_t i = 0U; i < PUBLISH_PRIORITY_AMOUNT; i++) {
+            if (max_messages == 0U || drained < max_messages) {
+                drained += Drain_Outbound_Queue(static_cast<Publish_Priority>(i), max_messages == 0U ? 0U : max_messages - drained);
+            }
+            result = result && m_outbound_queues[i].empty();
+        }
+        return result;
+    }
+
+    /// @brief Whether a message of the given priority class has to be appended to the persistent log configured with @ref Set_Persistent_Store, instead of being queued or published
+    /// @param priority Priority class of the message, messages of the CONTROL class are never persisted, because replies of the API implementations are only meaningful while connected
+    /// @return Whether the client is disconnected or the log still contains older messages, that the message is not allowed to overtake
+    bool Should_Persist(Publish_Priority priority) {
+        return m_persistent_log.Is_Open() && priority != Publish_Priority::CONTROL && (!m_client.connected() || !m_persistent_log.empty());
+    }
+
+    /// @brief Replays the oldest messages stored in the persistent log configured with @ref Set_Persistent_Store, once the client has reconnected
+    /// @note Messages are kept in the log while the client is disconnected, the rate limits configured with @ref Set_Rate_Limits have been reached
+    /// the outbox of the client reached the high-water mark configured with @ref Set_Outbound_High_Water_Mark or the in-flight window configured with @ref Set_In_Flight_Window is full, so that they are replayed later on instead.
+    /// Messages published with QoS 1 are kept in the log until their delivery report has been handled in @ref Handle_Persistent_Delivery, every other message is removed immediately if no older replayed message is still kept.
+    /// Messages that could not be published even though the client is connected are discarded instead, to ensure a single broken message does not block the log forever
+    /// @param max_messages Maximum amount of messages that should be replayed, a value of 0 replays all stored messages
+    /// @return Amount of messages that have been replayed or discarded
+    size_t Replay_Persistent_Log(size_t const & max_messages) {
+        size_t replayed = 0U;
+        Persistent_Record record = {};
+        while (m_persistent_replay && (max_messages == 0U || replayed < max_messages) && m_persistent_log.next(record)) {
+            if (!m_client.connected()) {
+                // Replay is only started again once the connect callback has been called, to ensure the permanent subscriptions have been restored beforehand
+                m_persistent_replay = false;
+                break;
+            }
+            else if (Is_Outbox_Full(record.priority) || Is_In_Flight_Window_Full(record.priority) || (m_persistent_in_flight != 0U && m_persistent_in_flight >= m_in_flight_window) || !Consume_Rate_Limits(record.data_point_amount)) {
+                break;
+            }
+            size_t const in_flight_amount = m_in_flight_amount;
+            if (!Publish_Persistent_Record(record)) {
+                if (!m_client.connected()) {
+                    m_persistent_replay = false;
+                    break;
+                }
+                Logger::printfln(UNABLE_TO_REPLAY_PERSISTED, record.payload_size);
+            }
+            // Messages that do not have to be confirmed are still kept while older messages are waiting for their confirmation, because the log can only remove messages in order
+            uint16_t const packet_id = m_in_flight_amount != in_flight_amount ? m_last_packet_id : 0U;
+            if (packet_id == 0U && m_persistent_in_flight == 0U) {
+                if (!m_persistent_log.pop()) {
+                    break;
+                }
+            }
+            else if (!m_persistent_log.advance()) {
+                break;
+            }
+            else {
+                m_persistent_packet_ids[m_persistent_in_flight++] = packet_id;
+            }
+            replayed++;
+        }
+        return replayed;
+    }
+
+    /// @brief Publishes the oldest message stored in the persistent log, telemetry data with a timestamp is wrapped into the timestamped form {"ts":1451649600512,"values":{...}}
+    /// @note The payload is read directly from the storage into the internal send buffer. If the payload including the timestamp does not fit, it is instead read in parts into the send buffer and streamed into the client
+    /// @param record Metadata of the oldest stored message
+    /// @return Whether publishing the message was successful or not
+    bool Publish_Persistent_Record(Persistent_Record const & record) {
+        uint16_t const current_send_buffer_size = m_client.get_send_buffer_size();
+        if (m_send_buffer_size != Calculate_Send_Buffer_Size(current_send_buffer_size) && !Allocate_Send_Buffer(current_send_buffer_size)) {
+            Logger::printfln(UNABLE_TO_ALLOCATE_BUFFER);
+            return false;
+        }
+        char const * topic = record.priority == Publish_Priority::BULK ? TELEMETRY_TOPIC : ATTRIBUTE_TOPIC;
+        char prefix[PERSISTENT_TIMESTAMP_PREFIX_SIZE] = {};
+        size_t prefix_size = 0U;
+        if (record.priority == Publish_Priority::BULK && record.timestamp != 0U && Is_Json_Object_Without_Timestamp(record.payload_size)) {
+            Fixed_Buffer_Writer writer(prefix, sizeof(prefix));
+            prefix_size = Json_Serializer::Write_Raw(writer, PERSISTENT_TIMESTAMP_KEY, strlen(PERSISTENT_TIMESTAMP_KEY));
+            prefix_size += Json_Serializer::Write_Unsigned_Integer(writer, record.timestamp);
+            prefix_size += Json_Serializer::Write_Raw(writer, PERSISTENT_VALUES_KEY, strlen(PERSISTENT_VALUES_KEY));
+        }
+        size_t const suffix_size = prefix_size != 0U ? 1U : 0U;
+        size_t const json_size = prefix_size + record.payload_size + suffix_size;
+
+        if (json_size <= current_send_buffer_size) {
+            (void)memcpy(m_send_buffer, prefix, prefix_size);
+            if (!m_persistent_log.read(0U, reinterpret_cast<uint8_t *>(m_send_buffer + prefix_size), record.payload_size)) {
+                return false;
+            }
+            (void)memset(m_send_buffer + prefix_size + record.payload_size, '}', suffix_size);
+            m_send_buffer[json_size] = '\0';
+            return Publish_Json_String(topic, m_send_buffer, json_size, record.priority);
+        }
+
+        if (Would_Exceed_In_Flight_Window(record.priority, json_size)) {
+            return false;
+        }
+        Select_Publish_QoS(record.priority);
+        if (!m_client.begin_publish(topic, json_size)) {
+            Logger::printfln(UNABLE_TO_STREAM_PAYLOAD, json_size, current_send_buffer_size);
+            return false;
+        }
+        bool result = m_client.write(reinterpret_cast<uint8_t const *>(prefix), prefix_size) == prefix_size;
+        for (size_t offset = 0U; result && offset < record.payload_size; offset += m_send_buffer_size) {
+            size_t const chunk_size = record.payload_size - offset < m_send_buffer_size ? record.payload_size - offset : m_send_buffer_size;
+            uint8_t * chunk = reinterpret_cast<uint8_t *>(m_send_buffer);
+            result = m_persistent_log.read(offset, chunk, chunk_size) && m_client.write(chunk, chunk_size) == chunk_size;
+        }
+        result = result && (suffix_size == 0U || m_client.write('}') == suffix_size);
+        // End publish is called even if writing failed, to ensure the client releases any resources it acquired in the begin_publish() call
+        if (!m_client.end_publish() || !result) {
+            Logger::printfln(UNABLE_TO_STREAM_PAYLOAD, json_size, current_send_buffer_size);
+            return false;
+        }
+        Track_Delivery(record.priority);
+        return true;
+    }
+
+    /// @brief Whether the payload of the oldest message stored in the persistent log is a json object, that does not already contain a timestamp and can therefore be wrapped into the timestamped form
+    /// @param payload_size Size of the payload in bytes
+    /// @return Whether the payload starts with an opening brace, but not with the timestamp key
+    bool Is_Json_Object_Without_Timestamp(size_t const & payload_size) {
+        size_t const key_size = strlen(PERSISTENT_TIMESTAMP_KEY);
+        char start[PERSISTENT_TIMESTAMP_PREFIX_SIZE] = {};
+        size_t const start_size = payload_size < key_size ? payload_size : key_size;
+        if (start_size == 0U || !m_persistent_log.read(0U, reinterpret_cast<uint8_t *>(start), start_size)) {
+            return false;
+        }
+        return start[0] == '{' && (start_size < key_size || strncmp(start, PERSISTENT_TIMESTAMP_KEY, key_size) != 0);
+    }
+
+    /// @brief Consumes one message and the given amount of data points from the rate limits configured with @ref Set_Rate_Limits, if all of them allow it
+    /// @param data_point_amount Amount of telemetry data points contained in the message that should be published
+    /// @return Whether the message can be published without exceeding the rate limits, nothing is consumed if it can not
+    bool Consume_Rate_Limits(size_t const & data_point_amount) {
+        if (!m_message_rate_limiter.Can_Consume(1U) || !m_data_point_rate_limiter.Can_Consume(data_point_amount)) {
+            return false;
+        }
+        m_message_rate_limiter.Consume(1U);
+        m_data_point_rate_limiter.Consume(data_point_amount);
+        return true;
+    }
+
+    /// @brief Calculates the amount of telemetry data points, ThingsBoard counts for the given JsonDocument sent over the given topic
+    /// @note Is the amount of key-value pairs for a json object, or the sum of the key-value pairs in the values objects for the timestamped array form [{"ts":1451649600512,"values":{"key1":"value1"}}, ...].
+    /// Only telemetry data counts towards the data point rate limits, therefore 0 is returned for every other topic
+    /// @param topic Non owning pointer to topic that the message is sent over
+    /// @param source JsonDocument containing our json key-value pairs
+    /// @return Amount of telemetry data points contained in the JsonDocument, 0 if no data point rate limit has been configured
+    size_t Calculate_Data_Point_Amount(char const * topic, JsonDocument const & source) {
+        if (!m_data_point_rate_limiter.Is_Enabled() || Get_Topic_Priority(topic) != Publish_Priority::BULK) {
+            return 0U;
+        }
+        else if (!source.is<JsonArrayConst>()) {
+            return source.size();
+        }
+        size_t amount = 0U;
+        for (JsonObjectConst group : source.as<JsonArrayConst>()) {
+            JsonObjectConst const values = group[TELEMETRY_VALUES_KEY];
+            amount += values.isNull() ? group.size() : values.size();
+        }
+        return amount;
+    }
+
+    /// @brief Estimates the amount of telemetry data points, ThingsBoard counts for the given json string sent over the given topic
+    /// @note Counts all keys outside of strings whose value is neither an object nor an array, which is never less than the actual amount of data points.
+    /// The timestamp keys of the timestamped array form are counted as well, because the string is not parsed completely, meaning the estimate is slightly too big in that case
+    /// @param topic Non owning pointer to topic that the message is sent over
+    /// @param json Non owning pointer to the string containing serialized json key-value pairs
+    /// @return Estimated amount of telemetry data points contained in the json string, 0 if no data point rate limit has been configured
+    size_t Calculate_Data_Point_Amount(char const * topic, char const * json) {
+        if (!m_data_point_rate_limiter.Is_Enabled() || Get_Topic_Priority(topic) != Publish_Priority::BULK) {
+            return 0U;
+        }
+        size_t amount = 0U;
+        bool in_string = false;
+        for (; *json != '\0'; json++) {
+            if (in_string) {
+                if (*json == '\\' && *(json + 1U) != '\0') {
+                    json++;
+                }
+                else if (*json == '"') {
+                    in_string = false;
+                }
+                continue;
+            }
+            else if (*json == '"') {
+                in_string = true;
+                continue;
+            }
+            else if (*json != ':') {
+                continue;
+            }
+            char const * value = json + 1U;
+            while (*value == ' ' || *value == '\t' || *value == '\r' || *value == '\n') {
+                value++;
+            }
+            if (*value != '{' && *value != '[') {
+                amount++;
+            }
+        }
+        return amount;
     }
-#endif // THINGSBOARD_ENABLE_STREAM_UTILS
 
     /// @copydoc IMQTT_Client::subscribe
     bool Subscribe_Topic(char const * topic) {
@@ -688,6 +2204,25 @@ class ThingsBoardSized {
             // Results are ignored, because the important part of clearing internal data structures always succeeds
             (void)api->Resubscribe_Permanent_Subscriptions();
         }
+        // Replaying the persisted messages is started afterwards, so that responses to them can already be received.
+        // Is only handed over to the next call to loop() instead of starting it directly, because the callback might be called from the task of the client
+        m_session_established = true;
+    }
+
+    /// @brief Takes over the new session that has been established since the last call, if the connect callback has been called in the meantime
+    /// @note The connect callback only sets a single flag, which is then handed over to the task calling loop() here, because the callback might be called from the task of the client.
+    /// Ensures the state that is used to publish messages, like whether persisted messages are replayed or attributes are resent, is only ever changed from the task calling loop() and the send methods
+    void Handle_Established_Session() {
+#if THINGSBOARD_ENABLE_ATOMIC
+        bool const established = m_session_established.exchange(false);
+#else
+        bool const established = m_session_established;
+        m_session_established = false;
+#endif // THINGSBOARD_ENABLE_ATOMIC
+        if (established) {
+            m_persistent_replay = true;
+            m_attribute_resync = true;
+        }
     }
 
     /// @brief Sends the given key-value pair as telemtry or attribute data
@@ -700,63 +2235,181 @@ class ThingsBoardSized {
     bool Send_Key_Value_Pair(char const * key, T const & value, bool telemetry = true) {
         const Telemetry t(key, value);
         if (t.IsEmpty()) {
-            return false;
-        }
-
-        StaticJsonDocument<JSON_OBJECT_SIZE(1)> json_buffer;
-        if (!t.SerializeKeyValue(json_buffer)) {
-            Logger::printfln(UNABLE_TO_SERIALIZE);
-            return false;
+            return Set_Publish_Result(Publish_Result::INVALID_PAYLOAD);
         }
-        return telemetry ? Send_Telemetry_Json(json_buffer) : Send_Attribute_Json(json_buffer);
+        return Send_Data_Array(&t, &t + 1U, telemetry);
     }
 
     /// @brief Send aggregated key-value pair as telemetry or attribute data
     /// @note Expects iterators to a container containing Telemetry class instances.
+    /// The key-value pairs are directly serialized as json text into the internal send buffer, without creating a JsonDocument beforehand, which would have to be traversed again to serialize it.
+    /// Serializing into the internal send buffer additionally measures the payload in the same pass, if it does not fit the payload is instead serialized a second time and streamed directly into the MQTT client.
+    /// Key-value pairs that are not reportable according to the filter configured with @ref Set_Telemetry_Filter or @ref Set_Attribute_Filter are skipped while serializing,
+    /// where the filter is asked only once per key-value pair and its decisions are reused when serializing and once the message has been sent.
     /// See https://thingsboard.io/docs/user-guide/telemetry/ for more information
     /// @tparam InputIterator Class that allows for forward incrementable access to data
     /// of the given data container, allows for using / passing either std::vector or std::array.
     /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
-    /// @tparam MaxKeyValuePairAmount Maximum amount of key-value pairs, which will ever be sent with this method.
-    /// Should simply be the biggest distance between first and last iterator this method is ever called with
     /// @param first Iterator pointing to the first element in the data container
     /// @param last Iterator pointing to the end of the data container (last element + 1)
+    /// @param telemetry Whether the key-value pairs are sent as telemetry or attribute data
+    /// @param schema Non owning pointer to the description of the protobuf message the key-value pairs are encoded as, nullptr serializes them as a json object instead, default = nullptr
     /// @return Whether copying the key-value pairs into the outgoing MQTT buffer, was successful or not
-#if THINGSBOARD_ENABLE_DYNAMIC
     template<typename InputIterator>
-#else
-    template<size_t MaxKeyValuePairAmount, typename InputIterator>
-#endif // THINGSBOARD_ENABLE_DYNAMIC
-    bool Send_Data_Array(InputIterator const & first, InputIterator const & last, bool telemetry) {
-        auto const size = Helper::distance(first, last);
-#if THINGSBOARD_ENABLE_DYNAMIC
-        // char const * are stored as only a pointer inside the JsonDocument --> zero copy, meaning the size for the strings is 0 bytes.
-        // Data structure size, therefore only depends on the amount of key value pairs passed.
-        // See https://arduinojson.org/v6/assistant/ for more information on the needed size for the JsonDocument
-        TBJsonDocument json_buffer(JSON_OBJECT_SIZE(size));
-#else
-        if (size > MaxKeyValuePairAmount) {
-            Logger::printfln(TOO_MANY_JSON_FIELDS, size, "MaxKeyValuePairAmount", MaxKeyValuePairAmount);
-            return false;
+    bool Send_Data_Array(InputIterator const & first, InputIterator const & last, bool telemetry, Protobuf_Schema const * schema = nullptr) {
+        char const * topic = telemetry ? TELEMETRY_TOPIC : ATTRIBUTE_TOPIC;
+        IReport_Filter * filter = telemetry ? m_telemetry_filter : m_attribute_filter;
+        // Takes over a session established since the last call to loop(), so that the first attributes sent after connecting directly are a full resync
+        Handle_Established_Session();
+        if (!telemetry && filter != nullptr && m_attribute_resync) {
+            m_attribute_resync = false;
+            filter->Reset();
+        }
+        if (filter != nullptr) {
+            filter->Begin_Report();
+        }
+        uint32_t const current_time = filter != nullptr ? Helper::Get_Milliseconds() : 0U;
+        size_t reported_amount = Helper::distance(first, last);
+        bool * reportable = nullptr;
+        if (filter != nullptr) {
+            if (!Allocate_Report_Decisions(reported_amount)) {
+                Logger::printfln(UNABLE_TO_ALLOCATE_REPORT_DECISIONS, reported_amount);
+                return Set_Publish_Result(Publish_Result::OUT_OF_MEMORY);
+            }
+            reportable = m_report_decisions;
+            reported_amount = 0U;
+            size_t index = 0U;
+            for (auto it = first; it != last; ++it, ++index) {
+                reportable[index] = filter->Is_Reportable(*it, current_time);
+                reported_amount += reportable[index] ? 1U : 0U;
+            }
+        }
+        // Every key-value pair was dropped by the filter, therefore there is nothing to send, which is not an error
+        if (reported_amount == 0U && filter != nullptr && first != last) {
+            return Set_Publish_Result(Publish_Result::SUCCESS);
         }
-        StaticJsonDocument<JSON_OBJECT_SIZE(MaxKeyValuePairAmount)> json_buffer;
-#endif // THINGSBOARD_ENABLE_DYNAMIC
 
-#if THINGSBOARD_ENABLE_STL
-        if (std::any_of(first, last, [&json_buffer](Telemetry const & data) { return !data.SerializeKeyValue(json_buffer); })) {
+        uint16_t const current_send_buffer_size = m_client.get_send_buffer_size();
+        if (m_send_buffer_size != Calculate_Send_Buffer_Size(current_send_buffer_size) && !Allocate_Send_Buffer(current_send_buffer_size)) {
+            Logger::printfln(UNABLE_TO_ALLOCATE_BUFFER);
+            return Set_Publish_Result(Publish_Result::OUT_OF_MEMORY);
+        }
+
+        Fixed_Buffer_Writer writer(m_send_buffer, m_send_buffer_size);
+        size_t const json_size = schema != nullptr ? Serialize_Protobuf_Key_Value_Pairs(writer, *schema, first, last, reportable) : Serialize_Key_Value_Pairs(writer, first, last, reportable);
+        size_t const data_point_amount = telemetry && m_data_point_rate_limiter.Is_Enabled() ? reported_amount : 0U;
+        bool result = false;
+        // Empty protobuf messages are valid and encoded as 0 bytes, whereas a json object always contains at least its braces
+        if (schema != nullptr ? json_size == PROTOBUF_SERIALIZATION_FAILED : json_size == 0U) {
             Logger::printfln(UNABLE_TO_SERIALIZE);
-            return false;
+            return Set_Publish_Result(Publish_Result::INVALID_PAYLOAD);
         }
-#else
-        for (auto it = first; it != last; ++it) {
-            auto const & data = *it;
-            if (!data.SerializeKeyValue(json_buffer)) {
-                Logger::printfln(UNABLE_TO_SERIALIZE);
-                return false;
+        else if (json_size <= current_send_buffer_size) {
+            m_send_buffer[json_size] = '\0';
+            result = Enqueue_Json_String(topic, m_send_buffer, json_size, telemetry ? Publish_Priority::BULK : Publish_Priority::NORMAL, data_point_amount);
+        }
+        else {
+            result = Stream_Payload(topic, telemetry ? Publish_Priority::BULK : Publish_Priority::NORMAL, json_size, data_point_amount, [&first, &last, schema, reportable](Buffered_Publish_Writer & writer) {
+                return schema != nullptr ? Serialize_Protobuf_Key_Value_Pairs(writer, *schema, first, last, reportable) : Serialize_Key_Value_Pairs(writer, first, last, reportable);
+            });
+        }
+        if (result && filter != nullptr) {
+            size_t index = 0U;
+            for (auto it = first; it != last; ++it, ++index) {
+                if (reportable[index]) {
+                    filter->Reported(*it, current_time);
+                }
             }
         }
-#endif // THINGSBOARD_ENABLE_STL
-        return telemetry ? Send_Telemetry_Json(json_buffer) : Send_Attribute_Json(json_buffer);
+        return result;
+    }
+
+#if THINGSBOARD_ENABLE_CONCURRENT_PUBLISH
+    /// @brief Serializes the given key-value pairs as a json object directly into a free slot of the concurrent publish queue, can be called from any thread
+    /// @note Does not log failures, because the logger is not guaranteed to be thread-safe, instead the return value has to be checked by the caller
+    /// @tparam InputIterator Class that allows for forward incrementable access to data
+    /// of the given data container, allows for using / passing either std::vector or std::array.
+    /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
+    /// @param first Iterator pointing to the first element in the data container
+    /// @param last Iterator pointing to the end of the data container (last element + 1)
+    /// @param telemetry Whether the key-value pairs are sent as telemetry or attribute data
+    /// @return Whether copying the key-value pairs into the concurrent publish queue was successful or not
+    template<typename InputIterator>
+    bool Post_Data_Array(InputIterator const & first, InputIterator const & last, bool telemetry) {
+        // Always counted, because reading whether the data point rate limiter is enabled from another thread would race with Set_Rate_Limits
+        size_t const data_point_amount = telemetry ? Helper::distance(first, last) : 0U;
+        return m_posted_messages.push(telemetry, data_point_amount, [&first, &last](char * buffer, size_t const & buffer_size) {
+            Fixed_Buffer_Writer writer(buffer, buffer_size);
+            return Serialize_Key_Value_Pairs(writer, first, last);
+        });
+    }
+
+#endif // THINGSBOARD_ENABLE_CONCURRENT_PUBLISH
+    /// @brief Serializes the given key-value pairs directly as a json object into the given writer
+    /// @tparam TWriter Writer class the json object is written into, see @ref Json_Serializer for more information on the requirements of the writer
+    /// @tparam InputIterator Class that allows for forward incrementable access to data
+    /// of the given data container, allows for using / passing either std::vector or std::array.
+    /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
+    /// @param writer Writer the json object is written into
+    /// @param first Iterator pointing to the first element in the data container
+    /// @param last Iterator pointing to the end of the data container (last element + 1)
+    /// @param reportable Non owning pointer to whether each key-value pair is reported, in the same order as the data container, key-value pairs that are not are skipped.
+    /// nullptr serializes all key-value pairs, default = nullptr
+    /// @return Amount of bytes that have been written or 0 if any of the key-value pairs does not contain a key, because it can then not be serialized into a json object
+    template<typename TWriter, typename InputIterator>
+    static size_t Serialize_Key_Value_Pairs(TWriter & writer, InputIterator const & first, InputIterator const & last, bool const * reportable = nullptr) {
+        size_t size = Json_Serializer::Write_Character(writer, '{');
+        bool first_written = true;
+        size_t index = 0U;
+        for (auto it = first; it != last; ++it, ++index) {
+            Telemetry const & data = *it;
+            if (data.GetKey() == nullptr) {
+                return 0U;
+            }
+            else if (reportable != nullptr && !reportable[index]) {
+                continue;
+            }
+            else if (!first_written) {
+                size += Json_Serializer::Write_Character(writer, ',');
+            }
+            first_written = false;
+            size += data.SerializeJson(writer);
+        }
+        return size + Json_Serializer::Write_Character(writer, '}');
+    }
+
+    /// @brief Encodes the given key-value pairs directly as the fields of a protobuf message into the given writer
+    /// @tparam TWriter Writer class the message is written into, see @ref Protobuf_Serializer for more information on the requirements of the writer
+    /// @tparam InputIterator Class that allows for forward incrementable access to data
+    /// of the given data container, allows for using / passing either std::vector or std::array.
+    /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
+    /// @param writer Writer the message is written into
+    /// @param schema Description of the protobuf message, mapping every key to the number and type of its field
+    /// @param first Iterator pointing to the first element in the data container
+    /// @param last Iterator pointing to the end of the data container (last element + 1)
+    /// @param reportable Non owning pointer to whether each key-value pair is reported, in the same order as the data container, key-value pairs that are not are skipped.
+    /// nullptr encodes all key-value pairs, default = nullptr
+    /// @return Amount of bytes that have been written or PROTOBUF_SERIALIZATION_FAILED if any of the key-value pairs can not be encoded with the given schema
+    template<typename TWriter, typename InputIterator>
+    static size_t Serialize_Protobuf_Key_Value_Pairs(TWriter & writer, Protobuf_Schema const & schema, InputIterator const & first, InputIterator const & last, bool const * reportable = nullptr) {
+        size_t size = 0U;
+        size_t index = 0U;
+        for (auto it = first; it != last; ++it, ++index) {
+            Telemetry const & data = *it;
+            if (data.GetKey() == nullptr) {
+                return PROTOBUF_SERIALIZATION_FAILED;
+            }
+            else if (reportable != nullptr && !reportable[index]) {
+                continue;
+            }
+            size_t const field_size = data.SerializeProtobuf(writer, schema);
+            if (field_size == 0U) {
+                Logger::printfln(UNABLE_TO_SERIALIZE_PROTOBUF, data.GetKey());
+                return PROTOBUF_SERIALIZATION_FAILED;
+            }
+            size += field_size;
+        }
+        return size;
     }
 
     /// @brief Internal callback for received MQTT responses
@@ -776,50 +2429,82 @@ class ThingsBoardSized {
         Logger::printfln(RECEIVE_MESSAGE, length, topic);
 #endif // THINGSBOARD_ENABLE_DEBUG
 
-#if THINGSBOARD_ENABLE_STL
-#if THINGSBOARD_ENABLE_CXX20
-        auto filtered_raw_api_implementations = m_api_implementations | std::views::filter([&topic](IAPI_Implementation const * api) {
-#else
-        IAPI_Container filtered_raw_api_implementations = {};
-        std::copy_if(m_api_implementations.begin(), m_api_implementations.end(), std::back_inserter(filtered_raw_api_implementations), [&topic](IAPI_Implementation const * api) {
-#endif // THINGSBOARD_ENABLE_CXX20
-            return (api != nullptr && api->Get_Process_Type() == API_Process_Type::RAW && api->Is_Response_Topic_Matching(topic));
+        // Walks the topic once to find all API implementations handling responses on it, instead of comparing the topic of every subscribed API implementation.
+        // If any of them was processed as raw bytes we skip the further processing of those raw bytes as json, because the received response is in that case not even valid json in the first place and would therefore simply fail deserialization.
+        // If none of them expects json we skip the deserialization as well, because the response would simply be ignored afterwards
+        bool processed_response_as_raw = false;
+        size_t json_api_amount = 0U;
+        (void)m_api_dispatch_table.For_Each_Match(topic, [&](IAPI_Implementation & api) {
+            if (api.Get_Process_Type() == API_Process_Type::JSON) {
+                json_api_amount++;
+                return;
+            }
+            api.Process_Response(topic, payload, length);
+            processed_response_as_raw = true;
         });
 
-        for (auto & api : filtered_raw_api_implementations) {
-            api->Process_Response(topic, payload, length);
+        if (processed_response_as_raw || json_api_amount == 0U) {
+            return;
         }
 
-        // If the filtered api implementations was not emtpy it means the response was processed as its raw bytes representation atleast once,
-        // and because we interpreted it as raw bytes instead of json, we skip the further processing of those raw bytes as json.
-        // We do that because the received response is in that case not even valid json in the first place and would therefore simply fail deserialization
-        if (!filtered_raw_api_implementations.empty()) {
+        // Calculate size with the total amount of commas, always denotes the end of a key-value pair besides for the last element in an array or in an object where the comma is not permitted,
+        // therfore we have to add the space for another key-value pair for all the occurences of thoose symbols as well. All symbols are counted in a single pass over the payload, skipping the ones inside of string literals
+        auto size = Helper::Calculate_Json_Symbol_Occurences(payload, length);
+        // Filter containing only the keys the subscribed callbacks actually read, all other key-value pairs are skipped while deserializing and do not have to fit into the JsonDocument.
+        // Is only built if every api implementation handling the response only reads specific keys, its size therefore only depends on the amount of those keys and not on the received payload
+        size_t filter_size = Get_Json_Filter_Size(topic);
+#if !THINGSBOARD_ENABLE_DYNAMIC
+        // Filter that would not fit into the statically allocated filter is not built at all, instead the complete response is deserialized
+        if (filter_size > MaxFilterKeys) {
+            filter_size = 0U;
+        }
+#endif // !THINGSBOARD_ENABLE_DYNAMIC
+#if THINGSBOARD_ENABLE_DYNAMIC
+        auto const & max_response_size = Get_Max_Response_Size();
+        // Response that can not be filtered is refused before any memory is allocated, whereas a filtered response is only refused once the size of the keys kept by the filter is known
+        if (filter_size == 0U && max_response_size != 0U && JSON_OBJECT_SIZE(size) > max_response_size) {
+            Logger::printfln(MAXIMUM_RESPONSE_EXCEEDED, JSON_OBJECT_SIZE(size), max_response_size);
             return;
         }
 #else
-        bool processed_response_as_raw = false;
-        for (auto & api : m_api_implementations) {
-            if (api == nullptr || api->Get_Process_Type() != API_Process_Type::RAW || !api->Is_Response_Topic_Matching(topic)) {
-                continue;
-            }
-            api->Process_Response(topic, payload, length);
-            processed_response_as_raw = true;
+        if (filter_size == 0U && size > MaxResponse) {
+            Logger::printfln(TOO_MANY_JSON_FIELDS, size, "MaxResponse", MaxResponse);
+            return;
+        }
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+        if (filter_size == 0U) {
+            Deserialize_Json_Response(topic, payload, length, size, nullptr);
+            return;
         }
 
-        if (processed_response_as_raw) {
+#if THINGSBOARD_ENABLE_DYNAMIC
+        // Filter is only created if it is actually used, so that responses that can not be filtered do not additionally reserve the memory for it
+        TBJsonDocument filter(JSON_OBJECT_SIZE(filter_size));
+#else
+        // Filter is kept as a member instead of on the stack, so that it does not additionally occupy the stack next to the JsonDocument the response is deserialized into
+        JsonDocument & filter = m_json_filter;
+        filter.clear();
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+        if (!Build_Json_Filter(topic, filter)) {
+            Deserialize_Json_Response(topic, payload, length, size, nullptr);
             return;
         }
-#endif // THINGSBOARD_ENABLE_STL
+        Deserialize_Json_Response(topic, payload, length, Helper::Calculate_Filtered_Json_Symbol_Occurences(payload, length, filter), &filter);
+    }
 
-        // Calculate size with the total amount of commas, always denotes the end of a key-value pair besides for the last element in an array or in an object where the comma is not permitted,
-        // therfore we have to add the space for another key-value pair for all the occurences of thoose symbols as well
-        auto const size = Helper::Calculate_Symbol_Occurences(payload, ',', length) + Helper::Calculate_Symbol_Occurences(payload, '{', length) + Helper::Calculate_Symbol_Occurences(payload, '[', length);
+    /// @brief Deserializes the json response received over the given topic and passes it to every api implementation that handles the response as json
+    /// @param topic Non owning pointer to topic that the message was received over
+    /// @param payload Non owning pointer to the received payload, is modified while deserializing, because the strings are not copied into the JsonDocument (zero copy)
+    /// @param length Total length of the received payload
+    /// @param size Amount of key-value pairs the JsonDocument has to hold, only counting the ones kept by the given filter
+    /// @param filter Non owning pointer to the filter the response is deserialized with, nullptr deserializes every key-value pair
+    void Deserialize_Json_Response(char * topic, uint8_t * payload, unsigned int length, size_t const & size, JsonDocument const * filter) {
 #if THINGSBOARD_ENABLE_DYNAMIC
+        auto const & max_response_size = Get_Max_Response_Size();
         // Buffer that we deserialize is writeable and not read only and therefore stored as a pointer inside the JsonDocument --> zero copy, meaning the size for the received payload is 0 bytes.
         // Data structure size, therefore only depends on the amount of key value pairs received.
         // See https://arduinojson.org/v6/assistant/ for more information on the needed size for the JsonDocument
         auto const document_size = JSON_OBJECT_SIZE(size);
-        auto const & max_response_size = Get_Max_Response_Size();
         if (max_response_size != 0U && document_size > max_response_size) {
             Logger::printfln(MAXIMUM_RESPONSE_EXCEEDED, document_size, max_response_size);
             return;
@@ -846,33 +2531,49 @@ class ThingsBoardSized {
         // The deserializeJson method we use, can use the zero copy mode because a writeable input was passed,
         // if that were not the case the needed allocated memory would drastically increase, because the keys would need to be copied as well.
         // See https://arduinojson.org/v6/doc/deserialization/ for more info on ArduinoJson deserialization
-        DeserializationError const error = deserializeJson(json_buffer, payload, length);
+        DeserializationError const error = filter != nullptr ? deserializeJson(json_buffer, payload, length, DeserializationOption::Filter(*filter)) : deserializeJson(json_buffer, payload, length);
         if (error) {
             Logger::printfln(UNABLE_TO_DE_SERIALIZE_JSON, error.c_str());
             return;
         }
 
-#if THINGSBOARD_ENABLE_STL
-#if THINGSBOARD_ENABLE_CXX20
-        auto filtered_json_api_implementations = m_api_implementations | std::views::filter([&topic](IAPI_Implementation const * api) {
-#else
-        IAPI_Container filtered_json_api_implementations = {};
-        std::copy_if(m_api_implementations.begin(), m_api_implementations.end(), std::back_inserter(filtered_json_api_implementations), [&topic](IAPI_Implementation const * api) {
-#endif // THINGSBOARD_ENABLE_CXX20
-            return (api != nullptr && api->Get_Process_Type() == API_Process_Type::JSON && api->Is_Response_Topic_Matching(topic));
+        (void)m_api_dispatch_table.For_Each_Match(topic, [&](IAPI_Implementation & api) {
+            if (api.Get_Process_Type() == API_Process_Type::JSON) {
+                api.Process_Json_Response(topic, json_buffer);
+            }
         });
+    }
 
-        for (auto & api : filtered_json_api_implementations) {
-            api->Process_Json_Response(topic, json_buffer);
-        }
-#else
-        for (auto & api : m_api_implementations) {
-            if (api == nullptr || api->Get_Process_Type() != API_Process_Type::JSON || !api->Is_Response_Topic_Matching(topic)) {
-                continue;
+    /// @brief Returns the amount of keys the deserialization filter for the json response received over the given topic contains, summed up over every api implementation that handles the response
+    /// @param topic Non owning pointer to topic that the message was received over
+    /// @return Maximum amount of keys in the filter, 0 if atleast one api implementation can not filter the response and it therefore has to be deserialized without a filter
+    size_t Get_Json_Filter_Size(char const * topic) const {
+        size_t filter_size = 0U;
+        bool filterable = true;
+        (void)m_api_dispatch_table.For_Each_Match(topic, [&](IAPI_Implementation & api) {
+            if (!filterable || api.Get_Process_Type() != API_Process_Type::JSON) {
+                return;
             }
-            api->Process_Json_Response(topic, json_buffer);
-        }
-#endif // THINGSBOARD_ENABLE_STL
+            size_t const api_filter_size = api.Get_Json_Filter_Size(topic);
+            filterable = api_filter_size != 0U;
+            filter_size += api_filter_size;
+        });
+        return filterable ? filter_size : 0U;
+    }
+
+    /// @brief Builds the deserialization filter for the json response received over the given topic, from the keys read by every api implementation that handles the response
+    /// @param topic Non owning pointer to topic that the message was received over
+    /// @param filter Filter the keys are added to, has to be empty
+    /// @return Whether the response can be deserialized with the given filter, false if atleast one api implementation requires every key or the keys did not fit into the filter
+    bool Build_Json_Filter(char const * topic, JsonDocument & filter) const {
+        bool filterable = true;
+        (void)m_api_dispatch_table.For_Each_Match(topic, [&](IAPI_Implementation & api) {
+            if (filterable && api.Get_Process_Type() == API_Process_Type::JSON) {
+                filterable = api.Add_Json_Filter(topic, filter);
+            }
+        });
+        // Filter that is missing keys, because they did not fit, would skip key-value pairs the callbacks require, therefore the complete response is deserialized instead
+        return filterable && !filter.overflowed();
     }
 
 #if !THINGSBOARD_ENABLE_STL
@@ -883,6 +2584,13 @@ class ThingsBoardSized {
         m_subscribedInstance->On_MQTT_Message(topic, payload, length);
     }
 
+    static void On_Static_MQTT_Delivery(uint16_t packet_id, bool delivered) {
+        if (m_subscribedInstance == nullptr) {
+            return;
+        }
+        m_subscribedInstance->On_MQTT_Delivery(packet_id, delivered);
+    }
+
     static void Static_MQTT_Connect() {
         if (m_subscribedInstance == nullptr) {
             return;
@@ -894,21 +2602,28 @@ class ThingsBoardSized {
         if (m_subscribedInstance == nullptr) {
             return;
         }
-        m_subscribedInstance->Subscribe_API_Implementation(api);
+        (void)m_subscribedInstance->Subscribe_API_Implementation(api);
     }
 
     static bool Static_Send_Json(char const * topic, JsonDocument const & source) {
         if (m_subscribedInstance == nullptr) {
             return false;
         }
-        return m_subscribedInstance->Send_Json(topic, source);
+        return m_subscribedInstance->Send_Control_Json(topic, source);
     }
 
     static bool Static_Send_Json_String(char const * topic, char const * json) {
         if (m_subscribedInstance == nullptr) {
             return false;
         }
-        return m_subscribedInstance->Send_Json_String(topic, json);
+        return m_subscribedInstance->Send_Control_Json_String(topic, json);
+    }
+
+    static bool Static_Send_Protobuf_Json(char const * topic, uint32_t field_number, JsonDocument const & source) {
+        if (m_subscribedInstance == nullptr) {
+            return false;
+        }
+        return m_subscribedInstance->Send_Control_Protobuf_Json(topic, field_number, source);
     }
 
     static bool Static_Subscribe_Topic(char const * topic) {
@@ -959,19 +2674,65 @@ class ThingsBoardSized {
     IMQTT_Client&  m_client = {};              // MQTT client instance.
     size_t         m_max_stack = {};           // Maximum stack size we allocate at once.
     size_t         m_request_id = {};          // Internal id used to differentiate which request should receive which response for certain API calls. Can send 4'294'967'296 requests before wrapping back to 0
-#if THINGSBOARD_ENABLE_STREAM_UTILS
-    size_t         m_buffering_size = {};      // Buffering size used to serialize directly into client.
-#endif // THINGSBOARD_ENABLE_STREAM_UTILS
+    char           *m_send_buffer = {};        // Internal buffer all messages are serialized into before they are published, allocated once and then reused to avoid allocating on every sent message
+    size_t         m_send_buffer_size = {};    // Size of the internal send buffer, is always the send buffer size of the client + 2 bytes. See Calculate_Send_Buffer_Size for more information
+    IReport_Filter *m_telemetry_filter = {};    // Non owning pointer to the filter deciding which telemetry key-value pairs are dropped before they are sent, nullptr sends every key-value pair
+    IReport_Filter *m_attribute_filter = {};    // Non owning pointer to the filter deciding which attribute key-value pairs are dropped before they are sent, nullptr sends every key-value pair
+    bool           *m_report_decisions = {};    // Whether each key-value pair of the message that is currently sent is reported according to the filter, only allocated once a filter is used and grown to the most key-value pairs sent at once
+    size_t         m_report_decisions_size = {}; // Amount of elements in m_report_decisions
+    bool           m_attribute_resync = {};     // Whether the attribute filter is reset before the next attributes are sent, set once a new session has been established or a message published with QoS 1 has been dropped, only changed from the task calling loop()
+    Telemetry_Aggregator *m_telemetry_aggregator = {}; // Non owning pointer to the aggregator whose statistics are sent once its window has finished, nullptr if aggregation is not used
+    Telemetry      *m_coalesced_telemetry = {}; // Key-value pairs sent with Send_Telemetry_Data that are merged into a single telemetry json object, only allocated if telemetry coalescing is enabled
+    size_t         m_coalescing_max_amount = {}; // Maximum amount of key-value pairs that can be merged, is the amount of elements in m_coalesced_telemetry
+    char           *m_coalescing_arena = {};    // Copies of the keys and string values of the merged key-value pairs, allocated together with m_coalesced_telemetry and released once they have been sent
+    size_t         m_coalescing_arena_size = {}; // Size of m_coalescing_arena, is the send buffer size of the client at the time telemetry coalescing was enabled
+    size_t         m_coalescing_arena_used = {}; // Amount of bytes in m_coalescing_arena currently used by copied keys and string values, including those of replaced values
+    size_t         m_coalesced_amount = {};     // Amount of key-value pairs that are currently merged and have not been sent yet
+    size_t         m_coalesced_size = {};       // Size of the currently merged key-value pairs serialized as a single json object, without null terminator
+    uint32_t       m_coalescing_window = {};    // Amount of time in milliseconds after the first merged key-value pair, that further key-value pairs are merged before they are sent
+    uint32_t       m_coalescing_start = {};     // Time in milliseconds the first currently merged key-value pair has been merged at
+    Outbound_Queue m_outbound_queues[PUBLISH_PRIORITY_AMOUNT] = {}; // Queued outgoing messages per priority class, ordered from the highest (CONTROL) to the lowest (BULK) priority, only allocated if configured with Set_Outbound_Queue
+    size_t         m_outbound_drain_limit = {}; // Maximum amount of queued messages published per call to loop(), 0 means all queued messages are published
+    size_t         m_outbound_high_water_mark = {}; // Maximum amount of bytes in the outbound queues and the outbox of the client, before telemetry and attribute data is refused, 0 means there is no limit
+    Persistent_Log m_persistent_log = {};       // Append-only log in a persistent storage, that telemetry and attribute data is stored in while disconnected, only opened if configured with Set_Persistent_Store
+    Callback<uint64_t> m_persistent_time_callback = {}; // Time source returning the current time in milliseconds since the unix epoch, that persisted telemetry data is timestamped with
+    size_t         m_persistent_drain_limit = {}; // Maximum amount of persisted messages replayed per call to loop(), 0 means all persisted messages are replayed
+    bool           m_persistent_replay = {};    // Whether persisted messages are currently replayed, is set once the client reconnected and reset once it is disconnected, only changed from the task calling loop()
+    uint16_t       *m_persistent_packet_ids = {}; // Packet ids of the replayed persisted messages that are still kept in the log, oldest first, 0 for messages that do not need to be confirmed anymore, allocated together with m_in_flight_packet_ids
+    size_t         m_persistent_in_flight = {}; // Amount of replayed persisted messages that are still kept in the log, at most m_in_flight_window
+#if THINGSBOARD_ENABLE_ATOMIC
+    std::atomic<bool> m_session_established = {}; // Whether a new session has been established in the connect callback, which might be called from the task of the client, handed over in loop() or the next send method
+#else
+    bool           m_session_established = {};  // Whether a new session has been established in the connect callback, handed over in loop() or the next send method
+#endif // THINGSBOARD_ENABLE_ATOMIC
+    Publish_Result m_last_publish_result = {};  // Result of the last call to any method sending data, allows to differentiate why the method failed
+    Rate_Limiter   m_message_rate_limiter = {};    // Token buckets limiting the amount of published messages, disabled until configured with Set_Rate_Limits
+    Rate_Limiter   m_data_point_rate_limiter = {}; // Token buckets limiting the amount of published telemetry data points, disabled until configured with Set_Rate_Limits
+    MQTT_QoS       m_publish_qos[PUBLISH_PRIORITY_AMOUNT] = {}; // Quality of service messages are published with per priority class, configured with Set_Publish_QoS
+    MQTT_QoS       m_client_qos = {};           // Quality of service last configured in the client, allows to only change it if the next message uses a different one
+    uint16_t       *m_in_flight_packet_ids = {}; // Packet ids of the messages published with QoS 1 that have not been confirmed yet, only allocated if configured with Set_In_Flight_Window or Set_Publish_QoS
+    size_t         m_in_flight_window = {};     // Maximum amount of unconfirmed messages, is the amount of elements in m_in_flight_packet_ids
+    size_t         m_in_flight_amount = {};     // Amount of messages that have not been confirmed yet
+    uint16_t       m_last_packet_id = {};       // Packet id of the last message published with QoS 1
+    Delivery_Report_Queue m_delivery_reports = {}; // Lock-free queue handing the delivery reports of the client over to the task calling loop(), allocated together with m_in_flight_packet_ids
+    Callback<void, uint16_t, bool> m_delivery_callback = {}; // Callback that will be called as soon as a message published with QoS 1 has been confirmed or dropped
+#if THINGSBOARD_ENABLE_CONCURRENT_PUBLISH
+    Concurrent_Publish_Queue m_posted_messages = {}; // Lock-free queue of messages posted from any thread with the Post methods, only allocated if configured with Set_Concurrent_Queue
+    bool           m_process_posted_in_loop = {}; // Whether the posted messages are processed automatically in loop(), or by a dedicated thread calling Process_Posted_Messages instead
+#endif // THINGSBOARD_ENABLE_CONCURRENT_PUBLISH
 #if THINGSBOARD_ENABLE_DYNAMIC
     size_t         m_max_response_size = {};   // Maximum size allocated on the heap to hold the Json data structure for received cloud response payload, prevents possible malicious payload allocaitng a lot of memory
+#else
+    StaticJsonDocument<JSON_OBJECT_SIZE(MaxFilterKeys)> m_json_filter = {}; // Deserialization filter built from the keys the subscribed API implementations read from a received response, rebuilt for every received response
 #endif // THINGSBOARD_ENABLE_DYNAMIC    
     IAPI_Container m_api_implementations = {}; // Can hold a pointer to all  possible API implementations (Server side RPC, Client side RPC, Shared attribute update, Client-side or shared attribute request, Provision)             
+    IAPI_Dispatch_Table m_api_dispatch_table = {}; // Maps the response topic of every subscribed API implementation to it, allows to find the API implementations handling a received message without comparing the topic of each of them
 };
 
 #if !THINGSBOARD_ENABLE_STL
 #if !THINGSBOARD_ENABLE_DYNAMIC
-template<size_t MaxResponse, size_t MaxEndpointsAmount, typename Logger>
-ThingsBoardSized<MaxResponse, MaxEndpointsAmount, Logger> *ThingsBoardSized<MaxResponse, MaxEndpointsAmount, Logger>::m_subscribedInstance = nullptr;
+template<size_t MaxResponse, size_t MaxEndpointsAmount, size_t MaxFilterKeys, typename Logger>
+ThingsBoardSized<MaxResponse, MaxEndpointsAmount, MaxFilterKeys, Logger> *ThingsBoardSized<MaxResponse, MaxEndpointsAmount, MaxFilterKeys, Logger>::m_subscribedInstance = nullptr;
 #else
 template<typename Logger>
 ThingsBoardSized<Logger> *ThingsBoardSized<Logger>::m_subscribedInstance = nullptr;
@@ -4,6 +4,7 @@
 // Local includes.
 #include "Constants.h"
 #include "Telemetry.h"
+#include "Timestamped_Telemetry.h"
 #include "Helper.h"
 #include "IHTTP_Client.h"
 #include "DefaultLogger.h"
@@ -179,6 +180,65 @@ class ThingsBoardHttpSized {
 #endif // THINGSBOARD_ENABLE_DYNAMIC
     }
 
+    /// @brief Send multiple groups of key-value pairs, each with their own timestamp, as telemetry data in one message
+    /// @note Expects iterators to a container containing Timestamped_Telemetry class instances. Serializes them into the array form expected by ThingsBoard [{"ts":1451649600512,"values":{"key1":"value1"}}, ...],
+    /// which allows to sample data more often than it is sent, while still keeping the exact time each sample was taken at, instead of the time the message was received by the server.
+    /// See https://thingsboard.io/docs/user-guide/telemetry/ for more information
+    /// @tparam InputIterator Class that allows for forward incrementable access to data
+    /// of the given data container, allows for using / passing either std::vector or std::array.
+    /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
+    /// @tparam MaxTimestampAmount Maximum amount of timestamped groups, which will ever be sent with this method.
+    /// Should simply be the biggest distance between first and last iterator this method is ever called with
+    /// @tparam MaxKeyValuePairAmount Maximum amount of key-value pairs over all timestamped groups combined, which will ever be sent with this method
+    /// @param first Iterator pointing to the first element in the data container
+    /// @param last Iterator pointing to the end of the data container (last element + 1)
+    /// @return Whether copying the timestamped key-value pairs into the outgoing HTTP buffer, was successful or not
+#if THINGSBOARD_ENABLE_DYNAMIC
+    template<typename InputIterator>
+#else
+    template<size_t MaxTimestampAmount, size_t MaxKeyValuePairAmount, typename InputIterator>
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+    bool Send_Timestamped_Telemetry(InputIterator const & first, InputIterator const & last) {
+        size_t const timestamp_amount = Helper::distance(first, last);
+        size_t key_value_pair_amount = 0U;
+        for (auto it = first; it != last; ++it) {
+            Timestamped_Telemetry const & data = *it;
+            key_value_pair_amount += data.GetSize();
+        }
+#if THINGSBOARD_ENABLE_DYNAMIC
+        // char const * are stored as only a pointer inside the JsonDocument --> zero copy, meaning the size for the strings is 0 bytes.
+        // Data structure size, therefore only depends on the amount of timestamped groups, each containing an object with the timestamp and the values object, and the amount of key value pairs passed.
+        // See https://arduinojson.org/v6/assistant/ for more information on the needed size for the JsonDocument
+        TBJsonDocument json_buffer(JSON_ARRAY_SIZE(timestamp_amount) + timestamp_amount * JSON_OBJECT_SIZE(2U) + JSON_OBJECT_SIZE(key_value_pair_amount));
+#else
+        if (timestamp_amount > MaxTimestampAmount) {
+            Logger::printfln(TOO_MANY_JSON_FIELDS, timestamp_amount, "MaxTimestampAmount", MaxTimestampAmount);
+            return false;
+        }
+        else if (key_value_pair_amount > MaxKeyValuePairAmount) {
+            Logger::printfln(TOO_MANY_JSON_FIELDS, key_value_pair_amount, "MaxKeyValuePairAmount", MaxKeyValuePairAmount);
+            return false;
+        }
+        StaticJsonDocument<JSON_ARRAY_SIZE(MaxTimestampAmount) + MaxTimestampAmount * JSON_OBJECT_SIZE(2U) + JSON_OBJECT_SIZE(MaxKeyValuePairAmount)> json_buffer;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+
+#if THINGSBOARD_ENABLE_STL
+        if (std::any_of(first, last, [&json_buffer](Timestamped_Telemetry const & data) { return !data.SerializeTimestampedValues(json_buffer); })) {
+            Logger::printfln(UNABLE_TO_SERIALIZE);
+            return false;
+        }
+#else
+        for (auto it = first; it != last; ++it) {
+            auto const & data = *it;
+            if (!data.SerializeTimestampedValues(json_buffer)) {
+                Logger::printfln(UNABLE_TO_SERIALIZE);
+                return false;
+            }
+        }
+#endif // THINGSBOARD_ENABLE_STL
+        return Send_Telemetry_Json(json_buffer);
+    }
+
     /// @brief Send string containing json as telemetry data.
     /// See https://thingsboard.io/docs/user-guide/telemetry/ for more information
     /// @param json Non owning pointer to the string containing our json key-value pairs
@@ -0,0 +1,497 @@
+// Header include.
+#include "Time_Series_Buffer.h"
+
+/// @brief Marks that no XOR window has been stored for a floating point column in the current block yet
+uint8_t constexpr NO_XOR_WINDOW = UINT8_MAX;
+/// @brief Biggest amount of leading zero bits that can be stored in the 5 bits reserved for it, bigger amounts are stored as part of the meaningful bits instead
+uint8_t constexpr MAX_STORED_LEADING_ZEROS = 31U;
+/// @brief Amount of bits the zig-zag encoded delta of delta of a timestamp is stored in, depending on the amount of leading 1 bits of its control prefix
+uint8_t constexpr TIMESTAMP_BUCKET_BITS[] = { 0U, 7U, 9U, 12U, 64U };
+/// @brief Amount of bits stored per group of a varint, every group is preceded by a bit marking whether another group follows
+uint8_t constexpr VARINT_GROUP_BITS = 7U;
+
+namespace {
+
+/// @brief Writes the given amount of lowest bits of the value at the given bit offset into the block, starting with the most significant bit
+/// @param block Block the bits are written into, the bits have to still be cleared. If it is a nullptr the bits are only counted
+/// @param bit_position Offset in bits into the block, is moved past the written bits
+/// @param value Value containing the bits
+/// @param bit_amount Amount of bits that should be written, at most 64
+void Write_Bits(uint8_t * block, size_t & bit_position, uint64_t const & value, uint8_t const & bit_amount) {
+    if (block != nullptr) {
+        for (uint8_t i = bit_amount; i > 0U; i--) {
+            size_t const position = bit_position + bit_amount - i;
+            if (((value >> (i - 1U)) & 1U) != 0U) {
+                block[position / 8U] |= static_cast<uint8_t>(0x80U >> (position % 8U));
+            }
+        }
+    }
+    bit_position += bit_amount;
+}
+
+/// @brief Reads the given amount of bits at the given bit offset from the block, starting with the most significant bit
+/// @param block Block the bits are read from
+/// @param bit_position Offset in bits into the block, is moved past the read bits
+/// @param bit_amount Amount of bits that should be read, at most 64
+/// @return Value containing the read bits as its lowest bits
+uint64_t Read_Bits(uint8_t const * block, size_t & bit_position, uint8_t const & bit_amount) {
+    uint64_t value = 0U;
+    for (uint8_t i = 0U; i < bit_amount; i++) {
+        value = (value << 1U) | ((block[bit_position / 8U] >> (7U - (bit_position % 8U))) & 1U);
+        bit_position++;
+    }
+    return value;
+}
+
+/// @brief Maps signed values with a small magnitude to small unsigned values (0, -1, 1, -2, ... to 0, 1, 2, 3, ...), so that they can be stored in a few bits
+/// @param value Two's complement bits of the signed value
+/// @return Zig-zag encoded value
+uint64_t Zig_Zag(uint64_t const & value) {
+    return (value << 1U) ^ (UINT64_C(0) - (value >> 63U));
+}
+
+/// @brief Reverts @ref Zig_Zag
+/// @param value Zig-zag encoded value
+/// @return Two's complement bits of the signed value
+uint64_t Un_Zig_Zag(uint64_t const & value) {
+    return (value >> 1U) ^ (UINT64_C(0) - (value & 1U));
+}
+
+/// @brief Counts the leading zero bits of the given value
+/// @param value Value that has to contain at least one set bit
+/// @return Amount of leading zero bits
+uint8_t Count_Leading_Zeros(uint64_t value) {
+    uint8_t count = 0U;
+    while ((value & (UINT64_C(1) << 63U)) == 0U) {
+        value <<= 1U;
+        count++;
+    }
+    return count;
+}
+
+/// @brief Counts the trailing zero bits of the given value
+/// @param value Value that has to contain at least one set bit
+/// @return Amount of trailing zero bits
+uint8_t Count_Trailing_Zeros(uint64_t value) {
+    uint8_t count = 0U;
+    while ((value & 1U) == 0U) {
+        value >>= 1U;
+        count++;
+    }
+    return count;
+}
+
+} // namespace
+
+Time_Series_Buffer::Time_Series_Buffer()
+  : m_blocks(nullptr)
+  , m_block_info(nullptr)
+  , m_columns(nullptr)
+  , m_block_size(0U)
+  , m_block_amount(0U)
+  , m_max_column_amount(0U)
+  , m_column_amount(0U)
+  , m_write_cursor()
+  , m_read_cursor()
+  , m_peek_cursor()
+  , m_size(0U)
+  , m_overwritten(0U)
+{
+    // Nothing to do
+}
+
+Time_Series_Buffer::~Time_Series_Buffer() {
+    Free();
+}
+
+bool Time_Series_Buffer::Allocate(size_t const & block_size, size_t const & block_amount, size_t const & max_key_amount) {
+    Free();
+    if (block_size == 0U || block_amount < 2U || max_key_amount == 0U) {
+        return false;
+    }
+    m_blocks = new uint8_t[block_size * block_amount]();
+    m_block_info = new Block_Info[block_amount]();
+    m_columns = new Column[max_key_amount]();
+    if (m_blocks == nullptr || m_block_info == nullptr || m_columns == nullptr) {
+        Free();
+        return false;
+    }
+    m_block_size = block_size;
+    m_block_amount = block_amount;
+    m_max_column_amount = max_key_amount;
+    Clear();
+    return true;
+}
+
+void Time_Series_Buffer::Free() {
+    delete[] m_blocks;
+    m_blocks = nullptr;
+    delete[] m_block_info;
+    m_block_info = nullptr;
+    delete[] m_columns;
+    m_columns = nullptr;
+    m_block_size = 0U;
+    m_block_amount = 0U;
+    m_max_column_amount = 0U;
+    m_column_amount = 0U;
+    m_size = 0U;
+    m_overwritten = 0U;
+}
+
+void Time_Series_Buffer::Clear() {
+    m_size = 0U;
+    if (m_blocks == nullptr) {
+        return;
+    }
+    Reset_Block(m_write_cursor, 0U, State_Kind::WRITE);
+    Reset_Block(m_read_cursor, 0U, State_Kind::READ);
+}
+
+bool Time_Series_Buffer::Is_Allocated() const {
+    return m_blocks != nullptr;
+}
+
+size_t const & Time_Series_Buffer::size() const {
+    return m_size;
+}
+
+bool Time_Series_Buffer::empty() const {
+    return m_size == 0U;
+}
+
+size_t const & Time_Series_Buffer::Get_Overwritten_Amount() const {
+    return m_overwritten;
+}
+
+size_t Time_Series_Buffer::used_size() const {
+    if (empty()) {
+        return 0U;
+    }
+    size_t used = 0U;
+    for (size_t block = m_read_cursor.block; ; block = (block + 1U) % m_block_amount) {
+        used += (m_block_info[block].bit_size + 7U) / 8U;
+        if (block == m_write_cursor.block) {
+            break;
+        }
+    }
+    return used;
+}
+
+bool Time_Series_Buffer::push(uint64_t const & timestamp, Telemetry const * data, size_t const & size) {
+    if (m_blocks == nullptr || data == nullptr || size == 0U) {
+        return false;
+    }
+    for (size_t i = 0U; i < size; i++) {
+        size_t const column = Find_Column(data[i]);
+        if (column >= m_max_column_amount) {
+            return false;
+        }
+        int64_t integer = 0;
+        double real = 0.0;
+        bool boolean = false;
+        switch (m_columns[column].kind) {
+            case Value_Kind::INTEGER:
+                if (!data[i].GetInteger(integer)) {
+                    return false;
+                }
+                break;
+            case Value_Kind::REAL:
+                if (!data[i].GetReal(real) && !data[i].GetInteger(integer)) {
+                    return false;
+                }
+                break;
+            case Value_Kind::BOOLEAN:
+                if (!data[i].GetBoolean(boolean)) {
+                    return false;
+                }
+                break;
+        }
+    }
+
+    size_t const block_bit_size = m_block_size * 8U;
+    Block_Info * info = &m_block_info[m_write_cursor.block];
+    size_t bit_size = Encode_Sample(nullptr, info->bit_size, timestamp, data, size);
+    // Samples in a block all contain the same amount of presence bits, therefore a new key always starts a new block as well
+    if (bit_size > block_bit_size || info->column_amount != m_column_amount) {
+        size_t next_block = (m_write_cursor.block + 1U) % m_block_amount;
+        if (info->sample_amount == 0U) {
+            next_block = m_write_cursor.block;
+        }
+        else if (next_block == m_read_cursor.block) {
+            // Ring is full, therefore the block containing the oldest samples is overwritten
+            size_t const overwritten = m_block_info[next_block].sample_amount - m_read_cursor.sample;
+            m_size -= overwritten;
+            m_overwritten += overwritten;
+            Reset_Block(m_read_cursor, (next_block + 1U) % m_block_amount, State_Kind::READ);
+        }
+        Reset_Block(m_write_cursor, next_block, State_Kind::WRITE);
+        info = &m_block_info[m_write_cursor.block];
+        bit_size = Encode_Sample(nullptr, 0U, timestamp, data, size);
+        if (bit_size > block_bit_size) {
+            return false;
+        }
+    }
+
+    info->bit_size = Encode_Sample(m_blocks + m_write_cursor.block * m_block_size, info->bit_size, timestamp, data, size);
+    info->sample_amount++;
+    m_size++;
+    return true;
+}
+
+void Time_Series_Buffer::pop(size_t sample_amount) {
+    if (sample_amount > m_size) {
+        sample_amount = m_size;
+    }
+    for (size_t i = 0U; i < sample_amount; i++) {
+        uint64_t timestamp = 0U;
+        if (!Decode_Timestamp(m_read_cursor, State_Kind::READ, timestamp)) {
+            break;
+        }
+        for (size_t column = 0U; column < m_block_info[m_read_cursor.block].column_amount; column++) {
+            (void)Decode_Value(m_read_cursor, m_columns[column], m_columns[column].read);
+        }
+        m_read_cursor.sample++;
+        m_size--;
+    }
+}
+
+size_t Time_Series_Buffer::Encode_Sample(uint8_t * block, size_t bit_position, uint64_t const & timestamp, Telemetry const * data, size_t const & size) {
+    bool const commit = block != nullptr;
+    uint64_t const delta = timestamp - m_write_cursor.timestamp;
+    uint64_t const delta_of_delta = Zig_Zag(delta - m_write_cursor.delta);
+    // Control prefix consists of as many 1 bits as the index of the smallest bucket the value fits into, terminated by a 0 bit unless it is the last bucket
+    uint8_t bucket = 0U;
+    while (bucket + 1U < sizeof(TIMESTAMP_BUCKET_BITS) && (delta_of_delta >> TIMESTAMP_BUCKET_BITS[bucket]) != 0U) {
+        Write_Bits(block, bit_position, 1U, 1U);
+        bucket++;
+    }
+    if (bucket + 1U < sizeof(TIMESTAMP_BUCKET_BITS)) {
+        Write_Bits(block, bit_position, 0U, 1U);
+    }
+    Write_Bits(block, bit_position, delta_of_delta, TIMESTAMP_BUCKET_BITS[bucket]);
+    if (commit) {
+        m_write_cursor.timestamp = timestamp;
+        m_write_cursor.delta = delta;
+    }
+
+    for (size_t column = 0U; column < m_column_amount; column++) {
+        Column & current = m_columns[column];
+        Telemetry const * value = nullptr;
+        for (size_t i = 0U; i < size; i++) {
+            if (strcmp(data[i].GetKey(), current.key) == 0) {
+                value = &data[i];
+            }
+        }
+        Write_Bits(block, bit_position, value != nullptr ? 1U : 0U, 1U);
+        if (value == nullptr) {
+            continue;
+        }
+
+        Column_State & state = current.write;
+        int64_t integer = 0;
+        double real = 0.0;
+        bool boolean = false;
+        switch (current.kind) {
+            case Value_Kind::INTEGER: {
+                (void)value->GetInteger(integer);
+                uint64_t zig_zag = Zig_Zag(static_cast<uint64_t>(integer) - state.value);
+                Write_Bits(block, bit_position, zig_zag != 0U ? 1U : 0U, 1U);
+                while (zig_zag != 0U) {
+                    uint64_t const group = zig_zag & ((1U << VARINT_GROUP_BITS) - 1U);
+                    zig_zag >>= VARINT_GROUP_BITS;
+                    Write_Bits(block, bit_position, zig_zag != 0U ? 1U : 0U, 1U);
+                    Write_Bits(block, bit_position, group, VARINT_GROUP_BITS);
+                }
+                if (commit) {
+                    state.value = static_cast<uint64_t>(integer);
+                }
+                break;
+            }
+            case Value_Kind::REAL: {
+                if (!value->GetReal(real) && value->GetInteger(integer)) {
+                    real = static_cast<double>(integer);
+                }
+                uint64_t bits = 0U;
+                (void)memcpy(&bits, &real, sizeof(bits));
+                uint64_t const xor_value = bits ^ state.value;
+                if (xor_value == 0U) {
+                    Write_Bits(block, bit_position, 0U, 1U);
+                    break;
+                }
+                uint8_t leading = Count_Leading_Zeros(xor_value);
+                leading = leading < MAX_STORED_LEADING_ZEROS ? leading : MAX_STORED_LEADING_ZEROS;
+                uint8_t const trailing = Count_Trailing_Zeros(xor_value);
+                // Meaningful bits still fit into the window of the previous value, therefore the window does not need to be stored again
+                if (state.leading != NO_XOR_WINDOW && leading >= state.leading && trailing >= state.trailing) {
+                    Write_Bits(block, bit_position, 0x2U, 2U);
+                    Write_Bits(block, bit_position, xor_value >> state.trailing, 64U - state.leading - state.trailing);
+                }
+                else {
+                    uint8_t const meaningful = 64U - leading - trailing;
+                    Write_Bits(block, bit_position, 0x3U, 2U);
+                    Write_Bits(block, bit_position, leading, 5U);
+                    // 64 meaningful bits do not fit into the 6 bits reserved for the length and are therefore stored as 0, which would otherwise never occur
+                    Write_Bits(block, bit_position, meaningful & 0x3FU, 6U);
+                    Write_Bits(block, bit_position, xor_value >> trailing, meaningful);
+                    if (commit) {
+                        state.leading = leading;
+                        state.trailing = trailing;
+                    }
+                }
+                if (commit) {
+                    state.value = bits;
+                }
+                break;
+            }
+            case Value_Kind::BOOLEAN:
+                (void)value->GetBoolean(boolean);
+                Write_Bits(block, bit_position, boolean ? 1U : 0U, 1U);
+                break;
+        }
+    }
+    return bit_position;
+}
+
+bool Time_Series_Buffer::Decode_Timestamp(Cursor & cursor, State_Kind state, uint64_t & timestamp) {
+    while (cursor.sample >= m_block_info[cursor.block].sample_amount) {
+        if (cursor.block == m_write_cursor.block) {
+            return false;
+        }
+        Reset_Block(cursor, (cursor.block + 1U) % m_block_amount, state);
+    }
+    uint8_t const * block = m_blocks + cursor.block * m_block_size;
+    uint8_t bucket = 0U;
+    while (bucket + 1U < sizeof(TIMESTAMP_BUCKET_BITS) && Read_Bits(block, cursor.bit, 1U) != 0U) {
+        bucket++;
+    }
+    uint64_t const delta_of_delta = Un_Zig_Zag(Read_Bits(block, cursor.bit, TIMESTAMP_BUCKET_BITS[bucket]));
+    cursor.delta += delta_of_delta;
+    cursor.timestamp += cursor.delta;
+    timestamp = cursor.timestamp;
+    return true;
+}
+
+bool Time_Series_Buffer::Decode_Value(Cursor & cursor, Column const & column, Column_State & state) {
+    uint8_t const * block = m_blocks + cursor.block * m_block_size;
+    if (Read_Bits(block, cursor.bit, 1U) == 0U) {
+        return false;
+    }
+    switch (column.kind) {
+        case Value_Kind::INTEGER: {
+            if (Read_Bits(block, cursor.bit, 1U) == 0U) {
+                break;
+            }
+            uint64_t zig_zag = 0U;
+            bool more = true;
+            for (uint8_t shift = 0U; more && shift < 64U; shift += VARINT_GROUP_BITS) {
+                more = Read_Bits(block, cursor.bit, 1U) != 0U;
+                zig_zag |= Read_Bits(block, cursor.bit, VARINT_GROUP_BITS) << shift;
+            }
+            state.value += Un_Zig_Zag(zig_zag);
+            break;
+        }
+        case Value_Kind::REAL: {
+            if (Read_Bits(block, cursor.bit, 1U) == 0U) {
+                break;
+            }
+            else if (Read_Bits(block, cursor.bit, 1U) == 0U) {
+                state.value ^= Read_Bits(block, cursor.bit, 64U - state.leading - state.trailing) << state.trailing;
+                break;
+            }
+            uint8_t const leading = static_cast<uint8_t>(Read_Bits(block, cursor.bit, 5U));
+            uint8_t meaningful = static_cast<uint8_t>(Read_Bits(block, cursor.bit, 6U));
+            meaningful = meaningful != 0U ? meaningful : 64U;
+            state.leading = leading;
+            state.trailing = 64U - leading - meaningful;
+            state.value ^= Read_Bits(block, cursor.bit, meaningful) << state.trailing;
+            break;
+        }
+        case Value_Kind::BOOLEAN:
+            state.value = Read_Bits(block, cursor.bit, 1U);
+            break;
+    }
+    return true;
+}
+
+void Time_Series_Buffer::Copy_Read_State() {
+    m_peek_cursor = m_read_cursor;
+    for (size_t column = 0U; column < m_column_amount; column++) {
+        m_columns[column].peek = m_columns[column].read;
+    }
+}
+
+void Time_Series_Buffer::Reset_Block(Cursor & cursor, size_t const & block, State_Kind state) {
+    cursor.block = block;
+    cursor.bit = 0U;
+    cursor.sample = 0U;
+    cursor.timestamp = 0U;
+    cursor.delta = 0U;
+    for (size_t column = 0U; column < m_column_amount; column++) {
+        Column_State & current = Get_State(m_columns[column], state);
+        current.value = 0U;
+        current.leading = NO_XOR_WINDOW;
+        current.trailing = 0U;
+    }
+    if (state == State_Kind::WRITE) {
+        (void)memset(m_blocks + block * m_block_size, 0, m_block_size);
+        m_block_info[block].bit_size = 0U;
+        m_block_info[block].sample_amount = 0U;
+        m_block_info[block].column_amount = m_column_amount;
+    }
+}
+
+size_t Time_Series_Buffer::Find_Column(Telemetry const & data) {
+    char const * key = data.GetKey();
+    if (key == nullptr) {
+        return m_max_column_amount;
+    }
+    for (size_t column = 0U; column < m_column_amount; column++) {
+        if (strcmp(m_columns[column].key, key) == 0) {
+            return column;
+        }
+    }
+
+    int64_t integer = 0;
+    double real = 0.0;
+    bool boolean = false;
+    Column column = {};
+    if (data.GetInteger(integer)) {
+        column.kind = Value_Kind::INTEGER;
+    }
+    else if (data.GetReal(real)) {
+        column.kind = Value_Kind::REAL;
+    }
+    else if (data.GetBoolean(boolean)) {
+        column.kind = Value_Kind::BOOLEAN;
+    }
+    else {
+        return m_max_column_amount;
+    }
+    if (m_column_amount >= m_max_column_amount) {
+        return m_max_column_amount;
+    }
+    column.key = key;
+    column.write.leading = NO_XOR_WINDOW;
+    column.read.leading = NO_XOR_WINDOW;
+    column.peek.leading = NO_XOR_WINDOW;
+    m_columns[m_column_amount] = column;
+    return m_column_amount++;
+}
+
+Time_Series_Buffer::Column_State & Time_Series_Buffer::Get_State(Column & column, State_Kind state) {
+    switch (state) {
+        case State_Kind::WRITE:
+            return column.write;
+        case State_Kind::READ:
+            return column.read;
+        default:
+            break;
+    }
+    return column.peek;
+}
+
+double Time_Series_Buffer::Get_Real(uint64_t const & bits) {
+    double value = 0.0;
+    (void)memcpy(&value, &bits, sizeof(value));
+    return value;
+}
@@ -0,0 +1,265 @@
+#ifndef Time_Series_Buffer_h
+#define Time_Series_Buffer_h
+
+// Local includes.
+#include "Json_Serializer.h"
+#include "Timestamped_Telemetry.h"
+
+
+/// @brief Compressed in-memory ring of timestamped telemetry samples, that is meant to keep a long history of numeric data while the device is offline
+/// @note Every telemetry key is a column, that is compressed with its own predictor instead of storing the key-value pairs themselves, which would cost at least the size of a @ref Telemetry instance per data point.
+/// Timestamps are stored as the delta of the delta to the previous sample, meaning evenly spaced samples only require a single bit for their timestamp.
+/// Integral values are stored as the zig-zag encoded varint of the difference to the previous value of the same key, unchanged values only require a single bit.
+/// Floating point values are stored as the meaningful bits of the XOR with the previous value of the same key (Gorilla, see https://www.vldb.org/pvldb/vol8/p1816-teller.pdf), unchanged values only require a single bit.
+/// Boolean values always require a single bit. Additionally every sample contains one bit per key, marking whether the key was contained in the sample, so samples do not need to contain every key.
+/// The ring is split into blocks of a fixed size, where every block is compressed on its own, so that the oldest block can be overwritten once the ring is full, without having to decompress any other block.
+/// The samples are only expanded into the timestamped json form [{"ts":1451649600512,"values":{"key1":1}}, ...] once they are sent, see @ref Serialize.
+/// String values are not supported, because they can not be compressed meaningfully
+class Time_Series_Buffer {
+  public:
+    /// @brief Constructs an empty buffer, that can not hold any sample until @ref Allocate has been called
+    Time_Series_Buffer();
+
+    /// @brief Deleted copy constructor
+    /// @note Copying the buffer would require copying all compressed blocks and the state of every column. Therefore copying is disabled alltogether
+    /// @param other Other instance we disallow copying from
+    Time_Series_Buffer(Time_Series_Buffer const & other) = delete;
+
+    /// @brief Deleted copy assignment operator
+    /// @note Copying the buffer would require copying all compressed blocks and the state of every column. Therefore copying is disabled alltogether
+    /// @param other Other instance we disallow copying from
+    void operator=(Time_Series_Buffer const & other) = delete;
+
+    /// @brief Destructor, frees the blocks holding the compressed samples
+    ~Time_Series_Buffer();
+
+    /// @brief Allocates the blocks holding the compressed samples, any already stored samples and known keys are discarded
+    /// @param block_size Size of a single block in bytes, a single sample has to fit into one block. Smaller blocks waste less memory once the oldest block is overwritten,
+    /// but compress slightly worse, because the first sample of every block is stored uncompressed
+    /// @param block_amount Amount of blocks, has to be at least 2, so that the oldest block can be overwritten while the newest block is still kept
+    /// @param max_key_amount Maximum amount of different keys that can be stored, every key requires a few bytes of additional memory for the state of its predictor
+    /// @return Whether allocating the blocks was successful or not
+    bool Allocate(size_t const & block_size, size_t const & block_amount, size_t const & max_key_amount);
+
+    /// @brief Frees the blocks holding the compressed samples and therefore discards all stored samples and known keys
+    void Free();
+
+    /// @brief Discards all stored samples, without freeing the blocks holding them or forgetting the known keys
+    void Clear();
+
+    /// @brief Whether the blocks holding the compressed samples have been allocated
+    /// @return Whether samples can be stored
+    bool Is_Allocated() const;
+
+    /// @brief Amount of currently stored samples
+    /// @return Amount of stored samples
+    size_t const & size() const;
+
+    /// @brief Whether there are currently no stored samples
+    /// @return Whether the buffer is empty
+    bool empty() const;
+
+    /// @brief Amount of samples that have been overwritten, because the ring was full and the block containing them was reused for newer samples
+    /// @return Amount of overwritten samples since the blocks were allocated
+    size_t const & Get_Overwritten_Amount() const;
+
+    /// @brief Amount of bytes the compressed samples currently occupy in the blocks, allows to calculate the average size of a single sample
+    /// @return Amount of bytes occupied by the stored samples, rounded up to whole bytes per block
+    size_t used_size() const;
+
+    /// @brief Compresses the given key-value pairs, that have all been sampled at the given timestamp, and appends them to the end of the buffer
+    /// @note If the newest block is full, a new block is started. If that block still contains the oldest samples, they are overwritten.
+    /// A key that has not been stored before is added as a new column, where the type of its first value decides how the key is compressed from then on.
+    /// Integral values are accepted for floating point keys, but floating point values are not accepted for integral keys, because they would lose their decimal places
+    /// @param timestamp Unix timestamp in milliseconds, the key-value pairs have been sampled at
+    /// @param data Non owning pointer to the key-value pairs, that have been sampled at the given timestamp. The key-value pairs do not need to be kept alive, but their keys do,
+    /// because the buffer only stores a pointer to the key, the first time the key is added
+    /// @param size Amount of key-value pairs in the given data
+    /// @return Whether the sample was stored, fails if it contains a string value, more keys than the maximum key amount or does not fit into a single block
+    bool push(uint64_t const & timestamp, Telemetry const * data, size_t const & size);
+
+    /// @brief Compresses the given array of key-value pairs, that have all been sampled at the given timestamp, and appends them to the end of the buffer
+    /// @tparam Size Amount of key-value pairs in the given array, is deduced automatically
+    /// @param timestamp Unix timestamp in milliseconds, the key-value pairs have been sampled at
+    /// @param data Array of key-value pairs, that have been sampled at the given timestamp
+    /// @return Whether the sample was stored
+    template<size_t Size>
+    bool push(uint64_t const & timestamp, Telemetry const (&data)[Size]) {
+        return push(timestamp, data, Size);
+    }
+
+    /// @brief Expands the given amount of oldest samples into the timestamped json form expected by ThingsBoard [{"ts":1451649600512,"values":{"key1":1}}, ...], without removing them from the buffer
+    /// @note Decompresses the samples while they are written, meaning no memory is required besides the writer itself.
+    /// See @ref Json_Serializer for more information on the requirements of the writer
+    /// @tparam TWriter Writer class the json array is written into
+    /// @param writer Writer the json array is written into
+    /// @param sample_amount Amount of oldest samples that should be written, is limited to the amount of stored samples
+    /// @param data_point_amount Set to the amount of key-value pairs contained in the written samples
+    /// @return Amount of bytes that have been written
+    template<typename TWriter>
+    size_t Serialize(TWriter & writer, size_t const & sample_amount, size_t & data_point_amount) {
+        Copy_Read_State();
+        data_point_amount = 0U;
+        size_t const amount = sample_amount < m_size ? sample_amount : m_size;
+        size_t size = Json_Serializer::Write_Character(writer, '[');
+        for (size_t i = 0U; i < amount; i++) {
+            uint64_t timestamp = 0U;
+            if (!Decode_Timestamp(m_peek_cursor, State_Kind::PEEK, timestamp)) {
+                break;
+            }
+            // Separator is only written once the sample has been decompressed successfully, so that the json array never ends with a trailing comma
+            if (i != 0U) {
+                size += Json_Serializer::Write_Character(writer, ',');
+            }
+            size += Json_Serializer::Write_Character(writer, '{');
+            size += Json_Serializer::Write_String(writer, TELEMETRY_TIMESTAMP_KEY);
+            size += Json_Serializer::Write_Character(writer, ':');
+            size += Json_Serializer::Write_Unsigned_Integer(writer, timestamp);
+            size += Json_Serializer::Write_Character(writer, ',');
+            size += Json_Serializer::Write_String(writer, TELEMETRY_VALUES_KEY);
+            size += Json_Serializer::Write_Raw(writer, ":{", 2U);
+            bool first = true;
+            for (size_t column = 0U; column < m_block_info[m_peek_cursor.block].column_amount; column++) {
+                Column & current = m_columns[column];
+                if (!Decode_Value(m_peek_cursor, current, current.peek)) {
+                    continue;
+                }
+                if (!first) {
+                    size += Json_Serializer::Write_Character(writer, ',');
+                }
+                first = false;
+                data_point_amount++;
+                size += Json_Serializer::Write_String(writer, current.key);
+                size += Json_Serializer::Write_Character(writer, ':');
+                switch (current.kind) {
+                    case Value_Kind::INTEGER:
+                        size += Json_Serializer::Write_Integer(writer, static_cast<int64_t>(current.peek.value));
+                        break;
+                    case Value_Kind::REAL:
+                        size += Json_Serializer::Write_Real(writer, Get_Real(current.peek.value));
+                        break;
+                    case Value_Kind::BOOLEAN:
+                        size += Json_Serializer::Write_Boolean(writer, current.peek.value != 0U);
+                        break;
+                }
+            }
+            size += Json_Serializer::Write_Raw(writer, "}}", 2U);
+            m_peek_cursor.sample++;
+        }
+        return size + Json_Serializer::Write_Character(writer, ']');
+    }
+
+    /// @brief Removes the given amount of oldest samples from the buffer, should be called once they have been sent successfully
+    /// @param sample_amount Amount of oldest samples that should be removed, is limited to the amount of stored samples
+    void pop(size_t sample_amount);
+
+  private:
+    /// @brief Type of the values stored for a key, decides how they are compressed
+    enum class Value_Kind : uint8_t {
+        INTEGER, ///< Zig-zag encoded varint of the difference to the previous value
+        REAL, ///< Meaningful bits of the XOR with the previous value
+        BOOLEAN ///< Single bit containing the value itself
+    };
+
+    /// @brief Which of the predictor states is used
+    enum class State_Kind : uint8_t {
+        WRITE, ///< State used to compress appended samples
+        READ, ///< State used to decompress and remove the oldest samples
+        PEEK ///< State used to decompress the oldest samples without removing them
+    };
+
+    /// @brief State of the predictor of a single key, that is needed to compress or decompress the next value
+    struct Column_State {
+        uint64_t value;    // Previous value, the raw bits of the double for floating point values
+        uint8_t  leading;  // Amount of leading zero bits of the last stored XOR window, UINT8_MAX if no window has been stored in the current block yet
+        uint8_t  trailing; // Amount of trailing zero bits of the last stored XOR window
+    };
+
+    /// @brief Single key, that is stored as its own column
+    struct Column {
+        char const   *key;  // Non owning pointer to the key, has to be kept alive by the user for as long as the buffer is used
+        Value_Kind   kind;  // Type of the values stored for the key
+        Column_State write; // State used to compress the next appended value
+        Column_State read;  // State used to decompress the oldest stored value
+        Column_State peek;  // Copy of the read state, used to decompress values without removing them from the buffer
+    };
+
+    /// @brief Metadata of a single block
+    struct Block_Info {
+        size_t bit_size;      // Amount of bits written into the block
+        size_t sample_amount; // Amount of samples written into the block
+        size_t column_amount; // Amount of keys every sample in the block contains a presence bit for, new keys always start a new block
+    };
+
+    /// @brief Position of a sample in the buffer and state of the timestamp predictor, that is needed to decompress it
+    struct Cursor {
+        size_t   block;     // Index of the block the sample is contained in
+        size_t   bit;       // Offset in bits into the block the sample starts at
+        size_t   sample;    // Index of the sample in the block
+        uint64_t timestamp; // Timestamp of the previous sample in the block
+        uint64_t delta;     // Difference between the timestamps of the previous two samples in the block
+    };
+
+    /// @brief Encodes a complete sample into the given block, or only measures its size
+    /// @param block Block the sample is written into, if it is a nullptr the sample is only measured and the state of the predictors is not changed
+    /// @param bit_position Offset in bits into the block the sample starts at
+    /// @param timestamp Unix timestamp in milliseconds, the key-value pairs have been sampled at
+    /// @param data Non owning pointer to the key-value pairs, the keys have to already be known
+    /// @param size Amount of key-value pairs in the given data
+    /// @return Offset in bits into the block the sample ends at
+    size_t Encode_Sample(uint8_t * block, size_t bit_position, uint64_t const & timestamp, Telemetry const * data, size_t const & size);
+
+    /// @brief Moves the given cursor to the next block if it reached the end of its block and decompresses the timestamp of the sample it points to
+    /// @param cursor Cursor pointing to the sample, is moved to the first value of the sample
+    /// @param state Predictor states that are reset if the cursor is moved to the next block
+    /// @param timestamp Set to the decompressed timestamp
+    /// @return Whether there was a sample to decompress
+    bool Decode_Timestamp(Cursor & cursor, State_Kind state, uint64_t & timestamp);
+
+    /// @brief Decompresses the value of the given key in the sample the given cursor points to
+    /// @param cursor Cursor pointing to the value, is moved to the next value of the sample
+    /// @param column Column the value belongs to
+    /// @param state Predictor state of the column, is set to the decompressed value
+    /// @return Whether the sample contains a value for the given key
+    bool Decode_Value(Cursor & cursor, Column const & column, Column_State & state);
+
+    /// @brief Copies the read cursor and the read state of every column into the peek cursor and states, so that samples can be decompressed without removing them
+    void Copy_Read_State();
+
+    /// @brief Moves the given cursor to the start of the given block and resets the given predictor state of every column, because every block is compressed on its own
+    /// @param cursor Cursor that should be moved to the start of the given block
+    /// @param block Index of the block
+    /// @param state Predictor states that should be reset
+    void Reset_Block(Cursor & cursor, size_t const & block, State_Kind state);
+
+    /// @brief Returns the index of the column with the key of the given key-value pair, adds a new column if the key is not known yet
+    /// @param data Key-value pair, whose key should be found
+    /// @return Index of the column, or the maximum key amount if the key could not be found or added
+    size_t Find_Column(Telemetry const & data);
+
+    /// @brief Returns the given predictor state of the given column
+    /// @param column Column the state belongs to
+    /// @param state Which of the predictor states should be returned
+    /// @return Reference to the predictor state
+    static Column_State & Get_State(Column & column, State_Kind state);
+
+    /// @brief Converts the raw bits of a double back into the double itself
+    /// @param bits Raw bits of the double
+    /// @return Double with the given raw bits
+    static double Get_Real(uint64_t const & bits);
+
+    uint8_t    *m_blocks = {};          // Blocks holding the compressed samples, allocated once with Allocate
+    Block_Info *m_block_info = {};      // Metadata of every block
+    Column     *m_columns = {};         // State of every known key
+    size_t     m_block_size = {};       // Size of a single block in bytes
+    size_t     m_block_amount = {};     // Amount of blocks
+    size_t     m_max_column_amount = {}; // Maximum amount of keys
+    size_t     m_column_amount = {};    // Amount of known keys
+    Cursor     m_write_cursor = {};     // Position the next sample is appended at, the sample index is unused
+    Cursor     m_read_cursor = {};      // Position of the oldest stored sample
+    Cursor     m_peek_cursor = {};      // Copy of the read cursor, used to decompress samples without removing them from the buffer
+    size_t     m_size = {};             // Amount of stored samples
+    size_t     m_overwritten = {};      // Amount of samples that have been overwritten since the blocks were allocated
+};
+
+#endif // Time_Series_Buffer_h
@@ -0,0 +1,26 @@
+// Header include.
+#include "Timestamped_Telemetry.h"
+
+Timestamped_Telemetry::Timestamped_Telemetry()
+  : m_timestamp(0U)
+  , m_data(nullptr)
+  , m_size(0U)
+{
+    // Nothing to do
+}
+
+Timestamped_Telemetry::Timestamped_Telemetry(uint64_t const & timestamp, Telemetry const * data, size_t const & size)
+  : m_timestamp(timestamp)
+  , m_data(data)
+  , m_size(data != nullptr ? size : 0U)
+{
+    // Nothing to do
+}
+
+bool Timestamped_Telemetry::IsEmpty() const {
+    return m_size == 0U;
+}
+
+size_t const & Timestamped_Telemetry::GetSize() const {
+    return m_size;
+}
@@ -0,0 +1,77 @@
+#ifndef Timestamped_Telemetry_h
+#define Timestamped_Telemetry_h
+
+// Local includes.
+#include "Telemetry.h"
+
+
+// Timestamped telemetry data keys.
+char constexpr TELEMETRY_TIMESTAMP_KEY[] = "ts";
+char constexpr TELEMETRY_VALUES_KEY[] = "values";
+
+
+/// @brief Timestamped telemetry record class, groups multiple key-value pairs that have all been sampled at the same time
+/// @note Is used to send multiple samples, each with their own timestamp, in one message. Where the message is serialized into the array form expected by ThingsBoard [{"ts":1451649600512,"values":{"key1":"value1"}}, ...].
+/// See https://thingsboard.io/docs/reference/mqtt-api/#telemetry-upload-api for more information
+class Timestamped_Telemetry {
+  public:
+    /// @brief Creates an empty timestamped telemetry record containg neither a timestamp nor any key-value pairs
+    Timestamped_Telemetry();
+
+    /// @brief Constructs a timestamped telemetry record from the given key-value pairs
+    /// @param timestamp Unix timestamp in milliseconds, the key-value pairs have been sampled at
+    /// @param data Non owning pointer to the key-value pairs, that have been sampled at the given timestamp.
+    /// Has to be kept alive for as long as this instance is used, because the key-value pairs are not copied
+    /// @param size Amount of key-value pairs in the given data
+    Timestamped_Telemetry(uint64_t const & timestamp, Telemetry const * data, size_t const & size);
+
+    /// @brief Constructs a timestamped telemetry record from the given array of key-value pairs
+    /// @tparam Size Amount of key-value pairs in the given array, is deduced automatically
+    /// @param timestamp Unix timestamp in milliseconds, the key-value pairs have been sampled at
+    /// @param data Array of key-value pairs, that have been sampled at the given timestamp.
+    /// Has to be kept alive for as long as this instance is used, because the key-value pairs are not copied
+    template<size_t Size>
+    Timestamped_Telemetry(uint64_t const & timestamp, Telemetry const (&data)[Size])
+      : Timestamped_Telemetry(timestamp, data, Size)
+    {
+        // Nothing to do
+    }
+
+    /// @brief Whether this record is empty or not
+    /// @return Whether there are any key-value pairs in this record or not
+    bool IsEmpty() const;
+
+    /// @brief Returns the amount of key-value pairs in this record
+    /// @return Amount of key-value pairs in this record
+    size_t const & GetSize() const;
+
+    /// @brief Serializes the timestamp and all key-value pairs as a nested json object {"ts":1451649600512,"values":{"key1":"value1"}}, which is appended to the given json array
+    /// @tparam TSource Source class that the nested json object should be appended to
+    /// @param source Data source the nested json object should be appended to, is expected to be or to contain a json array
+    /// @return Whether serializing was successful or not
+    template <typename TSource>
+    bool SerializeTimestampedValues(TSource & source) const {
+        JsonObject object = source.createNestedObject();
+        if (object.isNull()) {
+            return false;
+        }
+        object[TELEMETRY_TIMESTAMP_KEY] = m_timestamp;
+        JsonObject values = object.createNestedObject(TELEMETRY_VALUES_KEY);
+        if (values.isNull()) {
+            return false;
+        }
+        for (size_t i = 0U; i < m_size; i++) {
+            if (!m_data[i].SerializeKeyValue(values)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+  private:
+    uint64_t        m_timestamp = {}; // Unix timestamp in milliseconds, the key-value pairs have been sampled at
+    Telemetry const *m_data = {};     // Non owning pointer to the key-value pairs, that have been sampled at the timestamp
+    size_t          m_size = {};      // Amount of key-value pairs in the data
+};
+
+#endif // Timestamped_Telemetry_h
@@ -0,0 +1,195 @@
+#ifndef Topic_Dispatch_Table_h
+#define Topic_Dispatch_Table_h
+
+// Local include.
+#include "Callback.h"
+
+// Library includes.
+#include <stdint.h>
+#include <string.h>
+
+
+/// @brief Radix tree (compressed prefix trie) mapping topic prefixes to the values that handle messages received on topics starting with them, for example the API implementations of the ThingsBoard client
+/// @note Built once when the values are inserted, afterwards finding every value whose prefix matches a received topic only walks the topic once from left to right,
+/// independent of how many values have been inserted and without allocating any memory. Every node is labeled with a part of an inserted prefix, where topics sharing the same beginning
+/// ("v1/devices/me/rpc/request/" and "v1/devices/me/rpc/response/") share the nodes for that beginning. Labels are not copied, instead they point directly into the inserted prefixes,
+/// therefore the prefixes have to be kept alive for as long as the table is used, which is always the case for constant strings. Inserting n prefixes requires at most 2 * n + 1 nodes
+/// @tparam T Type of the values the prefixes are mapped to, the table only stores non owning pointers to them
+#if THINGSBOARD_ENABLE_DYNAMIC
+template <typename T>
+#else
+/// @tparam MaxEntryAmount Maximum amount of prefixes that can be inserted.
+/// Once the maximum amount has been reached it is not possible to increase the size, this is done because it allows to allcoate the memory on the stack instead of the heap
+template <typename T, size_t MaxEntryAmount>
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+class Topic_Dispatch_Table {
+    /// @brief Single node of the tree, labeled with the part of the prefix between its parent and itself
+    struct Node {
+        char const *label;         // Non owning pointer to the part of the inserted prefix this node is labeled with, is not null terminated
+        uint16_t   label_size;     // Amount of characters in the label, only the root node has an empty label
+        uint16_t   first_child;    // Index of the first child node, NO_INDEX if the node does not have any children
+        uint16_t   next_sibling;   // Index of the next child node of the same parent, NO_INDEX if it is the last child
+        uint16_t   first_entry;    // Index of the first value whose prefix ends at this node, NO_INDEX if no prefix ends at this node
+    };
+
+    /// @brief Value whose prefix ends at a node, values ending at the same node are linked in the order they have been inserted
+    struct Entry {
+        T        *value;           // Non owning pointer to the value
+        bool     exact;            // Whether the topic has to end at the node as well, instead of only starting with the prefix
+        uint16_t next_entry;       // Index of the next value whose prefix ends at the same node, NO_INDEX if it is the last value
+    };
+
+    static uint16_t constexpr NO_INDEX = UINT16_MAX;
+
+#if THINGSBOARD_ENABLE_DYNAMIC
+    using Node_Container = Container<Node>;
+    using Entry_Container = Container<Entry>;
+#else
+    using Node_Container = Container<Node, 2U * MaxEntryAmount + 1U>;
+    using Entry_Container = Container<Entry, MaxEntryAmount>;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+
+  public:
+    /// @brief Constructs an empty table, that does not match any topic
+    Topic_Dispatch_Table() = default;
+
+    /// @brief Maps the given prefix to the given value, inserting the same prefix multiple times maps it to all given values
+    /// @param prefix Non owning pointer to the prefix, has to be kept alive for as long as the table is used, because it is not copied
+    /// @param exact Whether received topics have to be exactly the prefix, or whether they only have to start with it, because they contain additional parameters (request id)
+    /// @param value Non owning pointer to the value, has to be kept alive for as long as the table is used
+    /// @return Whether inserting the prefix was successful or not, fails if the maximum amount of prefixes has already been inserted
+    bool Insert(char const * prefix, bool exact, T * value) {
+        if (prefix == nullptr || value == nullptr || m_entries.size() + 1U > Get_Max_Entry_Amount()) {
+            return false;
+        }
+        if (m_nodes.empty()) {
+            Push_Node(prefix, 0U, NO_INDEX, NO_INDEX);
+        }
+        uint16_t node = 0U;
+        size_t remaining = strlen(prefix);
+        while (remaining != 0U) {
+            uint16_t const child = Find_Child(node, *prefix);
+            if (child == NO_INDEX) {
+                uint16_t const leaf = Push_Node(prefix, remaining, NO_INDEX, NO_INDEX);
+                m_nodes[leaf].next_sibling = m_nodes[node].first_child;
+                m_nodes[node].first_child = leaf;
+                node = leaf;
+                break;
+            }
+            size_t common = 1U;
+            uint16_t const label_size = m_nodes[child].label_size;
+            while (common < label_size && common < remaining && m_nodes[child].label[common] == prefix[common]) {
+                common++;
+            }
+            if (common < label_size) {
+                // Prefix diverges inside the label, therefore the node is split and the rest of its label moved into a new child, which takes over the children and values of the node
+                Node const & split = m_nodes[child];
+                uint16_t const rest = Push_Node(split.label + common, label_size - common, split.first_child, split.first_entry);
+                m_nodes[child].label_size = common;
+                m_nodes[child].first_child = rest;
+                m_nodes[child].first_entry = NO_INDEX;
+            }
+            node = child;
+            prefix += common;
+            remaining -= common;
+        }
+
+        Entry entry = {};
+        entry.value = value;
+        entry.exact = exact;
+        entry.next_entry = NO_INDEX;
+        m_entries.push_back(entry);
+        uint16_t const index = static_cast<uint16_t>(m_entries.size() - 1U);
+        uint16_t * next = &m_nodes[node].first_entry;
+        while (*next != NO_INDEX) {
+            next = &m_entries[*next].next_entry;
+        }
+        *next = index;
+        return true;
+    }
+
+    /// @brief Calls the given visitor with every value whose prefix matches the given topic, values with shorter prefixes are visited first
+    /// @tparam Visitor Callable receiving a reference to each matching value
+    /// @param topic Non owning pointer to the null terminated topic the message was received on
+    /// @param visitor Callable that is called for every matching value
+    /// @return Amount of values that have been visited
+    template <typename Visitor>
+    size_t For_Each_Match(char const * topic, Visitor visitor) const {
+        if (topic == nullptr || m_nodes.empty()) {
+            return 0U;
+        }
+        size_t visited = 0U;
+        uint16_t node = 0U;
+        while (true) {
+            bool const topic_end = *topic == '\0';
+            for (uint16_t index = m_nodes[node].first_entry; index != NO_INDEX; index = m_entries[index].next_entry) {
+                Entry const & entry = m_entries[index];
+                if (!entry.exact || topic_end) {
+                    visitor(*entry.value);
+                    visited++;
+                }
+            }
+            if (topic_end) {
+                break;
+            }
+            node = Find_Child(node, *topic);
+            // Comparison stops at the null terminator of the topic, therefore topics that are shorter than the label never read past their end
+            if (node == NO_INDEX || strncmp(topic, m_nodes[node].label, m_nodes[node].label_size) != 0) {
+                break;
+            }
+            topic += m_nodes[node].label_size;
+        }
+        return visited;
+    }
+
+    /// @brief Returns the amount of prefixes that have been inserted
+    /// @return Amount of inserted prefixes
+    size_t size() const {
+        return m_entries.size();
+    }
+
+  private:
+    /// @brief Returns the maximum amount of prefixes that can be inserted
+    /// @return Maximum amount of prefixes, limited by the type of the indices in dynamic mode
+    static size_t Get_Max_Entry_Amount() {
+#if THINGSBOARD_ENABLE_DYNAMIC
+        return (NO_INDEX - 1U) / 2U;
+#else
+        return MaxEntryAmount;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+    }
+
+    /// @brief Returns the child of the given node, whose label starts with the given character
+    /// @param node Index of the parent node
+    /// @param character First character of the label
+    /// @return Index of the child node, NO_INDEX if there is no such child
+    uint16_t Find_Child(uint16_t node, char character) const {
+        uint16_t child = m_nodes[node].first_child;
+        while (child != NO_INDEX && m_nodes[child].label[0] != character) {
+            child = m_nodes[child].next_sibling;
+        }
+        return child;
+    }
+
+    /// @brief Appends a new node without any siblings
+    /// @param label Non owning pointer to the label of the node
+    /// @param label_size Amount of characters in the label
+    /// @param first_child Index of the first child node
+    /// @param first_entry Index of the first value whose prefix ends at the node
+    /// @return Index of the new node
+    uint16_t Push_Node(char const * label, size_t label_size, uint16_t first_child, uint16_t first_entry) {
+        Node node = {};
+        node.label = label;
+        node.label_size = static_cast<uint16_t>(label_size);
+        node.first_child = first_child;
+        node.next_sibling = NO_INDEX;
+        node.first_entry = first_entry;
+        m_nodes.push_back(node);
+        return static_cast<uint16_t>(m_nodes.size() - 1U);
+    }
+
+    Node_Container  m_nodes = {};   // Nodes of the tree, where the first node is the root with an empty label
+    Entry_Container m_entries = {}; // Values the inserted prefixes are mapped to
+};
+
+#endif // Topic_Dispatch_Table_h
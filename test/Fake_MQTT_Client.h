@@ -0,0 +1,333 @@
+#ifndef Fake_MQTT_Client_h
+#define Fake_MQTT_Client_h
+
+// Local includes.
+#include "IMQTT_Client.h"
+
+// Library includes.
+#include <algorithm>
+#include <string>
+#include <vector>
+
+
+// Maximum amount of topics a topic alias can be reserved for, same limit as the one of the Espressif_MQTT_Client
+constexpr size_t FAKE_MAX_TOPIC_ALIASES = 4U;
+
+
+/// @brief Message that has been published through the @ref Fake_MQTT_Client
+struct Published_Message {
+    std::string topic;          // Topic the message has been published on, resolved from the topic alias by the simulated broker if only the alias was sent
+    std::string payload;        // Complete payload of the message, regardless of whether it was published at once or streamed
+    uint16_t    topic_alias = {}; // Topic alias the message was published with, 0 if it was published without one
+    bool        alias_only = {};  // Whether only the topic alias was sent instead of the full topic
+    uint16_t    packet_id = {};   // Packet id the message was published with, 0 if it was published with QoS 0
+};
+
+
+/// @brief IMQTT_Client implementation that does not connect to any broker, but instead records every published message and allows to simulate received messages.
+/// Used by the host tests and benchmarks to run the complete ThingsBoard class without any network access.
+/// Additionally simulates the topic aliases of MQTT 5 the same way as the @ref Espressif_MQTT_Client uses them, where the simulated broker refuses any message that only contains an alias it does not know in the current connection.
+/// Messages published with QoS 1 are kept in an outbox until they are acknowledged and are resent exactly as they were first sent after a reconnect, like the ESP MQTT client does
+class Fake_MQTT_Client : public IMQTT_Client {
+  public:
+    void set_data_callback(Callback<void, char *, uint8_t *, unsigned int>::function callback) override {
+        m_data_callback.Set_Callback(callback);
+    }
+
+    void set_connect_callback(Callback<void>::function callback) override {
+        m_connect_callback.Set_Callback(callback);
+    }
+
+    bool set_buffer_size(uint16_t receive_buffer_size, uint16_t send_buffer_size) override {
+        m_receive_buffer_size = receive_buffer_size;
+        m_send_buffer_size = send_buffer_size;
+        return true;
+    }
+
+    uint16_t get_receive_buffer_size() override {
+        return m_receive_buffer_size;
+    }
+
+    uint16_t get_send_buffer_size() override {
+        return m_send_buffer_size;
+    }
+
+    void set_server(char const * domain, uint16_t port) override {
+        // Nothing to do
+    }
+
+    bool connect(char const * client_id, char const * user_name, char const * password) override {
+        Set_Connected(true);
+        m_connect_callback.Call_Callback();
+        return true;
+    }
+
+    void disconnect() override {
+        m_connected = false;
+    }
+
+    bool loop() override {
+        return m_connected;
+    }
+
+    bool publish(char const * topic, uint8_t const * payload, size_t const & length) override {
+        if (!m_connected || length > m_send_buffer_size) {
+            return false;
+        }
+        return Transmit(topic, std::string(reinterpret_cast<char const *>(payload), length));
+    }
+
+    bool subscribe(char const * topic) override {
+        return true;
+    }
+
+    bool unsubscribe(char const * topic) override {
+        return true;
+    }
+
+    bool connected() override {
+        return m_connected;
+    }
+
+    MQTT_Connection_State get_connection_state() const override {
+        return m_connected ? MQTT_Connection_State::CONNECTED : MQTT_Connection_State::DISCONNECTED;
+    }
+
+    MQTT_Connection_Error get_last_connection_error() const override {
+        return MQTT_Connection_Error::NONE;
+    }
+
+    void subscribe_connection_state_changed_callback(Callback<void, MQTT_Connection_State, MQTT_Connection_Error>::function callback) override {
+        // Nothing to do
+    }
+
+    bool begin_publish(char const * topic, size_t const & length) override {
+        if (!m_connected) {
+            return false;
+        }
+        m_stream_topic = topic;
+        m_stream_payload.clear();
+        m_stream_length = length;
+        m_streaming = true;
+        return true;
+    }
+
+    bool end_publish() override {
+        bool const complete = m_streaming && m_stream_payload.size() == m_stream_length;
+        m_streaming = false;
+        return complete && Transmit(m_stream_topic.c_str(), m_stream_payload);
+    }
+
+    size_t write(uint8_t payload_byte) override {
+        return write(&payload_byte, 1U);
+    }
+
+    size_t write(uint8_t const * buffer, size_t const & size) override {
+        if (!m_streaming) {
+            return 0U;
+        }
+        m_stream_payload.append(reinterpret_cast<char const *>(buffer), size);
+        return size;
+    }
+
+    size_t get_outbox_size() override {
+        size_t outbox_size = 0U;
+        for (auto const & message : m_outbox) {
+            outbox_size += message.topic.size() + message.payload.size();
+        }
+        return outbox_size;
+    }
+
+    bool set_publish_qos(MQTT_QoS qos) override {
+        m_publish_qos = qos;
+        return true;
+    }
+
+    uint16_t get_last_packet_id() const override {
+        return m_last_packet_id;
+    }
+
+    void set_delivery_callback(Callback<void, uint16_t, bool>::function callback) override {
+        m_delivery_callback.Set_Callback(callback);
+    }
+
+    bool reserve_topic_alias(char const * topic) override {
+        if (topic == nullptr || Get_Reserved_Topic_Alias(topic) != 0U) {
+            return topic != nullptr;
+        }
+        if (m_topic_aliases.size() >= FAKE_MAX_TOPIC_ALIASES) {
+            return false;
+        }
+        m_topic_aliases.push_back(topic);
+        return true;
+    }
+
+    /// @brief Sets the maximum amount of topic aliases the client uses, where any value above 0 connects with MQTT 5 instead of MQTT 3.1.1, applied on the next connect
+    /// @param topic_alias_maximum Maximum amount of topic aliases, capped at FAKE_MAX_TOPIC_ALIASES, 0 connects with MQTT 3.1.1 and disables topic aliases
+    void Set_Topic_Alias_Maximum(uint16_t topic_alias_maximum) {
+        m_topic_alias_maximum = topic_alias_maximum > FAKE_MAX_TOPIC_ALIASES ? FAKE_MAX_TOPIC_ALIASES : topic_alias_maximum;
+    }
+
+    /// @brief Configures the simulated broker, applied on the next connect
+    /// @param topic_alias_maximum Maximum amount of topic aliases the broker accepts in its connect acknowledgement, aliases above it are not used by the client
+    /// @param supports_mqtt_5 Whether the broker supports MQTT 5 at all, if it does not the client falls back to MQTT 3.1.1 and does not use any topic alias
+    void Set_Broker(uint16_t topic_alias_maximum, bool supports_mqtt_5) {
+        m_broker_topic_alias_maximum = topic_alias_maximum;
+        m_broker_supports_mqtt_5 = supports_mqtt_5;
+    }
+
+    /// @brief Whether the current connection uses MQTT 5, which is only the case if both the client and the broker support it
+    /// @return Whether the current connection uses MQTT 5 or MQTT 3.1.1
+    bool Is_MQTT_5() const {
+        return m_session_topic_alias_maximum != 0U;
+    }
+
+    /// @brief Simulates losing or regaining the connection to the broker, without calling the connect callback.
+    /// Regaining the connection starts a new session, where neither the client nor the broker know any previously established topic alias
+    /// @param connected Whether the client should be connected or not
+    void Set_Connected(bool connected) {
+        if (connected && !m_connected) {
+            bool const mqtt_5 = m_topic_alias_maximum != 0U && m_broker_supports_mqtt_5;
+            m_session_topic_alias_maximum = mqtt_5 ? std::min<uint16_t>(m_topic_alias_maximum, m_broker_topic_alias_maximum) : 0U;
+            m_topic_alias_established.assign(m_session_topic_alias_maximum, false);
+            m_broker_topic_aliases.assign(m_session_topic_alias_maximum, std::string());
+        }
+        m_connected = connected;
+    }
+
+    /// @brief Simulates the broker acknowledging the message published with QoS 1 with the given packet id, which removes it from the outbox and calls the delivery callback
+    /// @param packet_id Packet id of the acknowledged message
+    /// @return Whether a message with the given packet id was waiting in the outbox or not
+    bool Acknowledge(uint16_t packet_id) {
+        return Remove_From_Outbox(packet_id, true);
+    }
+
+    /// @brief Simulates the client giving up on the message published with QoS 1 with the given packet id, which removes it from the outbox without it being acknowledged and calls the delivery callback
+    /// @param packet_id Packet id of the dropped message
+    /// @return Whether a message with the given packet id was waiting in the outbox or not
+    bool Drop(uint16_t packet_id) {
+        return Remove_From_Outbox(packet_id, false);
+    }
+
+    /// @brief Simulates losing the connection and reconnecting automatically, which calls the connect callback and then resends every message that is still waiting in the outbox exactly as it was first sent
+    void Reconnect() {
+        Set_Connected(false);
+        Set_Connected(true);
+        m_connect_callback.Call_Callback();
+        for (auto const & message : m_outbox) {
+            if (!Receive_Published(message)) {
+                return;
+            }
+        }
+    }
+
+    /// @brief Simulates receiving a message from the broker, by calling the data callback with a copy of the given payload
+    /// @param topic Topic the message has been received on
+    /// @param payload Payload of the received message
+    void Receive(char const * topic, std::string payload) {
+        std::string received_topic(topic);
+        m_data_callback.Call_Callback(&received_topic[0], reinterpret_cast<uint8_t *>(&payload[0]), payload.size());
+    }
+
+    std::vector<Published_Message> published = {}; // Every message that has been published successfully, in the order they were published in
+    bool protocol_error = {};                       // Whether the simulated broker received a message containing only a topic alias it did not know and therefore closed the connection
+
+  private:
+    /// @brief Gets the alias that was reserved for the given topic, independent of whether it can be used in the current connection
+    /// @param topic Topic the message is published on
+    /// @return Alias between 1 and FAKE_MAX_TOPIC_ALIASES, or 0 if no alias has been reserved for the topic
+    uint16_t Get_Reserved_Topic_Alias(char const * topic) const {
+        for (size_t i = 0U; i < m_topic_aliases.size(); i++) {
+            if (m_topic_aliases[i] == topic) {
+                return static_cast<uint16_t>(i + 1U);
+            }
+        }
+        return 0U;
+    }
+
+    /// @brief Removes the message with the given packet id from the outbox and reports whether it has been delivered to the delivery callback
+    /// @param packet_id Packet id of the removed message
+    /// @param delivered Whether the message has been acknowledged by the broker (true) or dropped by the client (false)
+    /// @return Whether a message with the given packet id was waiting in the outbox or not
+    bool Remove_From_Outbox(uint16_t packet_id, bool delivered) {
+        for (auto it = m_outbox.begin(); it != m_outbox.end(); ++it) {
+            if (it->packet_id == packet_id) {
+                m_outbox.erase(it);
+                m_delivery_callback.Call_Callback(packet_id, delivered);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// @brief Sends the message the same way the @ref Espressif_MQTT_Client would, with the full topic and the alias for the first message on an aliased topic and only the alias for every following one published with QoS 0.
+    /// Messages published with QoS 1 are additionally kept in the outbox, even if the broker refused them, because they are resent after the next reconnect
+    /// @param topic Topic the message is published on
+    /// @param payload Complete payload of the message
+    /// @return Whether the simulated broker accepted the message or not
+    bool Transmit(char const * topic, std::string const & payload) {
+        uint16_t topic_alias = Get_Reserved_Topic_Alias(topic);
+        if (topic_alias > m_session_topic_alias_maximum) {
+            topic_alias = 0U;
+        }
+        Published_Message message = {topic, payload, topic_alias, false, 0U};
+        if (topic_alias != 0U) {
+            // Messages published with QoS 1 are resent after a reconnect, once the broker does not know the alias anymore, therefore they always contain the full topic
+            message.alias_only = m_topic_alias_established[topic_alias - 1U] && m_publish_qos == MQTT_QoS::AT_MOST_ONCE;
+            m_topic_alias_established[topic_alias - 1U] = true;
+        }
+        m_last_packet_id = 0U;
+        if (m_publish_qos != MQTT_QoS::AT_MOST_ONCE) {
+            // Packet id 0 is not allowed for messages published with QoS 1
+            m_next_packet_id = m_next_packet_id == UINT16_MAX ? 1U : static_cast<uint16_t>(m_next_packet_id + 1U);
+            message.packet_id = m_next_packet_id;
+            m_last_packet_id = m_next_packet_id;
+            m_outbox.push_back(message);
+        }
+        return Receive_Published(message);
+    }
+
+    /// @brief Simulates the broker receiving the given message, which resolves or establishes its topic alias
+    /// @param message Message as it was sent by the client, where the topic is ignored if only the alias was sent
+    /// @return Whether the broker accepted the message, if it did not know the alias the connection is closed instead
+    bool Receive_Published(Published_Message message) {
+        if (message.topic_alias != 0U) {
+            std::string & alias_topic = m_broker_topic_aliases[message.topic_alias - 1U];
+            if (!message.alias_only) {
+                alias_topic = message.topic;
+            }
+            else if (alias_topic.empty()) {
+                protocol_error = true;
+                m_connected = false;
+                return false;
+            }
+            message.topic = alias_topic;
+        }
+        published.push_back(message);
+        return true;
+    }
+
+    Callback<void, char *, uint8_t *, unsigned int> m_data_callback = {}; // Callback that is called when a message is received
+    Callback<void>                                  m_connect_callback = {}; // Callback that is called when the connection has been established
+    uint16_t                                        m_receive_buffer_size = {}; // Size of the receive buffer
+    uint16_t                                        m_send_buffer_size = {}; // Size of the send buffer, messages exceeding it can only be streamed
+    bool                                            m_connected = {}; // Whether the client is currently connected
+    std::string                                     m_stream_topic = {}; // Topic of the message that is currently streamed
+    std::string                                     m_stream_payload = {}; // Payload that has been written for the message that is currently streamed
+    size_t                                          m_stream_length = {}; // Announced length of the message that is currently streamed
+    bool                                            m_streaming = {}; // Whether a message is currently streamed
+    std::vector<std::string>                        m_topic_aliases = {}; // Topics an alias has been reserved for, where the alias is the index + 1
+    uint16_t                                        m_topic_alias_maximum = {}; // Maximum amount of topic aliases configured for the client, 0 means MQTT 3.1.1 is used
+    uint16_t                                        m_broker_topic_alias_maximum = FAKE_MAX_TOPIC_ALIASES; // Maximum amount of topic aliases the simulated broker accepts
+    bool                                            m_broker_supports_mqtt_5 = true; // Whether the simulated broker accepts MQTT 5 connections
+    uint16_t                                        m_session_topic_alias_maximum = {}; // Maximum amount of topic aliases that can be used in the current connection, 0 if it uses MQTT 3.1.1
+    std::vector<bool>                               m_topic_alias_established = {}; // Whether the client already sent the alias together with its full topic in the current connection
+    std::vector<std::string>                        m_broker_topic_aliases = {}; // Topics the simulated broker resolves the aliases to in the current connection, empty if the alias is not known yet
+    Callback<void, uint16_t, bool>                  m_delivery_callback = {}; // Callback that is called when a message published with QoS 1 has been acknowledged
+    MQTT_QoS                                        m_publish_qos = {}; // Quality of service the following messages are published with
+    uint16_t                                        m_next_packet_id = {}; // Packet id of the last message published with QoS 1, incremented for every following one
+    uint16_t                                        m_last_packet_id = {}; // Packet id of the last published message, 0 if it was published with QoS 0
+    std::vector<Published_Message>                  m_outbox = {}; // Messages published with QoS 1 that have not been acknowledged yet, exactly as they were first sent
+};
+
+#endif // Fake_MQTT_Client_h
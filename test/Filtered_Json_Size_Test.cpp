@@ -0,0 +1,93 @@
+// Local includes.
+#include "Helper.h"
+#include "Test_Assert.h"
+
+// Library includes.
+#include <ArduinoJson.h>
+#include <string>
+#include <vector>
+
+
+constexpr size_t MAX_DOCUMENT_SIZE = 4096U;
+
+
+/// @brief Deserializes the given payload with the given filter into a document that is only as big as the calculated amount of structural json symbols
+/// and compares it against deserializing it into a document that is big enough for every key-value pair
+/// @param payload Payload that is deserialized, does not have to be valid json
+/// @param filter_json Filter the payload is deserialized with, as json
+/// @param expected Error expected when deserializing the payload, the calculated size has to be enough to never cause DeserializationError::NoMemory
+/// @return Amount of structural json symbols kept by the filter
+static size_t Expect_Filtered_Size(std::string const & payload, char const * filter_json, DeserializationError::Code const & expected) {
+    DynamicJsonDocument filter(MAX_DOCUMENT_SIZE);
+    TEST_ASSERT(deserializeJson(filter, filter_json) == DeserializationError::Ok);
+    // Deserializing modifies the payload, because the strings are not copied into the JsonDocument (zero copy)
+    std::vector<uint8_t> bytes(payload.begin(), payload.end());
+    size_t const count = Helper::Calculate_Filtered_Json_Symbol_Occurences(bytes.data(), bytes.size(), filter.as<JsonVariantConst>());
+
+    DynamicJsonDocument document(JSON_OBJECT_SIZE(count));
+    DeserializationError const error = deserializeJson(document, bytes.data(), bytes.size(), DeserializationOption::Filter(filter));
+    TEST_ASSERT(error == expected);
+    TEST_ASSERT(document.memoryUsage() <= JSON_OBJECT_SIZE(count));
+    if (expected != DeserializationError::Ok) {
+        return count;
+    }
+
+    bytes.assign(payload.begin(), payload.end());
+    DynamicJsonDocument unbounded(MAX_DOCUMENT_SIZE);
+    TEST_ASSERT(deserializeJson(unbounded, bytes.data(), bytes.size(), DeserializationOption::Filter(filter)) == DeserializationError::Ok);
+    std::string serialized = {};
+    std::string expected_serialized = {};
+    (void)serializeJson(document, serialized);
+    (void)serializeJson(unbounded, expected_serialized);
+    TEST_ASSERT(serialized == expected_serialized);
+
+    // Every truncated payload has to fit as well, no matter where the received payload was cut off
+    for (size_t size = 0U; size < payload.size(); size++) {
+        bytes.assign(payload.begin(), payload.begin() + size);
+        size_t const truncated_count = Helper::Calculate_Filtered_Json_Symbol_Occurences(bytes.data(), bytes.size(), filter.as<JsonVariantConst>());
+        DynamicJsonDocument truncated(JSON_OBJECT_SIZE(truncated_count));
+        TEST_ASSERT(deserializeJson(truncated, bytes.data(), bytes.size(), DeserializationOption::Filter(filter)) != DeserializationError::NoMemory);
+        TEST_ASSERT(truncated.memoryUsage() <= JSON_OBJECT_SIZE(truncated_count));
+    }
+    return count;
+}
+
+int main() {
+    std::string const shared = "{\"shared\":{\"fw_title\":\"firmware\",\"fw_version\":\"1.0.0\",\"fw_size\":1024,\"config\":{\"rate\":5,\"limits\":[1,2,3]}},\"client\":{\"state\":\"idle\",\"values\":[4,5,6]},\"deleted\":[\"a\",\"b\"]}";
+    // Only the kept keys are counted, skipped values containing structural json symbols are not
+    TEST_ASSERT(Expect_Filtered_Size(shared, "{\"shared\":{\"fw_title\":true,\"fw_size\":true}}", DeserializationError::Ok) == 3U);
+    // Kept arrays and objects count every contained structural json symbol
+    TEST_ASSERT(Expect_Filtered_Size(shared, "{\"shared\":{\"config\":true},\"deleted\":true}", DeserializationError::Ok) == 10U);
+    TEST_ASSERT(Expect_Filtered_Size(shared, "{\"client\":true}", DeserializationError::Ok) == 6U);
+    // Nested filters only recurse into the kept keys
+    TEST_ASSERT(Expect_Filtered_Size(shared, "{\"shared\":{\"config\":{\"rate\":true}},\"client\":{\"state\":true}}", DeserializationError::Ok) == 5U);
+    TEST_ASSERT(Expect_Filtered_Size(shared, "{\"missing\":true}", DeserializationError::Ok) == 0U);
+    // Null filter skips every key-value pair
+    TEST_ASSERT(Expect_Filtered_Size(shared, "null", DeserializationError::Ok) == 0U);
+    // Filter that is not an object keeps everything
+    (void)Expect_Filtered_Size(shared, "true", DeserializationError::Ok);
+
+    // Whitespace and newlines between every token
+    std::string const spaced = " \r\n{ \"shared\" :\n{\t\"fw_title\" : \"firmware\" , \"config\" : { \"rate\" : 5 } } ,\n\"client\" : [ 1 , { \"a\" : 2 } ] }\n";
+    TEST_ASSERT(Expect_Filtered_Size(spaced, "{\"shared\":{\"fw_title\":true,\"config\":{\"rate\":true}}}", DeserializationError::Ok) == 4U);
+    TEST_ASSERT(Expect_Filtered_Size(spaced, "{\"client\":true}", DeserializationError::Ok) == 4U);
+
+    // Escaped keys can not be compared without unescaping them and are therefore always kept, including their nested values
+    std::string const escaped = "{\"a\\\"b\":[1,2,3],\"\\u0066w_title\":{\"x\":1},\"fw_size\":2,\"skipped\":\"\\\"{,[\"}";
+    TEST_ASSERT(Expect_Filtered_Size(escaped, "{\"fw_title\":true,\"fw_size\":true}", DeserializationError::Ok) == 7U);
+    TEST_ASSERT(Expect_Filtered_Size(escaped, "{\"fw_title\":{\"y\":true}}", DeserializationError::Ok) == 6U);
+
+    // Values of kept keys, that are not objects even though the filter contains nested keys for them, count every contained structural json symbol
+    TEST_ASSERT(Expect_Filtered_Size("{\"config\":[{\"rate\":1},{\"rate\":2}],\"other\":{}}", "{\"config\":{\"rate\":true}}", DeserializationError::Ok) == 5U);
+    // Empty kept objects and arrays
+    TEST_ASSERT(Expect_Filtered_Size("{\"config\":{},\"values\":[]}", "{\"config\":{\"rate\":true},\"values\":true}", DeserializationError::Ok) == 3U);
+
+    // Malformed and truncated payloads are counted without the filter instead, which is never less than the amount of kept key-value pairs
+    (void)Expect_Filtered_Size("{\"shared\":{\"fw_title\":\"firmware\",\"fw_size\":[1,2", "{\"shared\":{\"fw_size\":true}}", DeserializationError::IncompleteInput);
+    (void)Expect_Filtered_Size("{\"shared\":{\"fw_title\" \"firmware\"},\"a\":[1,2]}", "{\"shared\":true}", DeserializationError::InvalidInput);
+    (void)Expect_Filtered_Size("{\"shared\":{\"fw_title\":\"firmware\"}}}", "{\"shared\":true}", DeserializationError::Ok);
+    (void)Expect_Filtered_Size("{shared:[1,2,3]}", "{\"shared\":true}", DeserializationError::InvalidInput);
+    (void)Expect_Filtered_Size("[{\"shared\":1},{\"shared\":2}]", "{\"shared\":true}", DeserializationError::Ok);
+    (void)Expect_Filtered_Size("", "{\"shared\":true}", DeserializationError::EmptyInput);
+    return 0;
+}
@@ -0,0 +1,91 @@
+// Local includes.
+#include "Helper.h"
+#include "Test_Assert.h"
+
+// Library includes.
+#include <random>
+#include <string>
+#include <string.h>
+#include <vector>
+
+
+// Amount of randomly generated payloads that are counted
+constexpr size_t RANDOM_PAYLOAD_AMOUNT = 200000U;
+constexpr size_t MAX_PAYLOAD_SIZE = 64U;
+// Bytes the random payloads are built from, quotes, backslashes and structural symbols are picked a lot more often than they occur in actual payloads
+char constexpr ALPHABET[] = "\"\"\"\\\\\\,,{{[[]}:ab 1";
+
+
+/// @brief Counts the structural json symbols outside of string literals by comparing every byte on its own, which is what the word-wise comparison has to be equivalent to
+/// @param bytes Non owning pointer to the byte payload
+/// @param length Length of the byte payload
+/// @return Amount of occurences of the structural json symbols outside of string literals
+static size_t Count_Byte_Per_Byte(uint8_t const * bytes, size_t const & length) {
+    size_t count = 0U;
+    bool in_string = false;
+    bool escaped = false;
+    for (size_t i = 0U; i < length; i++) {
+        uint8_t const byte = bytes[i];
+        if (in_string) {
+            if (escaped) {
+                escaped = false;
+            }
+            else if (byte == '\\') {
+                escaped = true;
+            }
+            else if (byte == '"') {
+                in_string = false;
+            }
+        }
+        else if (byte == '"') {
+            in_string = true;
+        }
+        else if (byte == ',' || byte == '{' || byte == '[') {
+            count++;
+        }
+    }
+    return count;
+}
+
+/// @brief Counts the given payload at every offset up to the size of a word, so that the words compared at once start at every possible position relative to the payload and to the alignment of the buffer
+/// @param payload Payload that is counted, does not have to be valid json
+static void Expect_Equal_Count(std::string const & payload) {
+    std::vector<uint8_t> buffer(payload.size() + sizeof(size_t));
+    for (size_t offset = 0U; offset < sizeof(size_t); offset++) {
+        uint8_t * bytes = buffer.data() + offset;
+        (void)memcpy(bytes, payload.data(), payload.size());
+        size_t const expected = Count_Byte_Per_Byte(bytes, payload.size());
+        TEST_ASSERT(Helper::Calculate_Json_Symbol_Occurences(bytes, payload.size()) == expected);
+    }
+}
+
+int main() {
+    TEST_ASSERT(Helper::Calculate_Json_Symbol_Occurences(nullptr, 16U) == 0U);
+    Expect_Equal_Count("");
+    Expect_Equal_Count("{\"key\":\"value, with {symbols} and [brackets]\",\"array\":[1,2,{\"nested\":true}]}");
+    // Escaped quotes do not end the string literal, whereas an escaped backslash in front of a quote does
+    Expect_Equal_Count("{\"a\":\"\\\",{[\",\"b\":[1,2]}");
+    Expect_Equal_Count("{\"path\":\"C:\\\\data\\\\\",\"c\":{\"d\":[3,4]},\"e\":\"\\\\\\\",\"}");
+    // Backslashes outside of string literals are not escaping anything and quotes inside of unterminated string literals are never closed
+    Expect_Equal_Count("\\\"{,[\\\",");
+    Expect_Equal_Count("{\"unterminated\":\"{,[\\");
+
+    // String literals and escaped characters that start at every position of a word and end in the following words
+    for (size_t prefix = 0U; prefix < 3U * sizeof(size_t); prefix++) {
+        std::string const padding(prefix, 'x');
+        Expect_Equal_Count("{\"" + padding + "\\\",{[\":[" + padding + "],\"" + padding + "\\\\\":{\"k\":1}}");
+        Expect_Equal_Count(padding + "\"\\\\\\\"\",[\"" + padding + "\\\\\",{");
+    }
+
+    std::mt19937 random(42U);
+    std::uniform_int_distribution<size_t> size_distribution(0U, MAX_PAYLOAD_SIZE);
+    std::uniform_int_distribution<size_t> symbol_distribution(0U, sizeof(ALPHABET) - 2U);
+    for (size_t i = 0U; i < RANDOM_PAYLOAD_AMOUNT; i++) {
+        std::string payload(size_distribution(random), '\0');
+        for (auto & symbol : payload) {
+            symbol = ALPHABET[symbol_distribution(random)];
+        }
+        Expect_Equal_Count(payload);
+    }
+    return 0;
+}
@@ -0,0 +1,91 @@
+// Local includes.
+#include "Fake_MQTT_Client.h"
+#include "Test_Assert.h"
+#include "ThingsBoard.h"
+
+// Library includes.
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+
+// Amount of threads posting at once and amount of messages posted by every thread
+constexpr size_t PRODUCER_AMOUNT = 8U;
+constexpr int MESSAGES_PER_PRODUCER = 10000;
+// Deliberately smaller than the amount of producers, so that the queue is full most of the time and posting has to be retried
+constexpr size_t SLOT_AMOUNT = 4U;
+constexpr size_t SLOT_SIZE = 32U;
+constexpr auto TIMEOUT = std::chrono::seconds(120);
+
+
+/// @brief Posts every value of the producer in ascending order, every third value as an attribute and all others as telemetry.
+/// Retries as long as the queue is full, because the consumer might still be processing the previously posted messages
+/// @param tb Instance the messages are posted to
+/// @param producer Index of the producer, used as the key of every posted message
+static void Produce(ThingsBoardSized<> & tb, size_t const & producer) {
+    char key[8] = {};
+    (void)snprintf(key, sizeof(key), "p%zu", producer);
+    for (int value = 0; value < MESSAGES_PER_PRODUCER; value++) {
+        bool const attribute = value % 3 == 0;
+        while (!(attribute ? tb.Post_Attribute_Data(key, value) : tb.Post_Telemetry_Data(key, value))) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+int main() {
+    Fake_MQTT_Client client;
+    ThingsBoardSized<> tb(client, 256U, 128U);
+    TEST_ASSERT(tb.connect("localhost", "token"));
+
+    // Posting without a queue and posting messages bigger than a slot has to fail without corrupting the queue
+    TEST_ASSERT(!tb.Post_Telemetry_Data("key", 1));
+    TEST_ASSERT(tb.Set_Concurrent_Queue(SLOT_AMOUNT, SLOT_SIZE));
+    std::string const too_big(SLOT_SIZE, 'x');
+    TEST_ASSERT(!tb.Post_Telemetry_Data("key", too_big.c_str()));
+    tb.loop();
+    TEST_ASSERT(client.published.empty());
+
+    std::vector<std::thread> producers;
+    for (size_t producer = 0U; producer < PRODUCER_AMOUNT; producer++) {
+        producers.emplace_back(Produce, std::ref(tb), producer);
+    }
+
+    // The thread calling loop() is the only consumer, loops until every posted message has been published.
+    // Yields if nothing could be consumed, because the producer that reserved the oldest slot might still need to be scheduled to finish writing it
+    size_t const expected = PRODUCER_AMOUNT * MESSAGES_PER_PRODUCER;
+    auto const deadline = std::chrono::steady_clock::now() + TIMEOUT;
+    while (client.published.size() < expected) {
+        TEST_ASSERT(std::chrono::steady_clock::now() < deadline);
+        size_t const published = client.published.size();
+        tb.loop();
+        if (client.published.size() == published) {
+            std::this_thread::yield();
+        }
+    }
+    for (auto & producer : producers) {
+        producer.join();
+    }
+    tb.loop();
+    TEST_ASSERT(client.published.size() == expected);
+
+    // Every message has to be published exactly once, uncorrupted, on the topic it was posted for and in the order it was posted in by its producer
+    std::vector<int> next_value(PRODUCER_AMOUNT, 0);
+    for (auto const & message : client.published) {
+        size_t producer = 0U;
+        int value = 0;
+        int consumed = 0;
+        TEST_ASSERT(sscanf(message.payload.c_str(), "{\"p%zu\":%d}%n", &producer, &value, &consumed) == 2);
+        TEST_ASSERT(static_cast<size_t>(consumed) == message.payload.size());
+        TEST_ASSERT(producer < PRODUCER_AMOUNT);
+        TEST_ASSERT(value == next_value[producer]);
+        next_value[producer]++;
+        bool const attribute = value % 3 == 0;
+        TEST_ASSERT(message.topic == (attribute ? ATTRIBUTE_TOPIC : TELEMETRY_TOPIC));
+    }
+    for (auto const & value : next_value) {
+        TEST_ASSERT(value == MESSAGES_PER_PRODUCER);
+    }
+    return 0;
+}
@@ -0,0 +1,175 @@
+// Local includes.
+#include "File_Storage.h"
+#include "Persistent_Log.h"
+#include "Test_Assert.h"
+
+// Library includes.
+#include <filesystem>
+#include <random>
+#include <string>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+// Amount of times a writer process is started and killed at a random point in time
+constexpr size_t CRASH_AMOUNT = 300U;
+// Upper limit of the time the writer process runs before being killed
+constexpr unsigned int MAX_RUN_TIME_US = 10000U;
+// Small segments, so that the writer starts new segments and wraps around the ring regularly
+constexpr size_t SEGMENT_AMOUNT = 4U;
+constexpr size_t SEGMENT_SIZE = 512U;
+constexpr size_t MAX_PAYLOAD_SIZE = 100U;
+char constexpr LOG_DIRECTORY[] = "Persistent_Log_Crash_Test_Data";
+char constexpr LOG_PREFIX[] = "Persistent_Log_Crash_Test_Data/log_";
+char constexpr COPY_PREFIX[] = "Persistent_Log_Crash_Test_Data/copy_";
+
+
+/// @brief Operation the writer process reports to the test process, once it has returned successfully and is therefore guaranteed to be persisted
+struct Acknowledgement {
+    bool     pushed; // Whether the message with the given id has been pushed (true) or popped (false)
+    uint32_t id;     // Id of the message, every message gets an id one bigger than the previous message
+};
+
+
+/// @brief Builds the payload stored for the message with the given id, the size and content are derived from the id so that every payload can be validated without knowing the size it was stored with
+/// @param id Id of the message
+/// @return Payload of the message
+static std::string Build_Payload(uint32_t const & id) {
+    std::string payload = std::to_string(id) + ':';
+    size_t const size = 8U + (id * 37U) % (MAX_PAYLOAD_SIZE - 8U);
+    while (payload.size() < size) {
+        payload += static_cast<char>('a' + (id + payload.size()) % 26U);
+    }
+    return payload;
+}
+
+/// @brief Reads the oldest pending message of the log and ensures it is uncorrupted
+/// @param log Log the message is read from
+/// @param id Set to the id of the message
+/// @return Whether the message is uncorrupted
+static bool Read_Front(Persistent_Log & log, uint32_t & id) {
+    Persistent_Record record = {};
+    if (!log.front(record) || record.payload_size > MAX_PAYLOAD_SIZE) {
+        return false;
+    }
+    std::string payload(record.payload_size, '\0');
+    if (!log.read(0U, reinterpret_cast<uint8_t *>(&payload[0]), payload.size())) {
+        return false;
+    }
+    id = static_cast<uint32_t>(record.timestamp);
+    return record.data_point_amount == 1U && payload == Build_Payload(id);
+}
+
+/// @brief Writer process, pushes and pops messages in a random order until it is killed and reports every completed operation over the given pipe
+/// @param pipe Writeable end of the pipe the operations are reported over
+/// @param next_id Id of the next pushed message
+/// @param seed Seed of the random order, differs for every writer process
+[[noreturn]] static void Run_Writer(int const & pipe, uint32_t next_id, uint32_t const & seed) {
+    File_Storage storage(LOG_PREFIX, SEGMENT_AMOUNT, SEGMENT_SIZE);
+    Persistent_Log log;
+    if (!log.Open(&storage)) {
+        _exit(EXIT_FAILURE);
+    }
+    std::mt19937 random(seed);
+    for (;;) {
+        Acknowledgement acknowledgement = {};
+        std::string const payload = Build_Payload(next_id);
+        if (random() % 3U != 0U && log.push(Publish_Priority::BULK, next_id, 1U, reinterpret_cast<uint8_t const *>(payload.data()), payload.size())) {
+            acknowledgement = {true, next_id++};
+        }
+        else if (!log.empty()) {
+            if (!Read_Front(log, acknowledgement.id) || !log.pop()) {
+                _exit(EXIT_FAILURE);
+            }
+            acknowledgement.pushed = false;
+        }
+        else {
+            continue;
+        }
+        if (write(pipe, &acknowledgement, sizeof(acknowledgement)) != static_cast<ssize_t>(sizeof(acknowledgement))) {
+            _exit(EXIT_FAILURE);
+        }
+    }
+}
+
+/// @brief Copies the files of the log, so that the recovered log can be checked by popping all messages without modifying the log the next writer process continues with
+static void Copy_Log() {
+    for (size_t segment = 0U; segment < SEGMENT_AMOUNT; segment++) {
+        std::string const suffix = std::to_string(segment) + ".log";
+        std::filesystem::path const source = LOG_PREFIX + suffix;
+        std::filesystem::path const destination = COPY_PREFIX + suffix;
+        std::filesystem::remove(destination);
+        if (std::filesystem::exists(source)) {
+            std::filesystem::copy_file(source, destination);
+        }
+    }
+}
+
+int main() {
+    std::filesystem::remove_all(LOG_DIRECTORY);
+    std::filesystem::create_directory(LOG_DIRECTORY);
+    std::mt19937 random(42U);
+
+    // Ids of the newest message whose push and pop has been acknowledged by any writer process
+    uint32_t pushed_id = 0U;
+    uint32_t popped_id = 0U;
+    for (size_t crash = 0U; crash < CRASH_AMOUNT; crash++) {
+        int pipe_ends[2] = {};
+        TEST_ASSERT(pipe(pipe_ends) == 0);
+        pid_t const writer = fork();
+        TEST_ASSERT(writer >= 0);
+        if (writer == 0) {
+            close(pipe_ends[0]);
+            Run_Writer(pipe_ends[1], pushed_id + 1U, static_cast<uint32_t>(crash));
+        }
+        close(pipe_ends[1]);
+        usleep(random() % MAX_RUN_TIME_US);
+        TEST_ASSERT(kill(writer, SIGKILL) == 0);
+        int status = 0;
+        TEST_ASSERT(waitpid(writer, &status, 0) == writer);
+        // Any other termination means the writer failed to open the log or read a corrupted message
+        TEST_ASSERT(WIFSIGNALED(status) && WTERMSIG(status) == SIGKILL);
+
+        Acknowledgement acknowledgement = {};
+        while (read(pipe_ends[0], &acknowledgement, sizeof(acknowledgement)) == static_cast<ssize_t>(sizeof(acknowledgement))) {
+            uint32_t & id = acknowledgement.pushed ? pushed_id : popped_id;
+            TEST_ASSERT(acknowledgement.id == id + 1U);
+            id = acknowledgement.id;
+        }
+        close(pipe_ends[0]);
+
+        // The recovered log has to contain exactly the acknowledged messages that have not been popped yet, in order and uncorrupted.
+        // Except for the single operation that might have completed without being acknowledged before the writer was killed,
+        // meaning the oldest message might already be popped and one more message than acknowledged might have been pushed
+        Copy_Log();
+        File_Storage storage(COPY_PREFIX, SEGMENT_AMOUNT, SEGMENT_SIZE);
+        Persistent_Log log;
+        TEST_ASSERT(log.Open(&storage));
+        uint32_t expected_id = popped_id + 1U;
+        size_t const size = log.size();
+        for (size_t i = 0U; i < size; i++) {
+            uint32_t id = 0U;
+            TEST_ASSERT(Read_Front(log, id));
+            if (i == 0U && id == expected_id + 1U && expected_id <= pushed_id) {
+                expected_id++;
+                popped_id++;
+            }
+            TEST_ASSERT(id == expected_id);
+            TEST_ASSERT(log.pop());
+            expected_id++;
+        }
+        TEST_ASSERT(log.empty());
+        uint32_t const newest_id = expected_id - 1U;
+        if (size == 0U && popped_id + 1U == pushed_id) {
+            popped_id = pushed_id;
+        }
+        TEST_ASSERT(newest_id == pushed_id || newest_id == pushed_id + 1U || (size == 0U && popped_id == pushed_id));
+        pushed_id = newest_id > pushed_id ? newest_id : pushed_id;
+    }
+
+    // Ensures the writer processes actually ran long enough to wrap around the ring multiple times
+    TEST_ASSERT(pushed_id > SEGMENT_AMOUNT * SEGMENT_SIZE / MAX_PAYLOAD_SIZE * 4U);
+    std::filesystem::remove_all(LOG_DIRECTORY);
+    return 0;
+}
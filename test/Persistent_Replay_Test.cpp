@@ -0,0 +1,115 @@
+// Local includes.
+#include "Fake_MQTT_Client.h"
+#include "File_Storage.h"
+#include "Test_Assert.h"
+#include "ThingsBoard.h"
+
+// Library includes.
+#include <filesystem>
+#include <string>
+
+
+constexpr size_t SEGMENT_AMOUNT = 4U;
+constexpr size_t SEGMENT_SIZE = 512U;
+char constexpr LOG_DIRECTORY[] = "Persistent_Replay_Test_Data";
+char constexpr LOG_PREFIX[] = "Persistent_Replay_Test_Data/log_";
+
+
+/// @brief Packet id of the message published the given amount of messages before the newest one
+/// @param client Client the messages have been published through
+/// @param age Amount of messages that have been published after the message, 0 for the newest one
+/// @return Packet id of the message
+static uint16_t Get_Packet_ID(Fake_MQTT_Client const & client, size_t const & age) {
+    return client.published[client.published.size() - 1U - age].packet_id;
+}
+
+/// @brief Amount of messages that are still kept in the log after the device rebooted
+/// @return Amount of recovered messages, that would be replayed again
+static size_t Recover_Log_Size() {
+    File_Storage storage(LOG_PREFIX, SEGMENT_AMOUNT, SEGMENT_SIZE);
+    Persistent_Log log;
+    TEST_ASSERT(log.Open(&storage));
+    return log.size();
+}
+
+int main() {
+    std::filesystem::remove_all(LOG_DIRECTORY);
+    std::filesystem::create_directory(LOG_DIRECTORY);
+    {
+        File_Storage storage(LOG_PREFIX, SEGMENT_AMOUNT, SEGMENT_SIZE);
+        Fake_MQTT_Client client;
+        ThingsBoardSized<> tb(client, 256U, 256U);
+        TEST_ASSERT(tb.Set_Publish_QoS(Publish_Priority::BULK, MQTT_QoS::AT_LEAST_ONCE));
+        TEST_ASSERT(tb.Set_In_Flight_Window(2U));
+        TEST_ASSERT(tb.Set_Persistent_Store(&storage));
+
+        // Messages sent while disconnected are persisted and replayed once connected, at most the in-flight window at once
+        for (int value = 0; value < 5; value++) {
+            TEST_ASSERT(tb.Send_Telemetry_Data("a", value));
+        }
+        TEST_ASSERT(tb.Get_Persistent_Backlog() == 5U);
+        TEST_ASSERT(tb.connect("localhost", "token"));
+        TEST_ASSERT(client.published.empty());
+        tb.loop();
+        TEST_ASSERT(client.published.size() == 2U);
+        TEST_ASSERT(client.published[0U].payload == "{\"a\":0}");
+        TEST_ASSERT(client.published[1U].payload == "{\"a\":1}");
+
+        // Replayed messages are kept until the broker confirmed them, meaning they are replayed again after a reboot
+        tb.loop();
+        TEST_ASSERT(client.published.size() == 2U);
+        TEST_ASSERT(tb.Get_Persistent_Backlog() == 5U);
+        TEST_ASSERT(Recover_Log_Size() == 5U);
+
+        // Messages are only removed in order, therefore confirming the newer message keeps both until the older one has been confirmed as well
+        TEST_ASSERT(client.Acknowledge(Get_Packet_ID(client, 0U)));
+        tb.loop();
+        TEST_ASSERT(tb.Get_Persistent_Backlog() == 5U);
+        TEST_ASSERT(client.published.size() == 2U);
+        TEST_ASSERT(client.Acknowledge(Get_Packet_ID(client, 1U)));
+        tb.loop();
+        TEST_ASSERT(tb.Get_Persistent_Backlog() == 3U);
+        TEST_ASSERT(Recover_Log_Size() == 3U);
+        TEST_ASSERT(client.published.size() == 4U);
+        TEST_ASSERT(client.published[2U].payload == "{\"a\":2}");
+        TEST_ASSERT(client.published[3U].payload == "{\"a\":3}");
+
+        // Dropped message is replayed again, together with every newer message that is still kept, once the in-flight window allows it
+        uint16_t const dropped_packet_id = Get_Packet_ID(client, 1U);
+        uint16_t const newer_packet_id = Get_Packet_ID(client, 0U);
+        TEST_ASSERT(client.Drop(dropped_packet_id));
+        tb.loop();
+        TEST_ASSERT(tb.Get_Persistent_Backlog() == 3U);
+        TEST_ASSERT(client.published.size() == 5U);
+        TEST_ASSERT(client.published.back().payload == "{\"a\":2}");
+        TEST_ASSERT(client.Acknowledge(newer_packet_id));
+        tb.loop();
+        TEST_ASSERT(tb.Get_Persistent_Backlog() == 3U);
+        TEST_ASSERT(client.published.size() == 6U);
+        TEST_ASSERT(client.published.back().payload == "{\"a\":3}");
+
+        TEST_ASSERT(client.Acknowledge(Get_Packet_ID(client, 1U)));
+        TEST_ASSERT(client.Acknowledge(Get_Packet_ID(client, 0U)));
+        tb.loop();
+        TEST_ASSERT(tb.Get_Persistent_Backlog() == 1U);
+        TEST_ASSERT(client.published.size() == 7U);
+        TEST_ASSERT(client.published.back().payload == "{\"a\":4}");
+        TEST_ASSERT(client.Acknowledge(Get_Packet_ID(client, 0U)));
+        tb.loop();
+        TEST_ASSERT(tb.Get_Persistent_Backlog() == 0U);
+        TEST_ASSERT(Recover_Log_Size() == 0U);
+
+        // Messages published with QoS 0 can not be confirmed and are therefore removed once the client accepted them
+        client.Set_Connected(false);
+        TEST_ASSERT(tb.Send_Attribute_Data("b", 1));
+        TEST_ASSERT(tb.Get_Persistent_Backlog() == 1U);
+        client.Reconnect();
+        tb.loop();
+        TEST_ASSERT(tb.Get_Persistent_Backlog() == 0U);
+        TEST_ASSERT(client.published.back().payload == "{\"b\":1}");
+        TEST_ASSERT(client.published.back().packet_id == 0U);
+        TEST_ASSERT(!client.protocol_error);
+    }
+    std::filesystem::remove_all(LOG_DIRECTORY);
+    return 0;
+}
@@ -0,0 +1,286 @@
+// Local includes.
+#include "Fake_MQTT_Client.h"
+#include "Fixed_Buffer_Writer.h"
+#include "Protobuf_Reader.h"
+#include "Protobuf_Serializer.h"
+#include "Server_Side_RPC.h"
+#include "Shared_Attribute_Update.h"
+#include "Test_Assert.h"
+#include "ThingsBoard.h"
+
+// Library includes.
+#include <random>
+#include <string>
+#include <vector>
+
+
+// Amount of randomly generated messages that are encoded, decoded and encoded again
+constexpr size_t RANDOM_MESSAGE_AMOUNT = 20000U;
+constexpr size_t MAX_FIELDS_PER_MESSAGE = 16U;
+constexpr uint32_t MAX_FIELD_NUMBER = 536870911U;
+constexpr size_t MAX_MESSAGE_SIZE = 4096U;
+
+
+/// @brief Single decoded field of a randomly generated message
+struct Random_Field {
+    uint32_t      number; // Number of the field
+    Protobuf_Type type;   // Type the field was written as
+    uint64_t      bits;   // Value of integral fields or raw bits of floating point fields
+    std::string   str;    // Value of string fields
+};
+
+
+/// @brief Builds a message from the given bytes
+/// @param bytes Bytes of the message
+/// @return Message containing exactly the given bytes
+static std::string Bytes(std::initializer_list<uint8_t> bytes) {
+    return std::string(bytes.begin(), bytes.end());
+}
+
+/// @brief Writes the given field with the serializer
+/// @param writer Writer the field is written into
+/// @param field Field that should be written
+/// @return Amount of bytes that have been written
+static size_t Write_Field(Fixed_Buffer_Writer & writer, Random_Field const & field) {
+    switch (field.type) {
+        case Protobuf_Type::FLOAT: {
+            float value = 0.0F;
+            uint32_t const bits = static_cast<uint32_t>(field.bits);
+            (void)memcpy(&value, &bits, sizeof(value));
+            return Protobuf_Serializer::Write_Real_Field(writer, field.number, field.type, value);
+        }
+        case Protobuf_Type::DOUBLE: {
+            double value = 0.0;
+            (void)memcpy(&value, &field.bits, sizeof(value));
+            return Protobuf_Serializer::Write_Real_Field(writer, field.number, field.type, value);
+        }
+        case Protobuf_Type::STRING:
+            return Protobuf_Serializer::Write_String_Field(writer, field.number, field.str.c_str());
+        default:
+            return Protobuf_Serializer::Write_Integer_Field(writer, field.number, field.type, static_cast<int64_t>(field.bits));
+    }
+}
+
+/// @brief Encodes the given fields into a message
+/// @param fields Fields of the message
+/// @return Encoded message
+static std::string Encode(std::vector<Random_Field> const & fields) {
+    char buffer[MAX_MESSAGE_SIZE] = {};
+    Fixed_Buffer_Writer writer(buffer, sizeof(buffer));
+    size_t size = 0U;
+    for (auto const & field : fields) {
+        size += Write_Field(writer, field);
+    }
+    TEST_ASSERT(size <= sizeof(buffer));
+    return std::string(buffer, size);
+}
+
+/// @brief Decodes the given message with the types the fields were written as, the zigzag and 32-bit types are converted back into the written value
+/// @param message Encoded message
+/// @param types Types of the fields in the order they were written in
+/// @return Decoded fields
+static std::vector<Random_Field> Decode(std::string const & message, std::vector<Protobuf_Type> const & types) {
+    std::vector<Random_Field> fields;
+    Protobuf_Reader reader(reinterpret_cast<uint8_t const *>(message.data()), message.size());
+    uint32_t number = 0U;
+    Protobuf_Wire_Type wire_type = {};
+    while (reader.Next_Field(number, wire_type)) {
+        TEST_ASSERT(fields.size() < types.size());
+        Random_Field field = {number, types[fields.size()], 0U, {}};
+        uint32_t fixed = 0U;
+        uint8_t const * data = nullptr;
+        size_t size = 0U;
+        switch (field.type) {
+            case Protobuf_Type::FLOAT:
+                TEST_ASSERT(wire_type == Protobuf_Wire_Type::FIXED32 && reader.Read_Fixed32(fixed));
+                field.bits = fixed;
+                break;
+            case Protobuf_Type::DOUBLE:
+                TEST_ASSERT(wire_type == Protobuf_Wire_Type::FIXED64 && reader.Read_Fixed64(field.bits));
+                break;
+            case Protobuf_Type::STRING:
+                TEST_ASSERT(wire_type == Protobuf_Wire_Type::LENGTH_DELIMITED && reader.Read_Length_Delimited(data, size));
+                field.str.assign(reinterpret_cast<char const *>(data), size);
+                break;
+            case Protobuf_Type::SINT32:
+            case Protobuf_Type::SINT64:
+                TEST_ASSERT(wire_type == Protobuf_Wire_Type::VARINT && reader.Read_Varint(field.bits));
+                field.bits = (field.bits >> 1U) ^ (UINT64_C(0) - (field.bits & 1U));
+                break;
+            default:
+                TEST_ASSERT(wire_type == Protobuf_Wire_Type::VARINT && reader.Read_Varint(field.bits));
+                break;
+        }
+        if (field.type == Protobuf_Type::INT32 || field.type == Protobuf_Type::SINT32) {
+            field.bits = static_cast<uint64_t>(static_cast<int64_t>(static_cast<int32_t>(field.bits)));
+        }
+        fields.push_back(field);
+    }
+    TEST_ASSERT(!reader.Is_Malformed());
+    return fields;
+}
+
+/// @brief Generates a random field, integral values are kept inside of the range of their type
+/// @param random Random number generator
+/// @return Generated field
+static Random_Field Generate_Field(std::mt19937_64 & random) {
+    static Protobuf_Type constexpr TYPES[] = { Protobuf_Type::BOOL, Protobuf_Type::INT32, Protobuf_Type::INT64, Protobuf_Type::UINT32, Protobuf_Type::UINT64,
+                                               Protobuf_Type::SINT32, Protobuf_Type::SINT64, Protobuf_Type::FLOAT, Protobuf_Type::DOUBLE, Protobuf_Type::STRING };
+    Random_Field field = {1U + static_cast<uint32_t>(random() % MAX_FIELD_NUMBER), TYPES[random() % (sizeof(TYPES) / sizeof(TYPES[0U]))], random(), {}};
+    // Small values are far more common in practice and exercise the short variable length integers
+    if (random() % 2U == 0U) {
+        field.bits >>= random() % 64U;
+    }
+    switch (field.type) {
+        case Protobuf_Type::BOOL:
+            field.bits &= 1U;
+            break;
+        case Protobuf_Type::INT32:
+        case Protobuf_Type::SINT32:
+            field.bits = static_cast<uint64_t>(static_cast<int64_t>(static_cast<int32_t>(field.bits)));
+            break;
+        case Protobuf_Type::UINT32:
+            field.bits &= UINT32_MAX;
+            break;
+        case Protobuf_Type::FLOAT:
+            field.bits &= UINT32_MAX;
+            // NaN might be converted into a quiet NaN with different bits when passed as a double, therefore it is replaced with infinity
+            if ((field.bits & 0x7F800000U) == 0x7F800000U) {
+                field.bits &= 0xFF800000U;
+            }
+            break;
+        case Protobuf_Type::DOUBLE:
+            if ((field.bits & UINT64_C(0x7FF0000000000000)) == UINT64_C(0x7FF0000000000000)) {
+                field.bits &= UINT64_C(0xFFF0000000000000);
+            }
+            break;
+        case Protobuf_Type::STRING:
+            field.bits = 0U;
+            field.str.resize(random() % 200U);
+            for (auto & character : field.str) {
+                character = static_cast<char>(1U + random() % 255U);
+            }
+            break;
+        default:
+            // Nothing to do
+            break;
+    }
+    return field;
+}
+
+int main() {
+    // Encodings from https://protobuf.dev/programming-guides/encoding/
+    TEST_ASSERT(Encode({{1U, Protobuf_Type::INT32, 150U, {}}}) == Bytes({0x08U, 0x96U, 0x01U}));
+    TEST_ASSERT(Encode({{2U, Protobuf_Type::STRING, 0U, "testing"}}) == Bytes({0x12U, 0x07U, 't', 'e', 's', 't', 'i', 'n', 'g'}));
+    TEST_ASSERT(Encode({{1U, Protobuf_Type::INT32, static_cast<uint64_t>(-2), {}}}) == Bytes({0x08U, 0xFEU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0x01U}));
+    TEST_ASSERT(Encode({{1U, Protobuf_Type::SINT32, static_cast<uint64_t>(-2), {}}}) == Bytes({0x08U, 0x03U}));
+    TEST_ASSERT(Encode({{MAX_FIELD_NUMBER, Protobuf_Type::BOOL, 1U, {}}}) == Bytes({0xF8U, 0xFFU, 0xFFU, 0xFFU, 0x0FU, 0x01U}));
+
+    // Every randomly generated message has to decode into the written values and encode into the exact same bytes again
+    std::mt19937_64 random(19U);
+    for (size_t i = 0U; i < RANDOM_MESSAGE_AMOUNT; i++) {
+        std::vector<Random_Field> fields(random() % (MAX_FIELDS_PER_MESSAGE + 1U));
+        std::vector<Protobuf_Type> types;
+        for (auto & field : fields) {
+            field = Generate_Field(random);
+            types.push_back(field.type);
+        }
+        std::string const message = Encode(fields);
+        std::vector<Random_Field> const decoded = Decode(message, types);
+        TEST_ASSERT(decoded.size() == fields.size());
+        for (size_t j = 0U; j < fields.size(); j++) {
+            TEST_ASSERT(decoded[j].number == fields[j].number && decoded[j].bits == fields[j].bits && decoded[j].str == fields[j].str);
+        }
+        TEST_ASSERT(Encode(decoded) == message);
+
+        // Reading a truncated message must never access any byte outside of its bounds, the copy is allocated with the exact size so AddressSanitizer detects any such access
+        if (!message.empty()) {
+            std::vector<uint8_t> const truncated(message.begin(), message.begin() + random() % message.size());
+            Protobuf_Reader reader(truncated.data(), truncated.size());
+            uint32_t number = 0U;
+            Protobuf_Wire_Type wire_type = {};
+            while (reader.Next_Field(number, wire_type) && reader.Skip_Field(wire_type)) {
+                // Nothing to do
+            }
+        }
+    }
+
+    Fake_MQTT_Client client;
+    Server_Side_RPC<> rpc;
+    Shared_Attribute_Update<> shared_attributes;
+    ThingsBoardSized<> tb(client, 256U, 256U);
+    TEST_ASSERT(tb.Subscribe_API_Implementation(rpc));
+    TEST_ASSERT(tb.Subscribe_API_Implementation(shared_attributes));
+    TEST_ASSERT(tb.connect("localhost", "token"));
+
+    // Telemetry is encoded in the order it was passed in, with the number and type of its field in the schema
+    static Protobuf_Field constexpr fields[] = { {"temperature", 1U, Protobuf_Type::DOUBLE}, {"humidity", 2U, Protobuf_Type::INT32}, {"offset", 3U, Protobuf_Type::SINT32},
+                                                 {"name", 4U, Protobuf_Type::STRING}, {"active", 5U, Protobuf_Type::BOOL}, {"samples", 6U, Protobuf_Type::FLOAT} };
+    Protobuf_Schema const schema(fields);
+    float samples[] = { 1.0F, -0.5F };
+    Telemetry const values[] = { Telemetry("temperature", 1.5), Telemetry("humidity", -1), Telemetry("offset", -2), Telemetry("name", "hi"), Telemetry("active", true), Telemetry("samples", &samples[0], 2U) };
+    TEST_ASSERT(tb.Send_Telemetry_Protobuf(schema, std::begin(values), std::end(values)));
+    TEST_ASSERT(client.published.back().topic == TELEMETRY_TOPIC);
+    TEST_ASSERT(client.published.back().payload == Bytes({0x09U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0xF8U, 0x3FU,
+                                                          0x10U, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0x01U,
+                                                          0x18U, 0x03U,
+                                                          0x22U, 0x02U, 'h', 'i',
+                                                          0x28U, 0x01U,
+                                                          0x32U, 0x08U, 0x00U, 0x00U, 0x80U, 0x3FU, 0x00U, 0x00U, 0x00U, 0xBFU}));
+    Telemetry const unknown[] = { Telemetry("unknown", 1) };
+    TEST_ASSERT(!tb.Send_Telemetry_Protobuf(schema, std::begin(unknown), std::end(unknown)));
+    TEST_ASSERT(tb.Get_Last_Publish_Result() == Publish_Result::INVALID_PAYLOAD);
+    // Messages without any field are valid and encoded as 0 bytes
+    size_t const published_amount = client.published.size();
+    TEST_ASSERT(tb.Send_Telemetry_Protobuf(schema, std::begin(values), std::begin(values)));
+    TEST_ASSERT(client.published.size() == published_amount + 1U);
+    TEST_ASSERT(client.published.back().payload.empty());
+
+    // Server-side RPC request { method: "echo", params: "{\"x\":7}" } has to be answered with the json response in the payload field, independent of the field order
+    static int received = 0;
+    RPC_Callback const callback("echo", [](JsonVariantConst const & params, JsonDocument & response) {
+        received = params["x"].as<int>();
+        response["v"] = received;
+    }, JSON_OBJECT_SIZE(1U));
+    TEST_ASSERT(rpc.RPC_Subscribe(callback));
+    TEST_ASSERT(rpc.Set_Process_Type(API_Process_Type::PROTOBUF));
+    TEST_ASSERT(!rpc.Set_Process_Type(API_Process_Type::RAW));
+    std::string const params = "{\"x\":7}";
+    client.Receive("v1/devices/me/rpc/request/3", Bytes({0x0AU, 0x04U, 'e', 'c', 'h', 'o', 0x1AU, static_cast<uint8_t>(params.size())}) + params);
+    TEST_ASSERT(received == 7);
+    TEST_ASSERT(client.published.back().topic == "v1/devices/me/rpc/response/3");
+    TEST_ASSERT(client.published.back().payload == Bytes({0x0AU, 0x07U}) + "{\"v\":7}");
+    client.Receive("v1/devices/me/rpc/request/4", Bytes({0x1AU, static_cast<uint8_t>(params.size())}) + "{\"x\":9}" + Bytes({0x0AU, 0x04U, 'e', 'c', 'h', 'o'}));
+    TEST_ASSERT(received == 9);
+    TEST_ASSERT(client.published.back().payload == Bytes({0x0AU, 0x07U}) + "{\"v\":9}");
+    // Responses whose encoded message is bigger than the send buffer size are streamed, with the size of the field encoded as a multi byte variable length integer
+    static std::string const padding(300U, 'a');
+    RPC_Callback const padded_callback("pad", [](JsonVariantConst const & params, JsonDocument & response) {
+        (void)params;
+        response["v"] = padding.c_str();
+    }, JSON_OBJECT_SIZE(1U));
+    TEST_ASSERT(rpc.RPC_Subscribe(padded_callback));
+    client.Receive("v1/devices/me/rpc/request/5", Bytes({0x0AU, 0x03U, 'p', 'a', 'd'}));
+    TEST_ASSERT(client.published.back().topic == "v1/devices/me/rpc/response/5");
+    TEST_ASSERT(client.published.back().payload == Bytes({0x0AU, 0xB4U, 0x02U}) + "{\"v\":\"" + padding + "\"}");
+
+    // Shared attribute update { sharedUpdated: [{ ts: 1, kv: { key: "k", type: LONG, long_v: 42 } }, { kv: { key: "s", type: STRING, string_v: "ab" } }], sharedDeleted: ["z"] }
+    static std::string updated;
+    Shared_Attribute_Callback const shared_callback([](JsonObjectConst const & data) {
+        updated.clear();
+        (void)serializeJson(data, updated);
+    });
+    TEST_ASSERT(shared_attributes.Shared_Attributes_Subscribe(shared_callback));
+    TEST_ASSERT(shared_attributes.Set_Process_Type(API_Process_Type::PROTOBUF));
+    std::string const long_value = Bytes({0x0AU, 0x01U, 'k', 0x10U, 0x01U, 0x20U, 0x2AU});
+    std::string const long_update = Bytes({0x08U, 0x01U, 0x12U, static_cast<uint8_t>(long_value.size())}) + long_value;
+    std::string const string_value = Bytes({0x0AU, 0x01U, 's', 0x10U, 0x03U, 0x32U, 0x02U, 'a', 'b'});
+    std::string const string_update = Bytes({0x12U, static_cast<uint8_t>(string_value.size())}) + string_value;
+    std::string const update = Bytes({0x0AU, static_cast<uint8_t>(long_update.size())}) + long_update + Bytes({0x0AU, static_cast<uint8_t>(string_update.size())}) + string_update + Bytes({0x12U, 0x01U, 'z'});
+    client.Receive(ATTRIBUTE_TOPIC, update);
+    TEST_ASSERT(updated == "{\"k\":42,\"s\":\"ab\"}");
+    updated.clear();
+    client.Receive(ATTRIBUTE_TOPIC, update.substr(0U, update.size() - 4U));
+    TEST_ASSERT(updated.empty());
+    return 0;
+}
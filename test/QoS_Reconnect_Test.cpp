@@ -0,0 +1,85 @@
+// Local includes.
+#include "Fake_MQTT_Client.h"
+#include "Test_Assert.h"
+#include "ThingsBoard.h"
+
+// Library includes.
+#include <utility>
+#include <vector>
+
+
+int main() {
+    Fake_MQTT_Client client;
+    client.Set_Topic_Alias_Maximum(4U);
+    ThingsBoardSized<> tb(client, 256U, 256U);
+    static std::vector<std::pair<uint16_t, bool>> reports;
+    tb.Set_Delivery_Callback([](uint16_t packet_id, bool delivered) {
+        reports.emplace_back(packet_id, delivered);
+    });
+    TEST_ASSERT(tb.connect("localhost", "token"));
+    TEST_ASSERT(client.Is_MQTT_5());
+    TEST_ASSERT(tb.Set_Publish_QoS(Publish_Priority::BULK, MQTT_QoS::AT_LEAST_ONCE));
+    TEST_ASSERT(tb.Set_In_Flight_Window(3U));
+
+    // Messages published with QoS 1 always contain the full topic together with the alias, because they are resent after a reconnect
+    for (int value = 0; value < 3; value++) {
+        TEST_ASSERT(tb.Send_Telemetry_Data("a", value));
+        Published_Message const & message = client.published.back();
+        TEST_ASSERT(message.topic == TELEMETRY_TOPIC);
+        TEST_ASSERT(message.topic_alias == 1U);
+        TEST_ASSERT(!message.alias_only);
+        TEST_ASSERT(message.packet_id == tb.Get_Last_Packet_ID());
+    }
+    TEST_ASSERT(tb.Get_In_Flight_Amount() == 3U);
+    uint16_t const first_packet_id = client.published[client.published.size() - 3U].packet_id;
+
+    // Full in-flight window refuses further messages with QoS 1, but not the ones of classes published with QoS 0, which still only send the established alias
+    TEST_ASSERT(!tb.Send_Telemetry_Data("a", 3));
+    TEST_ASSERT(tb.Get_Last_Publish_Result() == Publish_Result::WOULD_BLOCK);
+    TEST_ASSERT(tb.Send_Attribute_Data("b", 1));
+    TEST_ASSERT(tb.Send_Attribute_Data("b", 2));
+    TEST_ASSERT(client.published.back().alias_only);
+    TEST_ASSERT(client.published.back().packet_id == 0U);
+
+    // Acknowledged messages free their place in the window once they are handed over in loop()
+    TEST_ASSERT(client.Acknowledge(first_packet_id));
+    TEST_ASSERT(tb.Get_In_Flight_Amount() == 3U);
+    tb.loop();
+    TEST_ASSERT(tb.Get_In_Flight_Amount() == 2U);
+    TEST_ASSERT(reports.size() == 1U && reports.back().first == first_packet_id && reports.back().second);
+
+    // Reconnecting with unacknowledged messages resends them exactly as they were first sent, which the broker has to be able to resolve even though it forgot every alias
+    size_t const published_before_reconnect = client.published.size();
+    client.Reconnect();
+    TEST_ASSERT(!client.protocol_error);
+    TEST_ASSERT(client.connected());
+    TEST_ASSERT(client.published.size() == published_before_reconnect + 2U);
+    for (size_t i = published_before_reconnect; i < client.published.size(); i++) {
+        Published_Message const & message = client.published[i];
+        TEST_ASSERT(message.topic == TELEMETRY_TOPIC);
+        TEST_ASSERT(!message.alias_only);
+        TEST_ASSERT(message.packet_id == first_packet_id + i - published_before_reconnect + 1U);
+    }
+
+    // Messages with QoS 0 on an alias that was established by a resent message only send the alias again
+    TEST_ASSERT(tb.Send_Attribute_Data("b", 3));
+    TEST_ASSERT(!client.published.back().alias_only);
+    TEST_ASSERT(tb.Send_Attribute_Data("b", 4));
+    TEST_ASSERT(client.published.back().alias_only);
+    TEST_ASSERT(!client.protocol_error);
+
+    // Acknowledging the resent messages empties the window again, so that new messages with QoS 1 are accepted
+    TEST_ASSERT(client.Acknowledge(first_packet_id + 1U));
+    TEST_ASSERT(client.Acknowledge(first_packet_id + 2U));
+    TEST_ASSERT(client.get_outbox_size() == 0U);
+    tb.loop();
+    TEST_ASSERT(tb.Get_In_Flight_Amount() == 0U);
+    TEST_ASSERT(reports.size() == 3U);
+    for (auto const & report : reports) {
+        TEST_ASSERT(report.second);
+    }
+    TEST_ASSERT(tb.Send_Telemetry_Data("a", 4));
+    TEST_ASSERT(!client.published.back().alias_only);
+    TEST_ASSERT(tb.Get_In_Flight_Amount() == 1U);
+    return 0;
+}
@@ -0,0 +1,58 @@
+// Local includes.
+#include "Fake_MQTT_Client.h"
+#include "IReport_Filter.h"
+#include "Test_Assert.h"
+#include "ThingsBoard.h"
+
+// Library includes.
+#include <string>
+#include <string.h>
+
+
+/// @brief Report filter dropping a single key, that counts how often it has been asked and informed
+class Counting_Filter : public IReport_Filter {
+  public:
+    bool Is_Reportable(Telemetry const & data, uint32_t const & current_time) override {
+        (void)current_time;
+        reportable_calls++;
+        return strcmp(data.GetKey(), "skipped") != 0;
+    }
+
+    void Reported(Telemetry const & data, uint32_t const & current_time) override {
+        (void)data;
+        (void)current_time;
+        reported_calls++;
+    }
+
+    void Reset() override {
+        // Nothing to do
+    }
+
+    size_t reportable_calls = {}; // Amount of times Is_Reportable has been called
+    size_t reported_calls = {};   // Amount of times Reported has been called
+};
+
+
+int main() {
+    Fake_MQTT_Client client;
+    ThingsBoardSized<> tb(client, 64U, 32U);
+    Counting_Filter filter;
+    tb.Set_Telemetry_Filter(&filter);
+    TEST_ASSERT(tb.connect("localhost", "token"));
+
+    // Filter is asked once per key-value pair, even though the key-value pairs are counted, serialized and reported
+    Telemetry const small[] = { Telemetry("a", 1), Telemetry("skipped", 2), Telemetry("b", 3) };
+    TEST_ASSERT(tb.Send_Telemetry(small + 0U, small + 3U));
+    TEST_ASSERT(client.published.back().payload == "{\"a\":1,\"b\":3}");
+    TEST_ASSERT(filter.reportable_calls == 3U);
+    TEST_ASSERT(filter.reported_calls == 2U);
+
+    // Payloads bigger than the send buffer are serialized a second time while streaming them, which reuses the same decisions
+    std::string const value(40U, 'x');
+    Telemetry const big[] = { Telemetry("skipped", 1), Telemetry("c", value.c_str()), Telemetry("d", 4), Telemetry("skipped", 5) };
+    TEST_ASSERT(tb.Send_Telemetry(big + 0U, big + 4U));
+    TEST_ASSERT(client.published.back().payload == "{\"c\":\"" + value + "\",\"d\":4}");
+    TEST_ASSERT(filter.reportable_calls == 7U);
+    TEST_ASSERT(filter.reported_calls == 4U);
+    return 0;
+}
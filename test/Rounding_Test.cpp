@@ -0,0 +1,98 @@
+// Local includes.
+#include "Fake_MQTT_Client.h"
+#include "Fixed_Buffer_Writer.h"
+#include "Test_Assert.h"
+#include "ThingsBoard.h"
+
+// Library includes.
+#include <random>
+#include <string>
+
+
+// Amount of random values every property is checked for
+constexpr size_t RANDOM_VALUE_AMOUNT = 1000000U;
+char constexpr TEMPERATURE_KEY[] = "temperature";
+char constexpr HUMIDITY_KEY[] = "humidity";
+using Climate_Schema = Telemetry_Schema<Telemetry_Fixed_Field<TEMPERATURE_KEY, float, 1U>, Telemetry_Fixed_Field<HUMIDITY_KEY, double, 2U>>;
+
+
+/// @brief Writes the given value rounded to the given amount of decimal places
+/// @param value Floating point number that should be written
+/// @param decimal_places Amount of decimal places the number is rounded to
+/// @return Written text
+static std::string Write_Fixed(double const & value, uint8_t const & decimal_places) {
+    char buffer[64U] = {};
+    Fixed_Buffer_Writer writer(buffer, sizeof(buffer));
+    return std::string(buffer, Json_Serializer::Write_Real_Fixed(writer, value, decimal_places));
+}
+
+/// @brief Writes the given value in the format ArduinoJson uses as well
+/// @param value Floating point number that should be written
+/// @return Written text
+static std::string Write_Compatible(double const & value) {
+    char buffer[64U] = {};
+    Fixed_Buffer_Writer writer(buffer, sizeof(buffer));
+    return std::string(buffer, Json_Serializer::Write_Real_Compatible(writer, value));
+}
+
+int main() {
+    // Compatible format splits 9 significant digits between the integral and decimal part like ArduinoJson, where rounding might carry over into the integral part and the exponent
+    TEST_ASSERT(Write_Compatible(123.123456789123) == "123.1234568");
+    TEST_ASSERT(Write_Compatible(-9876543.21987654) == "-9876543.22");
+    TEST_ASSERT(Write_Compatible(0.123456789123) == "0.123456789");
+    TEST_ASSERT(Write_Compatible(99.99999999999) == "100");
+    TEST_ASSERT(Write_Compatible(12345678901.5) == "1.23456789e10");
+    TEST_ASSERT(Write_Compatible(1.5e-7) == "1.5e-7");
+
+    // Halves are rounded away from zero, numbers rounded to zero lose their sign and trailing zeros are removed
+    TEST_ASSERT(Write_Fixed(21.456, 2U) == "21.46");
+    TEST_ASSERT(Write_Fixed(0.125, 2U) == "0.13");
+    TEST_ASSERT(Write_Fixed(2.5, 0U) == "3");
+    TEST_ASSERT(Write_Fixed(-2.5, 0U) == "-3");
+    TEST_ASSERT(Write_Fixed(-0.004, 2U) == "0");
+    TEST_ASSERT(Write_Fixed(1.0, 3U) == "1");
+    TEST_ASSERT(Write_Fixed(-7.77777, 3U) == "-7.778");
+    TEST_ASSERT(Write_Fixed(0.1, 9U) == "0.1");
+    TEST_ASSERT(Write_Fixed(123456.789, 1U) == "123456.8");
+    TEST_ASSERT(Write_Fixed(0.000000004, 9U) == "0.000000004");
+    // More decimal places than supported are clamped, values not fitting into the precision of a double keep the compatible format and not finite values are written as null
+    TEST_ASSERT(Write_Fixed(1.23456789012, 12U) == "1.23456789");
+    TEST_ASSERT(Write_Fixed(1e300, 2U) == Write_Compatible(1e300));
+    TEST_ASSERT(Write_Fixed(NAN, 2U) == "null");
+    TEST_ASSERT(Write_Fixed(-INFINITY, 2U) == "null");
+
+    // Rounding before writing into a JsonDocument has to result in the same digits as writing the rounded value directly, as long as they fit into the 9 significant digits of the compatible format,
+    // the rounded value has to be the closest one and rounding it again must not change it anymore
+    std::mt19937_64 random(17U);
+    std::uniform_real_distribution<double> distribution(-1000.0, 1000.0);
+    for (size_t i = 0U; i < RANDOM_VALUE_AMOUNT; i++) {
+        double const value = distribution(random);
+        uint8_t const decimal_places = static_cast<uint8_t>(random() % 10U);
+        double const rounded = Json_Serializer::Round_To_Decimal_Places(value, decimal_places);
+        uint8_t integral_digits = 1U;
+        for (double remaining = fabs(rounded); remaining >= 10.0; remaining /= 10.0) {
+            integral_digits++;
+        }
+        if (integral_digits + decimal_places <= MAX_DECIMAL_PLACES) {
+            TEST_ASSERT(Write_Fixed(value, decimal_places) == Write_Compatible(rounded));
+        }
+        TEST_ASSERT(Json_Serializer::Round_To_Decimal_Places(rounded, decimal_places) == rounded);
+        TEST_ASSERT(fabs(rounded - value) <= 0.5 * pow(10.0, -decimal_places) + fabs(value) * 1e-15);
+    }
+
+    // Single values, referenced sample buffers and schema fields are rounded the same way once published
+    Fake_MQTT_Client client;
+    ThingsBoardSized<> tb(client, 256U, 256U);
+    TEST_ASSERT(tb.connect("localhost", "token"));
+    Telemetry const values[] = { Telemetry("a", 21.456, 2U), Telemetry("b", -0.004, 2U), Telemetry("c", 2.5, 0U), Telemetry("d", 1e300, 2U) };
+    TEST_ASSERT(tb.Send_Telemetry(std::begin(values), std::end(values)));
+    TEST_ASSERT(client.published.back().payload == "{\"a\":21.46,\"b\":0,\"c\":3,\"d\":" + Write_Compatible(1e300) + "}");
+    float samples[] = { 0.123456F, 1.0F, -7.77777F };
+    Telemetry samples_telemetry("samples", &samples[0], 3U);
+    samples_telemetry.SetDecimalPlaces(3U);
+    TEST_ASSERT(tb.Send_Telemetry(&samples_telemetry, &samples_telemetry + 1U));
+    TEST_ASSERT(client.published.back().payload == "{\"samples\":[0.123,1,-7.778]}");
+    TEST_ASSERT(tb.Send_Telemetry_Schema<Climate_Schema>(21.4567F, 55.5551));
+    TEST_ASSERT(client.published.back().payload == "{\"temperature\":21.5,\"humidity\":55.56}");
+    return 0;
+}
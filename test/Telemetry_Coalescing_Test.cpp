@@ -0,0 +1,48 @@
+// Local includes.
+#include "Fake_MQTT_Client.h"
+#include "Test_Assert.h"
+#include "ThingsBoard.h"
+
+// Library includes.
+#include <string.h>
+
+
+int main() {
+    Fake_MQTT_Client client;
+    ThingsBoardSized<> tb(client, 64U, 64U);
+    TEST_ASSERT(tb.connect("localhost", "token"));
+    TEST_ASSERT(tb.Set_Telemetry_Coalescing(60'000U, 4U));
+
+    // Keys and string values are copied, meaning the caller can reuse its buffers before the merged key-value pairs are sent
+    char key[16U] = {};
+    char value[16U] = {};
+    (void)strcpy(key, "state");
+    (void)strcpy(value, "idle");
+    TEST_ASSERT(tb.Send_Telemetry_Data(key, value));
+    (void)strcpy(key, "temp");
+    TEST_ASSERT(tb.Send_Telemetry_Data(key, 21));
+    (void)strcpy(key, "xxxxx");
+    (void)strcpy(value, "xxxx");
+    TEST_ASSERT(client.published.empty());
+    TEST_ASSERT(tb.Flush_Telemetry());
+    TEST_ASSERT(client.published.size() == 1U);
+    TEST_ASSERT(client.published.back().payload == "{\"state\":\"idle\",\"temp\":21}");
+
+    // Replaced string values still occupy the copied memory until the merged key-value pairs are sent,
+    // once it is used up they are sent early and merging continues with the latest value
+    for (int i = 0; i < 16; i++) {
+        (void)strcpy(key, "state");
+        (void)strcpy(value, i % 2 == 0 ? "running" : "stopped");
+        TEST_ASSERT(tb.Send_Telemetry_Data(key, value));
+    }
+    (void)strcpy(key, "xxxxx");
+    (void)strcpy(value, "xxxxxxx");
+    size_t const early_amount = client.published.size() - 1U;
+    TEST_ASSERT(early_amount > 0U);
+    TEST_ASSERT(tb.Flush_Telemetry());
+    TEST_ASSERT(client.published.size() == early_amount + 2U);
+    TEST_ASSERT(client.published.back().payload == "{\"state\":\"stopped\"}");
+
+    TEST_ASSERT(!client.protocol_error);
+    return 0;
+}
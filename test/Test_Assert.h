@@ -0,0 +1,19 @@
+#ifndef Test_Assert_h
+#define Test_Assert_h
+
+// Library includes.
+#include <stdio.h>
+#include <stdlib.h>
+
+
+/// @brief Aborts the test with the failed condition and its location if the given condition is false.
+/// Used instead of assert, because it also checks the condition in release builds where NDEBUG is defined
+#define TEST_ASSERT(condition) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: Assertion failed: %s\n", __FILE__, __LINE__, #condition); \
+            exit(EXIT_FAILURE); \
+        } \
+    } while (false)
+
+#endif // Test_Assert_h
@@ -0,0 +1,170 @@
+// Local includes.
+#include "Fixed_Buffer_Writer.h"
+#include "Test_Assert.h"
+#include "Time_Series_Buffer.h"
+
+// Library includes.
+#include <ArduinoJson.h>
+#include <deque>
+#include <math.h>
+#include <random>
+#include <string.h>
+#include <vector>
+
+
+// Amount of randomly generated samples that are compressed into the buffer
+constexpr size_t RANDOM_SAMPLE_AMOUNT = 20000U;
+constexpr size_t BLOCK_SIZE = 48U;
+constexpr size_t BLOCK_AMOUNT = 4U;
+constexpr size_t MAX_KEY_AMOUNT = 4U;
+constexpr size_t MAX_PAYLOAD_SIZE = 16384U;
+char constexpr INTEGER_KEY[] = "counter";
+char constexpr REAL_KEY[] = "temperature";
+char constexpr FLOAT_KEY[] = "voltage";
+char constexpr BOOLEAN_KEY[] = "enabled";
+
+
+/// @brief Single key-value pair of a sample, as it has been pushed into the buffer
+struct Expected_Value {
+    char const *key;     // Key of the key-value pair
+    bool       boolean;  // Whether the value is a boolean value
+    bool       integral; // Whether the value is an integral value
+    int64_t    integer;  // Value of integral and boolean key-value pairs
+    double     real;     // Value of floating point key-value pairs
+};
+
+/// @brief Single sample, as it has been pushed into the buffer
+struct Expected_Sample {
+    uint64_t                    timestamp; // Timestamp the sample has been pushed with
+    std::vector<Expected_Value> values;    // Key-value pairs contained in the sample
+};
+
+
+/// @brief Serializes the given amount of oldest samples and compares every timestamp, key and value against the expected samples
+/// @param buffer Buffer that is serialized
+/// @param expected Samples that have been pushed into the buffer and are still stored in it, the oldest one first
+/// @param sample_amount Amount of oldest samples that should be serialized, might be bigger than the amount of stored samples
+static void Expect_Round_Trip(Time_Series_Buffer & buffer, std::deque<Expected_Sample> const & expected, size_t const & sample_amount) {
+    static char payload[MAX_PAYLOAD_SIZE] = {};
+    Fixed_Buffer_Writer writer(payload, sizeof(payload) - 1U);
+    size_t data_point_amount = 0U;
+    size_t const size = buffer.Serialize(writer, sample_amount, data_point_amount);
+    TEST_ASSERT(size < sizeof(payload));
+    payload[size] = '\0';
+    TEST_ASSERT(strlen(payload) == size);
+
+    DynamicJsonDocument document(4U * MAX_PAYLOAD_SIZE);
+    TEST_ASSERT(deserializeJson(document, payload, size) == DeserializationError::Ok);
+    JsonArrayConst const samples = document.as<JsonArrayConst>();
+    size_t const amount = sample_amount < expected.size() ? sample_amount : expected.size();
+    TEST_ASSERT(samples.size() == amount);
+    size_t expected_data_point_amount = 0U;
+    for (size_t i = 0U; i < amount; i++) {
+        Expected_Sample const & sample = expected[i];
+        JsonObjectConst const serialized = samples[i];
+        TEST_ASSERT(serialized[TELEMETRY_TIMESTAMP_KEY].as<uint64_t>() == sample.timestamp);
+        JsonObjectConst const values = serialized[TELEMETRY_VALUES_KEY];
+        TEST_ASSERT(values.size() == sample.values.size());
+        for (auto const & value : sample.values) {
+            JsonVariantConst const serialized_value = values[value.key];
+            TEST_ASSERT(!serialized_value.isNull());
+            if (value.boolean) {
+                TEST_ASSERT(serialized_value.is<bool>());
+                TEST_ASSERT(serialized_value.as<bool>() == (value.integer != 0));
+            }
+            else if (value.integral) {
+                TEST_ASSERT(serialized_value.as<int64_t>() == value.integer);
+            }
+            else {
+                // Floating point values are stored losslessly, but written with at most 9 significant digits
+                double const real = serialized_value.as<double>();
+                TEST_ASSERT(fabs(real - value.real) <= fabs(value.real) * 1e-8);
+            }
+        }
+        expected_data_point_amount += sample.values.size();
+    }
+    TEST_ASSERT(data_point_amount == expected_data_point_amount);
+}
+
+int main() {
+    Time_Series_Buffer buffer;
+    TEST_ASSERT(buffer.Allocate(BLOCK_SIZE, BLOCK_AMOUNT, MAX_KEY_AMOUNT));
+    std::deque<Expected_Sample> expected;
+
+    // Serializing an empty buffer or more samples than are stored never writes a trailing separator
+    Expect_Round_Trip(buffer, expected, 3U);
+    Telemetry const first[] = { Telemetry(INTEGER_KEY, 1), Telemetry(REAL_KEY, 21.5) };
+    TEST_ASSERT(buffer.push(1451649600512U, first));
+    expected.push_back({ 1451649600512U, { { INTEGER_KEY, false, true, 1, 0.0 }, { REAL_KEY, false, false, 0, 21.5 } } });
+    Expect_Round_Trip(buffer, expected, 5U);
+
+    // Random walks with mostly evenly spaced timestamps and samples that do not contain every key,
+    // where the boolean key is only added later and therefore starts a new block
+    std::mt19937_64 random(5U);
+    uint64_t timestamp = 1451649600512U;
+    int64_t integer = 1;
+    double real = 21.5;
+    float voltage = 3.3F;
+    size_t overwritten = 0U;
+    for (size_t i = 0U; i < RANDOM_SAMPLE_AMOUNT; i++) {
+        timestamp += random() % 4U == 0U ? 1000U + random() % 50U : 1000U;
+        Telemetry data[MAX_KEY_AMOUNT] = {};
+        Expected_Sample sample = { timestamp, {} };
+        size_t size = 0U;
+        if (random() % 4U != 0U) {
+            integer += static_cast<int64_t>(random() % 21U) - 10;
+            data[size++] = Telemetry(INTEGER_KEY, integer);
+            sample.values.push_back({ INTEGER_KEY, false, true, integer, 0.0 });
+        }
+        if (random() % 4U != 0U) {
+            real += std::uniform_real_distribution<double>(-0.5, 0.5)(random);
+            data[size++] = Telemetry(REAL_KEY, real);
+            sample.values.push_back({ REAL_KEY, false, false, 0, real });
+        }
+        if (random() % 4U != 0U) {
+            // Single precision values only differ in a few bits of the stored double
+            voltage += static_cast<float>(static_cast<int>(random() % 5U) - 2) * 0.01F;
+            data[size++] = Telemetry(FLOAT_KEY, voltage);
+            sample.values.push_back({ FLOAT_KEY, false, false, 0, static_cast<double>(voltage) });
+        }
+        if (i >= RANDOM_SAMPLE_AMOUNT / 4U && random() % 2U == 0U) {
+            bool const enabled = random() % 3U == 0U;
+            data[size++] = Telemetry(BOOLEAN_KEY, enabled);
+            sample.values.push_back({ BOOLEAN_KEY, true, false, enabled, 0.0 });
+        }
+        if (size == 0U) {
+            continue;
+        }
+        TEST_ASSERT(buffer.push(timestamp, data, size));
+        expected.push_back(sample);
+
+        // Once the ring is full the oldest block is overwritten, which removes the oldest samples
+        size_t const newly_overwritten = buffer.Get_Overwritten_Amount() - overwritten;
+        TEST_ASSERT(newly_overwritten <= expected.size());
+        expected.erase(expected.begin(), expected.begin() + newly_overwritten);
+        overwritten = buffer.Get_Overwritten_Amount();
+        TEST_ASSERT(buffer.size() == expected.size());
+
+        if (i % 97U == 0U) {
+            Expect_Round_Trip(buffer, expected, expected.size());
+            Expect_Round_Trip(buffer, expected, expected.size() / 2U);
+            Expect_Round_Trip(buffer, expected, expected.size() + 1U);
+        }
+        if (i % 211U == 0U) {
+            // Removing the oldest samples continues decompressing from the same position the serialized samples ended at
+            size_t const popped = expected.size() / 3U;
+            buffer.pop(popped);
+            expected.erase(expected.begin(), expected.begin() + popped);
+            TEST_ASSERT(buffer.size() == expected.size());
+            Expect_Round_Trip(buffer, expected, expected.size());
+        }
+    }
+    TEST_ASSERT(overwritten > 0U);
+
+    // Emptying the buffer completely still results in a valid json array
+    buffer.pop(expected.size() + 1U);
+    expected.clear();
+    TEST_ASSERT(buffer.empty());
+    Expect_Round_Trip(buffer, expected, 2U);
+    return 0;
+}
@@ -0,0 +1,84 @@
+// Local includes.
+#include "Fake_MQTT_Client.h"
+#include "Test_Assert.h"
+#include "ThingsBoard.h"
+
+
+/// @brief Checks that the last published message was received on the given topic, with the given alias and with or without the full topic
+/// @param client Client the message has been published with
+/// @param topic Topic the broker has to resolve the message to
+/// @param topic_alias Alias the message has to be published with, 0 if it has to be published without one
+/// @param alias_only Whether only the alias has to be sent instead of the full topic
+static void Expect_Last(Fake_MQTT_Client const & client, char const * topic, uint16_t const & topic_alias, bool alias_only) {
+    TEST_ASSERT(!client.published.empty());
+    Published_Message const & message = client.published.back();
+    TEST_ASSERT(message.topic == topic);
+    TEST_ASSERT(message.topic_alias == topic_alias);
+    TEST_ASSERT(message.alias_only == alias_only);
+}
+
+int main() {
+    Fake_MQTT_Client client;
+    ThingsBoardSized<> tb(client, 256U, 256U);
+
+    // Without a configured maximum the client connects with MQTT 3.1.1 and always sends the full topic
+    TEST_ASSERT(tb.connect("localhost", "token"));
+    TEST_ASSERT(!client.Is_MQTT_5());
+    TEST_ASSERT(tb.Send_Telemetry_Data("a", 1));
+    Expect_Last(client, TELEMETRY_TOPIC, 0U, false);
+    TEST_ASSERT(tb.Send_Telemetry_Data("a", 2));
+    Expect_Last(client, TELEMETRY_TOPIC, 0U, false);
+
+    // The telemetry and attribute topic reserved by the ThingsBoard client get the first two aliases,
+    // the full topic is only sent together with the alias for the first message on each topic
+    client.Set_Topic_Alias_Maximum(4U);
+    tb.disconnect();
+    TEST_ASSERT(tb.connect("localhost", "token"));
+    TEST_ASSERT(client.Is_MQTT_5());
+    TEST_ASSERT(tb.Send_Telemetry_Data("a", 3));
+    Expect_Last(client, TELEMETRY_TOPIC, 1U, false);
+    TEST_ASSERT(tb.Send_Telemetry_Data("a", 4));
+    Expect_Last(client, TELEMETRY_TOPIC, 1U, true);
+    TEST_ASSERT(tb.Send_Attribute_Data("b", 5));
+    Expect_Last(client, ATTRIBUTE_TOPIC, 2U, false);
+    TEST_ASSERT(tb.Send_Attribute_Data("b", 6));
+    Expect_Last(client, ATTRIBUTE_TOPIC, 2U, true);
+    TEST_ASSERT(tb.Send_Telemetry_Data("a", 7));
+    Expect_Last(client, TELEMETRY_TOPIC, 1U, true);
+    // Topics without a reserved alias are always sent in full
+    TEST_ASSERT(tb.Claim_Request(1000U));
+    Expect_Last(client, CLAIM_TOPIC, 0U, false);
+
+    // The broker forgets every alias once the connection has been closed, therefore the first message after the reconnect has to contain the full topic again
+    client.Set_Connected(false);
+    client.Set_Connected(true);
+    TEST_ASSERT(tb.Send_Telemetry_Data("a", 8));
+    Expect_Last(client, TELEMETRY_TOPIC, 1U, false);
+    TEST_ASSERT(tb.Send_Telemetry_Data("a", 9));
+    Expect_Last(client, TELEMETRY_TOPIC, 1U, true);
+
+    // Aliases above the maximum accepted by the broker are not used, topics without a usable alias are sent in full
+    client.Set_Broker(1U, true);
+    tb.disconnect();
+    TEST_ASSERT(tb.connect("localhost", "token"));
+    TEST_ASSERT(client.Is_MQTT_5());
+    TEST_ASSERT(tb.Send_Telemetry_Data("a", 10));
+    Expect_Last(client, TELEMETRY_TOPIC, 1U, false);
+    TEST_ASSERT(tb.Send_Attribute_Data("b", 11));
+    Expect_Last(client, ATTRIBUTE_TOPIC, 0U, false);
+    TEST_ASSERT(tb.Send_Attribute_Data("b", 12));
+    Expect_Last(client, ATTRIBUTE_TOPIC, 0U, false);
+
+    // Brokers that only support MQTT 3.1.1 make the client fall back to it, without sending any alias
+    client.Set_Broker(4U, false);
+    tb.disconnect();
+    TEST_ASSERT(tb.connect("localhost", "token"));
+    TEST_ASSERT(!client.Is_MQTT_5());
+    TEST_ASSERT(tb.Send_Telemetry_Data("a", 13));
+    Expect_Last(client, TELEMETRY_TOPIC, 0U, false);
+    TEST_ASSERT(tb.Send_Telemetry_Data("a", 14));
+    Expect_Last(client, TELEMETRY_TOPIC, 0U, false);
+
+    TEST_ASSERT(!client.protocol_error);
+    return 0;
+}
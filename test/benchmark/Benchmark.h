@@ -0,0 +1,47 @@
+#ifndef Benchmark_h
+#define Benchmark_h
+
+// Library includes.
+#include <chrono>
+#include <stddef.h>
+#include <stdio.h>
+
+
+/// @brief Minimum duration every operation is repeated for, long enough to make the overhead of reading the clock negligible
+constexpr auto MIN_BENCHMARK_DURATION = std::chrono::milliseconds(200);
+
+
+/// @brief Prevents the compiler from removing the calculation of the given value, because its result is never used
+/// @tparam T Type of the value
+/// @param value Value that has to be calculated
+template<typename T>
+inline void Do_Not_Optimize(T const & value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/// @brief Repeats the given operation for at least @ref MIN_BENCHMARK_DURATION and prints the average duration of processing a single item
+/// @tparam Operation Callable that is measured
+/// @param name Non owning pointer to the name printed in front of the duration
+/// @param operation Callable that is measured, called once before the measurement starts to warm up caches and allocations
+/// @param items_per_call Amount of items processed by a single call, the printed and returned duration is divided by it, default = 1
+/// @return Average duration of processing a single item in nanoseconds
+template<typename Operation>
+double Run_Benchmark(char const * name, Operation operation, size_t const & items_per_call = 1U) {
+    operation();
+    size_t iterations = 0U;
+    auto const start = std::chrono::steady_clock::now();
+    auto end = start;
+    // Clock is only read once every batch, so reading it does not dominate very short operations
+    while (end - start < MIN_BENCHMARK_DURATION) {
+        for (size_t i = 0U; i < 64U; i++) {
+            operation();
+        }
+        iterations += 64U;
+        end = std::chrono::steady_clock::now();
+    }
+    double const nanoseconds = std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(iterations * items_per_call);
+    printf("%-56s %12.1f ns\n", name, nanoseconds);
+    return nanoseconds;
+}
+
+#endif // Benchmark_h
@@ -0,0 +1,95 @@
+// Local includes.
+#include "Benchmark.h"
+#include "Fixed_Buffer_Writer.h"
+#include "Telemetry.h"
+
+// Library includes.
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+
+// Amounts of key-value pairs serialized into a single payload
+constexpr size_t KEY_VALUE_AMOUNTS[] = { 4U, 16U, 64U };
+constexpr size_t MAX_PAYLOAD_SIZE = 4096U;
+
+
+/// @brief Serializes the given key-value pairs directly as json text with the Json_Serializer, like the send methods of ThingsBoardSized do
+/// @param data Key-value pairs that are serialized
+/// @param buffer Buffer the payload is written into, has to hold @ref MAX_PAYLOAD_SIZE bytes
+/// @return Size of the payload
+static size_t Serialize_Direct(std::vector<Telemetry> const & data, char * buffer) {
+    Fixed_Buffer_Writer writer(buffer, MAX_PAYLOAD_SIZE);
+    size_t size = Json_Serializer::Write_Character(writer, '{');
+    for (size_t i = 0U; i < data.size(); i++) {
+        if (i != 0U) {
+            size += Json_Serializer::Write_Character(writer, ',');
+        }
+        size += data[i].SerializeJson(writer);
+    }
+    return size + Json_Serializer::Write_Character(writer, '}');
+}
+
+/// @brief Serializes the given key-value pairs by first copying them into a JsonDocument and then serializing the document, like the send methods of ThingsBoardSized did before
+/// @param data Key-value pairs that are serialized
+/// @param buffer Buffer the payload is written into, has to hold @ref MAX_PAYLOAD_SIZE bytes
+/// @return Size of the payload
+static size_t Serialize_Document(std::vector<Telemetry> const & data, char * buffer) {
+    DynamicJsonDocument document(JSON_OBJECT_SIZE(data.size()));
+    for (auto const & key_value : data) {
+        if (!key_value.SerializeKeyValue(document)) {
+            return 0U;
+        }
+    }
+    return serializeJson(document, buffer, MAX_PAYLOAD_SIZE);
+}
+
+int main() {
+    static char constexpr KEYS[][12] = { "temperature", "humidity", "pressure", "voltage", "status", "enabled", "counter", "location" };
+    std::vector<std::string> keys;
+    for (size_t i = 0U; i < KEY_VALUE_AMOUNTS[sizeof(KEY_VALUE_AMOUNTS) / sizeof(KEY_VALUE_AMOUNTS[0U]) - 1U]; i++) {
+        keys.push_back(std::string(KEYS[i % 8U]) + std::to_string(i / 8U));
+    }
+
+    char buffer[MAX_PAYLOAD_SIZE] = {};
+    char document_buffer[MAX_PAYLOAD_SIZE] = {};
+    for (auto const & amount : KEY_VALUE_AMOUNTS) {
+        // Mix of the value types commonly sent as telemetry
+        std::vector<Telemetry> data;
+        for (size_t i = 0U; i < amount; i++) {
+            char const * key = keys[i].c_str();
+            switch (i % 4U) {
+                case 0U:
+                    data.emplace_back(key, 21.5F + static_cast<float>(i));
+                    break;
+                case 1U:
+                    data.emplace_back(key, static_cast<int>(1000U * i));
+                    break;
+                case 2U:
+                    data.emplace_back(key, "connected");
+                    break;
+                default:
+                    data.emplace_back(key, i % 8U == 3U);
+                    break;
+            }
+        }
+
+        // Both approaches have to succeed and write the exact same payload, otherwise the benchmark would not compare equivalent work
+        size_t const document_size = Serialize_Document(data, document_buffer);
+        size_t const direct_size = Serialize_Direct(data, buffer);
+        if (document_size == 0U || direct_size > MAX_PAYLOAD_SIZE || document_size != direct_size || memcmp(document_buffer, buffer, direct_size) != 0) {
+            printf("Serializing %zu key-value pairs directly does not result in the same payload as serializing them with a JsonDocument\n", amount);
+            return EXIT_FAILURE;
+        }
+        printf("%zu key-value pairs, payload size %zu bytes, JsonDocument capacity %zu bytes\n", amount, direct_size, JSON_OBJECT_SIZE(amount));
+        double const direct = Run_Benchmark("  Json_Serializer directly into the send buffer", [&]() {
+            Do_Not_Optimize(Serialize_Direct(data, buffer));
+        });
+        double const document = Run_Benchmark("  ArduinoJson DynamicJsonDocument and serializeJson", [&]() {
+            Do_Not_Optimize(Serialize_Document(data, buffer));
+        });
+        printf("  speedup %.2fx\n", document / direct);
+    }
+    return 0;
+}
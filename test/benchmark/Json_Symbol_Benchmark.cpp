@@ -0,0 +1,101 @@
+// Local includes.
+#include "Benchmark.h"
+#include "Helper.h"
+
+// Library includes.
+#include <random>
+#include <stdlib.h>
+#include <string>
+
+
+// Payload sizes received on the RPC and attribute topics, from a few values up to large configuration objects
+constexpr size_t PAYLOAD_SIZES[] = {1024U, 2048U, 4096U, 8192U, 16384U};
+
+
+/// @brief Counts the structural json symbols outside of string literals by comparing every byte on its own, which is what the word-wise comparison has to be equivalent to
+/// @param bytes Non owning pointer to the byte payload
+/// @param length Length of the byte payload
+/// @return Amount of occurences of the structural json symbols outside of string literals
+static size_t Calculate_Json_Symbol_Occurences_Byte_Per_Byte(uint8_t const * bytes, uint32_t length) {
+    size_t count = 0U;
+    bool in_string = false;
+    for (uint32_t i = 0U; i < length; i++) {
+        char const symbol = static_cast<char>(bytes[i]);
+        if (in_string) {
+            if (symbol == '\\') {
+                i++;
+            }
+            else if (symbol == '"') {
+                in_string = false;
+            }
+        }
+        else if (symbol == '"') {
+            in_string = true;
+        }
+        else if (symbol == ',' || symbol == '{' || symbol == '[') {
+            count++;
+        }
+    }
+    return count;
+}
+
+/// @brief Counts the structural json symbols with one pass per symbol, which was used to size the JsonDocument before the single string-aware pass
+/// @note Compilers for hosts with vector instructions (SSE2, NEON) vectorize each of the passes, which the supported boards can not do,
+/// therefore the host results underestimate the advantage of reading the payload only once
+/// @param bytes Non owning pointer to the byte payload
+/// @param length Length of the byte payload
+/// @return Amount of occurences of the structural json symbols, including the ones inside of string literals
+static size_t Calculate_Json_Symbol_Occurences_Per_Symbol(uint8_t const * bytes, uint32_t length) {
+    return Helper::Calculate_Symbol_Occurences(bytes, ',', length) + Helper::Calculate_Symbol_Occurences(bytes, '{', length) + Helper::Calculate_Symbol_Occurences(bytes, '[', length);
+}
+
+/// @brief Generates a json object with nested objects and arrays, and string values that contain escaped characters and symbols, until it is at least as long as the given size
+/// @param random Random number generator the keys and values are generated with
+/// @param size Minimum length of the generated payload
+/// @return Generated json payload
+static std::string Generate_Payload(std::mt19937 & random, size_t const & size) {
+    std::string payload = "{\"method\":\"setConfiguration\",\"params\":{";
+    for (size_t i = 0U; payload.size() < size; i++) {
+        payload += (i == 0U ? "\"key" : ",\"key") + std::to_string(i) + "\":";
+        switch (random() % 4U) {
+            case 0U:
+                payload += std::to_string(static_cast<int>(random() % 100000U) - 50000);
+                break;
+            case 1U:
+                payload += "[" + std::to_string(random() % 100U) + "," + std::to_string(random() % 100U) + ",true]";
+                break;
+            case 2U:
+                payload += "{\"enabled\":false,\"interval\":" + std::to_string(random() % 3600U) + "}";
+                break;
+            default:
+                payload += random() % 8U == 0U ? "\"C:\\\\data\\\\log, {\\\"level\\\": [1,2]}\"" : "\"value, with {symbols} and [brackets]\"";
+                break;
+        }
+    }
+    payload += "}}";
+    return payload;
+}
+
+int main() {
+    std::mt19937 random(24U);
+    for (auto const & size : PAYLOAD_SIZES) {
+        std::string const payload = Generate_Payload(random, size);
+        uint8_t const * bytes = reinterpret_cast<uint8_t const *>(payload.data());
+        uint32_t const length = static_cast<uint32_t>(payload.size());
+        if (Helper::Calculate_Json_Symbol_Occurences(bytes, length) != Calculate_Json_Symbol_Occurences_Byte_Per_Byte(bytes, length)) {
+            return EXIT_FAILURE;
+        }
+
+        printf("%zu bytes payload\n", payload.size());
+        Run_Benchmark("  Three Calculate_Symbol_Occurences passes", [&]() {
+            Do_Not_Optimize(Calculate_Json_Symbol_Occurences_Per_Symbol(bytes, length));
+        });
+        Run_Benchmark("  String-aware pass comparing every byte", [&]() {
+            Do_Not_Optimize(Calculate_Json_Symbol_Occurences_Byte_Per_Byte(bytes, length));
+        });
+        Run_Benchmark("  Helper::Calculate_Json_Symbol_Occurences", [&]() {
+            Do_Not_Optimize(Helper::Calculate_Json_Symbol_Occurences(bytes, length));
+        });
+    }
+    return 0;
+}
@@ -0,0 +1,99 @@
+// Local includes.
+#include "Benchmark.h"
+#include "Fixed_Buffer_Writer.h"
+#include "Json_Serializer.h"
+
+// Library includes.
+#include <random>
+#include <vector>
+
+
+// Amount of values formatted in a single call, small enough to keep all values and the written text in the cache
+constexpr size_t VALUE_AMOUNT = 4096U;
+// Maximum length of a single formatted value, including the sign and the exponent
+constexpr size_t MAX_VALUE_LENGTH = 32U;
+
+
+/// @brief Writes the digits of the given integer by repeatedly dividing it by 10, which was used before the table-driven formatting
+/// @param writer Writer the number is written into
+/// @param value Integer that should be written
+/// @return Amount of bytes that have been written
+static size_t Write_Integer_Digit_By_Digit(Fixed_Buffer_Writer & writer, int64_t const & value) {
+    char buffer[MAX_VALUE_LENGTH] = {};
+    char * start = buffer + sizeof(buffer);
+    uint64_t remaining = value < 0 ? UINT64_C(0) - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+    do {
+        *--start = static_cast<char>('0' + remaining % 10U);
+        remaining /= 10U;
+    } while (remaining != 0U);
+    if (value < 0) {
+        *--start = '-';
+    }
+    return writer.write(reinterpret_cast<uint8_t const *>(start), static_cast<size_t>(buffer + sizeof(buffer) - start));
+}
+
+/// @brief Writes the given value with snprintf and the given format
+/// @param writer Writer the number is written into
+/// @param format Non owning pointer to the printf format string
+/// @param value Value that should be written
+/// @return Amount of bytes that have been written
+template<typename T>
+static size_t Write_Printf(Fixed_Buffer_Writer & writer, char const * format, T const & value) {
+    char buffer[MAX_VALUE_LENGTH] = {};
+    int const length = snprintf(buffer, sizeof(buffer), format, value);
+    return writer.write(reinterpret_cast<uint8_t const *>(buffer), static_cast<size_t>(length));
+}
+
+/// @brief Measures writing every given value with the given formatter into a buffer
+/// @param name Non owning pointer to the name printed in front of the duration
+/// @param values Values that are written
+/// @param formatter Callable writing a single value into the given writer
+template<typename T, typename Formatter>
+static void Run_Format_Benchmark(char const * name, std::vector<T> const & values, Formatter formatter) {
+    static char output[VALUE_AMOUNT * MAX_VALUE_LENGTH] = {};
+    Run_Benchmark(name, [&]() {
+        Fixed_Buffer_Writer writer(output, sizeof(output));
+        size_t size = 0U;
+        for (auto const & value : values) {
+            size += formatter(writer, value);
+        }
+        Do_Not_Optimize(size);
+    }, values.size());
+}
+
+int main() {
+    std::mt19937_64 random(16U);
+    std::uniform_real_distribution<double> distribution(-1000.0, 1000.0);
+    std::vector<int64_t> integers;
+    std::vector<int64_t> small_integers;
+    std::vector<double> doubles;
+    std::vector<float> floats;
+    for (size_t i = 0U; i < VALUE_AMOUNT; i++) {
+        // Shifting by a random amount results in evenly distributed digit counts, instead of almost only 19 digit numbers
+        integers.push_back(static_cast<int64_t>(random()) >> (random() % 64U));
+        small_integers.push_back(static_cast<int64_t>(random() % 100000U));
+        doubles.push_back(distribution(random));
+        floats.push_back(static_cast<float>(distribution(random)));
+    }
+
+    printf("int64 with evenly distributed digit counts\n");
+    Run_Format_Benchmark("  Json_Serializer::Write_Integer", integers, [](Fixed_Buffer_Writer & writer, int64_t const & value) { return Json_Serializer::Write_Integer(writer, value); });
+    Run_Format_Benchmark("  Digit by digit", integers, Write_Integer_Digit_By_Digit);
+    Run_Format_Benchmark("  snprintf %lld", integers, [](Fixed_Buffer_Writer & writer, int64_t const & value) { return Write_Printf(writer, "%lld", static_cast<long long>(value)); });
+    printf("int64 between 0 and 99999\n");
+    Run_Format_Benchmark("  Json_Serializer::Write_Integer", small_integers, [](Fixed_Buffer_Writer & writer, int64_t const & value) { return Json_Serializer::Write_Integer(writer, value); });
+    Run_Format_Benchmark("  Digit by digit", small_integers, Write_Integer_Digit_By_Digit);
+    Run_Format_Benchmark("  snprintf %lld", small_integers, [](Fixed_Buffer_Writer & writer, int64_t const & value) { return Write_Printf(writer, "%lld", static_cast<long long>(value)); });
+
+    printf("double between -1000 and 1000\n");
+    Run_Format_Benchmark("  Json_Serializer::Write_Real_Compatible", doubles, [](Fixed_Buffer_Writer & writer, double const & value) { return Json_Serializer::Write_Real_Compatible(writer, value); });
+    Run_Format_Benchmark("  Json_Serializer::Write_Real_Shortest", doubles, [](Fixed_Buffer_Writer & writer, double const & value) { return Json_Serializer::Write_Real_Shortest(writer, value); });
+    Run_Format_Benchmark("  Json_Serializer::Write_Real_Fixed (3 decimal places)", doubles, [](Fixed_Buffer_Writer & writer, double const & value) { return Json_Serializer::Write_Real_Fixed(writer, value, 3U); });
+    Run_Format_Benchmark("  snprintf %.17g", doubles, [](Fixed_Buffer_Writer & writer, double const & value) { return Write_Printf(writer, "%.17g", value); });
+    printf("float between -1000 and 1000\n");
+    Run_Format_Benchmark("  Json_Serializer::Write_Real_Compatible", floats, [](Fixed_Buffer_Writer & writer, float const & value) { return Json_Serializer::Write_Real_Compatible(writer, value); });
+    Run_Format_Benchmark("  Json_Serializer::Write_Real_Shortest", floats, [](Fixed_Buffer_Writer & writer, float const & value) { return Json_Serializer::Write_Real_Shortest(writer, value); });
+    Run_Format_Benchmark("  Json_Serializer::Write_Real_Fixed (3 decimal places)", floats, [](Fixed_Buffer_Writer & writer, float const & value) { return Json_Serializer::Write_Real_Fixed(writer, value, 3U); });
+    Run_Format_Benchmark("  snprintf %.9g", floats, [](Fixed_Buffer_Writer & writer, float const & value) { return Write_Printf(writer, "%.9g", static_cast<double>(value)); });
+    return 0;
+}
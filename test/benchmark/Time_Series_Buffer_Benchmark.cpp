@@ -0,0 +1,102 @@
+// Local includes.
+#include "Benchmark.h"
+#include "Fixed_Buffer_Writer.h"
+#include "Time_Series_Buffer.h"
+
+// Library includes.
+#include <random>
+#include <stdlib.h>
+#include <vector>
+
+
+// Amount of samples kept while offline, one sample every second for about 17 minutes
+constexpr size_t SAMPLE_AMOUNT = 1024U;
+constexpr size_t KEY_AMOUNT = 4U;
+constexpr uint64_t FIRST_TIMESTAMP = 1451649600000U;
+constexpr uint64_t SAMPLE_INTERVAL = 1000U;
+// Enough blocks to keep every sample, so that no sample is overwritten
+constexpr size_t BLOCK_SIZE = 256U;
+constexpr size_t BLOCK_AMOUNT = 64U;
+constexpr size_t MAX_PAYLOAD_SIZE = 256U * 1024U;
+char constexpr TEMPERATURE_KEY[] = "temperature";
+char constexpr HUMIDITY_KEY[] = "humidity";
+char constexpr VOLTAGE_KEY[] = "voltage";
+char constexpr DOOR_KEY[] = "door";
+
+
+int main() {
+    // Typical sensor data, slowly changing temperature with one decimal place, rarely changing integral humidity, noisy voltage and a door that is rarely opened
+    std::mt19937 random(12U);
+    std::vector<Telemetry> data;
+    float temperature = 21.5F;
+    int humidity = 45;
+    for (size_t i = 0U; i < SAMPLE_AMOUNT; i++) {
+        temperature += static_cast<float>(static_cast<int>(random() % 3U) - 1) * 0.1F;
+        humidity += random() % 16U == 0U ? static_cast<int>(random() % 3U) - 1 : 0;
+        data.emplace_back(TEMPERATURE_KEY, temperature);
+        data.emplace_back(HUMIDITY_KEY, humidity);
+        data.emplace_back(VOLTAGE_KEY, 3.3 + static_cast<double>(random() % 1000U) / 100000.0);
+        data.emplace_back(DOOR_KEY, i % 300U < 10U);
+    }
+    std::vector<Timestamped_Telemetry> samples;
+    for (size_t i = 0U; i < SAMPLE_AMOUNT; i++) {
+        samples.emplace_back(FIRST_TIMESTAMP + i * SAMPLE_INTERVAL, &data[i * KEY_AMOUNT], KEY_AMOUNT);
+    }
+
+    Time_Series_Buffer buffer;
+    if (!buffer.Allocate(BLOCK_SIZE, BLOCK_AMOUNT, KEY_AMOUNT)) {
+        return EXIT_FAILURE;
+    }
+    auto const push_all = [&]() {
+        buffer.Clear();
+        for (size_t i = 0U; i < SAMPLE_AMOUNT; i++) {
+            if (!buffer.push(FIRST_TIMESTAMP + i * SAMPLE_INTERVAL, &data[i * KEY_AMOUNT], KEY_AMOUNT)) {
+                exit(EXIT_FAILURE);
+            }
+        }
+    };
+    push_all();
+    if (buffer.size() != SAMPLE_AMOUNT || buffer.Get_Overwritten_Amount() != 0U) {
+        return EXIT_FAILURE;
+    }
+
+    size_t const data_point_amount = SAMPLE_AMOUNT * KEY_AMOUNT;
+    size_t const array_size = data.size() * sizeof(Telemetry) + samples.size() * sizeof(Timestamped_Telemetry);
+    printf("%zu samples with %zu keys each\n", SAMPLE_AMOUNT, KEY_AMOUNT);
+    printf("  Memory per data point, Telemetry and Timestamped_Telemetry arrays %10.2f bytes\n", static_cast<double>(array_size) / static_cast<double>(data_point_amount));
+    printf("  Memory per data point, Time_Series_Buffer                         %10.2f bytes\n", static_cast<double>(buffer.used_size()) / static_cast<double>(data_point_amount));
+
+    // Storing a sample, which is a simple copy for the arrays and compressing the values for the buffer
+    std::vector<Telemetry> copied_data(data.size());
+    std::vector<Timestamped_Telemetry> copied_samples(samples.size());
+    Run_Benchmark("  Store sample, copy into Telemetry arrays", [&]() {
+        for (size_t i = 0U; i < SAMPLE_AMOUNT; i++) {
+            for (size_t j = 0U; j < KEY_AMOUNT; j++) {
+                copied_data[i * KEY_AMOUNT + j] = data[i * KEY_AMOUNT + j];
+            }
+            copied_samples[i] = Timestamped_Telemetry(FIRST_TIMESTAMP + i * SAMPLE_INTERVAL, &copied_data[i * KEY_AMOUNT], KEY_AMOUNT);
+        }
+        Do_Not_Optimize(copied_samples.back());
+    }, SAMPLE_AMOUNT);
+    Run_Benchmark("  Store sample, compress into Time_Series_Buffer", push_all, SAMPLE_AMOUNT);
+
+    // Expanding all samples into the timestamped json array, like the arrays are sent with Send_Timestamped_Telemetry and the buffer is drained by ThingsBoardSized
+    static char payload[MAX_PAYLOAD_SIZE] = {};
+    Run_Benchmark("  Serialize sample, Timestamped_Telemetry with JsonDocument", [&]() {
+        DynamicJsonDocument document(JSON_ARRAY_SIZE(SAMPLE_AMOUNT) + SAMPLE_AMOUNT * JSON_OBJECT_SIZE(2U) + SAMPLE_AMOUNT * JSON_OBJECT_SIZE(KEY_AMOUNT));
+        for (auto const & sample : samples) {
+            if (!sample.SerializeTimestampedValues(document)) {
+                exit(EXIT_FAILURE);
+            }
+        }
+        Do_Not_Optimize(serializeJson(document, payload, sizeof(payload)));
+    }, SAMPLE_AMOUNT);
+    Run_Benchmark("  Serialize sample, decompress from Time_Series_Buffer", [&]() {
+        Fixed_Buffer_Writer writer(payload, sizeof(payload));
+        size_t serialized_data_points = 0U;
+        if (buffer.Serialize(writer, SAMPLE_AMOUNT, serialized_data_points) > sizeof(payload) || serialized_data_points != data_point_amount) {
+            exit(EXIT_FAILURE);
+        }
+    }, SAMPLE_AMOUNT);
+    return 0;
+}
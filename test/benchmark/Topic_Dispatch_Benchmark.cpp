@@ -0,0 +1,109 @@
+// Local includes.
+#include "Benchmark.h"
+#include "Topic_Dispatch_Table.h"
+
+// Library includes.
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+
+/// @brief Response topic an API implementation handles received messages on
+struct Endpoint {
+    char const *topic;    // Non owning pointer to the constant response topic
+    bool       exact;     // Whether the received topic has to be exactly the response topic, instead of only starting with it
+    size_t     received;  // Amount of received messages dispatched to the endpoint
+};
+
+
+// Response topics of the built-in API implementations, with the same prefixes and exactness returned by their Get_Response_Topic
+char constexpr SHARED_ATTRIBUTE_TOPIC[] = "v1/devices/me/attributes";
+char constexpr ATTRIBUTE_RESPONSE_TOPIC[] = "v1/devices/me/attributes/response/";
+char constexpr RPC_REQUEST_TOPIC[] = "v1/devices/me/rpc/request/";
+char constexpr RPC_RESPONSE_TOPIC[] = "v1/devices/me/rpc/response/";
+char constexpr FIRMWARE_RESPONSE_TOPIC[] = "v2/fw/response/";
+char constexpr PROVISION_RESPONSE_TOPIC[] = "/provision/response";
+// Additional custom API implementations, which are registered by applications that extend the client
+char constexpr CUSTOM_TOPICS[][32] = {
+    "v1/devices/me/claim/response/", "v1/gateway/rpc/", "v1/gateway/attributes/", "v1/gateway/attributes/response/",
+    "v1/devices/me/config/", "v1/devices/me/commands/", "v1/devices/me/logs/", "v1/devices/me/events/",
+    "v1/devices/me/alarms/", "v1/devices/me/state/", "v1/devices/me/files/", "v1/devices/me/schedule/",
+    "v1/devices/me/relay/", "v1/devices/me/sensors/", "v1/devices/me/display/", "v1/devices/me/power/",
+    "v1/devices/me/network/", "v1/devices/me/storage/", "v1/devices/me/diagnostics/", "v1/devices/me/debug/",
+    "v1/devices/me/metrics/", "v1/devices/me/camera/", "v1/devices/me/audio/", "v1/devices/me/location/",
+    "v1/devices/me/motion/", "v1/devices/me/light/",
+};
+// Topics messages are received on, mostly server-side RPC requests and shared attribute updates, followed by requested responses and firmware chunks
+char constexpr RECEIVED_TOPICS[][40] = {
+    "v1/devices/me/rpc/request/17", "v1/devices/me/attributes", "v1/devices/me/rpc/request/18", "v1/devices/me/attributes/response/3",
+    "v1/devices/me/rpc/response/4", "v2/fw/response/0/chunk/12", "v1/devices/me/attributes", "v1/devices/me/rpc/request/19",
+};
+
+
+/// @brief Finds every endpoint handling the given topic by comparing it with the response topic of every endpoint, which was used before the dispatch table
+/// @param endpoints Endpoints that are compared in the order they have been registered
+/// @param topic Non owning pointer to the received topic
+/// @return Amount of endpoints the topic was dispatched to
+static size_t Dispatch_Linear_Scan(std::vector<Endpoint*> const & endpoints, char const * topic) {
+    size_t visited = 0U;
+    for (auto const & endpoint : endpoints) {
+        bool const matching = endpoint->exact ? strcmp(endpoint->topic, topic) == 0 : strncmp(endpoint->topic, topic, strlen(endpoint->topic)) == 0;
+        if (matching) {
+            endpoint->received++;
+            visited++;
+        }
+    }
+    return visited;
+}
+
+/// @brief Measures dispatching the received topics to the given endpoints with a linear scan and with the dispatch table
+/// @param endpoint_amount Amount of registered endpoints, the built-in endpoints are always registered and custom endpoints are added until the amount is reached
+static void Run_Dispatch_Benchmark(size_t const & endpoint_amount) {
+    std::vector<Endpoint> storage = {
+        {SHARED_ATTRIBUTE_TOPIC, true, 0U}, {ATTRIBUTE_RESPONSE_TOPIC, false, 0U}, {RPC_REQUEST_TOPIC, false, 0U},
+        {RPC_RESPONSE_TOPIC, false, 0U}, {FIRMWARE_RESPONSE_TOPIC, false, 0U}, {PROVISION_RESPONSE_TOPIC, true, 0U},
+    };
+    for (size_t i = 0U; storage.size() < endpoint_amount; i++) {
+        storage.push_back({CUSTOM_TOPICS[i], false, 0U});
+    }
+    std::vector<Endpoint*> endpoints;
+    Topic_Dispatch_Table<Endpoint> table;
+    for (auto & endpoint : storage) {
+        endpoints.push_back(&endpoint);
+        if (!table.Insert(endpoint.topic, endpoint.exact, &endpoint)) {
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    // Both have to dispatch every received topic to exactly one endpoint, otherwise the comparison would be meaningless
+    for (auto const & topic : RECEIVED_TOPICS) {
+        if (Dispatch_Linear_Scan(endpoints, topic) != 1U || table.For_Each_Match(topic, [](Endpoint & endpoint) { endpoint.received++; }) != 1U) {
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    size_t constexpr TOPIC_AMOUNT = sizeof(RECEIVED_TOPICS) / sizeof(RECEIVED_TOPICS[0]);
+    printf("%zu registered endpoints\n", endpoint_amount);
+    Run_Benchmark("  Linear scan comparing every response topic", [&]() {
+        size_t visited = 0U;
+        for (auto const & topic : RECEIVED_TOPICS) {
+            visited += Dispatch_Linear_Scan(endpoints, topic);
+        }
+        Do_Not_Optimize(visited);
+    }, TOPIC_AMOUNT);
+    Run_Benchmark("  Topic_Dispatch_Table::For_Each_Match", [&]() {
+        size_t visited = 0U;
+        for (auto const & topic : RECEIVED_TOPICS) {
+            visited += table.For_Each_Match(topic, [](Endpoint & endpoint) { endpoint.received++; });
+        }
+        Do_Not_Optimize(visited);
+    }, TOPIC_AMOUNT);
+}
+
+int main() {
+    // Only the built-in API implementations, with a few custom ones and with the maximum amount of custom ones the benchmark contains
+    Run_Dispatch_Benchmark(6U);
+    Run_Dispatch_Benchmark(8U);
+    Run_Dispatch_Benchmark(6U + sizeof(CUSTOM_TOPICS) / sizeof(CUSTOM_TOPICS[0]));
+    return 0;
+}
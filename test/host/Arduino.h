@@ -0,0 +1,20 @@
+#ifndef Arduino_h
+#define Arduino_h
+
+// Library includes.
+#include <chrono>
+
+
+/// @brief Minimal replacement for the Arduino core on the host, only provides the timing functions used by the platform independent sources
+/// @return Milliseconds that have passed since an arbitrary but fixed point in time, wraps around like on an Arduino device
+inline unsigned long millis() {
+    return static_cast<unsigned long>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/// @brief Minimal replacement for the Arduino core on the host, only provides the timing functions used by the platform independent sources
+/// @return Microseconds that have passed since an arbitrary but fixed point in time, wraps around like on an Arduino device
+inline unsigned long micros() {
+    return static_cast<unsigned long>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+#endif // Arduino_h